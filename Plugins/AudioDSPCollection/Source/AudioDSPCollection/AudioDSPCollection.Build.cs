@@ -29,6 +29,7 @@ public class AudioDSPCollection : ModuleRules
 			new string[]
 			{
 				// ... add public dependencies that you statically link with here ...
+				"AudioExtensions",
 				"Core",
                 "MetasoundFrontend",
 				"MetasoundGraphCore",
@@ -40,8 +41,11 @@ public class AudioDSPCollection : ModuleRules
 			new string[]
 			{
 				// ... add private dependencies that you statically link with here ...	
+				"AudioMixer",
+				"AudioMixerCore",
 				"CoreUObject",
 				"Engine",
+				"NonRealtimeAudioRenderer",
 				"SignalProcessing",
 			}
 		);
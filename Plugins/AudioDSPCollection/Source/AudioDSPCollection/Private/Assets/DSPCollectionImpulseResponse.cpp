@@ -0,0 +1,144 @@
+#include "Assets/DSPCollectionImpulseResponse.h"
+#include "AudioDevice.h"
+#include "AudioDeviceManager.h"
+#include "AudioDSPCollection.h"
+#include "DSP/Dsp.h"
+#include "DSPProcessing/Helpers/SampleConversion.h"
+#include "Sound/SoundWave.h"
+
+
+//------------------------------------------------------------------------------------
+// UDSPCollectionImpulseResponse
+//------------------------------------------------------------------------------------
+void UDSPCollectionImpulseResponse::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildSharedImpulseResponse();
+}
+
+#if WITH_EDITOR
+void UDSPCollectionImpulseResponse::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	RebuildSharedImpulseResponse();
+}
+
+void UDSPCollectionImpulseResponse::ImportSoundWave()
+{
+	if (SourceSoundWave == nullptr)
+	{
+		return;
+	}
+
+	TArray<uint8> RawPCMData;
+	uint32 WaveSampleRate = 0;
+	uint16 WaveNumChannels = 0;
+
+	if (!SourceSoundWave->GetImportedSoundWaveData(RawPCMData, WaveSampleRate, WaveNumChannels) || WaveNumChannels == 0)
+	{
+		UE_LOG(LogAudioDSPCollection, Warning, TEXT("%s: couldn't read the imported data of %s"), *GetName(), *SourceSoundWave->GetName());
+		return;
+	}
+
+	Modify();
+
+	const int32 NumSamples = RawPCMData.Num() / sizeof(int16);
+
+	Samples.SetNumUninitialized(NumSamples);
+	DSPProcessing::SampleConversion::Pcm16ToFloat(reinterpret_cast<const int16*>(RawPCMData.GetData()), Samples.GetData(), NumSamples);
+
+	NumChannels = WaveNumChannels;
+	NumFrames   = NumSamples / NumChannels;
+	SampleRate  = WaveSampleRate;
+
+	RebuildSharedImpulseResponse();
+}
+#endif
+
+void UDSPCollectionImpulseResponse::SetImpulseResponse(const TArray<float>& InSamples, const int32 InNumChannels, const float InSampleRate)
+{
+	if (InNumChannels <= 0 || InSampleRate <= 0.0f)
+	{
+		return;
+	}
+
+	Samples     = InSamples;
+	NumChannels = InNumChannels;
+	NumFrames   = Samples.Num() / NumChannels;
+	SampleRate  = InSampleRate;
+
+	RebuildSharedImpulseResponse();
+}
+
+TSharedPtr<const DSPProcessing::FSharedImpulseResponse> UDSPCollectionImpulseResponse::GetSharedImpulseResponse() const
+{
+	FScopeLock Lock(&SharedImpulseResponseCriticalSection);
+
+	return SharedImpulseResponse;
+}
+
+int32 UDSPCollectionImpulseResponse::GetDeviceBlockFrames(const uint32 InDeviceId)
+{
+	FAudioDeviceManager* AudioDeviceManager = FAudioDeviceManager::Get();
+	FAudioDevice* AudioDevice               = AudioDeviceManager ? AudioDeviceManager->GetAudioDeviceRaw(InDeviceId) : nullptr;
+
+	return AudioDevice ? AudioDevice->GetBufferLength() : 0;
+}
+
+TSharedPtr<Audio::IProxyData> UDSPCollectionImpulseResponse::CreateProxyData(const Audio::FProxyDataInitParams& InitParams)
+{
+	return MakeShared<FDSPCollectionImpulseResponseProxy>(GetSharedImpulseResponse());
+}
+
+void UDSPCollectionImpulseResponse::RebuildSharedImpulseResponse()
+{
+	TSharedPtr<const DSPProcessing::FSharedImpulseResponse> NewImpulseResponse;
+
+	if (NumChannels > 0 && NumFrames > 0 && SampleRate > 0.0f)
+	{
+		TArray<float> ScaledSamples(Samples.GetData(), NumFrames * NumChannels);
+
+		float Scale = Audio::ConvertToLinear(GainDb);
+
+		if (bNormalize)
+		{
+			// Unit energy per channel on average
+			double Energy = 0.0;
+
+			for (const float Sample : ScaledSamples)
+			{
+				Energy += Sample * Sample;
+			}
+
+			Energy /= NumChannels;
+
+			if (Energy > UE_SMALL_NUMBER)
+			{
+				Scale /= FMath::Sqrt(Energy);
+			}
+		}
+
+		for (float& Sample : ScaledSamples)
+		{
+			Sample *= Scale;
+		}
+
+		NewImpulseResponse = MakeShared<const DSPProcessing::FSharedImpulseResponse>(MoveTemp(ScaledSamples), NumChannels, SampleRate);
+
+		// The effects run at the block size and sample rate of their audio device, so they only have to pick up these partitions on the audio render thread
+		if (FAudioDeviceManager* AudioDeviceManager = FAudioDeviceManager::Get())
+		{
+			AudioDeviceManager->IterateOverAllDevices([&NewImpulseResponse](Audio::FDeviceId, FAudioDevice* InAudioDevice)
+			{
+				NewImpulseResponse->BuildPartitionedIR(InAudioDevice->GetBufferLength(), InAudioDevice->GetSampleRate(), false);
+				NewImpulseResponse->BuildPartitionedIR(InAudioDevice->GetBufferLength(), InAudioDevice->GetSampleRate(), true);
+			});
+		}
+	}
+
+	// Instances holding the previous IR keep it alive until they switch
+	FScopeLock Lock(&SharedImpulseResponseCriticalSection);
+	SharedImpulseResponse = MoveTemp(NewImpulseResponse);
+}
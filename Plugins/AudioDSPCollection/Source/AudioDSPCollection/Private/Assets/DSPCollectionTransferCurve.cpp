@@ -0,0 +1,72 @@
+#include "Assets/DSPCollectionTransferCurve.h"
+
+
+//------------------------------------------------------------------------------------
+// UDSPCollectionTransferCurve
+//------------------------------------------------------------------------------------
+UDSPCollectionTransferCurve::UDSPCollectionTransferCurve()
+{
+	FRichCurve* RichCurve = Curve.GetRichCurve();
+	RichCurve->AddKey(-1.0f, -1.0f);
+	RichCurve->AddKey(1.0f, 1.0f);
+
+	// New assets are usable before their first edit
+	Compile();
+}
+
+void UDSPCollectionTransferCurve::PostLoad()
+{
+	Super::PostLoad();
+
+	Compile();
+}
+
+#if WITH_EDITOR
+void UDSPCollectionTransferCurve::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Compile();
+}
+#endif
+
+void UDSPCollectionTransferCurve::Compile()
+{
+	const FRichCurve* RichCurve = Curve.GetRichCurveConst();
+
+	TSharedPtr<const DSPProcessing::FSharedTransferCurve> NewTransferCurve;
+
+	if (RichCurve != nullptr && RichCurve->GetNumKeys() > 0)
+	{
+		// Knots at -1 + 2 * i / NumSegments, the spline in between is built by FSharedTransferCurve
+		constexpr int32 NumSegments = DSPProcessing::FSharedTransferCurve::DefaultNumSegments;
+
+		TArray<float> Knots;
+		Knots.SetNumUninitialized(NumSegments + 1);
+
+		for (int32 Knot = 0; Knot <= NumSegments; ++Knot)
+		{
+			const float X = -1.0f + 2.0f * Knot / NumSegments;
+
+			Knots[Knot] = (bSymmetric && X < 0.0f) ? -RichCurve->Eval(-X) : RichCurve->Eval(X);
+		}
+
+		NewTransferCurve = MakeShared<const DSPProcessing::FSharedTransferCurve>(Knots);
+	}
+
+	// Instances holding the previous table keep it alive until they switch
+	FScopeLock Lock(&SharedTransferCurveCriticalSection);
+	SharedTransferCurve = MoveTemp(NewTransferCurve);
+}
+
+TSharedPtr<const DSPProcessing::FSharedTransferCurve> UDSPCollectionTransferCurve::GetSharedTransferCurve() const
+{
+	FScopeLock Lock(&SharedTransferCurveCriticalSection);
+
+	return SharedTransferCurve;
+}
+
+TSharedPtr<Audio::IProxyData> UDSPCollectionTransferCurve::CreateProxyData(const Audio::FProxyDataInitParams& InitParams)
+{
+	return MakeShared<FDSPCollectionTransferCurveProxy>(GetSharedTransferCurve());
+}
@@ -8,9 +8,15 @@
 
 #define LOCTEXT_NAMESPACE "FAudioDSPCollectionModule"
 
+DEFINE_LOG_CATEGORY(LogAudioDSPCollection);
+
 namespace FAudioDSPCollectionModulePrivate
 {
 	const FName SaturationTypePinDataTypeName(TEXT("Enum:SaturationType"));
+	const FName EnvelopeDetectorModePinDataTypeName(TEXT("Enum:EnvelopeDetectorMode"));
+	const FName TapeHysteresisSolverPinDataTypeName(TEXT("Enum:TapeHysteresisSolver"));
+	const FName GainRampShapePinDataTypeName(TEXT("Enum:GainRampShape"));
+	const FName EmphasisFilterTypePinDataTypeName(TEXT("Enum:EmphasisFilterType"));
 }
 
 void FAudioDSPCollectionModule::StartupModule()
@@ -26,6 +32,10 @@ void FAudioDSPCollectionModule::StartupModule()
 	PinParams.PinCategory = TEXT("Int32");
 
 	MetaSoundEditorModule.GetGraphPanelPinFactory()->RegisterPin(SaturationTypePinDataTypeName, PinParams);
+	MetaSoundEditorModule.GetGraphPanelPinFactory()->RegisterPin(EnvelopeDetectorModePinDataTypeName, PinParams);
+	MetaSoundEditorModule.GetGraphPanelPinFactory()->RegisterPin(TapeHysteresisSolverPinDataTypeName, PinParams);
+	MetaSoundEditorModule.GetGraphPanelPinFactory()->RegisterPin(GainRampShapePinDataTypeName, PinParams);
+	MetaSoundEditorModule.GetGraphPanelPinFactory()->RegisterPin(EmphasisFilterTypePinDataTypeName, PinParams);
 #endif
 }
 
@@ -39,6 +49,10 @@ void FAudioDSPCollectionModule::ShutdownModule()
 		Metasound::Editor::IMetasoundEditorModule& MetaSoundEditorModule = FModuleManager::GetModuleChecked<Metasound::Editor::IMetasoundEditorModule>(Metasound::Editor::IMetasoundEditorModule::ModuleName);
 
 		MetaSoundEditorModule.GetGraphPanelPinFactory()->UnregisterPin(SaturationTypePinDataTypeName);
+		MetaSoundEditorModule.GetGraphPanelPinFactory()->UnregisterPin(EnvelopeDetectorModePinDataTypeName);
+		MetaSoundEditorModule.GetGraphPanelPinFactory()->UnregisterPin(TapeHysteresisSolverPinDataTypeName);
+		MetaSoundEditorModule.GetGraphPanelPinFactory()->UnregisterPin(GainRampShapePinDataTypeName);
+		MetaSoundEditorModule.GetGraphPanelPinFactory()->UnregisterPin(EmphasisFilterTypePinDataTypeName);
 	}
 #endif
 
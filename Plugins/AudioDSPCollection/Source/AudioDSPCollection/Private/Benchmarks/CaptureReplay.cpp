@@ -0,0 +1,288 @@
+#include "AudioDSPCollection.h"
+#include "DSPProcessing/Gain.h"
+#include "DSPProcessing/Helpers/BlockCapture.h"
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "DSPProcessing/Saturation.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace DSPCollectionBenchmarks
+{
+	namespace CaptureReplay
+	{
+		constexpr int32 NumLoggedInstances = 20;
+
+		struct FInstance
+		{
+			uint64                                InstanceId  = 0;
+			DSPProcessing::EBlockCaptureProcessor Processor   = DSPProcessing::EBlockCaptureProcessor::Saturation;
+			float                                 SampleRate  = 48000.0f;
+			int32                                 NumChannels = 1;
+
+			// Recreated on every pass, the replay starts from a fresh instance like the capture did
+			TUniquePtr<DSPProcessing::FSaturation> Saturation;
+			TUniquePtr<DSPProcessing::FGain>       Gain;
+
+			int32  NumBlocks    = 0; // All passes
+			uint64 TotalCycles  = 0;
+			uint64 WorstCycles  = 0;
+			double AudioSeconds = 0.0;
+		};
+
+		static FString FindCaptureFile(const FString& InName)
+		{
+			const FString CaptureDir = FPaths::ProfilingDir() / TEXT("DSPCollection");
+
+			if (InName.IsEmpty())
+			{
+				// The newest capture, the date in the name sorts like the time
+				TArray<FString> FileNames;
+				IFileManager::Get().FindFiles(FileNames, *(CaptureDir / TEXT("Capture_*.dspcap")), true, false);
+				FileNames.Sort();
+
+				return (FileNames.Num() > 0) ? CaptureDir / FileNames.Last() : FString();
+			}
+
+			return FPaths::FileExists(InName) ? InName : CaptureDir / InName;
+		}
+
+		static const TCHAR* GetProcessorName(const DSPProcessing::EBlockCaptureProcessor InProcessor)
+		{
+			return (InProcessor == DSPProcessing::EBlockCaptureProcessor::Gain) ? TEXT("Gain") : TEXT("Saturation");
+		}
+
+		static uint64 ReplayBlock(FInstance& Instance, const DSPProcessing::FBlockCaptureRecord& InRecord, float* InBuffer, float* OutBuffer)
+		{
+			using namespace DSPProcessing;
+
+			const FBlockCaptureHeader& Header = *InRecord.Header;
+
+			const bool bFirstBlock    = !Instance.Saturation.IsValid() && !Instance.Gain.IsValid();
+			const bool bParamsChanged = bFirstBlock || EnumHasAnyFlags(Header.Flags, EBlockCaptureFlags::ParamsChanged);
+
+			// A copy, the buffer may be processed in place
+			FMemory::Memcpy(InBuffer, InRecord.Samples, sizeof(float) * Header.NumSamples);
+
+			uint64 StartCycles = 0;
+
+			if (Header.Processor == EBlockCaptureProcessor::Saturation)
+			{
+				if (bFirstBlock)
+				{
+					Instance.Saturation = MakeUnique<FSaturation>();
+					Instance.Saturation->Init(Header.SampleRate, Header.NumChannels);
+				}
+				else if (Header.NumChannels != Instance.NumChannels)
+				{
+					Instance.Saturation->SetNumChannels(Header.NumChannels);
+				}
+
+				if (bParamsChanged)
+				{
+					FSaturation::FCaptureParams Params;
+					FMemory::Memcpy(&Params, InRecord.Params, sizeof(Params));
+					Instance.Saturation->ApplyCaptureParams(Params);
+				}
+
+				StartCycles = FPlatformTime::Cycles64();
+
+				if (EnumHasAnyFlags(Header.Flags, EBlockCaptureFlags::Partitioned))
+				{
+					Instance.Saturation->ProcessAudioBufferPartitioned(InBuffer, OutBuffer, Header.NumSamples, EnumHasAnyFlags(Header.Flags, EBlockCaptureFlags::UseWorkers));
+				}
+				else
+				{
+					Instance.Saturation->ProcessAudioBuffer(InBuffer, OutBuffer, Header.NumSamples);
+				}
+			}
+			else
+			{
+				if (bFirstBlock)
+				{
+					Instance.Gain = MakeUnique<FGain>();
+					Instance.Gain->Init(Header.SampleRate, Header.NumChannels);
+				}
+				else if (Header.NumChannels != Instance.NumChannels)
+				{
+					Instance.Gain->SetNumChannels(Header.NumChannels);
+				}
+
+				if (bParamsChanged)
+				{
+					FGain::FCaptureParams Params;
+					FMemory::Memcpy(&Params, InRecord.Params, sizeof(Params));
+					Instance.Gain->ApplyCaptureParams(Params, bFirstBlock);
+				}
+
+				if (EnumHasAnyFlags(Header.Flags, EBlockCaptureFlags::Planar))
+				{
+					const int32 NumFrames = Header.NumSamples / Header.NumChannels;
+
+					TArray<const float*, TInlineAllocator<16>> InBuffers;
+					TArray<float*, TInlineAllocator<16>>       OutBuffers;
+
+					for (int32 Channel = 0; Channel < Header.NumChannels; ++Channel)
+					{
+						InBuffers.Add(InBuffer + Channel * NumFrames);
+						OutBuffers.Add(OutBuffer + Channel * NumFrames);
+					}
+
+					StartCycles = FPlatformTime::Cycles64();
+
+					Instance.Gain->ProcessPlanarBuffers(InBuffers.GetData(), OutBuffers.GetData(), Header.NumChannels, NumFrames);
+				}
+				else
+				{
+					StartCycles = FPlatformTime::Cycles64();
+
+					Instance.Gain->ProcessAudioBuffer(InBuffer, OutBuffer, Header.NumSamples);
+				}
+			}
+
+			Instance.NumChannels = Header.NumChannels;
+
+			return FPlatformTime::Cycles64() - StartCycles;
+		}
+
+		static void Run(const TArray<FString>& Args)
+		{
+			using namespace DSPProcessing;
+
+			if (FBlockCapture::IsCapturing())
+			{
+				UE_LOG(LogAudioDSPCollection, Warning, TEXT("Capture replay: a capture is running, the replay would record itself"));
+				return;
+			}
+
+			// Runs faster than real time on purpose, the capture is replayed at full quality
+			FQualityGovernor::FScopedDisable QualityGovernorDisable;
+
+			const FString Path      = FindCaptureFile((Args.Num() > 0) ? Args[0] : FString());
+			const int32   NumPasses = (Args.Num() > 1) ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 100) : 1;
+
+			TArray<uint8> Data;
+			TArray<FBlockCaptureRecord> Records;
+
+			if (Path.IsEmpty() || !FBlockCapture::LoadFile(Path, Data, Records))
+			{
+				UE_LOG(LogAudioDSPCollection, Warning, TEXT("Capture replay: no capture to replay, run au.DSPCollection.Capture.Start first"));
+				return;
+			}
+
+			TArray<FInstance> Instances;
+			TMap<uint64, int32> InstanceIndices;
+			int32 MaxNumSamples    = 0;
+			int32 NumSkippedBlocks = 0;
+
+			for (const FBlockCaptureRecord& Record : Records)
+			{
+				if (!InstanceIndices.Contains(Record.Header->InstanceId))
+				{
+					FInstance& Instance = Instances.AddDefaulted_GetRef();
+					Instance.InstanceId = Record.Header->InstanceId;
+					Instance.Processor  = Record.Header->Processor;
+					Instance.SampleRate = Record.Header->SampleRate;
+
+					InstanceIndices.Add(Record.Header->InstanceId, Instances.Num() - 1);
+				}
+
+				MaxNumSamples = FMath::Max(MaxNumSamples, Record.Header->NumSamples);
+			}
+
+			TArray<float, TAlignedHeapAllocator<16>> InBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> OutBuffer;
+			InBuffer.SetNumZeroed(MaxNumSamples);
+			OutBuffer.SetNumZeroed(MaxNumSamples);
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Capture replay: %s, %d blocks of %d instances, %d passes"), *Path, Records.Num(), Instances.Num(), NumPasses);
+
+			for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			{
+				for (FInstance& Instance : Instances)
+				{
+					Instance.Saturation.Reset();
+					Instance.Gain.Reset();
+				}
+
+				for (const FBlockCaptureRecord& Record : Records)
+				{
+					const FBlockCaptureHeader& Header = *Record.Header;
+
+					// Captured by another version of the processors
+					const int32 ExpectedParamsBytes = (Header.Processor == EBlockCaptureProcessor::Gain) ? sizeof(FGain::FCaptureParams) : sizeof(FSaturation::FCaptureParams);
+
+					if (Header.ParamsBytes != ExpectedParamsBytes || Header.NumChannels <= 0 || Header.NumSamples % Header.NumChannels != 0)
+					{
+						++NumSkippedBlocks;
+						continue;
+					}
+
+					FInstance& Instance = Instances[InstanceIndices[Header.InstanceId]];
+
+					const uint64 BlockCycles = ReplayBlock(Instance, Record, InBuffer.GetData(), OutBuffer.GetData());
+
+					++Instance.NumBlocks;
+					Instance.TotalCycles  += BlockCycles;
+					Instance.WorstCycles   = FMath::Max(Instance.WorstCycles, BlockCycles);
+					Instance.AudioSeconds += static_cast<double>(Header.NumSamples / Header.NumChannels) / Header.SampleRate;
+				}
+			}
+
+			if (NumSkippedBlocks > 0)
+			{
+				UE_LOG(LogAudioDSPCollection, Warning, TEXT("Capture replay: skipped %d blocks that don't match this build"), NumSkippedBlocks);
+			}
+
+			// Heaviest first
+			Instances.Sort([](const FInstance& A, const FInstance& B) { return A.TotalCycles > B.TotalCycles; });
+
+			uint64 TotalCycles = 0;
+			FString Csv = TEXT("InstanceId,Processor,SampleRate,NumChannels,NumBlocks,UsPerBlock,WorstUs,CorePercent\n");
+
+			for (int32 Index = 0; Index < Instances.Num(); ++Index)
+			{
+				const FInstance& Instance = Instances[Index];
+
+				if (Instance.NumBlocks == 0)
+				{
+					continue;
+				}
+
+				TotalCycles += Instance.TotalCycles;
+
+				const double TotalUs     = FPlatformTime::ToMilliseconds64(Instance.TotalCycles) * 1000.0;
+				const double UsPerBlock  = TotalUs / Instance.NumBlocks;
+				const double WorstUs     = FPlatformTime::ToMilliseconds64(Instance.WorstCycles) * 1000.0;
+				const double CorePercent = (Instance.AudioSeconds > 0.0) ? 100.0 * TotalUs * 1.0e-6 / Instance.AudioSeconds : 0.0;
+
+				if (Index < NumLoggedInstances)
+				{
+					UE_LOG(LogAudioDSPCollection, Display, TEXT("  %-10s #%-6llu %2d ch %6.0f Hz  %6d blocks  %8.2f us/block (worst %8.2f)  %6.2f%% of a core"),
+						   GetProcessorName(Instance.Processor), Instance.InstanceId, Instance.NumChannels, Instance.SampleRate, Instance.NumBlocks, UsPerBlock, WorstUs, CorePercent);
+				}
+
+				Csv += FString::Printf(TEXT("%llu,%s,%.0f,%d,%d,%.3f,%.3f,%.3f\n"), Instance.InstanceId, GetProcessorName(Instance.Processor), Instance.SampleRate, Instance.NumChannels,
+									   Instance.NumBlocks, UsPerBlock, WorstUs, CorePercent);
+			}
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Capture replay: %.2f ms of processing per pass"), FPlatformTime::ToMilliseconds64(TotalCycles) / NumPasses);
+
+			const FString CsvPath = FPaths::ProfilingDir() / TEXT("DSPCollection") / FString::Printf(TEXT("CaptureReplay_%s.csv"), *FDateTime::Now().ToString());
+
+			if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+			{
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("Capture replay results saved to %s"), *CsvPath);
+			}
+		}
+	}
+
+	static FAutoConsoleCommand CaptureReplayCommand(
+		TEXT("au.DSPCollection.Capture.Replay"),
+		TEXT("Reruns a block capture (au.DSPCollection.Capture.Start) through FSaturation and FGain with the captured signals and parameters, and times every instance. Saves a CSV to Saved/Profiling/DSPCollection. Args: [File=newest capture] [NumPasses=1]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&CaptureReplay::Run)
+	);
+}
@@ -0,0 +1,125 @@
+#include "AudioDSPCollection.h"
+#include "DSPProcessing/Convolution.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace DSPCollectionBenchmarks
+{
+	namespace ConvolutionBenchmark
+	{
+		struct FResult
+		{
+			double AverageUs; // Per block
+			double WorstUs;   // Heaviest block, the non-uniform tail lands on one block out of 8
+		};
+
+		static FResult TimeConvolution(const TSharedPtr<const DSPProcessing::FSharedImpulseResponse>& InImpulseResponse, const bool bInNonUniform, const int32 InNumChannels,
+									   const int32 InNumFrames, const int32 InNumBlocks, const float InSampleRate, const float* InBuffer, float* OutBuffer)
+		{
+			const int32 NumSamples = InNumFrames * InNumChannels;
+
+			DSPProcessing::FConvolution Convolution;
+			Convolution.Init(InSampleRate, InNumChannels);
+			Convolution.SetImpulseResponse(InImpulseResponse);
+			Convolution.SetNonUniformPartitions(bInNonUniform);
+			Convolution.PrepareBlocking(InNumFrames);
+
+			// Warm up, a full lap of the tail stage
+			for (int32 Block = 0; Block < 2 * DSPProcessing::FConvolutionIR::NonUniformTailFactor; ++Block)
+			{
+				Convolution.ProcessAudioBuffer(InBuffer, OutBuffer, NumSamples);
+			}
+
+			uint64 TotalCycles = 0;
+			uint64 WorstCycles = 0;
+
+			for (int32 Block = 0; Block < InNumBlocks; ++Block)
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+
+				Convolution.ProcessAudioBuffer(InBuffer, OutBuffer, NumSamples);
+
+				const uint64 BlockCycles = FPlatformTime::Cycles64() - StartCycles;
+				TotalCycles += BlockCycles;
+				WorstCycles  = FMath::Max(WorstCycles, BlockCycles);
+			}
+
+			return { FPlatformTime::ToMilliseconds64(TotalCycles) * 1000.0 / InNumBlocks, FPlatformTime::ToMilliseconds64(WorstCycles) * 1000.0 };
+		}
+
+		static void Run(const TArray<FString>& Args)
+		{
+			const int32 NumChannels = (Args.Num() > 0) ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 16)              : 2;
+			const float NumSeconds  = (Args.Num() > 1) ? FMath::Clamp(FCString::Atof(*Args[1]), 0.1f, 60.0f)        : 2.0f;
+			const float SampleRate  = (Args.Num() > 2) ? FMath::Clamp(FCString::Atof(*Args[2]), 8000.0f, 192000.0f) : 48000.0f;
+
+			static const int32 IRLengths[]   = { 256, 512, 1024, 2048, 4096, 8192, 16384 };
+			static const int32 FrameCounts[] = { 128, 256, 512, 1024 };
+
+			const int32 MaxNumSamples = FrameCounts[UE_ARRAY_COUNT(FrameCounts) - 1] * NumChannels;
+
+			TArray<float, TAlignedHeapAllocator<16>> InBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> OutBuffer;
+			InBuffer.SetNumUninitialized(MaxNumSamples);
+			OutBuffer.SetNumUninitialized(MaxNumSamples);
+
+			FRandomStream RandomStream(0x5A7);
+			for (float& Sample : InBuffer)
+			{
+				Sample = RandomStream.FRandRange(-0.8f, 0.8f);
+			}
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Convolution benchmark: %d channels, %.0f Hz, %.1f s of audio per measure"), NumChannels, SampleRate, NumSeconds);
+
+			FString Csv = TEXT("IRFrames,NumFrames,UniformUsPerBlock,UniformWorstUs,NonUniformUsPerBlock,NonUniformWorstUs,UniformRealtimeFactor,NonUniformRealtimeFactor\n");
+
+			for (const int32 IRFrames : IRLengths)
+			{
+				// Decaying noise, a stand-in for a cabinet/room IR (the cost doesn't depend on the content)
+				TArray<float> IRSamples;
+				IRSamples.SetNumUninitialized(IRFrames);
+
+				for (int32 Frame = 0; Frame < IRFrames; ++Frame)
+				{
+					IRSamples[Frame] = RandomStream.FRandRange(-1.0f, 1.0f) * FMath::Exp(-6.0f * Frame / IRFrames);
+				}
+
+				const TSharedPtr<const DSPProcessing::FSharedImpulseResponse> ImpulseResponse = MakeShared<const DSPProcessing::FSharedImpulseResponse>(MoveTemp(IRSamples), 1, SampleRate);
+
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("  IR %5d frames"), IRFrames);
+
+				for (const int32 NumFrames : FrameCounts)
+				{
+					const int32 NumBlocks        = FMath::Max(FMath::CeilToInt(NumSeconds * SampleRate / NumFrames), 1);
+					const double BlockDurationUs = 1.0e6 * NumFrames / SampleRate;
+
+					const FResult Uniform    = TimeConvolution(ImpulseResponse, false, NumChannels, NumFrames, NumBlocks, SampleRate, InBuffer.GetData(), OutBuffer.GetData());
+					const FResult NonUniform = TimeConvolution(ImpulseResponse, true,  NumChannels, NumFrames, NumBlocks, SampleRate, InBuffer.GetData(), OutBuffer.GetData());
+
+					UE_LOG(LogAudioDSPCollection, Display, TEXT("    %4d frames  uniform %8.2f us (worst %8.2f, x%7.1f realtime)  non-uniform %8.2f us (worst %8.2f, x%7.1f realtime)"),
+						   NumFrames, Uniform.AverageUs, Uniform.WorstUs, BlockDurationUs / Uniform.AverageUs, NonUniform.AverageUs, NonUniform.WorstUs, BlockDurationUs / NonUniform.AverageUs);
+
+					Csv += FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f\n"), IRFrames, NumFrames, Uniform.AverageUs, Uniform.WorstUs, NonUniform.AverageUs, NonUniform.WorstUs,
+										   BlockDurationUs / Uniform.AverageUs, BlockDurationUs / NonUniform.AverageUs);
+				}
+			}
+
+			const FString CsvPath = FPaths::ProfilingDir() / TEXT("DSPCollection") / FString::Printf(TEXT("Convolution_%s.csv"), *FDateTime::Now().ToString());
+
+			if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+			{
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("Convolution results saved to %s"), *CsvPath);
+			}
+		}
+	}
+
+	static FAutoConsoleCommand ConvolutionBenchmarkCommand(
+		TEXT("au.DSPCollection.Benchmark.Convolution"),
+		TEXT("Times FConvolution with uniform and non-uniform partitions, 256-16384 frame IRs and 128-1024 frame blocks. Saves a CSV to Saved/Profiling/DSPCollection. Args: [NumChannels=2] [NumSeconds=2] [SampleRate=48000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ConvolutionBenchmark::Run)
+	);
+}
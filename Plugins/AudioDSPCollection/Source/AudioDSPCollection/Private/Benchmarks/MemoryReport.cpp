@@ -0,0 +1,123 @@
+#include "AudioDSPCollection.h"
+#include "DSPProcessing/Convolution.h"
+#include "DSPProcessing/Gain.h"
+#include "DSPProcessing/GainMatrix.h"
+#include "DSPProcessing/Limiter.h"
+#include "DSPProcessing/MultibandSaturation.h"
+#include "DSPProcessing/Saturation.h"
+#include "HAL/IConsoleManager.h"
+#include "SourceEffects/SourceEffectConvolution.h"
+#include "SourceEffects/SourceEffectGain.h"
+#include "SourceEffects/SourceEffectGainMatrix.h"
+#include "SourceEffects/SourceEffectLimiter.h"
+#include "SourceEffects/SourceEffectMultibandSaturation.h"
+#include "SourceEffects/SourceEffectSaturation.h"
+
+namespace DSPCollectionBenchmarks
+{
+	namespace MemoryReport
+	{
+		constexpr int32 NumFramesPerBlock = 512;
+		constexpr float SampleRate        = 48000.0f;
+
+		static void LogInstance(const TCHAR* InName, const SIZE_T InStateSize, const SIZE_T InAllocatedSize, const int32 InNumVoices)
+		{
+			const SIZE_T TotalSize    = InStateSize + InAllocatedSize;
+			const int32 NumCacheLines = FMath::DivideAndRoundUp<int32>(static_cast<int32>(TotalSize), PLATFORM_CACHE_LINE_SIZE);
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("  %-36s %6llu bytes + %6llu heap  %3d cache lines  %8.1f KB for %d voices"),
+				   InName, (uint64)InStateSize, (uint64)InAllocatedSize, NumCacheLines, TotalSize * InNumVoices / 1024.0, InNumVoices);
+		}
+
+		template <typename EffectType>
+		static void LogPool(const TCHAR* InName)
+		{
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("  %-36s %6llu bytes  %5d in use  %5d pooled"),
+				   InName, (uint64)sizeof(EffectType), TSourceEffectPool<EffectType>::GetNumUsed(), TSourceEffectPool<EffectType>::GetNumFree());
+		}
+
+		static void Run(const TArray<FString>& Args)
+		{
+			const int32 NumChannels = (Args.Num() > 0) ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 8)    : 2;
+			const int32 NumVoices   = (Args.Num() > 1) ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 65536) : 1000;
+
+			TArray<float, TAlignedHeapAllocator<16>> Buffer;
+			Buffer.SetNumZeroed(NumFramesPerBlock * NumChannels);
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("DSP state per instance: %d channels, %d byte cache lines"), NumChannels, PLATFORM_CACHE_LINE_SIZE);
+
+			{
+				DSPProcessing::FGain Gain;
+				Gain.Init(SampleRate, NumChannels);
+				LogInstance(TEXT("FGain"), sizeof(Gain), 0, NumVoices);
+			}
+
+			{
+				DSPProcessing::FGainMatrix GainMatrix;
+				GainMatrix.Init(SampleRate, NumChannels, NumChannels);
+				LogInstance(TEXT("FGainMatrix"), sizeof(GainMatrix), 0, NumVoices);
+			}
+
+			{
+				DSPProcessing::FSaturation Saturation;
+				Saturation.Init(SampleRate, NumChannels);
+				Saturation.ProcessAudioBuffer(Buffer.GetData(), Buffer.GetData(), Buffer.Num());
+				LogInstance(TEXT("FSaturation"), sizeof(Saturation), Saturation.GetAllocatedSize(), NumVoices);
+
+				// The stateful type and the DC blocker own per channel heap state
+				Saturation.SetSaturationType(DSPProcessing::ESaturationType::TapeHysteresis);
+				Saturation.SetDCBlockerEnabled(true);
+				Saturation.ProcessAudioBuffer(Buffer.GetData(), Buffer.GetData(), Buffer.Num());
+				LogInstance(TEXT("FSaturation (TapeHysteresis + DC)"), sizeof(Saturation), Saturation.GetAllocatedSize(), NumVoices);
+			}
+
+			{
+				DSPProcessing::FMultibandSaturation MultibandSaturation;
+				MultibandSaturation.Init(SampleRate, NumChannels);
+				LogInstance(TEXT("FMultibandSaturation"), sizeof(MultibandSaturation), MultibandSaturation.GetAllocatedSize(), NumVoices);
+			}
+
+			{
+				DSPProcessing::FLimiter Limiter;
+				Limiter.Init(SampleRate, NumChannels, NumChannels, NumFramesPerBlock);
+				Limiter.ProcessAudioBuffer(Buffer.GetData(), Buffer.GetData(), Buffer.Num());
+				LogInstance(TEXT("FLimiter (5 ms look-ahead)"), sizeof(Limiter), Limiter.GetAllocatedSize(), NumVoices);
+			}
+
+			{
+				// The partitioned spectra are shared, only the delay lines and the scratch are per instance
+				TArray<float> IRSamples;
+				IRSamples.SetNumZeroed(2048);
+				IRSamples[0] = 1.0f;
+
+				const TSharedPtr<const DSPProcessing::FSharedImpulseResponse> ImpulseResponse = MakeShared<const DSPProcessing::FSharedImpulseResponse>(MoveTemp(IRSamples), 1, SampleRate);
+
+				DSPProcessing::FConvolution Convolution;
+				Convolution.Init(SampleRate, NumChannels);
+				Convolution.SetImpulseResponse(ImpulseResponse);
+				Convolution.PrepareBlocking(NumFramesPerBlock);
+				Convolution.ProcessAudioBuffer(Buffer.GetData(), Buffer.GetData(), Buffer.Num());
+				LogInstance(TEXT("FConvolution (2048 frame IR)"), sizeof(Convolution), Convolution.GetAllocatedSize(), NumVoices);
+				LogInstance(TEXT("FSharedImpulseResponse (shared)"), sizeof(DSPProcessing::FSharedImpulseResponse), ImpulseResponse->GetAllocatedSize(), 1);
+			}
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Smoother state: LPF %llu, Linear %llu, Block %llu bytes"),
+				   (uint64)sizeof(DSPProcessing::ParamSmootherLPF), (uint64)sizeof(DSPProcessing::ParamSmootherLinear), (uint64)sizeof(DSPProcessing::ParamSmootherBlock));
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Source effect pools:"));
+
+			LogPool<FSourceEffectGain>(TEXT("FSourceEffectGain"));
+			LogPool<FSourceEffectGainMatrix>(TEXT("FSourceEffectGainMatrix"));
+			LogPool<FSourceEffectSaturation>(TEXT("FSourceEffectSaturation"));
+			LogPool<FSourceEffectMultibandSaturation>(TEXT("FSourceEffectMultibandSaturation"));
+			LogPool<FSourceEffectLimiter>(TEXT("FSourceEffectLimiter"));
+			LogPool<FSourceEffectConvolution>(TEXT("FSourceEffectConvolution"));
+		}
+	}
+
+	static FAutoConsoleCommand MemoryReportCommand(
+		TEXT("au.DSPCollection.MemoryReport"),
+		TEXT("Logs the per-instance memory of every DSP class and the source effect pool usage. Args: [NumChannels=2] [NumVoices=1000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&MemoryReport::Run)
+	);
+}
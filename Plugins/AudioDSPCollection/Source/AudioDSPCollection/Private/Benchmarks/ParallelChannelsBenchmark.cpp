@@ -0,0 +1,193 @@
+#include "AudioDSPCollection.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "DSPProcessing/Saturation.h"
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace DSPCollectionBenchmarks
+{
+	namespace ParallelChannelsBenchmark
+	{
+		enum class EMode : uint8
+		{
+			Serial,             // ProcessAudioBuffer
+			PartitionedSerial,  // ProcessAudioBufferPartitioned on the calling thread, what the submix effect runs below the frame threshold
+			PartitionedWorkers  // ProcessAudioBufferPartitioned on the task graph workers
+		};
+
+		struct FConfig
+		{
+			const TCHAR* Name;
+			DSPProcessing::ESaturationType SaturationType;
+			int32 TapeHysteresisOversampling = 1;
+		};
+
+		static double TimeMode(const FConfig& InConfig, const EMode InMode, const int32 InNumChannels, const int32 InNumFrames, const int32 InNumBlocks, const float InSampleRate,
+							   const float* InBuffer, float* OutBuffer)
+		{
+			const int32 NumSamples = InNumFrames * InNumChannels;
+
+			DSPProcessing::FSaturation Saturation;
+			Saturation.Init(InSampleRate, InNumChannels, InNumChannels, InNumFrames);
+			Saturation.SetMaxChannelPartitions(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+			Saturation.SetSaturationType(InConfig.SaturationType);
+			Saturation.SetGain(50.0f);
+			Saturation.SetMix(100.0f);
+			Saturation.SetOutLevelDb(0.0f);
+			Saturation.SetTapeHysteresisOversampling(InConfig.TapeHysteresisOversampling);
+
+			// The envelope and the DC blocker are stepped by the shared parameter pass and by the partitions, the output comparison covers them too
+			Saturation.SetEnvelopeFollowerEnabled(true);
+			Saturation.SetEnvelopeToGain(50.0f);
+			Saturation.SetDCBlockerEnabled(true);
+
+			auto ProcessBlock = [&]()
+			{
+				if (InMode == EMode::Serial)
+				{
+					Saturation.ProcessAudioBuffer(InBuffer, OutBuffer, NumSamples);
+				}
+				else
+				{
+					Saturation.ProcessAudioBufferPartitioned(InBuffer, OutBuffer, NumSamples, InMode == EMode::PartitionedWorkers);
+				}
+			};
+
+			// Warm up, also wakes the workers up
+			for (int32 Block = 0; Block < 4; ++Block)
+			{
+				ProcessBlock();
+			}
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+
+			for (int32 Block = 0; Block < InNumBlocks; ++Block)
+			{
+				ProcessBlock();
+			}
+
+			return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / InNumBlocks;
+		}
+
+		static float MaxDifference(const float* InBufferA, const float* InBufferB, const int32 InNumSamples)
+		{
+			float Difference = 0.0f;
+			for (int32 i = 0; i < InNumSamples; ++i)
+			{
+				Difference = FMath::Max(Difference, FMath::Abs(InBufferA[i] - InBufferB[i]));
+			}
+
+			return Difference;
+		}
+
+		static void Run(const TArray<FString>& Args)
+		{
+			DSPProcessing::FQualityGovernor::FScopedDisable QualityGovernorDisable;
+
+			const float NumSeconds = (Args.Num() > 0) ? FMath::Clamp(FCString::Atof(*Args[0]), 0.1f, 60.0f)        : 1.0f;
+			const float SampleRate = (Args.Num() > 1) ? FMath::Clamp(FCString::Atof(*Args[1]), 8000.0f, 192000.0f) : 48000.0f;
+
+			static const int32 ChannelCounts[] = { 8, 16, 32, 64 };
+			static const int32 FrameCounts[]   = { 64, 128, 256, 512, 1024, 2048 };
+
+			static const FConfig Configs[] =
+			{
+				{ TEXT("Tape"),               DSPProcessing::ESaturationType::Tape },
+				{ TEXT("TapeHysteresis 1x"),  DSPProcessing::ESaturationType::TapeHysteresis, 1 },
+				{ TEXT("TapeHysteresis 4x"),  DSPProcessing::ESaturationType::TapeHysteresis, 4 }
+			};
+
+			const int32 MaxNumSamples = ChannelCounts[UE_ARRAY_COUNT(ChannelCounts) - 1] * FrameCounts[UE_ARRAY_COUNT(FrameCounts) - 1];
+
+			TArray<float, TAlignedHeapAllocator<16>> InBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> OutBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> SerialOutBuffer;
+			InBuffer.SetNumUninitialized(MaxNumSamples);
+			OutBuffer.SetNumUninitialized(MaxNumSamples);
+			SerialOutBuffer.SetNumUninitialized(MaxNumSamples);
+
+			FRandomStream RandomStream(0x5A7);
+			for (float& Sample : InBuffer)
+			{
+				Sample = RandomStream.FRandRange(-0.8f, 0.8f);
+			}
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Parallel channels benchmark: %.0f Hz, %.1f s of audio per measure, %d task graph workers"),
+				   SampleRate, NumSeconds, FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+			// Every mode processes the same blocks from the same state, so their last blocks must match up to rounding
+			constexpr float MaxAllowedDifference = 1.0e-4f;
+
+			FString Csv = TEXT("Config,NumChannels,NumFrames,SerialUsPerBlock,PartitionedSerialUsPerBlock,PartitionedWorkersUsPerBlock,Speedup,MaxDifference\n");
+
+			for (const FConfig& Config : Configs)
+			{
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("  %s"), Config.Name);
+
+				for (const int32 NumChannels : ChannelCounts)
+				{
+					int32 BreakEvenNumFrames = INDEX_NONE;
+
+					for (const int32 NumFrames : FrameCounts)
+					{
+						const int32 NumBlocks = FMath::Max(FMath::CeilToInt(NumSeconds * SampleRate / NumFrames), 1);
+
+						const int32 NumSamples = NumFrames * NumChannels;
+
+						const double SerialUs = TimeMode(Config, EMode::Serial, NumChannels, NumFrames, NumBlocks, SampleRate, InBuffer.GetData(), SerialOutBuffer.GetData());
+
+						const double PartitionedSerialUs = TimeMode(Config, EMode::PartitionedSerial, NumChannels, NumFrames, NumBlocks, SampleRate, InBuffer.GetData(), OutBuffer.GetData());
+						float Difference                 = MaxDifference(SerialOutBuffer.GetData(), OutBuffer.GetData(), NumSamples);
+
+						const double PartitionedWorkersUs = TimeMode(Config, EMode::PartitionedWorkers, NumChannels, NumFrames, NumBlocks, SampleRate, InBuffer.GetData(), OutBuffer.GetData());
+						Difference                        = FMath::Max(Difference, MaxDifference(SerialOutBuffer.GetData(), OutBuffer.GetData(), NumSamples));
+
+						const double Speedup = PartitionedSerialUs / PartitionedWorkersUs;
+
+						if (BreakEvenNumFrames == INDEX_NONE && Speedup > 1.0)
+						{
+							BreakEvenNumFrames = NumFrames;
+						}
+
+						UE_LOG(LogAudioDSPCollection, Display, TEXT("    %2d ch %5d frames  serial %9.2f us  partitioned %9.2f us  workers %9.2f us  x%.2f  max difference %.3g"),
+							   NumChannels, NumFrames, SerialUs, PartitionedSerialUs, PartitionedWorkersUs, Speedup, Difference);
+
+						if (Difference > MaxAllowedDifference)
+						{
+							UE_LOG(LogAudioDSPCollection, Error, TEXT("    %2d ch %5d frames: the partitioned output differs from the serial one by %.3g"), NumChannels, NumFrames, Difference);
+						}
+
+						Csv += FString::Printf(TEXT("%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3g\n"), Config.Name, NumChannels, NumFrames, SerialUs, PartitionedSerialUs, PartitionedWorkersUs, Speedup, Difference);
+					}
+
+					if (BreakEvenNumFrames != INDEX_NONE)
+					{
+						UE_LOG(LogAudioDSPCollection, Display, TEXT("    %2d ch break-even: workers win from %d frames"), NumChannels, BreakEvenNumFrames);
+					}
+					else
+					{
+						UE_LOG(LogAudioDSPCollection, Display, TEXT("    %2d ch break-even: workers never win, keep it serial"), NumChannels);
+					}
+				}
+			}
+
+			const FString CsvPath = FPaths::ProfilingDir() / TEXT("DSPCollection") / FString::Printf(TEXT("ParallelChannels_%s.csv"), *FDateTime::Now().ToString());
+
+			if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+			{
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("Parallel channels results saved to %s"), *CsvPath);
+			}
+		}
+	}
+
+	static FAutoConsoleCommand ParallelChannelsBenchmarkCommand(
+		TEXT("au.DSPCollection.Benchmark.ParallelChannels"),
+		TEXT("Times FSaturation serial vs channel partitioned on the task graph workers, 8-64 channels and 64-2048 frames, prints the break-even block size to use for au.DSPCollection.Saturation.ParallelMinChannels/ParallelMinFrames, and checks that all the modes give the same output. Saves a CSV to Saved/Profiling/DSPCollection. Args: [NumSeconds=1] [SampleRate=48000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ParallelChannelsBenchmark::Run)
+	);
+}
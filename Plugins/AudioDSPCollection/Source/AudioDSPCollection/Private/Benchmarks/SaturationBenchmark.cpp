@@ -0,0 +1,157 @@
+#include "AudioDSPCollection.h"
+#include "DSPProcessing/Saturation.h"
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "DSPProcessing/Helpers/SaturationUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace DSPCollectionBenchmarks
+{
+	namespace SaturationBenchmark
+	{
+		constexpr int32 NumFramesPerBlock = 512;
+
+		struct FConfig
+		{
+			DSPProcessing::ESaturationType SaturationType;
+			DSPProcessing::ETapeHysteresisSolver TapeHysteresisSolver = DSPProcessing::ETapeHysteresisSolver::RK4;
+			int32 TapeHysteresisOversampling = 1;
+			bool  bMidSide = false;
+		};
+
+		static FString GetConfigName(const FConfig& InConfig)
+		{
+			static const TCHAR* SaturationTypeNames[] = { TEXT("Tape"), TEXT("Tape2"), TEXT("Overdrive"), TEXT("Tube"), TEXT("Tube2"), TEXT("Distortion"), TEXT("Metal"),
+														  TEXT("Fuzz"), TEXT("HardClip"), TEXT("Foldback"), TEXT("HalfWaveRectifier"), TEXT("FullWaveRectifier"), TEXT("TapeHysteresis"),
+														  TEXT("Harmonic"), TEXT("Custom") };
+
+			FString Name = SaturationTypeNames[static_cast<int32>(InConfig.SaturationType)];
+
+			if (InConfig.SaturationType == DSPProcessing::ESaturationType::TapeHysteresis)
+			{
+				const TCHAR* SolverName = (InConfig.TapeHysteresisSolver == DSPProcessing::ETapeHysteresisSolver::RK4) ? TEXT("RK4") : TEXT("RK2");
+				Name += FString::Printf(TEXT(" (%s, %dx)"), SolverName, InConfig.TapeHysteresisOversampling);
+			}
+
+			if (InConfig.bMidSide)
+			{
+				Name += TEXT(" M/S");
+			}
+
+			return Name;
+		}
+
+		static void Run(const TArray<FString>& Args)
+		{
+			// Runs faster than real time on purpose, every config must be timed at full quality
+			DSPProcessing::FQualityGovernor::FScopedDisable QualityGovernorDisable;
+
+			const int32 NumChannels = (Args.Num() > 0) ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 16)         : 2;
+			const float NumSeconds  = (Args.Num() > 1) ? FMath::Clamp(FCString::Atof(*Args[1]), 0.1f, 60.0f)   : 10.0f;
+			const float SampleRate  = (Args.Num() > 2) ? FMath::Clamp(FCString::Atof(*Args[2]), 8000.0f, 192000.0f) : 48000.0f;
+
+			const int32 NumSamplesPerBlock = NumFramesPerBlock * NumChannels;
+			const int32 NumBlocks          = FMath::CeilToInt(NumSeconds * SampleRate / NumFramesPerBlock);
+			const double BlockDurationUs   = 1.0e6 * NumFramesPerBlock / SampleRate;
+
+			TArray<float, TAlignedHeapAllocator<16>> InBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> OutBuffer;
+			InBuffer.SetNumUninitialized(NumSamplesPerBlock);
+			OutBuffer.SetNumUninitialized(NumSamplesPerBlock);
+
+			FRandomStream RandomStream(0x5A7);
+			for (float& Sample : InBuffer)
+			{
+				Sample = RandomStream.FRandRange(-0.8f, 0.8f);
+			}
+
+			TArray<FConfig> Configs;
+			for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(DSPProcessing::ESaturationType::TapeHysteresis); ++TypeIndex)
+			{
+				Configs.Add({ static_cast<DSPProcessing::ESaturationType>(TypeIndex) });
+			}
+
+			for (const DSPProcessing::ETapeHysteresisSolver Solver : { DSPProcessing::ETapeHysteresisSolver::RK2, DSPProcessing::ETapeHysteresisSolver::RK4 })
+			{
+				for (int32 Oversampling = 1; Oversampling <= DSPProcessing::FTapeHysteresis::MaxOversampling; Oversampling *= 2)
+				{
+					Configs.Add({ DSPProcessing::ESaturationType::TapeHysteresis, Solver, Oversampling });
+				}
+			}
+
+			Configs.Add({ DSPProcessing::ESaturationType::Harmonic });
+			Configs.Add({ DSPProcessing::ESaturationType::Custom });
+
+			// The cost of the Custom type doesn't depend on the curve, any one will do
+			TArray<float> CustomCurveKnots;
+			for (int32 Knot = 0; Knot <= DSPProcessing::FSharedTransferCurve::DefaultNumSegments; ++Knot)
+			{
+				CustomCurveKnots.Add(DSPProcessing::SaturationUtils::FastTanh(3.0f * (-1.0f + 2.0f * Knot / DSPProcessing::FSharedTransferCurve::DefaultNumSegments)));
+			}
+
+			const TSharedPtr<const DSPProcessing::FSharedTransferCurve> CustomCurve = MakeShared<const DSPProcessing::FSharedTransferCurve>(CustomCurveKnots);
+
+			// Mid/side only exists for stereo, timed next to the same types in L/R
+			if (NumChannels == 2)
+			{
+				for (const DSPProcessing::ESaturationType SaturationType : { DSPProcessing::ESaturationType::Tape, DSPProcessing::ESaturationType::Tube, DSPProcessing::ESaturationType::HardClip })
+				{
+					Configs.Add({ SaturationType, DSPProcessing::ETapeHysteresisSolver::RK4, 1, true });
+				}
+
+				Configs.Add({ DSPProcessing::ESaturationType::TapeHysteresis, DSPProcessing::ETapeHysteresisSolver::RK4, 1, true });
+			}
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Saturation benchmark: %d channels, %d frames per block, %.0f Hz, %d blocks"), NumChannels, NumFramesPerBlock, SampleRate, NumBlocks);
+
+			for (const FConfig& Config : Configs)
+			{
+				DSPProcessing::FSaturation Saturation;
+				Saturation.Init(SampleRate, NumChannels);
+				Saturation.SetSaturationType(Config.SaturationType);
+				Saturation.SetGain(50.0f);
+				Saturation.SetBias(0.0f);
+				Saturation.SetMix(100.0f);
+				Saturation.SetOutLevelDb(0.0f);
+				Saturation.SetTapeHysteresisSolver(Config.TapeHysteresisSolver);
+				Saturation.SetTapeHysteresisOversampling(Config.TapeHysteresisOversampling);
+				Saturation.SetMidSideEnabled(Config.bMidSide);
+
+				// Every harmonic, so the Horner scheme runs at its full degree
+				for (int32 Harmonic = 1; Harmonic <= DSPProcessing::FHarmonicShaper::MaxHarmonic; ++Harmonic)
+				{
+					Saturation.SetHarmonicWeight(Harmonic, 1.0f / Harmonic);
+				}
+
+				Saturation.SetCustomCurve(CustomCurve);
+
+				Saturation.SetSideGain(25.0f);
+				Saturation.SetSideBias(0.0f);
+				Saturation.SetSideMix(100.0f);
+
+				// Warm up
+				Saturation.ProcessAudioBuffer(InBuffer.GetData(), OutBuffer.GetData(), NumSamplesPerBlock);
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+
+				for (int32 Block = 0; Block < NumBlocks; ++Block)
+				{
+					Saturation.ProcessAudioBuffer(InBuffer.GetData(), OutBuffer.GetData(), NumSamplesPerBlock);
+				}
+
+				const double ElapsedUs  = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+				const double UsPerBlock = ElapsedUs / NumBlocks;
+
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("  %-28s %8.2f us/block  %6.3f%% of one core  %6.2f ns/sample"),
+					   *GetConfigName(Config), UsPerBlock, 100.0 * UsPerBlock / BlockDurationUs, 1000.0 * UsPerBlock / NumSamplesPerBlock);
+			}
+		}
+	}
+
+	static FAutoConsoleCommand SaturationBenchmarkCommand(
+		TEXT("au.DSPCollection.Benchmark.Saturation"),
+		TEXT("Times FSaturation for every saturation type (and every TapeHysteresis solver/oversampling). Args: [NumChannels=2] [NumSeconds=10] [SampleRate=48000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&SaturationBenchmark::Run)
+	);
+}
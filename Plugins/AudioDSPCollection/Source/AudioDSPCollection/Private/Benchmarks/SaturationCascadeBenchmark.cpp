@@ -0,0 +1,142 @@
+#include "AudioDSPCollection.h"
+#include "DSPProcessing/Saturation.h"
+#include "DSPProcessing/SaturationCascade.h"
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace DSPCollectionBenchmarks
+{
+	namespace SaturationCascadeBenchmark
+	{
+		constexpr int32 NumFramesPerBlock = 512;
+
+		// A typical amp-style chain, truncated to the number of stages being timed
+		static const DSPProcessing::ESaturationType StageSaturationTypes[] = { DSPProcessing::ESaturationType::Tube, DSPProcessing::ESaturationType::Tube2,
+																			   DSPProcessing::ESaturationType::Tape, DSPProcessing::ESaturationType::HardClip };
+
+		static constexpr float StageGain    = 50.0f;
+		static constexpr float StageLevelDb = -3.0f;
+
+		static void Run(const TArray<FString>& Args)
+		{
+			// Runs faster than real time on purpose, the chained FSaturation instances must stay at full quality
+			DSPProcessing::FQualityGovernor::FScopedDisable QualityGovernorDisable;
+
+			const int32 NumChannels = (Args.Num() > 0) ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 16)         : 2;
+			const float NumSeconds  = (Args.Num() > 1) ? FMath::Clamp(FCString::Atof(*Args[1]), 0.1f, 60.0f)   : 10.0f;
+			const float SampleRate  = (Args.Num() > 2) ? FMath::Clamp(FCString::Atof(*Args[2]), 8000.0f, 192000.0f) : 48000.0f;
+
+			const int32 NumSamplesPerBlock = NumFramesPerBlock * NumChannels;
+			const int32 NumBlocks          = FMath::CeilToInt(NumSeconds * SampleRate / NumFramesPerBlock);
+			const double BlockDurationUs   = 1.0e6 * NumFramesPerBlock / SampleRate;
+
+			TArray<float, TAlignedHeapAllocator<16>> InBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> ChainedBuffers[2];
+			TArray<float, TAlignedHeapAllocator<16>> CascadeBuffer;
+			InBuffer.SetNumUninitialized(NumSamplesPerBlock);
+			ChainedBuffers[0].SetNumUninitialized(NumSamplesPerBlock);
+			ChainedBuffers[1].SetNumUninitialized(NumSamplesPerBlock);
+			CascadeBuffer.SetNumUninitialized(NumSamplesPerBlock);
+
+			FRandomStream RandomStream(0x5A7);
+			for (float& Sample : InBuffer)
+			{
+				Sample = RandomStream.FRandRange(-0.8f, 0.8f);
+			}
+
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Saturation cascade benchmark: %d channels, %d frames per block, %.0f Hz, %d blocks"), NumChannels, NumFramesPerBlock, SampleRate, NumBlocks);
+
+			for (int32 NumStages = 2; NumStages <= DSPProcessing::FSaturationCascade::MaxNumStages; ++NumStages)
+			{
+				// Chained equivalent: one FSaturation per stage at Mix 100, the stage level as its OutLevel
+				TArray<TUniquePtr<DSPProcessing::FSaturation>> ChainedStages;
+				for (int32 Stage = 0; Stage < NumStages; ++Stage)
+				{
+					TUniquePtr<DSPProcessing::FSaturation>& Saturation = ChainedStages.Add_GetRef(MakeUnique<DSPProcessing::FSaturation>());
+					Saturation->Init(SampleRate, NumChannels);
+					Saturation->SetSaturationType(StageSaturationTypes[Stage]);
+					Saturation->SetGain(StageGain);
+					Saturation->SetBias(0.0f);
+					Saturation->SetMix(100.0f);
+					Saturation->SetOutLevelDb(StageLevelDb);
+				}
+
+				DSPProcessing::FSaturationCascade Cascade;
+				Cascade.Init(SampleRate, NumChannels);
+				Cascade.SetNumStages(NumStages);
+				for (int32 Stage = 0; Stage < NumStages; ++Stage)
+				{
+					Cascade.SetStageSaturationType(Stage, StageSaturationTypes[Stage]);
+					Cascade.SetStageGain(Stage, StageGain);
+					Cascade.SetStageBias(Stage, 0.0f);
+					Cascade.SetStageLevelDb(Stage, StageLevelDb);
+				}
+				Cascade.SetMix(100.0f);
+				Cascade.SetOutLevelDb(0.0f);
+
+				// Returns the buffer holding the output of the last stage
+				auto ProcessChained = [&]() -> const float*
+				{
+					const float* StageIn = InBuffer.GetData();
+					for (int32 Stage = 0; Stage < NumStages; ++Stage)
+					{
+						float* StageOut = ChainedBuffers[Stage & 1].GetData();
+						ChainedStages[Stage]->ProcessAudioBuffer(StageIn, StageOut, NumSamplesPerBlock);
+						StageIn = StageOut;
+					}
+
+					return StageIn;
+				};
+
+				// Warm up
+				ProcessChained();
+				Cascade.ProcessAudioBuffer(InBuffer.GetData(), CascadeBuffer.GetData(), NumSamplesPerBlock);
+
+				const float* ChainedOut = nullptr;
+
+				uint64 StartCycles = FPlatformTime::Cycles64();
+
+				for (int32 Block = 0; Block < NumBlocks; ++Block)
+				{
+					ChainedOut = ProcessChained();
+				}
+
+				const double ChainedUsPerBlock = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumBlocks;
+
+				StartCycles = FPlatformTime::Cycles64();
+
+				for (int32 Block = 0; Block < NumBlocks; ++Block)
+				{
+					Cascade.ProcessAudioBuffer(InBuffer.GetData(), CascadeBuffer.GetData(), NumSamplesPerBlock);
+				}
+
+				const double CascadeUsPerBlock = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumBlocks;
+
+				// Both have settled by now, so their last blocks must match
+				float MaxDifference = 0.0f;
+				for (int32 i = 0; i < NumSamplesPerBlock; ++i)
+				{
+					MaxDifference = FMath::Max(MaxDifference, FMath::Abs(ChainedOut[i] - CascadeBuffer[i]));
+				}
+
+				const FString ChainedName = FString::Printf(TEXT("%d stages chained"), NumStages);
+				const FString CascadeName = FString::Printf(TEXT("%d stages cascade"), NumStages);
+
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("  %-28s %8.2f us/block  %6.3f%% of one core  %6.2f ns/sample"),
+					   *ChainedName, ChainedUsPerBlock, 100.0 * ChainedUsPerBlock / BlockDurationUs, 1000.0 * ChainedUsPerBlock / NumSamplesPerBlock);
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("  %-28s %8.2f us/block  %6.3f%% of one core  %6.2f ns/sample"),
+					   *CascadeName, CascadeUsPerBlock, 100.0 * CascadeUsPerBlock / BlockDurationUs, 1000.0 * CascadeUsPerBlock / NumSamplesPerBlock);
+				UE_LOG(LogAudioDSPCollection, Display, TEXT("  %-28s %8.2fx          max difference %.3g"),
+					   TEXT("speedup"), ChainedUsPerBlock / FMath::Max(CascadeUsPerBlock, UE_DOUBLE_SMALL_NUMBER), MaxDifference);
+			}
+		}
+	}
+
+	static FAutoConsoleCommand SaturationCascadeBenchmarkCommand(
+		TEXT("au.DSPCollection.Benchmark.SaturationCascade"),
+		TEXT("Times FSaturationCascade against the same 2-4 stages as chained FSaturation instances, and checks that both outputs match. Args: [NumChannels=2] [NumSeconds=10] [SampleRate=48000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&SaturationCascadeBenchmark::Run)
+	);
+}
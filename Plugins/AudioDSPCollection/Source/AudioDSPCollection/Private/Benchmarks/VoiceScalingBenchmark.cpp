@@ -0,0 +1,257 @@
+#include "AudioDSPCollection.h"
+#include "ActiveSound.h"
+#include "AudioDevice.h"
+#include "AudioDeviceManager.h"
+#include "AudioMixerDevice.h"
+#include "AudioMixerPlatformNonRealtime.h"
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Modules/ModuleManager.h"
+#include "Sound/SoundEffectSource.h"
+#include "Sound/SoundSubmix.h"
+#include "Sound/SoundWave.h"
+#include "SourceEffects/SourceEffectGain.h"
+#include "SourceEffects/SourceEffectSaturation.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Plays 64-2048 looping sine_220 voices through the real audio mixer, every voice with the Gain -> Saturation source effect chain and routed
+// to DemoSoundSubMix (with its submix effects), and times the mixer render of each block at every voice count.
+// The device is a unique non-realtime one: it renders on the calling thread when asked, so no sound card is needed and the time of each
+// render call is the render thread time of the block. Runs headless, e.g. on a Linux build machine (the voice count is capped by AudioMaxChannels):
+// UnrealEditor-Cmd UEAudioDSPCollection.uproject -nullrhi -unattended -ini:Engine:[/Script/LinuxTargetPlatform.LinuxTargetSettings]:AudioMaxChannels=2048
+//   -ExecCmds="Automation RunTests DSPCollection.Benchmark.VoiceScaling; Quit"
+// Optional: -VoiceScalingMinVoices=64 -VoiceScalingMaxVoices=2048 -VoiceScalingSeconds=2
+namespace DSPCollectionBenchmarks
+{
+	namespace VoiceScalingBenchmark
+	{
+		constexpr int32 NumFramesPerBlock = 512;
+		constexpr int32 NumWarmUpBlocks   = 16;
+
+		struct FResult
+		{
+			int32  NumVoices;
+			int32  NumActiveSources;
+			double MeanUsPerBlock;
+			double MaxUsPerBlock;
+		};
+
+		template <typename ObjectType>
+		static ObjectType* LoadDemoObject(const TCHAR* InPath)
+		{
+			return LoadObject<ObjectType>(nullptr, InPath, nullptr, LOAD_Quiet | LOAD_NoWarn);
+		}
+
+		static FResult RunVoiceCount(FAudioDevice& InAudioDevice, Audio::FMixerPlatformNonRealtime& InPlatform, USoundWave& InSound, const int32 InNumVoices, const int32 InNumBlocks)
+		{
+			const double BlockDurationSeconds = static_cast<double>(NumFramesPerBlock) / InAudioDevice.GetSampleRate();
+
+			InAudioDevice.SetMaxChannels(InNumVoices);
+
+			for (int32 VoiceIndex = 0; VoiceIndex < InNumVoices; ++VoiceIndex)
+			{
+				// UI sounds need no world nor listener, every voice is a plain 2D source
+				FActiveSound NewActiveSound;
+				NewActiveSound.SetSound(&InSound);
+				NewActiveSound.bIsUISound           = true;
+				NewActiveSound.bAllowSpatialization = false;
+				NewActiveSound.VolumeMultiplier     = 1.0f / FMath::Sqrt(static_cast<float>(InNumVoices));
+				NewActiveSound.RequestedStartTime   = BlockDurationSeconds * (VoiceIndex % 64) / 64.0; // Spread the phases
+
+				InAudioDevice.AddNewActiveSound(NewActiveSound);
+			}
+
+			// Let the voices start and the effect chains initialize before timing
+			for (int32 Block = 0; Block < NumWarmUpBlocks; ++Block)
+			{
+				InAudioDevice.Update(true);
+				InPlatform.RenderAudio(BlockDurationSeconds);
+			}
+
+			const int32 NumActiveSources = InAudioDevice.GetNumActiveSources();
+
+			double TotalUs = 0.0;
+			double MaxUs   = 0.0;
+
+			for (int32 Block = 0; Block < InNumBlocks; ++Block)
+			{
+				// Game thread side of the mixer, not part of the render
+				InAudioDevice.Update(true);
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+
+				InPlatform.RenderAudio(BlockDurationSeconds);
+
+				const double BlockUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+
+				TotalUs += BlockUs;
+				MaxUs    = FMath::Max(MaxUs, BlockUs);
+			}
+
+			InAudioDevice.StopAllSounds(true);
+
+			for (int32 Block = 0; Block < NumWarmUpBlocks; ++Block)
+			{
+				InAudioDevice.Update(true);
+				InPlatform.RenderAudio(BlockDurationSeconds);
+			}
+
+			return { InNumVoices, NumActiveSources, TotalUs / InNumBlocks, MaxUs };
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDSPCollectionVoiceScalingBenchmark, "DSPCollection.Benchmark.VoiceScaling",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FDSPCollectionVoiceScalingBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace DSPCollectionBenchmarks::VoiceScalingBenchmark;
+
+	// The curve is the cost of the full quality, the governor would flatten it
+	DSPProcessing::FQualityGovernor::FScopedDisable QualityGovernorDisable;
+
+	int32 MinNumVoices = 64;
+	int32 MaxNumVoices = 2048;
+	float NumSeconds   = 2.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("VoiceScalingMinVoices="), MinNumVoices);
+	FParse::Value(FCommandLine::Get(), TEXT("VoiceScalingMaxVoices="), MaxNumVoices);
+	FParse::Value(FCommandLine::Get(), TEXT("VoiceScalingSeconds="), NumSeconds);
+
+	MinNumVoices = FMath::Clamp(MinNumVoices, 1, 8192);
+	MaxNumVoices = FMath::Clamp(MaxNumVoices, MinNumVoices, 8192);
+	NumSeconds   = FMath::Clamp(NumSeconds, 0.1f, 60.0f);
+
+	FAudioDeviceManager* AudioDeviceManager = GEngine ? GEngine->GetAudioDeviceManager() : nullptr;
+
+	if (!AudioDeviceManager)
+	{
+		AddError(TEXT("No audio device manager, don't run with -nosound"));
+		return false;
+	}
+
+	IAudioDeviceModule* NonRealtimeModule = FModuleManager::LoadModulePtr<IAudioDeviceModule>(TEXT("NonRealtimeAudioRenderer"));
+
+	if (!NonRealtimeModule)
+	{
+		AddError(TEXT("The NonRealtimeAudioRenderer module is not available"));
+		return false;
+	}
+
+	USoundWave* SineSound = LoadDemoObject<USoundWave>(TEXT("/Game/sine_220.sine_220"));
+
+	if (!SineSound)
+	{
+		AddError(TEXT("Could not load /Game/sine_220"));
+		return false;
+	}
+
+	// The demo chain and submix when they have the plugin effects, the default presets otherwise
+	USoundEffectSourcePreset* GainPreset       = LoadDemoObject<USourceEffectGainPreset>(TEXT("/Game/SourceEffectPresets/Gain_SourceEffectPreset.Gain_SourceEffectPreset"));
+	USoundEffectSourcePreset* SaturationPreset = LoadDemoObject<USourceEffectSaturationPreset>(TEXT("/Game/SourceEffectPresets/Saturation_SourceEffectPreset.Saturation_SourceEffectPreset"));
+
+	USoundEffectSourcePresetChain* SourceEffectChain = NewObject<USoundEffectSourcePresetChain>();
+
+	FSourceEffectChainEntry GainEntry;
+	GainEntry.Preset = GainPreset ? GainPreset : NewObject<USourceEffectGainPreset>();
+	SourceEffectChain->Chain.Add(GainEntry);
+
+	FSourceEffectChainEntry SaturationEntry;
+	SaturationEntry.Preset = SaturationPreset ? SaturationPreset : NewObject<USourceEffectSaturationPreset>();
+	SourceEffectChain->Chain.Add(SaturationEntry);
+
+	USoundSubmix* DemoSubmix = LoadDemoObject<USoundSubmix>(TEXT("/Game/DemoSoundSubMix.DemoSoundSubMix"));
+
+	if (!DemoSubmix)
+	{
+		AddWarning(TEXT("Could not load /Game/DemoSoundSubMix, the voices go to the master submix without submix effects"));
+	}
+
+	// Restored when the test ends, the asset is shared with the rest of the session
+	USoundEffectSourcePresetChain* PrevSourceEffectChain = SineSound->SourceEffectChain;
+	USoundSubmixBase*              PrevSubmix            = SineSound->SoundSubmixObject;
+	const bool                     bPrevLooping          = SineSound->bLooping;
+
+	ON_SCOPE_EXIT
+	{
+		SineSound->SourceEffectChain = PrevSourceEffectChain;
+		SineSound->SoundSubmixObject = PrevSubmix;
+		SineSound->bLooping          = bPrevLooping;
+	};
+
+	SineSound->SourceEffectChain = SourceEffectChain;
+	SineSound->SoundSubmixObject = DemoSubmix;
+	SineSound->bLooping          = true;
+
+	FAudioDeviceParams DeviceParams;
+	DeviceParams.Scope              = EAudioDeviceScope::Unique;
+	DeviceParams.bIsNonRealtime     = true;
+	DeviceParams.AudioModule        = NonRealtimeModule;
+	DeviceParams.BufferSizeOverride = NumFramesPerBlock;
+	DeviceParams.NumBuffersOverride = 2;
+
+	FAudioDeviceHandle AudioDeviceHandle = AudioDeviceManager->RequestAudioDevice(DeviceParams);
+
+	Audio::FMixerDevice* MixerDevice = static_cast<Audio::FMixerDevice*>(AudioDeviceHandle.GetAudioDevice());
+
+	if (!MixerDevice || !MixerDevice->IsNonRealtime())
+	{
+		AddError(TEXT("Could not create a non-realtime audio mixer device"));
+		return false;
+	}
+
+	Audio::FMixerPlatformNonRealtime* Platform = static_cast<Audio::FMixerPlatformNonRealtime*>(MixerDevice->GetAudioMixerPlatform());
+
+	const float  SampleRate      = MixerDevice->GetSampleRate();
+	const int32  NumBlocks       = FMath::CeilToInt(NumSeconds * SampleRate / NumFramesPerBlock);
+	const double BlockDurationUs = 1.0e6 * NumFramesPerBlock / SampleRate;
+	const int32  MaxSources      = MixerDevice->GetMaxSources();
+
+	if (MaxNumVoices > MaxSources)
+	{
+		AddWarning(FString::Printf(TEXT("The device has %d sources, the curve stops there (raise AudioMaxChannels to go up to %d voices)"), MaxSources, MaxNumVoices));
+		MaxNumVoices = FMath::Max(MaxSources, MinNumVoices);
+	}
+
+	UE_LOG(LogAudioDSPCollection, Display, TEXT("Voice scaling benchmark: %d-%d voices, %d frames per block, %.0f Hz, %d blocks per voice count"),
+		   MinNumVoices, MaxNumVoices, NumFramesPerBlock, SampleRate, NumBlocks);
+
+	FString Csv = TEXT("NumVoices,NumActiveSources,MeanUsPerBlock,MaxUsPerBlock,MeanPercentOfBlock,MeanNsPerVoiceFrame\n");
+
+	for (int32 NumVoices = MinNumVoices; NumVoices <= MaxNumVoices; NumVoices *= 2)
+	{
+		const FResult Result = RunVoiceCount(*MixerDevice, *Platform, *SineSound, NumVoices, NumBlocks);
+
+		if (Result.NumActiveSources < NumVoices)
+		{
+			AddWarning(FString::Printf(TEXT("%d voices requested, only %d sources were playing (concurrency or virtualization)"), NumVoices, Result.NumActiveSources));
+		}
+
+		const double PercentOfBlock  = 100.0 * Result.MeanUsPerBlock / BlockDurationUs;
+		const double NsPerVoiceFrame = 1000.0 * Result.MeanUsPerBlock / (static_cast<double>(NumVoices) * NumFramesPerBlock);
+
+		UE_LOG(LogAudioDSPCollection, Display, TEXT("  %5d voices (%5d playing)  %9.2f us/block (max %9.2f)  %7.2f%% of one core  %6.2f ns/voice/frame"),
+			   NumVoices, Result.NumActiveSources, Result.MeanUsPerBlock, Result.MaxUsPerBlock, PercentOfBlock, NsPerVoiceFrame);
+
+		Csv += FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.3f,%.3f\n"), NumVoices, Result.NumActiveSources, Result.MeanUsPerBlock, Result.MaxUsPerBlock, PercentOfBlock, NsPerVoiceFrame);
+	}
+
+	const FString CsvPath = FPaths::ProfilingDir() / TEXT("DSPCollection") / FString::Printf(TEXT("VoiceScaling_%s.csv"), *FDateTime::Now().ToString());
+
+	if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		UE_LOG(LogAudioDSPCollection, Display, TEXT("Voice scaling curve saved to %s"), *CsvPath);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,334 @@
+#include "Commandlets/DSPCollectionRenderCommandlet.h"
+#include "AudioDSPCollection.h"
+#include "Commandlets/WaveStream.h"
+#include "DSPProcessing/Gain.h"
+#include "DSPProcessing/Saturation.h"
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "DSPProcessing/Helpers/SampleConversion.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+
+namespace DSPCollectionCommandlets
+{
+	namespace RenderCommandlet
+	{
+		constexpr int32 DefaultBlockSize = 4096;
+		constexpr int32 MinBlockSize     = 64;
+		constexpr int32 MaxBlockSize     = 65536;
+
+		class IRenderStage
+		{
+		public:
+			virtual ~IRenderStage() = default;
+			virtual void ProcessAudioBuffer(float* InOutBuffer, const int32 InNumSamples) = 0;
+		};
+
+		class FGainStage : public IRenderStage
+		{
+		public:
+			FGainStage(const float InSampleRate, const int32 InNumChannels, const float InGain)
+			{
+				Gain.Init(InSampleRate, InNumChannels);
+				Gain.SetGain(InGain);
+			}
+
+			virtual void ProcessAudioBuffer(float* InOutBuffer, const int32 InNumSamples) override
+			{
+				Gain.ProcessAudioBuffer(InOutBuffer, InOutBuffer, InNumSamples);
+			}
+
+		private:
+			DSPProcessing::FGain Gain;
+		};
+
+		class FSaturationStage : public IRenderStage
+		{
+		public:
+			FSaturationStage(const float InSampleRate, const int32 InNumChannels, const DSPProcessing::ESaturationType InType, const float InGain, const float InMix, const float InBias)
+			{
+				Saturation.Init(InSampleRate, InNumChannels);
+				Saturation.SetSaturationType(InType); // Set SaturationType first since Gain depends on it
+				Saturation.SetGain(InGain);
+				Saturation.SetMix(InMix);
+				Saturation.SetBias(InBias);
+				Saturation.SetOutLevelDb(0.0f);
+			}
+
+			virtual void ProcessAudioBuffer(float* InOutBuffer, const int32 InNumSamples) override
+			{
+				Saturation.ProcessAudioBuffer(InOutBuffer, InOutBuffer, InNumSamples);
+			}
+
+		private:
+			DSPProcessing::FSaturation Saturation;
+		};
+
+		static bool ParseSaturationType(const FString& InName, DSPProcessing::ESaturationType& OutType)
+		{
+			static const TCHAR* SaturationTypeNames[] = { TEXT("Tape"), TEXT("Tape2"), TEXT("Overdrive"), TEXT("Tube"), TEXT("Tube2"), TEXT("Distortion"), TEXT("Metal"),
+														  TEXT("Fuzz"), TEXT("HardClip"), TEXT("Foldback"), TEXT("HalfWaveRectifier"), TEXT("FullWaveRectifier"), TEXT("TapeHysteresis"),
+														  TEXT("Harmonic") };
+
+			for (int32 TypeIndex = 0; TypeIndex < UE_ARRAY_COUNT(SaturationTypeNames); ++TypeIndex)
+			{
+				if (InName.Equals(SaturationTypeNames[TypeIndex], ESearchCase::IgnoreCase))
+				{
+					OutType = static_cast<DSPProcessing::ESaturationType>(TypeIndex);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		static bool ParseChain(const FString& InChain, const float InSampleRate, const int32 InNumChannels, TArray<TUniquePtr<IRenderStage>>& OutStages)
+		{
+			TArray<FString> StageDescs;
+			InChain.ParseIntoArray(StageDescs, TEXT("+"));
+
+			for (const FString& StageDesc : StageDescs)
+			{
+				TArray<FString> Tokens;
+				StageDesc.ParseIntoArray(Tokens, TEXT(":"));
+
+				const FString StageName = Tokens.Num() > 0 ? Tokens[0] : FString();
+				auto GetArg = [&Tokens](const int32 InIndex, const float InDefault) { return Tokens.IsValidIndex(InIndex) ? FCString::Atof(*Tokens[InIndex]) : InDefault; };
+
+				if (StageName.Equals(TEXT("Gain"), ESearchCase::IgnoreCase))
+				{
+					OutStages.Add(MakeUnique<FGainStage>(InSampleRate, InNumChannels, GetArg(1, 1.0f)));
+				}
+				else if (StageName.Equals(TEXT("GainDb"), ESearchCase::IgnoreCase))
+				{
+					OutStages.Add(MakeUnique<FGainStage>(InSampleRate, InNumChannels, DSPProcessing::FGain::ConvertDbToGain(GetArg(1, 0.0f))));
+				}
+				else if (StageName.Equals(TEXT("Saturation"), ESearchCase::IgnoreCase))
+				{
+					DSPProcessing::ESaturationType SaturationType = DSPProcessing::ESaturationType::Tape;
+
+					if (Tokens.IsValidIndex(1) && !ParseSaturationType(Tokens[1], SaturationType))
+					{
+						UE_LOG(LogAudioDSPCollection, Error, TEXT("Unknown saturation type '%s'"), *Tokens[1]);
+						return false;
+					}
+
+					OutStages.Add(MakeUnique<FSaturationStage>(InSampleRate, InNumChannels, SaturationType, GetArg(2, 50.0f), GetArg(3, 100.0f), GetArg(4, 0.0f)));
+				}
+				else
+				{
+					UE_LOG(LogAudioDSPCollection, Error, TEXT("Unknown chain stage '%s'"), *StageDesc);
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		static bool ParseSampleFormat(const FString& InName, EWaveSampleFormat& OutFormat)
+		{
+			if (InName.Equals(TEXT("Int16"), ESearchCase::IgnoreCase))
+			{
+				OutFormat = EWaveSampleFormat::Int16;
+			}
+			else if (InName.Equals(TEXT("Int24"), ESearchCase::IgnoreCase))
+			{
+				OutFormat = EWaveSampleFormat::Int24;
+			}
+			else if (InName.Equals(TEXT("Float"), ESearchCase::IgnoreCase))
+			{
+				OutFormat = EWaveSampleFormat::Float32;
+			}
+			else
+			{
+				return false;
+			}
+
+			return true;
+		}
+
+		static void ConvertToFloat(const uint8* InBuffer, float* OutBuffer, const int32 InNumSamples, const EWaveSampleFormat InFormat)
+		{
+			switch (InFormat)
+			{
+				default:
+				case EWaveSampleFormat::Int16:
+					DSPProcessing::SampleConversion::Pcm16ToFloat(reinterpret_cast<const int16*>(InBuffer), OutBuffer, InNumSamples);
+					break;
+				case EWaveSampleFormat::Int24:
+					DSPProcessing::SampleConversion::Pcm24ToFloat(InBuffer, OutBuffer, InNumSamples);
+					break;
+				case EWaveSampleFormat::Float32:
+					FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * InNumSamples);
+					break;
+			}
+		}
+
+		static void ConvertFromFloat(const float* InBuffer, uint8* OutBuffer, const int32 InNumSamples, const EWaveSampleFormat InFormat)
+		{
+			switch (InFormat)
+			{
+				default:
+				case EWaveSampleFormat::Int16:
+					DSPProcessing::SampleConversion::FloatToPcm16(InBuffer, reinterpret_cast<int16*>(OutBuffer), InNumSamples);
+					break;
+				case EWaveSampleFormat::Int24:
+					DSPProcessing::SampleConversion::FloatToPcm24(InBuffer, OutBuffer, InNumSamples);
+					break;
+				case EWaveSampleFormat::Float32:
+					FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * InNumSamples);
+					break;
+			}
+		}
+	}
+}
+
+UDSPCollectionRenderCommandlet::UDSPCollectionRenderCommandlet()
+{
+	IsClient       = false;
+	IsEditor       = false;
+	IsServer       = false;
+	LogToConsole   = true;
+	ShowErrorCount = true;
+}
+
+int32 UDSPCollectionRenderCommandlet::Main(const FString& Params)
+{
+	using namespace DSPCollectionCommandlets;
+	using namespace DSPCollectionCommandlets::RenderCommandlet;
+
+	// Offline, as fast as possible: the output must not depend on the machine load
+	DSPProcessing::FQualityGovernor::FScopedDisable QualityGovernorDisable;
+
+	FString InFilename;
+	FString OutFilename;
+	FString Chain;
+
+	if (!FParse::Value(*Params, TEXT("In="), InFilename) || !FParse::Value(*Params, TEXT("Out="), OutFilename) || !FParse::Value(*Params, TEXT("Chain="), Chain))
+	{
+		UE_LOG(LogAudioDSPCollection, Error, TEXT("Usage: -run=DSPCollectionRender -In=In.wav -Out=Out.wav -Chain=Saturation:Tube:60+GainDb:-6 [-Format=Int16|Int24|Float] [-BlockSize=4096]"));
+		return 1;
+	}
+
+	FString Error;
+	FWaveStreamReader Reader;
+
+	if (!Reader.Open(InFilename, Error))
+	{
+		UE_LOG(LogAudioDSPCollection, Error, TEXT("%s: %s"), *InFilename, *Error);
+		return 1;
+	}
+
+	const FWaveFormat& InFormat = Reader.GetFormat();
+	FWaveFormat OutFormat       = InFormat;
+
+	FString OutFormatName;
+
+	if (FParse::Value(*Params, TEXT("Format="), OutFormatName) && !ParseSampleFormat(OutFormatName, OutFormat.SampleFormat))
+	{
+		UE_LOG(LogAudioDSPCollection, Error, TEXT("Unknown output format '%s', use Int16, Int24 or Float"), *OutFormatName);
+		return 1;
+	}
+
+	int32 BlockSize = DefaultBlockSize;
+	FParse::Value(*Params, TEXT("BlockSize="), BlockSize);
+	BlockSize = Align(FMath::Clamp(BlockSize, MinBlockSize, MaxBlockSize), 4); // Whole vectors for any channel count
+
+	TArray<TUniquePtr<IRenderStage>> Stages;
+
+	if (!ParseChain(Chain, static_cast<float>(InFormat.SampleRate), InFormat.NumChannels, Stages))
+	{
+		return 1;
+	}
+
+	FWaveStreamWriter Writer;
+
+	if (!Writer.Open(OutFilename, OutFormat, Error))
+	{
+		UE_LOG(LogAudioDSPCollection, Error, TEXT("%s: %s"), *OutFilename, *Error);
+		return 1;
+	}
+
+	// The only buffers, memory stays bounded by the block size whatever the file size
+	const int32 NumSamplesPerBlock = BlockSize * InFormat.NumChannels;
+
+	TArray<uint8> InBytes;
+	TArray<uint8> OutBytes;
+	TArray<float, TAlignedHeapAllocator<16>> Buffer;
+
+	InBytes.SetNumUninitialized(BlockSize * InFormat.GetBytesPerFrame());
+	OutBytes.SetNumUninitialized(BlockSize * OutFormat.GetBytesPerFrame());
+	Buffer.SetNumZeroed(NumSamplesPerBlock);
+
+	UE_LOG(LogAudioDSPCollection, Display, TEXT("Rendering %s -> %s: %d channels, %d Hz, %lld frames, %d stages, %d frames per block"),
+		   *InFilename, *OutFilename, InFormat.NumChannels, InFormat.SampleRate, Reader.GetNumFrames(), Stages.Num(), BlockSize);
+
+	const int64 TotalNumFrames = Reader.GetNumFrames();
+	const int64 ProgressStep   = FMath::Max<int64>(TotalNumFrames / 10, 1);
+	int64 NumFramesDone        = 0;
+	int64 NextProgressFrame    = ProgressStep;
+	double ProcessingSeconds   = 0.0;
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	while (const int32 NumFrames = Reader.ReadFrames(InBytes.GetData(), BlockSize))
+	{
+		const int32 NumSamples       = NumFrames * InFormat.NumChannels;
+		const int32 NumPaddedSamples = Align(NumSamples, 4);
+
+		const double BlockStartSeconds = FPlatformTime::Seconds();
+
+		ConvertToFloat(InBytes.GetData(), Buffer.GetData(), NumSamples, InFormat.SampleFormat);
+
+		// The last block is zero padded to whole vectors
+		if (NumPaddedSamples > NumSamples)
+		{
+			FMemory::Memzero(Buffer.GetData() + NumSamples, sizeof(float) * (NumPaddedSamples - NumSamples));
+		}
+
+		for (const TUniquePtr<IRenderStage>& Stage : Stages)
+		{
+			Stage->ProcessAudioBuffer(Buffer.GetData(), NumPaddedSamples);
+		}
+
+		ConvertFromFloat(Buffer.GetData(), OutBytes.GetData(), NumSamples, OutFormat.SampleFormat);
+
+		ProcessingSeconds += FPlatformTime::Seconds() - BlockStartSeconds;
+
+		if (!Writer.WriteFrames(OutBytes.GetData(), NumFrames))
+		{
+			UE_LOG(LogAudioDSPCollection, Error, TEXT("%s: write failed (disk full?)"), *OutFilename);
+			return 1;
+		}
+
+		NumFramesDone += NumFrames;
+
+		if (NumFramesDone >= NextProgressFrame)
+		{
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("  %3d%%"), static_cast<int32>(100 * NumFramesDone / FMath::Max<int64>(TotalNumFrames, 1)));
+			NextProgressFrame += ProgressStep;
+		}
+	}
+
+	// ReadFrames also stops on a read error
+	if (Reader.GetNumFramesRemaining() > 0)
+	{
+		UE_LOG(LogAudioDSPCollection, Error, TEXT("%s: read failed after %lld of %lld frames"), *InFilename, NumFramesDone, TotalNumFrames);
+		return 1;
+	}
+
+	if (!Writer.Close())
+	{
+		UE_LOG(LogAudioDSPCollection, Error, TEXT("%s: failed to finalize the header"), *OutFilename);
+		return 1;
+	}
+
+	const double TotalSeconds   = FPlatformTime::Seconds() - StartSeconds;
+	const double AudioSeconds   = static_cast<double>(NumFramesDone) / InFormat.SampleRate;
+	const double NumSamplesDone = static_cast<double>(NumFramesDone) * InFormat.NumChannels;
+
+	UE_LOG(LogAudioDSPCollection, Display, TEXT("Rendered %.1f s of audio in %.2f s (%.1fx realtime)"), AudioSeconds, TotalSeconds, AudioSeconds / FMath::Max(TotalSeconds, 1.0e-9));
+	UE_LOG(LogAudioDSPCollection, Display, TEXT("  Total (with I/O): %.2f M samples/sec"), NumSamplesDone / FMath::Max(TotalSeconds, 1.0e-9) * 1.0e-6);
+	UE_LOG(LogAudioDSPCollection, Display, TEXT("  DSP + conversion: %.2f M samples/sec"), NumSamplesDone / FMath::Max(ProcessingSeconds, 1.0e-9) * 1.0e-6);
+
+	return 0;
+}
@@ -0,0 +1,333 @@
+#include "Commandlets/WaveStream.h"
+
+namespace DSPCollectionCommandlets
+{
+	namespace WaveStreamUtils
+	{
+		constexpr uint16 WaveFormatPcm        = 0x0001;
+		constexpr uint16 WaveFormatIeeeFloat  = 0x0003;
+		constexpr uint16 WaveFormatExtensible = 0xFFFE;
+
+		constexpr int64 HeaderSize     = 12 + (8 + 28) + (8 + 16) + 8; // RIFF/WAVE + JUNK (ds64 placeholder) + fmt + data header
+		constexpr int64 DataSizeOffset = HeaderSize - 4;
+
+		FORCEINLINE bool IsChunkId(const uint8* InChunkId, const char* InExpectedId)
+		{
+			return FMemory::Memcmp(InChunkId, InExpectedId, 4) == 0;
+		}
+
+		FORCEINLINE uint16 ReadUInt16(const uint8* In)
+		{
+			return static_cast<uint16>(In[0] | (In[1] << 8));
+		}
+
+		FORCEINLINE uint32 ReadUInt32(const uint8* In)
+		{
+			return static_cast<uint32>(In[0]) | (static_cast<uint32>(In[1]) << 8) | (static_cast<uint32>(In[2]) << 16) | (static_cast<uint32>(In[3]) << 24);
+		}
+
+		FORCEINLINE uint64 ReadUInt64(const uint8* In)
+		{
+			return static_cast<uint64>(ReadUInt32(In)) | (static_cast<uint64>(ReadUInt32(In + 4)) << 32);
+		}
+
+		struct FHeaderWriter
+		{
+			TArray<uint8> Bytes;
+
+			void Id(const char* InId)    { Bytes.Append(reinterpret_cast<const uint8*>(InId), 4); }
+			void UInt16(const uint16 In) { Bytes.Append(reinterpret_cast<const uint8*>(&In), sizeof(In)); }
+			void UInt32(const uint32 In) { Bytes.Append(reinterpret_cast<const uint8*>(&In), sizeof(In)); }
+			void UInt64(const uint64 In) { Bytes.Append(reinterpret_cast<const uint8*>(&In), sizeof(In)); }
+		};
+	}
+
+	//------------------------------------------------------------------------------------
+	// FWaveFormat
+	//------------------------------------------------------------------------------------
+	int32 FWaveFormat::GetBytesPerSample() const
+	{
+		switch (SampleFormat)
+		{
+			default:
+			case EWaveSampleFormat::Int16:
+				return 2;
+			case EWaveSampleFormat::Int24:
+				return 3;
+			case EWaveSampleFormat::Float32:
+				return 4;
+		}
+	}
+
+	int32 FWaveFormat::GetBytesPerFrame() const
+	{
+		return GetBytesPerSample() * NumChannels;
+	}
+
+	//------------------------------------------------------------------------------------
+	// FWaveStreamReader
+	//------------------------------------------------------------------------------------
+	bool FWaveStreamReader::Open(const FString& InFilename, FString& OutError)
+	{
+		using namespace WaveStreamUtils;
+
+		FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*InFilename));
+
+		if (!FileHandle)
+		{
+			OutError = FString::Printf(TEXT("Can't open %s"), *InFilename);
+			return false;
+		}
+
+		uint8 RiffHeader[12];
+
+		if (!FileHandle->Read(RiffHeader, sizeof(RiffHeader)) || !(IsChunkId(RiffHeader, "RIFF") || IsChunkId(RiffHeader, "RF64")) || !IsChunkId(RiffHeader + 8, "WAVE"))
+		{
+			OutError = TEXT("Not a RIFF/RF64 WAVE file");
+			return false;
+		}
+
+		const int64 FileSize = FileHandle->Size();
+		uint64 DataSize64    = 0; // From ds64 (RF64)
+		bool bHasFormat      = false;
+
+		while (FileHandle->Tell() + 8 <= FileSize)
+		{
+			uint8 ChunkHeader[8];
+
+			if (!FileHandle->Read(ChunkHeader, sizeof(ChunkHeader)))
+			{
+				OutError = FString::Printf(TEXT("Can't read the chunk header at offset %lld"), FileHandle->Tell());
+				return false;
+			}
+
+			const int64 ChunkSize  = ReadUInt32(ChunkHeader + 4);
+			const int64 ChunkStart = FileHandle->Tell();
+
+			if (IsChunkId(ChunkHeader, "ds64"))
+			{
+				uint8 Ds64[16];
+
+				if (ChunkSize < static_cast<int64>(sizeof(Ds64)) || !FileHandle->Read(Ds64, sizeof(Ds64)))
+				{
+					OutError = TEXT("Truncated ds64 chunk");
+					return false;
+				}
+
+				DataSize64 = ReadUInt64(Ds64 + 8);
+			}
+			else if (IsChunkId(ChunkHeader, "fmt "))
+			{
+				uint8 Fmt[40] = {};
+
+				if (ChunkSize < 16 || !FileHandle->Read(Fmt, FMath::Min<int64>(ChunkSize, sizeof(Fmt))))
+				{
+					OutError = TEXT("Truncated fmt chunk");
+					return false;
+				}
+
+				uint16 FormatTag           = ReadUInt16(Fmt);
+				const uint16 BitsPerSample = ReadUInt16(Fmt + 14);
+
+				if (FormatTag == WaveFormatExtensible && ChunkSize >= 40)
+				{
+					FormatTag = ReadUInt16(Fmt + 24); // First 2 bytes of the SubFormat GUID
+				}
+
+				Format.NumChannels = ReadUInt16(Fmt + 2);
+				Format.SampleRate  = ReadUInt32(Fmt + 4);
+
+				if (FormatTag == WaveFormatPcm && BitsPerSample == 16)
+				{
+					Format.SampleFormat = EWaveSampleFormat::Int16;
+				}
+				else if (FormatTag == WaveFormatPcm && BitsPerSample == 24)
+				{
+					Format.SampleFormat = EWaveSampleFormat::Int24;
+				}
+				else if (FormatTag == WaveFormatIeeeFloat && BitsPerSample == 32)
+				{
+					Format.SampleFormat = EWaveSampleFormat::Float32;
+				}
+				else
+				{
+					OutError = FString::Printf(TEXT("Unsupported sample format (format tag %d, %d bits)"), FormatTag, BitsPerSample);
+					return false;
+				}
+
+				bHasFormat = (Format.NumChannels > 0 && Format.SampleRate > 0);
+			}
+			else if (IsChunkId(ChunkHeader, "data"))
+			{
+				if (!bHasFormat)
+				{
+					OutError = TEXT("data chunk before fmt chunk");
+					return false;
+				}
+
+				const int64 DataSize      = (ChunkSize == 0xFFFFFFFF && DataSize64 > 0) ? static_cast<int64>(DataSize64) : ChunkSize;
+				const int64 AvailableSize = FMath::Min(DataSize, FileSize - ChunkStart); // Truncated files
+
+				NumFrames  = AvailableSize / Format.GetBytesPerFrame();
+				FrameIndex = 0;
+
+				return true;
+			}
+
+			FileHandle->Seek(ChunkStart + ChunkSize + (ChunkSize & 1)); // Chunks are word aligned
+		}
+
+		OutError = TEXT("No data chunk");
+		return false;
+	}
+
+	const FWaveFormat& FWaveStreamReader::GetFormat() const
+	{
+		return Format;
+	}
+
+	int64 FWaveStreamReader::GetNumFrames() const
+	{
+		return NumFrames;
+	}
+
+	int64 FWaveStreamReader::GetNumFramesRemaining() const
+	{
+		return NumFrames - FrameIndex;
+	}
+
+	int32 FWaveStreamReader::ReadFrames(uint8* OutBuffer, const int32 InMaxNumFrames)
+	{
+		const int32 NumFramesToRead = static_cast<int32>(FMath::Min<int64>(InMaxNumFrames, GetNumFramesRemaining()));
+
+		if (NumFramesToRead <= 0 || !FileHandle->Read(OutBuffer, static_cast<int64>(NumFramesToRead) * Format.GetBytesPerFrame()))
+		{
+			return 0;
+		}
+
+		FrameIndex += NumFramesToRead;
+
+		return NumFramesToRead;
+	}
+
+	//------------------------------------------------------------------------------------
+	// FWaveStreamWriter
+	//------------------------------------------------------------------------------------
+	FWaveStreamWriter::~FWaveStreamWriter()
+	{
+		Close();
+	}
+
+	bool FWaveStreamWriter::Open(const FString& InFilename, const FWaveFormat& InFormat, FString& OutError)
+	{
+		using namespace WaveStreamUtils;
+
+		Format       = InFormat;
+		NumDataBytes = 0;
+
+		FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*InFilename));
+
+		if (!FileHandle)
+		{
+			OutError = FString::Printf(TEXT("Can't create %s"), *InFilename);
+			return false;
+		}
+
+		const uint16 BitsPerSample = static_cast<uint16>(Format.GetBytesPerSample() * 8);
+		const uint16 BlockAlign    = static_cast<uint16>(Format.GetBytesPerFrame());
+
+		FHeaderWriter Header;
+
+		Header.Id("RIFF");
+		Header.UInt32(0); // Patched on Close
+		Header.Id("WAVE");
+
+		// Reserved for the ds64 chunk in case the file goes over 4GB
+		Header.Id("JUNK");
+		Header.UInt32(28);
+		Header.Bytes.AddZeroed(28);
+
+		Header.Id("fmt ");
+		Header.UInt32(16);
+		Header.UInt16(Format.SampleFormat == EWaveSampleFormat::Float32 ? WaveFormatIeeeFloat : WaveFormatPcm);
+		Header.UInt16(static_cast<uint16>(Format.NumChannels));
+		Header.UInt32(static_cast<uint32>(Format.SampleRate));
+		Header.UInt32(static_cast<uint32>(Format.SampleRate) * BlockAlign);
+		Header.UInt16(BlockAlign);
+		Header.UInt16(BitsPerSample);
+
+		Header.Id("data");
+		Header.UInt32(0); // Patched on Close
+
+		check(Header.Bytes.Num() == HeaderSize);
+
+		return FileHandle->Write(Header.Bytes.GetData(), Header.Bytes.Num());
+	}
+
+	bool FWaveStreamWriter::WriteFrames(const uint8* InBuffer, const int32 InNumFrames)
+	{
+		const int64 NumBytes = static_cast<int64>(InNumFrames) * Format.GetBytesPerFrame();
+
+		if (!FileHandle || !FileHandle->Write(InBuffer, NumBytes))
+		{
+			return false;
+		}
+
+		NumDataBytes += NumBytes;
+
+		return true;
+	}
+
+	bool FWaveStreamWriter::Close()
+	{
+		using namespace WaveStreamUtils;
+
+		if (!FileHandle)
+		{
+			return true;
+		}
+
+		bool bSuccess = true;
+
+		if (NumDataBytes & 1)
+		{
+			const uint8 PadByte = 0;
+			bSuccess &= FileHandle->Write(&PadByte, 1);
+		}
+
+		const int64 RiffSize = HeaderSize - 8 + NumDataBytes + (NumDataBytes & 1);
+
+		if (RiffSize <= MAX_uint32)
+		{
+			const uint32 RiffSize32 = static_cast<uint32>(RiffSize);
+			const uint32 DataSize32 = static_cast<uint32>(NumDataBytes);
+
+			bSuccess &= FileHandle->Seek(4) && FileHandle->Write(reinterpret_cast<const uint8*>(&RiffSize32), 4);
+			bSuccess &= FileHandle->Seek(DataSizeOffset) && FileHandle->Write(reinterpret_cast<const uint8*>(&DataSize32), 4);
+		}
+		else
+		{
+			// RF64: the 32 bit sizes are set to -1 and the real ones go in ds64, in place of the JUNK chunk
+			FHeaderWriter Ds64;
+
+			Ds64.Id("ds64");
+			Ds64.UInt32(28);
+			Ds64.UInt64(static_cast<uint64>(RiffSize));
+			Ds64.UInt64(static_cast<uint64>(NumDataBytes));
+			Ds64.UInt64(static_cast<uint64>(NumDataBytes / Format.GetBytesPerFrame()));
+			Ds64.UInt32(0); // No table
+
+			const uint32 Unknown32 = MAX_uint32;
+
+			bSuccess &= FileHandle->Seek(0) && FileHandle->Write(reinterpret_cast<const uint8*>("RF64"), 4) && FileHandle->Write(reinterpret_cast<const uint8*>(&Unknown32), 4);
+			bSuccess &= FileHandle->Seek(12) && FileHandle->Write(Ds64.Bytes.GetData(), Ds64.Bytes.Num());
+			bSuccess &= FileHandle->Seek(DataSizeOffset) && FileHandle->Write(reinterpret_cast<const uint8*>(&Unknown32), 4);
+		}
+
+		bSuccess &= FileHandle->Flush();
+
+		FileHandle.Reset();
+
+		return bSuccess;
+	}
+}
@@ -0,0 +1,756 @@
+#include "DSPProcessing/Convolution.h"
+#include "AudioDSPCollection.h"
+#include "DSP/FFTAlgorithm.h"
+#include "Tasks/Task.h"
+
+namespace DSPProcessing
+{
+	namespace ConvolutionUtils
+	{
+		constexpr VectorRegister4Float VImaginarySigns = MakeVectorRegisterFloatConstant(-1.0f, 1.0f, -1.0f, 1.0f);
+
+		static TUniquePtr<Audio::IFFTAlgorithm> CreateFFT(const int32 InLog2FFTSize)
+		{
+			Audio::FFFTSettings Settings;
+			Settings.Log2Size                    = InLog2FFTSize;
+			Settings.bArrays128BitAligned        = true;
+			Settings.bEnableHardwareAcceleration = false;
+
+			if (!Audio::FFFTFactory::AreFFTSettingsSupported(Settings))
+			{
+				return nullptr;
+			}
+
+			return Audio::FFFTFactory::NewFFTAlgorithm(Settings);
+		}
+
+		static float GetScalingFactor(const Audio::EFFTScaling InScaling, const int32 InFFTSize)
+		{
+			switch (InScaling)
+			{
+				default:
+				case Audio::EFFTScaling::None:
+					return 1.0f;
+				case Audio::EFFTScaling::MultipliedByFFTSize:
+					return (float)InFFTSize;
+				case Audio::EFFTScaling::MultipliedBySqrtFFTSize:
+					return FMath::Sqrt((float)InFFTSize);
+				case Audio::EFFTScaling::DividedByFFTSize:
+					return 1.0f / InFFTSize;
+				case Audio::EFFTScaling::DividedBySqrtFFTSize:
+					return 1.0f / FMath::Sqrt((float)InFFTSize);
+			}
+		}
+
+		// The FFT output is interleaved complex (Re, Im), 2 bins per vector
+		FORCEINLINE void ComplexMultiplyAdd(const float* InX, const float* InH, float* InOutAccumulator, const int32 InNumFloats)
+		{
+			// Sequential version
+			//for (int32 Bin = 0; Bin < InNumFloats / 2; ++Bin)
+			//{
+			//    Acc[Bin].Re += X[Bin].Re * H[Bin].Re - X[Bin].Im * H[Bin].Im;
+			//    Acc[Bin].Im += X[Bin].Re * H[Bin].Im + X[Bin].Im * H[Bin].Re;
+			//}
+
+			// Vectorized version
+			for (int32 i = 0; i < InNumFloats; i += 4)
+			{
+				const VectorRegister4Float X = VectorLoadAligned(&InX[i]);
+				const VectorRegister4Float H = VectorLoadAligned(&InH[i]);
+
+				const VectorRegister4Float XRe   = VectorSwizzle(X, 0, 0, 2, 2);
+				const VectorRegister4Float XIm   = VectorSwizzle(X, 1, 1, 3, 3);
+				const VectorRegister4Float HSwap = VectorSwizzle(H, 1, 0, 3, 2);
+
+				VectorRegister4Float Accumulator = VectorLoadAligned(&InOutAccumulator[i]);
+				Accumulator = VectorMultiplyAdd(XRe, H, Accumulator);
+				Accumulator = VectorMultiplyAdd(VectorMultiply(XIm, VImaginarySigns), HSwap, Accumulator);
+
+				VectorStoreAligned(Accumulator, &InOutAccumulator[i]);
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------
+	// FConvolutionIR
+	//------------------------------------------------------------------------------------
+	TSharedPtr<const FConvolutionIR> FConvolutionIR::Create(const float* InSamples, const int32 InNumFrames, const int32 InNumChannels, const int32 InBlockFrames, const bool bInNonUniform)
+	{
+		if (InSamples == nullptr || InNumFrames <= 0 || InNumChannels <= 0 || InBlockFrames <= 0)
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FConvolutionIR> IR = MakeShared<FConvolutionIR>();
+		IR->BlockFrames = InBlockFrames;
+		IR->NumChannels = InNumChannels;
+
+		// Stage boundaries in IR frames
+		const int32 TailPartitionFrames = InBlockFrames * NonUniformTailFactor;
+		const bool bUseTail = bInNonUniform && InNumFrames > 2 * TailPartitionFrames
+							  && ConvolutionUtils::CreateFFT(FMath::FloorLog2(FMath::RoundUpToPowerOfTwo(2 * TailPartitionFrames))).IsValid();
+
+		struct FStageLayout
+		{
+			int32 StartFrame;
+			int32 EndFrame;
+			int32 PartitionFrames;
+		};
+
+		TArray<FStageLayout, TInlineAllocator<2>> Layouts;
+
+		if (bUseTail)
+		{
+			// The tail output is delayed by one tail partition, so the tail has to start at least that far into the IR
+			Layouts.Add({ 0, TailPartitionFrames, InBlockFrames });
+			Layouts.Add({ TailPartitionFrames, InNumFrames, TailPartitionFrames });
+		}
+		else
+		{
+			Layouts.Add({ 0, InNumFrames, InBlockFrames });
+		}
+
+		TArray<float, TAlignedHeapAllocator<16>> TimeBuffer;
+
+		for (const FStageLayout& Layout : Layouts)
+		{
+			FStage& Stage = IR->Stages.AddDefaulted_GetRef();
+
+			Stage.PartitionFrames = Layout.PartitionFrames;
+			Stage.FFTSize         = (int32)FMath::RoundUpToPowerOfTwo(2 * Layout.PartitionFrames); // Room for the whole linear convolution of two partitions
+			Stage.Log2FFTSize     = FMath::FloorLog2(Stage.FFTSize);
+			Stage.SpectrumFloats  = Stage.FFTSize + 4;
+			Stage.NumPartitions   = FMath::DivideAndRoundUp(Layout.EndFrame - Layout.StartFrame, Layout.PartitionFrames);
+
+			TUniquePtr<Audio::IFFTAlgorithm> FFT = ConvolutionUtils::CreateFFT(Stage.Log2FFTSize);
+
+			if (!FFT.IsValid())
+			{
+				return nullptr;
+			}
+
+			// X and H both go through the forward FFT, Y through the inverse one
+			const float ForwardScale = ConvolutionUtils::GetScalingFactor(FFT->ForwardScaling(), Stage.FFTSize);
+			const float InverseScale = ConvolutionUtils::GetScalingFactor(FFT->InverseScaling(), Stage.FFTSize);
+			const float Scale        = 1.0f / (ForwardScale * ForwardScale * InverseScale);
+
+			Stage.Spectra.SetNumZeroed(InNumChannels * Stage.NumPartitions * Stage.SpectrumFloats);
+			TimeBuffer.SetNumUninitialized(Stage.FFTSize, EAllowShrinking::No);
+
+			for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+			{
+				for (int32 Partition = 0; Partition < Stage.NumPartitions; ++Partition)
+				{
+					const int32 PartitionStart = Layout.StartFrame + Partition * Stage.PartitionFrames;
+					const int32 PartitionEnd   = FMath::Min(PartitionStart + Stage.PartitionFrames, Layout.EndFrame);
+
+					FMemory::Memzero(TimeBuffer.GetData(), sizeof(float) * Stage.FFTSize);
+
+					for (int32 Frame = PartitionStart; Frame < PartitionEnd; ++Frame)
+					{
+						TimeBuffer[Frame - PartitionStart] = InSamples[Frame * InNumChannels + Channel] * Scale;
+					}
+
+					FFT->ForwardRealToComplex(TimeBuffer.GetData(), Stage.Spectra.GetData() + (Channel * Stage.NumPartitions + Partition) * Stage.SpectrumFloats);
+				}
+			}
+		}
+
+		return IR;
+	}
+
+	SIZE_T FConvolutionIR::GetAllocatedSize() const
+	{
+		SIZE_T AllocatedSize = Stages.GetAllocatedSize();
+
+		for (const FStage& Stage : Stages)
+		{
+			AllocatedSize += Stage.Spectra.GetAllocatedSize();
+		}
+
+		return AllocatedSize;
+	}
+
+	//------------------------------------------------------------------------------------
+	// FSharedImpulseResponse
+	//------------------------------------------------------------------------------------
+	FSharedImpulseResponse::FSharedImpulseResponse(TArray<float>&& InSamples, const int32 InNumChannels, const float InSampleRate)
+		: Samples(MoveTemp(InSamples))
+		, NumChannels(FMath::Max(InNumChannels, 1))
+		, SampleRate(FMath::Max(InSampleRate, 1.0f))
+	{
+		NumFrames = Samples.Num() / NumChannels;
+	}
+
+	int32 FSharedImpulseResponse::GetNumResampledFrames(const float InSampleRate) const
+	{
+		return (InSampleRate == SampleRate) ? NumFrames : FMath::Max(FMath::FloorToInt((NumFrames - 1) / (SampleRate / InSampleRate)) + 1, 1);
+	}
+
+	bool FSharedImpulseResponse::UsesNonUniformPartitions(const int32 InBlockFrames, const float InSampleRate, const bool bInNonUniform) const
+	{
+		// Same threshold as FConvolutionIR::Create
+		return bInNonUniform && GetNumResampledFrames(InSampleRate) > 2 * InBlockFrames * FConvolutionIR::NonUniformTailFactor;
+	}
+
+	int32 FSharedImpulseResponse::FindCacheEntry(const int32 InBlockFrames, const float InSampleRate, const bool bInNonUniform) const
+	{
+		const int32 NumEntries = NumCacheEntries.load(std::memory_order_acquire);
+
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			const FCacheEntry& Entry = Cache[Index];
+
+			if (Entry.BlockFrames == InBlockFrames && Entry.SampleRate == InSampleRate && Entry.bNonUniform == bInNonUniform)
+			{
+				return Index;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	bool FSharedImpulseResponse::FindPartitionedIR(const int32 InBlockFrames, const float InSampleRate, const bool bInNonUniform, TSharedPtr<const FConvolutionIR>& OutPartitionedIR) const
+	{
+		const int32 Index = FindCacheEntry(InBlockFrames, InSampleRate, UsesNonUniformPartitions(InBlockFrames, InSampleRate, bInNonUniform));
+
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		OutPartitionedIR = Cache[Index].PartitionedIR;
+		return true;
+	}
+
+	TSharedPtr<const FConvolutionIR> FSharedImpulseResponse::BuildPartitionedIR(const int32 InBlockFrames, const float InSampleRate, const bool bInNonUniform) const
+	{
+		const bool bUsesNonUniform = UsesNonUniformPartitions(InBlockFrames, InSampleRate, bInNonUniform);
+
+		FScopeLock Lock(&CacheCriticalSection);
+
+		const int32 CachedIndex = FindCacheEntry(InBlockFrames, InSampleRate, bUsesNonUniform);
+
+		if (CachedIndex != INDEX_NONE)
+		{
+			return Cache[CachedIndex].PartitionedIR;
+		}
+
+		TSharedPtr<const FConvolutionIR> PartitionedIR;
+
+		if (InSampleRate == SampleRate)
+		{
+			PartitionedIR = FConvolutionIR::Create(Samples.GetData(), NumFrames, NumChannels, InBlockFrames, bUsesNonUniform);
+		}
+		else
+		{
+			// Linear interpolation, good enough for the short cabinet/coloring IRs this is meant for
+			const float Step               = SampleRate / InSampleRate;
+			const int32 NumResampledFrames = GetNumResampledFrames(InSampleRate);
+
+			TArray<float> Resampled;
+			Resampled.SetNumUninitialized(NumResampledFrames * NumChannels);
+
+			for (int32 Frame = 0; Frame < NumResampledFrames; ++Frame)
+			{
+				const float Position = Frame * Step;
+				const int32 Index    = FMath::Min(FMath::FloorToInt(Position), NumFrames - 1);
+				const int32 Next     = FMath::Min(Index + 1, NumFrames - 1);
+				const float Alpha    = Position - Index;
+
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					Resampled[Frame * NumChannels + Channel] = FMath::Lerp(Samples[Index * NumChannels + Channel], Samples[Next * NumChannels + Channel], Alpha);
+				}
+			}
+
+			PartitionedIR = FConvolutionIR::Create(Resampled.GetData(), NumResampledFrames, NumChannels, InBlockFrames, bUsesNonUniform);
+		}
+
+		const int32 NumEntries = NumCacheEntries.load(std::memory_order_relaxed);
+
+		if (NumEntries == MaxCacheEntries)
+		{
+			// Still usable by the caller, the next instances rebuild it
+			UE_LOG(LogAudioDSPCollection, Warning, TEXT("FSharedImpulseResponse: more than %d block size / sample rate / partitioning combinations, %d frames at %.0f Hz isn't cached"),
+				   MaxCacheEntries, InBlockFrames, InSampleRate);
+			return PartitionedIR;
+		}
+
+		Cache[NumEntries] = { InBlockFrames, InSampleRate, bUsesNonUniform, PartitionedIR };
+		NumCacheEntries.store(NumEntries + 1, std::memory_order_release);
+
+		return PartitionedIR;
+	}
+
+	SIZE_T FSharedImpulseResponse::GetAllocatedSize() const
+	{
+		SIZE_T AllocatedSize = Samples.GetAllocatedSize();
+
+		const int32 NumEntries = NumCacheEntries.load(std::memory_order_acquire);
+
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			AllocatedSize += Cache[Index].PartitionedIR.IsValid() ? Cache[Index].PartitionedIR->GetAllocatedSize() : 0;
+		}
+
+		return AllocatedSize;
+	}
+
+	//------------------------------------------------------------------------------------
+	// FConvolution
+	//------------------------------------------------------------------------------------
+	FConvolution::FConvolution()
+		: Mailbox(MakeShared<FStateMailbox, ESPMode::ThreadSafe>())
+	{
+	}
+
+	FConvolution::~FConvolution() = default;
+
+	void FConvolution::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		SampleRate  = InSampleRate;
+		NumChannels = FMath::Max(InNumChannels, 1);
+
+		// The state for the new sample rate is requested by the next Prepare/ProcessAudioBuffer, the current one restarts from silence meanwhile
+		bStateChanged = true;
+
+		if (State.IsValid())
+		{
+			State->Reset();
+		}
+	}
+
+	void FConvolution::SetNumChannels(const int32 InNumChannels)
+	{
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels == NumChannels)
+		{
+			return;
+		}
+
+		NumChannels   = NewNumChannels;
+		bStateChanged = true;
+	}
+
+	void FConvolution::SetImpulseResponse(const TSharedPtr<const FSharedImpulseResponse>& InImpulseResponse)
+	{
+		if (InImpulseResponse == ImpulseResponse)
+		{
+			return;
+		}
+
+		ImpulseResponse = InImpulseResponse;
+		bStateChanged   = true;
+	}
+
+	void FConvolution::SetNonUniformPartitions(const bool bInNonUniform)
+	{
+		if (bInNonUniform == bNonUniform)
+		{
+			return;
+		}
+
+		bNonUniform   = bInNonUniform;
+		bStateChanged = true;
+	}
+
+	void FConvolution::Prepare(const int32 InBlockFrames)
+	{
+		PreparedBlockFrames = InBlockFrames;
+		bStateChanged       = false;
+
+		// A state requested before doesn't match anymore
+		++RequestId;
+
+		if (State.IsValid() && State->Matches(ImpulseResponse.Get(), SampleRate, bNonUniform, NumChannels, InBlockFrames))
+		{
+			bStatePending = false;
+			return;
+		}
+
+		if (!ImpulseResponse.IsValid())
+		{
+			bStatePending = false;
+			RetireState();
+			return;
+		}
+
+		RequestState(InBlockFrames);
+		bStatePending = true;
+	}
+
+	void FConvolution::PrepareBlocking(const int32 InBlockFrames)
+	{
+		PreparedBlockFrames = InBlockFrames;
+		bStateChanged       = false;
+		bStatePending       = false;
+		++RequestId;
+
+		Mailbox->DeleteRetired();
+
+		if (State.IsValid() && State->Matches(ImpulseResponse.Get(), SampleRate, bNonUniform, NumChannels, InBlockFrames))
+		{
+			return;
+		}
+
+		State.Reset();
+
+		if (ImpulseResponse.IsValid())
+		{
+			State = FState::Create(ImpulseResponse, SampleRate, bNonUniform, NumChannels, InBlockFrames, RequestId);
+		}
+	}
+
+	bool FConvolution::IsActive() const
+	{
+		return ImpulseResponse.IsValid();
+	}
+
+	void FConvolution::RequestState(const int32 InBlockFrames)
+	{
+		// The task keeps the mailbox and the IR alive, the instance may be gone by the time it runs
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Mailbox = Mailbox, ImpulseResponse = ImpulseResponse, SampleRate = SampleRate, bNonUniform = bNonUniform,
+											   NumChannels = NumChannels, InBlockFrames, RequestId = RequestId]()
+		{
+			Mailbox->DeleteRetired();
+			Mailbox->Publish(FState::Create(ImpulseResponse, SampleRate, bNonUniform, NumChannels, InBlockFrames, RequestId).Release());
+		},
+		UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+
+	void FConvolution::PickUpState()
+	{
+		FState* NewState = Mailbox->TakePending();
+
+		if (NewState == nullptr)
+		{
+			return;
+		}
+
+		// Built for settings that changed since
+		if (NewState->RequestId != RequestId)
+		{
+			Mailbox->Retire(NewState);
+			return;
+		}
+
+		bStatePending = false;
+
+		RetireState();
+		State.Reset(NewState);
+	}
+
+	void FConvolution::RetireState()
+	{
+		if (State.IsValid())
+		{
+			Mailbox->Retire(State.Release());
+		}
+	}
+
+	void FConvolution::Reset()
+	{
+		if (State.IsValid())
+		{
+			State->Reset();
+		}
+	}
+
+	SIZE_T FConvolution::GetAllocatedSize() const
+	{
+		return State.IsValid() ? sizeof(FState) + State->GetAllocatedSize() : 0;
+	}
+
+	void FConvolution::ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FConvolution::ProcessAudioBuffer"))
+
+		const int32 NumFrames = InNumSamples / NumChannels;
+
+		// Never builds anything here, see Prepare
+		if (bStateChanged || PreparedBlockFrames != NumFrames)
+		{
+			Prepare(NumFrames);
+		}
+
+		if (bStatePending)
+		{
+			PickUpState();
+		}
+
+		// No IR, state not built yet (or an FFT size the platform doesn't support): bypass
+		if (!State.IsValid() || !State->CanProcess(NumChannels, NumFrames))
+		{
+			if (InBuffer != OutBuffer)
+			{
+				FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * InNumSamples);
+			}
+			return;
+		}
+
+		State->ProcessBlock(InBuffer, OutBuffer);
+	}
+
+	//------------------------------------------------------------------------------------
+	// FConvolution::FState
+	//------------------------------------------------------------------------------------
+	TUniquePtr<FConvolution::FState> FConvolution::FState::Create(const TSharedPtr<const FSharedImpulseResponse>& InImpulseResponse, const float InSampleRate, const bool bInNonUniform,
+																	const int32 InNumChannels, const int32 InBlockFrames, const uint32 InRequestId)
+	{
+		TUniquePtr<FState> NewState = MakeUnique<FState>();
+		NewState->ImpulseResponse = InImpulseResponse;
+		NewState->SampleRate      = InSampleRate;
+		NewState->bNonUniform     = bInNonUniform;
+		NewState->NumChannels     = InNumChannels;
+		NewState->BlockFrames     = InBlockFrames;
+		NewState->RequestId       = InRequestId;
+		NewState->PartitionedIR   = InImpulseResponse.IsValid() ? InImpulseResponse->BuildPartitionedIR(InBlockFrames, InSampleRate, bInNonUniform) : nullptr;
+
+		if (!NewState->PartitionedIR.IsValid())
+		{
+			return NewState;
+		}
+
+		const FConvolutionIR& IR = *NewState->PartitionedIR;
+
+		NewState->StageStates.SetNum(IR.Stages.Num());
+
+		int32 MaxFFTSize        = 0;
+		int32 MaxSpectrumFloats = 0;
+
+		for (int32 StageIndex = 0; StageIndex < IR.Stages.Num(); ++StageIndex)
+		{
+			const FConvolutionIR::FStage& Stage = IR.Stages[StageIndex];
+			FStageState& StageState             = NewState->StageStates[StageIndex];
+
+			StageState.FFT = ConvolutionUtils::CreateFFT(Stage.Log2FFTSize);
+
+			if (!StageState.FFT.IsValid())
+			{
+				NewState->StageStates.Reset();
+				return NewState;
+			}
+
+			StageState.DelayLine.SetNumUninitialized(InNumChannels * Stage.NumPartitions * Stage.SpectrumFloats);
+			StageState.OverlapTail.SetNumUninitialized(InNumChannels * Stage.PartitionFrames);
+
+			const int32 NumBlockSamples = (StageIndex > 0) ? InNumChannels * Stage.PartitionFrames : 0;
+			StageState.InputBlock.SetNumUninitialized(NumBlockSamples);
+			StageState.OutputBlock.SetNumUninitialized(NumBlockSamples);
+
+			MaxFFTSize        = FMath::Max(MaxFFTSize, Stage.FFTSize);
+			MaxSpectrumFloats = FMath::Max(MaxSpectrumFloats, Stage.SpectrumFloats);
+		}
+
+		NewState->TimeBuffer.SetNumUninitialized(MaxFFTSize);
+		NewState->SpectrumBuffer.SetNumUninitialized(MaxSpectrumFloats);
+		NewState->PlanarInput.SetNumUninitialized(InNumChannels * InBlockFrames);
+		NewState->PlanarOutput.SetNumUninitialized(InNumChannels * InBlockFrames);
+
+		NewState->Reset();
+
+		return NewState;
+	}
+
+	bool FConvolution::FState::Matches(const FSharedImpulseResponse* InImpulseResponse, const float InSampleRate, const bool bInNonUniform, const int32 InNumChannels, const int32 InBlockFrames) const
+	{
+		return ImpulseResponse.Get() == InImpulseResponse && SampleRate == InSampleRate && bNonUniform == bInNonUniform && NumChannels == InNumChannels && BlockFrames == InBlockFrames;
+	}
+
+	bool FConvolution::FState::CanProcess(const int32 InNumChannels, const int32 InBlockFrames) const
+	{
+		return !StageStates.IsEmpty() && NumChannels == InNumChannels && BlockFrames == InBlockFrames;
+	}
+
+	void FConvolution::FState::Reset()
+	{
+		for (FStageState& StageState : StageStates)
+		{
+			FMemory::Memzero(StageState.DelayLine.GetData(), sizeof(float) * StageState.DelayLine.Num());
+			FMemory::Memzero(StageState.OverlapTail.GetData(), sizeof(float) * StageState.OverlapTail.Num());
+			FMemory::Memzero(StageState.InputBlock.GetData(), sizeof(float) * StageState.InputBlock.Num());
+			FMemory::Memzero(StageState.OutputBlock.GetData(), sizeof(float) * StageState.OutputBlock.Num());
+
+			StageState.DelayLineHead = 0;
+			StageState.BlockPosition = 0;
+		}
+	}
+
+	SIZE_T FConvolution::FState::GetAllocatedSize() const
+	{
+		// The partitioned IR is shared, it's reported by FSharedImpulseResponse
+		SIZE_T AllocatedSize = StageStates.GetAllocatedSize() + TimeBuffer.GetAllocatedSize() + SpectrumBuffer.GetAllocatedSize();
+		AllocatedSize += PlanarInput.GetAllocatedSize() + PlanarOutput.GetAllocatedSize();
+
+		for (const FStageState& StageState : StageStates)
+		{
+			AllocatedSize += StageState.DelayLine.GetAllocatedSize() + StageState.OverlapTail.GetAllocatedSize();
+			AllocatedSize += StageState.InputBlock.GetAllocatedSize() + StageState.OutputBlock.GetAllocatedSize();
+		}
+
+		return AllocatedSize;
+	}
+
+	void FConvolution::FState::ProcessBlock(const float* InBuffer, float* OutBuffer)
+	{
+		// Planar copy, the FFTs work on one channel at a time
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			float* ChannelInput = PlanarInput.GetData() + Channel * BlockFrames;
+
+			for (int32 Frame = 0; Frame < BlockFrames; ++Frame)
+			{
+				ChannelInput[Frame] = InBuffer[Frame * NumChannels + Channel];
+			}
+		}
+
+		// Head: one partition per block, the output is ready right away
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			ProcessStagePartition(0, Channel, PlanarInput.GetData() + Channel * BlockFrames, PlanarOutput.GetData() + Channel * BlockFrames);
+		}
+
+		AdvanceDelayLine(0);
+
+		// Tail: the partition computed when the previous tail block was complete plays over this one, while the input of the next one is gathered
+		if (StageStates.Num() > 1)
+		{
+			FStageState& TailState          = StageStates[1];
+			const int32 TailPartitionFrames = PartitionedIR->Stages[1].PartitionFrames;
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				const float* ChannelInput = PlanarInput.GetData() + Channel * BlockFrames;
+				float* ChannelOutput      = PlanarOutput.GetData() + Channel * BlockFrames;
+
+				float* TailInput        = TailState.InputBlock.GetData() + Channel * TailPartitionFrames + TailState.BlockPosition;
+				const float* TailOutput = TailState.OutputBlock.GetData() + Channel * TailPartitionFrames + TailState.BlockPosition;
+
+				FMemory::Memcpy(TailInput, ChannelInput, sizeof(float) * BlockFrames);
+
+				for (int32 Frame = 0; Frame < BlockFrames; ++Frame)
+				{
+					ChannelOutput[Frame] += TailOutput[Frame];
+				}
+			}
+
+			TailState.BlockPosition += BlockFrames;
+
+			if (TailState.BlockPosition == TailPartitionFrames)
+			{
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					ProcessStagePartition(1, Channel, TailState.InputBlock.GetData() + Channel * TailPartitionFrames, TailState.OutputBlock.GetData() + Channel * TailPartitionFrames);
+				}
+
+				AdvanceDelayLine(1);
+				TailState.BlockPosition = 0;
+			}
+		}
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			const float* ChannelOutput = PlanarOutput.GetData() + Channel * BlockFrames;
+
+			for (int32 Frame = 0; Frame < BlockFrames; ++Frame)
+			{
+				OutBuffer[Frame * NumChannels + Channel] = ChannelOutput[Frame];
+			}
+		}
+	}
+
+	void FConvolution::FState::ProcessStagePartition(const int32 InStageIndex, const int32 InChannel, const float* InChannelInput, float* OutChannelOutput)
+	{
+		const FConvolutionIR::FStage& Stage = PartitionedIR->Stages[InStageIndex];
+		FStageState& State                  = StageStates[InStageIndex];
+
+		const int32 PartitionFrames = Stage.PartitionFrames;
+		const int32 NumPartitions   = Stage.NumPartitions;
+		const int32 SpectrumFloats  = Stage.SpectrumFloats;
+		const int32 IRChannel       = InChannel % PartitionedIR->GetNumChannels();
+
+		float* ChannelDelayLine = State.DelayLine.GetData() + InChannel * NumPartitions * SpectrumFloats;
+		float* OverlapTail      = State.OverlapTail.GetData() + InChannel * PartitionFrames;
+
+		// Zero padded to the FFT size, so the products below are linear convolutions
+		FMemory::Memcpy(TimeBuffer.GetData(), InChannelInput, sizeof(float) * PartitionFrames);
+		FMemory::Memzero(TimeBuffer.GetData() + PartitionFrames, sizeof(float) * (Stage.FFTSize - PartitionFrames));
+
+		State.FFT->ForwardRealToComplex(TimeBuffer.GetData(), ChannelDelayLine + State.DelayLineHead * SpectrumFloats);
+
+		//Y = Sum(X[Now - Partition] * H[Partition]);
+		FMemory::Memzero(SpectrumBuffer.GetData(), sizeof(float) * SpectrumFloats);
+
+		for (int32 Partition = 0; Partition < NumPartitions; ++Partition)
+		{
+			const int32 Slot = (State.DelayLineHead - Partition + NumPartitions) % NumPartitions;
+
+			ConvolutionUtils::ComplexMultiplyAdd(ChannelDelayLine + Slot * SpectrumFloats, Stage.GetSpectrum(IRChannel, Partition), SpectrumBuffer.GetData(), SpectrumFloats);
+		}
+
+		State.FFT->InverseComplexToReal(SpectrumBuffer.GetData(), TimeBuffer.GetData());
+
+		// Overlap-add, each product is up to 2 partitions long
+		for (int32 Frame = 0; Frame < PartitionFrames; ++Frame)
+		{
+			OutChannelOutput[Frame] = TimeBuffer[Frame] + OverlapTail[Frame];
+			OverlapTail[Frame]      = TimeBuffer[PartitionFrames + Frame];
+		}
+	}
+
+	void FConvolution::FState::AdvanceDelayLine(const int32 InStageIndex)
+	{
+		FStageState& State = StageStates[InStageIndex];
+		State.DelayLineHead = (State.DelayLineHead + 1) % PartitionedIR->Stages[InStageIndex].NumPartitions;
+	}
+
+	//------------------------------------------------------------------------------------
+	// FConvolution::FStateMailbox
+	//------------------------------------------------------------------------------------
+	FConvolution::FStateMailbox::~FStateMailbox()
+	{
+		delete Pending.exchange(nullptr);
+		DeleteRetired();
+	}
+
+	void FConvolution::FStateMailbox::Publish(FState* InState)
+	{
+		// Release: the state is fully built before the render thread can take it
+		delete Pending.exchange(InState, std::memory_order_acq_rel);
+	}
+
+	FConvolution::FState* FConvolution::FStateMailbox::TakePending()
+	{
+		// Cheap load first, most blocks have nothing to pick up
+		if (Pending.load(std::memory_order_relaxed) == nullptr)
+		{
+			return nullptr;
+		}
+
+		return Pending.exchange(nullptr, std::memory_order_acquire);
+	}
+
+	void FConvolution::FStateMailbox::Retire(FState* InState)
+	{
+		InState->NextRetired = Retired.load(std::memory_order_relaxed);
+
+		while (!Retired.compare_exchange_weak(InState->NextRetired, InState, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void FConvolution::FStateMailbox::DeleteRetired()
+	{
+		// Takes the whole list at once, so there is no ABA with Retire
+		FState* RetiredState = Retired.exchange(nullptr, std::memory_order_acquire);
+
+		while (RetiredState)
+		{
+			FState* NextRetired = RetiredState->NextRetired;
+			delete RetiredState;
+			RetiredState = NextRetired;
+		}
+	}
+}
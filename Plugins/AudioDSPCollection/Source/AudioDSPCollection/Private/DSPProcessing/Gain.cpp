@@ -1,39 +1,418 @@
 #include "DSPProcessing/Gain.h"
+#include "DSP/Dsp.h"
 
 namespace DSPProcessing
 {
-	void FGain::Init(const float InSampleRate)
+	namespace GainUtils
 	{
+		constexpr float MinExponentialGain = 1.58489e-05f; // -96dB, an exponential ramp can't start or end at 0
+
+		constexpr VectorRegister4Float VHalfPi = MakeVectorRegisterFloatConstant(UE_HALF_PI, UE_HALF_PI, UE_HALF_PI, UE_HALF_PI);
+
+		// Planar buffers hold 4 consecutive frames per vector
+		constexpr VectorRegister4Float VPlanarLaneFrameOffsets = MakeVectorRegisterFloatConstant(0.0f, 1.0f, 2.0f, 3.0f);
+	}
+
+	void FGain::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		// Stepped per frame, PrepareBlock converts the vectors of each layout to frames
 		constexpr float SmoothingTimeInMs = 21.33f;
 		GainParamSmoother.Init(SmoothingTimeInMs, InSampleRate);
+
+		SampleRate = InSampleRate;
+		bIsRamping = false;
+
+		CaptureInstanceId = FBlockCapture::NewInstanceId();
+		CaptureCommand    = ECaptureCommand::None;
+
+		NumChannels = 0;
+		SetNumChannels(InNumChannels);
+	}
+
+	void FGain::SetNumChannels(const int32 InNumChannels)
+	{
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels == NumChannels)
+		{
+			return;
+		}
+
+		NumChannels = NewNumChannels;
+
+		VLaneFrameOffsets = (NumChannels == 1) ? MakeVectorRegisterFloat(0.0f, 1.0f, 2.0f, 3.0f)
+											   : MakeVectorRegisterFloat(0.0f, 0.0f, 1.0f, 1.0f);
 	}
 
 	void FGain::SetGain(const float InGain)
 	{
+		// A smoothed change cancels the ramp from where it is
+		if (bIsRamping)
+		{
+			GainParamSmoother.ResetParamValue(GetCurrentRampGain());
+			bIsRamping = false;
+		}
+
 		GainParamSmoother.SetNewParamValue(InGain);
+
+		CaptureCommand = ECaptureCommand::SetGain;
+	}
+
+	void FGain::SetGainDb(const float InGainDb)
+	{
+		SetGain(ConvertDbToGain(InGainDb));
+	}
+
+	void FGain::StartRamp(const float InTargetGain, const int32 InDurationInFrames, const EGainRampShape InShape)
+	{
+		const float StartGain = bIsRamping ? GetCurrentRampGain() : GainParamSmoother.GetCurrentValue();
+
+		CaptureCommand           = ECaptureCommand::StartRamp;
+		CaptureCommandRampFrames = FMath::Clamp(InDurationInFrames, 0, MaxRampDurationInFrames);
+
+		if (InDurationInFrames <= 0)
+		{
+			bIsRamping = false;
+			GainParamSmoother.ResetParamValue(InTargetGain);
+			return;
+		}
+
+		RampShape          = InShape;
+		RampStartGain      = StartGain;
+		RampTargetGain     = InTargetGain;
+		RampFrameIndex     = 0;
+		RampDurationFrames = FMath::Min(InDurationInFrames, MaxRampDurationInFrames);
+		RampPositionStep   = 1.0f / RampDurationFrames;
+
+		if (RampShape == EGainRampShape::Exponential)
+		{
+			using namespace GainUtils;
+
+			// 0 is replaced by -96dB with the polarity of the other end
+			const float StartSign  = (RampStartGain != 0.0f) ? FMath::Sign(RampStartGain) : FMath::Sign(RampTargetGain);
+			const float TargetSign = (RampTargetGain != 0.0f) ? FMath::Sign(RampTargetGain) : StartSign;
+
+			const float ExpStartGain  = (FMath::Abs(RampStartGain)  < MinExponentialGain) ? StartSign  * MinExponentialGain : RampStartGain;
+			const float ExpTargetGain = (FMath::Abs(RampTargetGain) < MinExponentialGain) ? TargetSign * MinExponentialGain : RampTargetGain;
+
+			if (StartSign * TargetSign > 0.0f)
+			{
+				RampStartGain = ExpStartGain;
+				RampLogRatio  = FMath::Loge(ExpTargetGain / ExpStartGain);
+			}
+			else
+			{
+				// Polarity flip, there is no exponential path through 0
+				RampShape = EGainRampShape::Linear;
+			}
+		}
+		else if (RampShape == EGainRampShape::EqualPower)
+		{
+			if (RampStartGain * RampTargetGain < 0.0f)
+			{
+				// Polarity flip, the power blend would lose the sign
+				RampShape = EGainRampShape::SCurve;
+			}
+			else
+			{
+				RampSign = (RampStartGain + RampTargetGain < 0.0f) ? -1.0f : 1.0f;
+			}
+		}
+
+		bIsRamping = true;
+	}
+
+	void FGain::StartRampDb(const float InTargetGainDb, const int32 InDurationInFrames, const EGainRampShape InShape)
+	{
+		StartRamp(ConvertDbToGain(InTargetGainDb), InDurationInFrames, InShape);
+	}
+
+	bool FGain::IsRamping() const
+	{
+		return bIsRamping;
+	}
+
+	float FGain::GetRampTargetGain() const
+	{
+		return RampTargetGain;
+	}
+
+	float FGain::ConvertDbToGain(const float InGainDb)
+	{
+		const float GainDb = FMath::Clamp(InGainDb, -96.0f, 12.0f);
+		return (GainDb == -96.0f) ? 0.0f : Audio::ConvertToLinear(GainDb);
+	}
+
+	FGain::FCaptureParams FGain::MakeCaptureParams() const
+	{
+		FCaptureParams Params;
+		Params.CurrentGain         = bIsRamping ? GetCurrentRampGain() : GainParamSmoother.GetCurrentValue();
+		Params.TargetGain          = bIsRamping ? RampTargetGain : GainParamSmoother.GetTargetValue();
+		Params.bIsRamping          = bIsRamping;
+		Params.RampShape           = RampShape;
+		Params.RampRemainingFrames = bIsRamping ? RampDurationFrames - RampFrameIndex : 0;
+		Params.Command             = CaptureCommand;
+		Params.CommandRampFrames   = CaptureCommandRampFrames;
+
+		return Params;
+	}
+
+	void FGain::CaptureBlock(const float* InBuffer, const int32 InNumSamples)
+	{
+		const FCaptureParams Params = MakeCaptureParams();
+		const EBlockCaptureFlags Flags = (Params.Command != ECaptureCommand::None) ? EBlockCaptureFlags::ParamsChanged : EBlockCaptureFlags::None;
+
+		FBlockCapture::CaptureBlock(EBlockCaptureProcessor::Gain, CaptureInstanceId, SampleRate, NumChannels, Flags, &Params, sizeof(Params), InBuffer, InNumSamples);
+
+		CaptureCommand = ECaptureCommand::None;
+	}
+
+	void FGain::CapturePlanarBlock(const float* const* InBuffers, const int32 InNumChannels, const int32 InNumFrames)
+	{
+		const FCaptureParams Params = MakeCaptureParams();
+		const EBlockCaptureFlags Flags = (Params.Command != ECaptureCommand::None) ? EBlockCaptureFlags::ParamsChanged : EBlockCaptureFlags::None;
+
+		FBlockCapture::CapturePlanarBlock(EBlockCaptureProcessor::Gain, CaptureInstanceId, SampleRate, Flags, &Params, sizeof(Params), InBuffers, InNumChannels, InNumFrames);
+
+		CaptureCommand = ECaptureCommand::None;
+	}
+
+	void FGain::ApplyCaptureParams(const FCaptureParams& InParams, const bool bInFirstBlock)
+	{
+		if (bInFirstBlock)
+		{
+			// A ramp that was already running restarts its shape from the current gain, over what was left of it
+			bIsRamping = false;
+			GainParamSmoother.ResetParamValue(InParams.CurrentGain);
+
+			if (InParams.bIsRamping)
+			{
+				StartRamp(InParams.TargetGain, InParams.RampRemainingFrames, InParams.RampShape);
+			}
+			else if (InParams.TargetGain != InParams.CurrentGain)
+			{
+				GainParamSmoother.SetNewParamValue(InParams.TargetGain);
+			}
+			return;
+		}
+
+		switch (InParams.Command)
+		{
+			default:
+			case ECaptureCommand::None:
+				break;
+			case ECaptureCommand::SetGain:
+				SetGain(InParams.TargetGain);
+				break;
+			case ECaptureCommand::StartRamp:
+				StartRamp(InParams.TargetGain, InParams.bIsRamping ? InParams.CommandRampFrames : 0, InParams.RampShape);
+				break;
+		}
 	}
 
 	void FGain::ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
 	{
 		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FGain::ProcessAudioBuffer"))
 
-		// Skip processing if Gain == 0
-		if (GainParamSmoother.GetValue() == 0.0f)
+		if (FBlockCapture::IsCapturing())
 		{
-			FMemory::Memzero(OutBuffer, sizeof(float) * InNumSamples);
-			return;
+			CaptureBlock(InBuffer, InNumSamples);
 		}
 
-		// Skip processing if Gain == 1
-		if (GainParamSmoother.GetValue() == 1.0f)
+		// Gain has no quality to give back, its time still counts against the budget
+		FQualityGovernor::FScopedMeasure QualityGovernorMeasure;
+
+		if (bIsRamping)
 		{
-			FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * InNumSamples);
+			switch (RampShape)
+			{
+				default:
+				case EGainRampShape::Linear:
+					ProcessRamp<EGainRampShape::Linear>(InBuffer, OutBuffer, InNumSamples);
+					break;
+				case EGainRampShape::Exponential:
+					ProcessRamp<EGainRampShape::Exponential>(InBuffer, OutBuffer, InNumSamples);
+					break;
+				case EGainRampShape::SCurve:
+					ProcessRamp<EGainRampShape::SCurve>(InBuffer, OutBuffer, InNumSamples);
+					break;
+				case EGainRampShape::EqualPower:
+					ProcessRamp<EGainRampShape::EqualPower>(InBuffer, OutBuffer, InNumSamples);
+					break;
+			}
+
 			return;
 		}
 
+		// One smoother value per vector, 4 / NumChannels frames each
+		GainParamSmoother.PrepareBlock(InNumSamples / 4, 4.0f / NumChannels);
+
+		if (GainParamSmoother.IsSettled())
+		{
+			// Skip processing if Gain == 0
+			if (GainParamSmoother.GetTargetValue() == 0.0f)
+			{
+				FMemory::Memzero(OutBuffer, sizeof(float) * InNumSamples);
+				return;
+			}
+
+			// Skip processing if Gain == 1
+			if (GainParamSmoother.GetTargetValue() == 1.0f)
+			{
+				FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * InNumSamples);
+				return;
+			}
+		}
+
 		ProcessGain(InBuffer, OutBuffer, InNumSamples);
 	}
 
+	void FGain::ProcessPlanarBuffers(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InNumFrames)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FGain::ProcessPlanarBuffers"))
+
+		if (FBlockCapture::IsCapturing())
+		{
+			CapturePlanarBlock(InBuffers, InNumChannels, InNumFrames);
+		}
+
+		FQualityGovernor::FScopedMeasure QualityGovernorMeasure;
+
+		ProcessPlanarVectors(InBuffers, OutBuffers, InNumChannels, 0, InNumFrames);
+	}
+
+	void FGain::ProcessPlanarVectors(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InStartFrame, const int32 InNumFrames)
+	{
+		if (bIsRamping)
+		{
+			switch (RampShape)
+			{
+				default:
+				case EGainRampShape::Linear:
+					ProcessPlanarRamp<EGainRampShape::Linear>(InBuffers, OutBuffers, InNumChannels, InStartFrame, InNumFrames);
+					break;
+				case EGainRampShape::Exponential:
+					ProcessPlanarRamp<EGainRampShape::Exponential>(InBuffers, OutBuffers, InNumChannels, InStartFrame, InNumFrames);
+					break;
+				case EGainRampShape::SCurve:
+					ProcessPlanarRamp<EGainRampShape::SCurve>(InBuffers, OutBuffers, InNumChannels, InStartFrame, InNumFrames);
+					break;
+				case EGainRampShape::EqualPower:
+					ProcessPlanarRamp<EGainRampShape::EqualPower>(InBuffers, OutBuffers, InNumChannels, InStartFrame, InNumFrames);
+					break;
+			}
+
+			return;
+		}
+
+		// One smoother value per vector of frames, shared by all the channels
+		GainParamSmoother.PrepareBlock(InNumFrames / 4, 4.0f);
+
+		if (GainParamSmoother.IsSettled())
+		{
+			// Skip processing if Gain == 0
+			if (GainParamSmoother.GetTargetValue() == 0.0f)
+			{
+				for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+				{
+					FMemory::Memzero(OutBuffers[Channel] + InStartFrame, sizeof(float) * InNumFrames);
+				}
+				return;
+			}
+
+			// Skip processing if Gain == 1
+			if (GainParamSmoother.GetTargetValue() == 1.0f)
+			{
+				for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+				{
+					FMemory::Memcpy(OutBuffers[Channel] + InStartFrame, InBuffers[Channel] + InStartFrame, sizeof(float) * InNumFrames);
+				}
+				return;
+			}
+		}
+
+		for (int32 i = InStartFrame; i < InStartFrame + InNumFrames; i += 4)
+		{
+			const float CurrentGain = GainParamSmoother.GetValue();
+
+			const VectorRegister4Float VGain = VectorLoadFloat1(&CurrentGain);
+
+			for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+			{
+				const VectorRegister4Float In = VectorLoadAligned(&InBuffers[Channel][i]);
+				VectorStoreAligned(VectorMultiply(VGain, In), &OutBuffers[Channel][i]);
+			}
+		}
+	}
+
+	FGain::FScopedPlanarSegments::FScopedPlanarSegments(FGain& InGain, const float* const* InBuffers, const int32 InNumChannels, const int32 InNumFrames)
+	{
+		if (FBlockCapture::IsCapturing())
+		{
+			InGain.CapturePlanarBlock(InBuffers, InNumChannels, InNumFrames);
+		}
+
+		QualityGovernorMeasure.Emplace();
+	}
+
+	void FGain::ProcessPlanarSegment(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InStartFrame, const int32 InNumFrames)
+	{
+		const int32 EndFrame         = InStartFrame + InNumFrames;
+		const int32 VectorStartFrame = FMath::Min(Align(InStartFrame, 4), EndFrame);
+		const int32 VectorEndFrame   = FMath::Max(AlignDown(EndFrame, 4), VectorStartFrame);
+
+		ProcessPlanarFrames(InBuffers, OutBuffers, InNumChannels, InStartFrame, VectorStartFrame - InStartFrame);
+
+		// Offsets into the caller's buffers, no per-segment pointer arrays to build on the audio thread
+		if (VectorEndFrame > VectorStartFrame)
+		{
+			ProcessPlanarVectors(InBuffers, OutBuffers, InNumChannels, VectorStartFrame, VectorEndFrame - VectorStartFrame);
+		}
+
+		ProcessPlanarFrames(InBuffers, OutBuffers, InNumChannels, VectorEndFrame, EndFrame - VectorEndFrame);
+	}
+
+	void FGain::ProcessPlanarFrames(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InStartFrame, const int32 InNumFrames)
+	{
+		const int32 EndFrame = InStartFrame + InNumFrames;
+
+		int32 Frame = InStartFrame;
+
+		// A ramp ending in these frames hands over to the smoother, settled on the ramp target
+		for (; bIsRamping && Frame < EndFrame; ++Frame)
+		{
+			const float FrameGain = GetCurrentRampGain();
+
+			if (++RampFrameIndex >= RampDurationFrames)
+			{
+				FinishRamp();
+			}
+
+			for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+			{
+				OutBuffers[Channel][Frame] = FrameGain * InBuffers[Channel][Frame];
+			}
+		}
+
+		if (Frame == EndFrame)
+		{
+			return;
+		}
+
+		// One smoother step per frame here, the vectorized kernels take one per 4 frames, so a smoothed change keeps its duration across the segments
+		GainParamSmoother.PrepareBlock(EndFrame - Frame, 1.0f);
+
+		for (; Frame < EndFrame; ++Frame)
+		{
+			const float FrameGain = GainParamSmoother.GetValue();
+
+			for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+			{
+				OutBuffers[Channel][Frame] = FrameGain * InBuffers[Channel][Frame];
+			}
+		}
+	}
+
 	void FGain::ProcessGain(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
 	{
 		// Sequential version
@@ -55,4 +434,180 @@ namespace DSPProcessing
 			VectorStoreAligned(Out, &OutBuffer[i]);
 		}
 	}
+
+	template <EGainRampShape RampShapeT>
+	FORCEINLINE VectorRegister4Float FGain::VectorRampGain(const VectorRegister4Float& RampPosition) const
+	{
+		const VectorRegister4Float VStartGain  = VectorLoadFloat1(&RampStartGain);
+		const VectorRegister4Float VTargetGain = VectorLoadFloat1(&RampTargetGain);
+
+		VectorRegister4Float Gain;
+
+		if constexpr (RampShapeT == EGainRampShape::Linear)
+		{
+			//Gain = Start + (Target - Start) * Position;
+			Gain = VectorMultiplyAdd(VectorSubtract(VTargetGain, VStartGain), RampPosition, VStartGain);
+		}
+		else if constexpr (RampShapeT == EGainRampShape::Exponential)
+		{
+			//Gain = Start * FMath::Exp(Position * FMath::Loge(Target / Start));
+			const VectorRegister4Float VLogRatio = VectorLoadFloat1(&RampLogRatio);
+			Gain = VectorMultiply(VStartGain, VectorExp(VectorMultiply(RampPosition, VLogRatio)));
+		}
+		else if constexpr (RampShapeT == EGainRampShape::SCurve)
+		{
+			//const float Smooth = Position * Position * (3.0f - 2.0f * Position);
+			const VectorRegister4Float Smooth = VectorMultiply(VectorMultiply(RampPosition, RampPosition), VectorNegateMultiplyAdd(AudioUtils::VTwos, RampPosition, AudioUtils::VThrees));
+
+			//Gain = Start + (Target - Start) * Smooth;
+			Gain = VectorMultiplyAdd(VectorSubtract(VTargetGain, VStartGain), Smooth, VStartGain);
+		}
+		else
+		{
+			// The power goes from Start^2 to Target^2 along cos^2/sin^2, which sum to 1: a plain sine/cosine fade from or to 0,
+			// and no overshoot between two non-zero gains (Start * Cos + Target * Sin peaks above both)
+			//Gain = Sign * FMath::Sqrt(Start^2 * FMath::Cos(Position * PI / 2)^2 + Target^2 * FMath::Sin(Position * PI / 2)^2);
+			VectorRegister4Float Sin;
+			VectorRegister4Float Cos;
+			const VectorRegister4Float Angle = VectorMultiply(RampPosition, GainUtils::VHalfPi);
+			VectorSinCos(&Sin, &Cos, &Angle);
+
+			const VectorRegister4Float StartPower  = VectorMultiply(VectorMultiply(VStartGain, VStartGain), VectorMultiply(Cos, Cos));
+			const VectorRegister4Float TargetPower = VectorMultiply(VectorMultiply(VTargetGain, VTargetGain), VectorMultiply(Sin, Sin));
+
+			Gain = VectorMultiply(VectorLoadFloat1(&RampSign), VectorSqrt(VectorAdd(StartPower, TargetPower)));
+		}
+
+		// Lands exactly on the target, so the Memzero/Memcpy fast paths kick in once the ramp is over
+		return VectorSelect(VectorCompareGE(RampPosition, AudioUtils::VOnes), VTargetGain, Gain);
+	}
+
+	template <EGainRampShape RampShapeT>
+	void FGain::ProcessRamp(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	{
+		const int32 NumFrames = InNumSamples / NumChannels;
+
+		if (NumChannels <= 2)
+		{
+			// Mono/Stereo: several frames per vector, every lane gets its own ramp position
+			const int32 FramesPerVector = 4 / NumChannels;
+
+			const VectorRegister4Float VPositionStep = VectorLoadFloat1(&RampPositionStep);
+
+			for (int32 i = 0, Frame = RampFrameIndex; i < InNumSamples; i += 4, Frame += FramesPerVector)
+			{
+				//const float Position = (Frame + LaneFrameOffset) / RampDurationFrames;
+				const float FramePosition = Frame * RampPositionStep;
+				const VectorRegister4Float Position = VectorMultiplyAdd(VLaneFrameOffsets, VPositionStep, VectorLoadFloat1(&FramePosition));
+
+				const VectorRegister4Float VGain = VectorRampGain<RampShapeT>(Position);
+
+				const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+				VectorStoreAligned(VectorMultiply(VGain, In), &OutBuffer[i]);
+			}
+		}
+		else
+		{
+			// One or more vectors per frame, one ramp position per frame
+			const bool bIsMultipleOfFour = (NumChannels % 4) == 0;
+
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				const float FramePosition = (RampFrameIndex + Frame) * RampPositionStep;
+				const VectorRegister4Float VGain = VectorRampGain<RampShapeT>(VectorLoadFloat1(&FramePosition));
+
+				const int32 FrameStart = Frame * NumChannels;
+
+				if (bIsMultipleOfFour)
+				{
+					for (int32 Channel = 0; Channel < NumChannels; Channel += 4)
+					{
+						const VectorRegister4Float In = VectorLoadAligned(&InBuffer[FrameStart + Channel]);
+						VectorStoreAligned(VectorMultiply(VGain, In), &OutBuffer[FrameStart + Channel]);
+					}
+				}
+				else
+				{
+					float Gain;
+					VectorStoreFloat1(VGain, &Gain);
+
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						OutBuffer[FrameStart + Channel] = Gain * InBuffer[FrameStart + Channel];
+					}
+				}
+			}
+		}
+
+		RampFrameIndex += NumFrames;
+
+		if (RampFrameIndex >= RampDurationFrames)
+		{
+			FinishRamp();
+		}
+	}
+
+	template <EGainRampShape RampShapeT>
+	void FGain::ProcessPlanarRamp(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InStartFrame, const int32 InNumFrames)
+	{
+		const VectorRegister4Float VPositionStep = VectorLoadFloat1(&RampPositionStep);
+
+		for (int32 i = InStartFrame; i < InStartFrame + InNumFrames; i += 4)
+		{
+			//const float Position = (RampFrameIndex + i - InStartFrame + Lane) / RampDurationFrames;
+			const float FramePosition = (RampFrameIndex + i - InStartFrame) * RampPositionStep;
+			const VectorRegister4Float Position = VectorMultiplyAdd(GainUtils::VPlanarLaneFrameOffsets, VPositionStep, VectorLoadFloat1(&FramePosition));
+
+			const VectorRegister4Float VGain = VectorRampGain<RampShapeT>(Position);
+
+			for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+			{
+				const VectorRegister4Float In = VectorLoadAligned(&InBuffers[Channel][i]);
+				VectorStoreAligned(VectorMultiply(VGain, In), &OutBuffers[Channel][i]);
+			}
+		}
+
+		RampFrameIndex += InNumFrames;
+
+		if (RampFrameIndex >= RampDurationFrames)
+		{
+			FinishRamp();
+		}
+	}
+
+	float FGain::GetCurrentRampGain() const
+	{
+		const float Position = FMath::Min(RampFrameIndex * RampPositionStep, 1.0f);
+		const VectorRegister4Float VPosition = VectorLoadFloat1(&Position);
+
+		VectorRegister4Float VGain;
+
+		switch (RampShape)
+		{
+			default:
+			case EGainRampShape::Linear:
+				VGain = VectorRampGain<EGainRampShape::Linear>(VPosition);
+				break;
+			case EGainRampShape::Exponential:
+				VGain = VectorRampGain<EGainRampShape::Exponential>(VPosition);
+				break;
+			case EGainRampShape::SCurve:
+				VGain = VectorRampGain<EGainRampShape::SCurve>(VPosition);
+				break;
+			case EGainRampShape::EqualPower:
+				VGain = VectorRampGain<EGainRampShape::EqualPower>(VPosition);
+				break;
+		}
+
+		float Gain;
+		VectorStoreFloat1(VGain, &Gain);
+
+		return Gain;
+	}
+
+	void FGain::FinishRamp()
+	{
+		bIsRamping = false;
+		GainParamSmoother.ResetParamValue(RampTargetGain);
+	}
 }
@@ -0,0 +1,767 @@
+#include "DSPProcessing/GainMatrix.h"
+
+namespace DSPProcessing
+{
+	namespace GainMatrixUtils
+	{
+		constexpr float MinusThreeDb = 0.70710678f;
+
+		// UE channel order: FL, FR, FC, LFE, SL, SR, BL, BR
+		constexpr int32 FrontCenter = 2;
+		constexpr int32 LowFrequency = 3;
+	}
+
+	void FGainMatrix::Init(const float InSampleRate, const int32 InNumInputChannels, const int32 InNumOutputChannels)
+	{
+		constexpr float SmoothingTimeInMs = 21.33f;
+		SmoothingTimeInFrames = FMath::Max(FMath::RoundToInt(SmoothingTimeInMs * 0.001f * InSampleRate), 1);
+
+		NumInputChannels  = FMath::Clamp(InNumInputChannels,  1, MaxNumChannels);
+		NumOutputChannels = FMath::Clamp(InNumOutputChannels, 1, MaxNumChannels);
+
+		Layout = EGainMatrixLayout::Identity;
+		FillLayout();
+
+		FMemory::Memcpy(CurrentGains, TargetGains, sizeof(TargetGains));
+
+		RemainingSmoothingFrames = 0;
+		bIsSmoothing			 = false;
+		bFirstUpdate			 = true;
+
+		UpdateKernel();
+	}
+
+	void FGainMatrix::SetNumChannels(const int32 InNumInputChannels, const int32 InNumOutputChannels)
+	{
+		const int32 NewNumInputChannels  = FMath::Clamp(InNumInputChannels,  1, MaxNumChannels);
+		const int32 NewNumOutputChannels = FMath::Clamp(InNumOutputChannels, 1, MaxNumChannels);
+
+		if (NewNumInputChannels == NumInputChannels && NewNumOutputChannels == NumOutputChannels)
+		{
+			return;
+		}
+
+		NumInputChannels  = NewNumInputChannels;
+		NumOutputChannels = NewNumOutputChannels;
+
+		if (Layout != EGainMatrixLayout::Custom)
+		{
+			FillLayout();
+		}
+
+		// Smoothing between two channel layouts doesn't make sense, jump to the new matrix
+		bFirstUpdate = true;
+		MarkTargetChanged();
+	}
+
+	int32 FGainMatrix::GetNumInputChannels() const
+	{
+		return NumInputChannels;
+	}
+
+	int32 FGainMatrix::GetNumOutputChannels() const
+	{
+		return NumOutputChannels;
+	}
+
+	void FGainMatrix::SetLayout(const EGainMatrixLayout InLayout)
+	{
+		Layout = InLayout;
+
+		if (Layout == EGainMatrixLayout::Custom)
+		{
+			return;
+		}
+
+		FillLayout();
+		MarkTargetChanged();
+	}
+
+	void FGainMatrix::SetGain(const int32 InOutputChannel, const int32 InInputChannel, const float InGain)
+	{
+		if (InOutputChannel < 0 || InOutputChannel >= MaxNumChannels || InInputChannel < 0 || InInputChannel >= MaxNumChannels)
+		{
+			return;
+		}
+
+		Layout = EGainMatrixLayout::Custom;
+
+		const float Gain = FMath::Clamp(InGain, -4.0f, 4.0f);
+		float& TargetGain = TargetGains[GetIndex(InOutputChannel, InInputChannel)];
+
+		if (TargetGain != Gain)
+		{
+			TargetGain = Gain;
+			MarkTargetChanged();
+		}
+	}
+
+	void FGainMatrix::ClearGains()
+	{
+		Layout = EGainMatrixLayout::Custom;
+
+		FMemory::Memzero(TargetGains, sizeof(TargetGains));
+		MarkTargetChanged();
+	}
+
+	void FGainMatrix::MarkTargetChanged()
+	{
+		bIsSmoothing			 = true;
+		RemainingSmoothingFrames = SmoothingTimeInFrames;
+	}
+
+	void FGainMatrix::FillLayout()
+	{
+		using namespace GainMatrixUtils;
+
+		FMemory::Memzero(TargetGains, sizeof(TargetGains));
+
+		auto FillDownmixToStereo = [this](const int32 LeftOutput, const int32 RightOutput, const float Scale)
+		{
+			if (NumInputChannels == 1)
+			{
+				TargetGains[GetIndex(LeftOutput,  0)] += Scale * MinusThreeDb;
+				TargetGains[GetIndex(RightOutput, 0)] += Scale * MinusThreeDb;
+				return;
+			}
+
+			TargetGains[GetIndex(LeftOutput,  0)] += Scale;
+			TargetGains[GetIndex(RightOutput, 1)] += Scale;
+
+			const bool bHasCenterAndLFE = (NumInputChannels == 6 || NumInputChannels == 8);
+
+			for (int32 InputChannel = 2; InputChannel < NumInputChannels; ++InputChannel)
+			{
+				if (bHasCenterAndLFE && InputChannel == LowFrequency)
+				{
+					continue;
+				}
+
+				if (bHasCenterAndLFE && InputChannel == FrontCenter)
+				{
+					TargetGains[GetIndex(LeftOutput,  InputChannel)] += Scale * MinusThreeDb;
+					TargetGains[GetIndex(RightOutput, InputChannel)] += Scale * MinusThreeDb;
+				}
+				else if (NumInputChannels == 4 || bHasCenterAndLFE)
+				{
+					// Surround pairs, left channels are even
+					const int32 Output = (InputChannel % 2 == 0) ? LeftOutput : RightOutput;
+					TargetGains[GetIndex(Output, InputChannel)] += Scale * MinusThreeDb;
+				}
+				else
+				{
+					// Unknown layout, extra channels go to both sides
+					TargetGains[GetIndex(LeftOutput,  InputChannel)] += Scale * 0.5f;
+					TargetGains[GetIndex(RightOutput, InputChannel)] += Scale * 0.5f;
+				}
+			}
+		};
+
+		auto FillIdentity = [this]()
+		{
+			for (int32 Channel = 0; Channel < FMath::Min(NumInputChannels, NumOutputChannels); ++Channel)
+			{
+				TargetGains[GetIndex(Channel, Channel)] = 1.0f;
+			}
+		};
+
+		switch (Layout)
+		{
+			default:
+			case EGainMatrixLayout::Identity:
+				FillIdentity();
+				break;
+
+			case EGainMatrixLayout::DownmixToMono:
+				// Average of the stereo fold-down
+				FillDownmixToStereo(0, 0, NumInputChannels == 1 ? MinusThreeDb : 0.5f);
+				break;
+
+			case EGainMatrixLayout::DownmixToStereo:
+				if (NumOutputChannels == 1)
+				{
+					FillDownmixToStereo(0, 0, NumInputChannels == 1 ? MinusThreeDb : 0.5f);
+				}
+				else
+				{
+					FillDownmixToStereo(0, 1, 1.0f);
+				}
+				break;
+
+			case EGainMatrixLayout::MonoToStereo:
+				TargetGains[GetIndex(0, 0)] = (NumOutputChannels == 1) ? 1.0f : MinusThreeDb;
+				if (NumOutputChannels > 1)
+				{
+					TargetGains[GetIndex(1, 0)] = MinusThreeDb;
+				}
+				break;
+
+			case EGainMatrixLayout::SwapStereo:
+				FillIdentity();
+				if (NumInputChannels > 1 && NumOutputChannels > 1)
+				{
+					TargetGains[GetIndex(0, 0)] = 0.0f;
+					TargetGains[GetIndex(1, 1)] = 0.0f;
+					TargetGains[GetIndex(0, 1)] = 1.0f;
+					TargetGains[GetIndex(1, 0)] = 1.0f;
+				}
+				break;
+		}
+	}
+
+	void FGainMatrix::BeginBlock(const int32 InNumFrames)
+	{
+		if (!bIsSmoothing)
+		{
+			bFirstUpdate = false;
+			return;
+		}
+
+		if (bFirstUpdate)
+		{
+			FMemory::Memcpy(CurrentGains, TargetGains, sizeof(TargetGains));
+
+			bFirstUpdate = false;
+			bIsSmoothing = false;
+			UpdateKernel();
+			return;
+		}
+
+		// Every coefficient moves linearly inside the block, the last block lands exactly on the target
+		const bool  bIsLastBlock	 = InNumFrames >= RemainingSmoothingFrames;
+		const float Fraction		 = bIsLastBlock ? 1.0f : (float)InNumFrames / RemainingSmoothingFrames;
+		const float OneOverNumFrames = 1.0f / InNumFrames;
+
+		float StartGains[MaxNumChannels * MaxNumChannels];
+		float GainDeltas[MaxNumChannels * MaxNumChannels];
+
+		bool bIsDiagonal = (NumInputChannels == NumOutputChannels);
+
+		Entries.Reset();
+
+		for (int32 OutputChannel = 0; OutputChannel < NumOutputChannels; ++OutputChannel)
+		{
+			for (int32 InputChannel = 0; InputChannel < NumInputChannels; ++InputChannel)
+			{
+				const int32 Index = GetIndex(OutputChannel, InputChannel);
+
+				const float StartGain = CurrentGains[Index];
+				const float EndGain	  = bIsLastBlock ? TargetGains[Index] : StartGain + (TargetGains[Index] - StartGain) * Fraction;
+
+				CurrentGains[Index] = EndGain;
+				StartGains[Index]	= StartGain;
+				GainDeltas[Index]	= (EndGain - StartGain) * OneOverNumFrames;
+
+				if (StartGain != 0.0f || EndGain != 0.0f)
+				{
+					Entries.Add({ InputChannel, OutputChannel, StartGain, GainDeltas[Index] });
+					bIsDiagonal &= (InputChannel == OutputChannel);
+				}
+			}
+		}
+
+		// Same vector kernels as the static matrix, the dense ones handle whatever the start and end matrices are
+		if (bIsDiagonal && !Entries.IsEmpty())
+		{
+			RampKernel = EKernel::Diagonal;
+		}
+		else if (NumInputChannels == 2 && NumOutputChannels == 2)
+		{
+			RampKernel = EKernel::Stereo;
+		}
+		else if (NumOutputChannels == 2 && NumInputChannels % 2 == 0)
+		{
+			RampKernel = EKernel::FoldDown;
+		}
+		else if (NumInputChannels % 4 == 0)
+		{
+			RampKernel = EKernel::DotProduct;
+		}
+		else
+		{
+			RampKernel = EKernel::Sparse;
+		}
+
+		FillKernelGains(RampKernel, StartGains, GainDeltas);
+
+		RemainingSmoothingFrames -= InNumFrames;
+	}
+
+	void FGainMatrix::EndBlock()
+	{
+		if (bIsSmoothing && RemainingSmoothingFrames <= 0)
+		{
+			FMemory::Memcpy(CurrentGains, TargetGains, sizeof(TargetGains));
+
+			bIsSmoothing = false;
+			UpdateKernel();
+		}
+	}
+
+	void FGainMatrix::UpdateKernel()
+	{
+		Entries.Reset();
+
+		bool bIsDiagonal = (NumInputChannels == NumOutputChannels);
+		bool bIsIdentity = bIsDiagonal;
+
+		for (int32 OutputChannel = 0; OutputChannel < NumOutputChannels; ++OutputChannel)
+		{
+			for (int32 InputChannel = 0; InputChannel < NumInputChannels; ++InputChannel)
+			{
+				const float Gain = CurrentGains[GetIndex(OutputChannel, InputChannel)];
+
+				if (Gain != 0.0f)
+				{
+					Entries.Add({ InputChannel, OutputChannel, Gain, 0.0f });
+				}
+
+				if (InputChannel == OutputChannel)
+				{
+					bIsIdentity &= (Gain == 1.0f);
+				}
+				else if (Gain != 0.0f)
+				{
+					bIsDiagonal = false;
+					bIsIdentity = false;
+				}
+			}
+		}
+
+		if (Entries.IsEmpty())
+		{
+			Kernel = EKernel::Zero;
+		}
+		else if (bIsIdentity)
+		{
+			Kernel = EKernel::Identity;
+		}
+		else if (bIsDiagonal)
+		{
+			Kernel = EKernel::Diagonal;
+		}
+		else if (NumInputChannels == 2 && NumOutputChannels == 2)
+		{
+			Kernel = EKernel::Stereo;
+		}
+		else if (NumOutputChannels == 2 && NumInputChannels % 2 == 0)
+		{
+			// Whatever the density, the fold-downs are only a few multiply-adds per frame
+			Kernel = EKernel::FoldDown;
+		}
+		else if (NumInputChannels % 4 == 0 && Entries.Num() * 2 > NumInputChannels * NumOutputChannels)
+		{
+			Kernel = EKernel::DotProduct;
+		}
+		else
+		{
+			Kernel = EKernel::Sparse;
+		}
+
+		FillKernelGains(Kernel, CurrentGains, nullptr);
+	}
+
+	void FGainMatrix::FillKernelGains(const EKernel InKernel, const float* InGains, const float* InGainDeltas)
+	{
+		// Gain of a lane InFrameOffset frames into the iteration, and how much it moves in one iteration of InNumFrames
+		auto GetGain = [this, InGains, InGainDeltas](const int32 OutputChannel, const int32 InputChannel, const int32 InFrameOffset)
+		{
+			const int32 Index = GetIndex(OutputChannel, InputChannel);
+			return InGainDeltas ? InGains[Index] + InGainDeltas[Index] * InFrameOffset : InGains[Index];
+		};
+
+		auto GetStep = [this, InGainDeltas](const int32 OutputChannel, const int32 InputChannel, const int32 InNumFrames)
+		{
+			return InGainDeltas[GetIndex(OutputChannel, InputChannel)] * InNumFrames;
+		};
+
+		switch (InKernel)
+		{
+			case EKernel::Diagonal:
+			{
+				// Lane pattern of an interleaved buffer, e.g. 6 channels: [0 1 2 3] [4 5 0 1] [2 3 4 5]
+				NumDiagonalVectors = NumInputChannels / FMath::GreatestCommonDivisor(NumInputChannels, 4);
+
+				const int32 NumPatternFrames = NumDiagonalVectors * 4 / NumInputChannels;
+
+				for (int32 VectorIndex = 0; VectorIndex < NumDiagonalVectors; ++VectorIndex)
+				{
+					float Lanes[4];
+					float Steps[4];
+					for (int32 Lane = 0; Lane < 4; ++Lane)
+					{
+						const int32 Sample	= VectorIndex * 4 + Lane;
+						const int32 Channel = Sample % NumInputChannels;
+
+						Lanes[Lane] = GetGain(Channel, Channel, Sample / NumInputChannels);
+						Steps[Lane] = InGainDeltas ? GetStep(Channel, Channel, NumPatternFrames) : 0.0f;
+					}
+
+					VDiagonalGains[VectorIndex]		= MakeVectorRegisterFloat(Lanes[0], Lanes[1], Lanes[2], Lanes[3]);
+					VDiagonalGainSteps[VectorIndex] = MakeVectorRegisterFloat(Steps[0], Steps[1], Steps[2], Steps[3]);
+				}
+				break;
+			}
+
+			case EKernel::Stereo:
+			{
+				// 2 frames per vector
+				VStereoDirectGains = MakeVectorRegisterFloat(GetGain(0, 0, 0), GetGain(1, 1, 0), GetGain(0, 0, 1), GetGain(1, 1, 1));
+				VStereoCrossGains  = MakeVectorRegisterFloat(GetGain(0, 1, 0), GetGain(1, 0, 0), GetGain(0, 1, 1), GetGain(1, 0, 1)); // R into L, L into R
+
+				if (InGainDeltas)
+				{
+					VStereoDirectGainSteps = MakeVectorRegisterFloat(GetStep(0, 0, 2), GetStep(1, 1, 2), GetStep(0, 0, 2), GetStep(1, 1, 2));
+					VStereoCrossGainSteps  = MakeVectorRegisterFloat(GetStep(0, 1, 2), GetStep(1, 0, 2), GetStep(0, 1, 2), GetStep(1, 0, 2));
+				}
+				break;
+			}
+
+			case EKernel::FoldDown:
+			{
+				for (int32 Frame = 0; Frame < 2; ++Frame)
+				{
+					for (int32 OutputChannel = 0; OutputChannel < 2; ++OutputChannel)
+					{
+						for (int32 VectorIndex = 0; VectorIndex < NumInputChannels / 2; ++VectorIndex)
+						{
+							float Lanes[4];
+							float Steps[4];
+							for (int32 Lane = 0; Lane < 4; ++Lane)
+							{
+								const int32 Sample	= VectorIndex * 4 + Lane;
+								const int32 Channel = Sample % NumInputChannels;
+								const bool	bInFrame = (Sample / NumInputChannels == Frame);
+
+								Lanes[Lane] = bInFrame ? GetGain(OutputChannel, Channel, Frame) : 0.0f;
+								Steps[Lane] = (bInFrame && InGainDeltas) ? GetStep(OutputChannel, Channel, 2) : 0.0f;
+							}
+
+							VFoldGains[Frame][OutputChannel][VectorIndex]	  = MakeVectorRegisterFloat(Lanes[0], Lanes[1], Lanes[2], Lanes[3]);
+							VFoldGainSteps[Frame][OutputChannel][VectorIndex] = MakeVectorRegisterFloat(Steps[0], Steps[1], Steps[2], Steps[3]);
+						}
+					}
+				}
+				break;
+			}
+
+			case EKernel::DotProduct:
+			{
+				for (int32 OutputChannel = 0; OutputChannel < NumOutputChannels; ++OutputChannel)
+				{
+					for (int32 VectorIndex = 0; VectorIndex < NumInputChannels / 4; ++VectorIndex)
+					{
+						const int32 Input = VectorIndex * 4;
+
+						VRowGains[OutputChannel][VectorIndex] = MakeVectorRegisterFloat(GetGain(OutputChannel, Input, 0), GetGain(OutputChannel, Input + 1, 0),
+																						GetGain(OutputChannel, Input + 2, 0), GetGain(OutputChannel, Input + 3, 0));
+
+						if (InGainDeltas)
+						{
+							VRowGainSteps[OutputChannel][VectorIndex] = MakeVectorRegisterFloat(GetStep(OutputChannel, Input, 1), GetStep(OutputChannel, Input + 1, 1),
+																								GetStep(OutputChannel, Input + 2, 1), GetStep(OutputChannel, Input + 3, 1));
+						}
+					}
+				}
+				break;
+			}
+
+			default:
+				// Identity, Zero and Sparse have no vector gains, Sparse reads Entries
+				break;
+		}
+	}
+
+	void FGainMatrix::ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FGainMatrix::ProcessAudioBuffer"))
+
+		if (InNumFrames <= 0)
+		{
+			return;
+		}
+
+		BeginBlock(InNumFrames);
+
+		if (bIsSmoothing)
+		{
+			ProcessKernel<true>(RampKernel, InBuffer, OutBuffer, InNumFrames);
+			EndBlock();
+			return;
+		}
+
+		ProcessKernel<false>(Kernel, InBuffer, OutBuffer, InNumFrames);
+	}
+
+	template <bool bRampT>
+	void FGainMatrix::ProcessKernel(const EKernel InKernel, const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
+	{
+		switch (InKernel)
+		{
+			case EKernel::Identity:
+				FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * InNumFrames * NumInputChannels);
+				break;
+			case EKernel::Zero:
+				FMemory::Memzero(OutBuffer, sizeof(float) * InNumFrames * NumOutputChannels);
+				break;
+			case EKernel::Diagonal:
+				ProcessDiagonal<bRampT>(InBuffer, OutBuffer, InNumFrames);
+				break;
+			case EKernel::Stereo:
+				ProcessStereo<bRampT>(InBuffer, OutBuffer, InNumFrames);
+				break;
+			case EKernel::FoldDown:
+				ProcessFoldDown<bRampT>(InBuffer, OutBuffer, InNumFrames);
+				break;
+			case EKernel::DotProduct:
+				ProcessDotProduct<bRampT>(InBuffer, OutBuffer, InNumFrames);
+				break;
+			default:
+			case EKernel::Sparse:
+				ProcessSparse<bRampT>(InBuffer, OutBuffer, InNumFrames);
+				break;
+		}
+	}
+
+	void FGainMatrix::ProcessPlanarBuffers(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumFrames)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FGainMatrix::ProcessPlanarBuffers"))
+
+		if (InNumFrames <= 0)
+		{
+			return;
+		}
+
+		BeginBlock(InNumFrames);
+
+		if (!bIsSmoothing && Kernel == EKernel::Identity)
+		{
+			for (int32 Channel = 0; Channel < NumOutputChannels; ++Channel)
+			{
+				FMemory::Memcpy(OutBuffers[Channel], InBuffers[Channel], sizeof(float) * InNumFrames);
+			}
+			return;
+		}
+
+		for (int32 Channel = 0; Channel < NumOutputChannels; ++Channel)
+		{
+			FMemory::Memzero(OutBuffers[Channel], sizeof(float) * InNumFrames);
+		}
+
+		// Sequential version
+		//for (const FMatrixEntry& Entry : Entries)
+		//{
+		//	  for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+		//	  {
+		//		  OutBuffers[Entry.OutputChannel][Frame] += (Entry.Gain + Frame * Entry.GainDelta) * InBuffers[Entry.InputChannel][Frame];
+		//	  }
+		//}
+
+		// Vectorized version
+		for (const FMatrixEntry& Entry : Entries)
+		{
+			const float* InBuffer = InBuffers[Entry.InputChannel];
+			float* OutBuffer	  = OutBuffers[Entry.OutputChannel];
+
+			const float GainStep = 4.0f * Entry.GainDelta;
+
+			const VectorRegister4Float VGainStep = VectorLoadFloat1(&GainStep);
+			VectorRegister4Float VGain = MakeVectorRegisterFloat(Entry.Gain, Entry.Gain + Entry.GainDelta, Entry.Gain + 2.0f * Entry.GainDelta, Entry.Gain + 3.0f * Entry.GainDelta);
+
+			for (int32 i = 0; i < InNumFrames; i += 4)
+			{
+				const VectorRegister4Float In  = VectorLoadAligned(&InBuffer[i]);
+				const VectorRegister4Float Out = VectorMultiplyAdd(VGain, In, VectorLoadAligned(&OutBuffer[i]));
+
+				VectorStoreAligned(Out, &OutBuffer[i]);
+
+				VGain = VectorAdd(VGain, VGainStep);
+			}
+		}
+
+		EndBlock();
+	}
+
+	template <bool bRampT>
+	void FGainMatrix::ProcessDiagonal(const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
+	{
+		const int32 NumSamples = InNumFrames * NumInputChannels;
+
+		// Sequential version
+		//for (int32 i = 0; i < NumSamples; ++i)
+		//{
+		//	  const int32 Channel = i % NumInputChannels;
+		//	  OutBuffer[i] = CurrentGains[GetIndex(Channel, Channel)] * InBuffer[i];
+		//}
+
+		// Vectorized version
+		for (int32 i = 0, VectorIndex = 0; i < NumSamples; i += 4)
+		{
+			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+			VectorStoreAligned(VectorMultiply(VDiagonalGains[VectorIndex], In), &OutBuffer[i]);
+
+			if constexpr (bRampT)
+			{
+				// Next used one pattern later
+				VDiagonalGains[VectorIndex] = VectorAdd(VDiagonalGains[VectorIndex], VDiagonalGainSteps[VectorIndex]);
+			}
+
+			if (++VectorIndex == NumDiagonalVectors)
+			{
+				VectorIndex = 0;
+			}
+		}
+	}
+
+	template <bool bRampT>
+	void FGainMatrix::ProcessStereo(const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
+	{
+		const int32 NumSamples = InNumFrames * 2;
+
+		// Sequential version
+		//for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+		//{
+		//	  const float L = InBuffer[2 * Frame];
+		//	  const float R = InBuffer[2 * Frame + 1];
+		//	  OutBuffer[2 * Frame]	   = LL * L + RL * R;
+		//	  OutBuffer[2 * Frame + 1] = LR * L + RR * R;
+		//}
+
+		// Vectorized version, 2 frames per vector
+		for (int32 i = 0; i < NumSamples; i += 4)
+		{
+			const VectorRegister4Float In	   = VectorLoadAligned(&InBuffer[i]);
+			const VectorRegister4Float Swapped = VectorSwizzle(In, 1, 0, 3, 2);
+
+			//Out = Direct * [L, R] + Cross * [R, L];
+			const VectorRegister4Float Out = VectorMultiplyAdd(VStereoDirectGains, In, VectorMultiply(VStereoCrossGains, Swapped));
+
+			VectorStoreAligned(Out, &OutBuffer[i]);
+
+			if constexpr (bRampT)
+			{
+				VStereoDirectGains = VectorAdd(VStereoDirectGains, VStereoDirectGainSteps);
+				VStereoCrossGains  = VectorAdd(VStereoCrossGains, VStereoCrossGainSteps);
+			}
+		}
+	}
+
+	template <bool bRampT>
+	void FGainMatrix::ProcessFoldDown(const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
+	{
+		const int32 NumInputVectors = NumInputChannels / 2;
+
+		// Sequential version
+		//for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+		//{
+		//	  for (int32 OutputChannel = 0; OutputChannel < 2; ++OutputChannel)
+		//	  {
+		//		  OutBuffer[2 * Frame + OutputChannel] = Sum(Row[i] * InBuffer[Frame * NumInputChannels + i]);
+		//	  }
+		//}
+
+		// Vectorized version, 2 frames per iteration: NumInputChannels / 2 input vectors, one output vector [L0, R0, L1, R1]
+		for (int32 Frame = 0; Frame < InNumFrames; Frame += 2)
+		{
+			const float* InFrames = &InBuffer[Frame * NumInputChannels];
+
+			VectorRegister4Float L0 = AudioUtils::VZeros;
+			VectorRegister4Float R0 = AudioUtils::VZeros;
+			VectorRegister4Float L1 = AudioUtils::VZeros;
+			VectorRegister4Float R1 = AudioUtils::VZeros;
+
+			for (int32 VectorIndex = 0; VectorIndex < NumInputVectors; ++VectorIndex)
+			{
+				const VectorRegister4Float In = VectorLoadAligned(&InFrames[VectorIndex * 4]);
+
+				L0 = VectorMultiplyAdd(In, VFoldGains[0][0][VectorIndex], L0);
+				R0 = VectorMultiplyAdd(In, VFoldGains[0][1][VectorIndex], R0);
+				L1 = VectorMultiplyAdd(In, VFoldGains[1][0][VectorIndex], L1);
+				R1 = VectorMultiplyAdd(In, VFoldGains[1][1][VectorIndex], R1);
+			}
+
+			// Horizontal sums of the 4 accumulators, lanes 0 + 2 and 1 + 3 first, then the two halves: [Sum(L0), Sum(R0), Sum(L1), Sum(R1)]
+			const VectorRegister4Float Frame0 = VectorAdd(VectorShuffle(L0, R0, 0, 1, 0, 1), VectorShuffle(L0, R0, 2, 3, 2, 3));
+			const VectorRegister4Float Frame1 = VectorAdd(VectorShuffle(L1, R1, 0, 1, 0, 1), VectorShuffle(L1, R1, 2, 3, 2, 3));
+			const VectorRegister4Float Out	  = VectorAdd(VectorShuffle(Frame0, Frame1, 0, 2, 0, 2), VectorShuffle(Frame0, Frame1, 1, 3, 1, 3));
+
+			VectorStoreAligned(Out, &OutBuffer[Frame * 2]);
+
+			if constexpr (bRampT)
+			{
+				for (int32 VectorIndex = 0; VectorIndex < NumInputVectors; ++VectorIndex)
+				{
+					VFoldGains[0][0][VectorIndex] = VectorAdd(VFoldGains[0][0][VectorIndex], VFoldGainSteps[0][0][VectorIndex]);
+					VFoldGains[0][1][VectorIndex] = VectorAdd(VFoldGains[0][1][VectorIndex], VFoldGainSteps[0][1][VectorIndex]);
+					VFoldGains[1][0][VectorIndex] = VectorAdd(VFoldGains[1][0][VectorIndex], VFoldGainSteps[1][0][VectorIndex]);
+					VFoldGains[1][1][VectorIndex] = VectorAdd(VFoldGains[1][1][VectorIndex], VFoldGainSteps[1][1][VectorIndex]);
+				}
+			}
+		}
+	}
+
+	template <bool bRampT>
+	void FGainMatrix::ProcessDotProduct(const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
+	{
+		const int32 NumInputVectors = NumInputChannels / 4;
+
+		VectorRegister4Float InVectors[MaxNumChannels / 4];
+
+		for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+		{
+			const float* InFrame = &InBuffer[Frame * NumInputChannels];
+			float* OutFrame		 = &OutBuffer[Frame * NumOutputChannels];
+
+			for (int32 VectorIndex = 0; VectorIndex < NumInputVectors; ++VectorIndex)
+			{
+				InVectors[VectorIndex] = VectorLoadAligned(&InFrame[VectorIndex * 4]);
+			}
+
+			for (int32 OutputChannel = 0; OutputChannel < NumOutputChannels; ++OutputChannel)
+			{
+				//OutFrame[OutputChannel] = Sum(Row[i] * InFrame[i]);
+				VectorRegister4Float Sum = VectorMultiply(InVectors[0], VRowGains[OutputChannel][0]);
+
+				for (int32 VectorIndex = 1; VectorIndex < NumInputVectors; ++VectorIndex)
+				{
+					Sum = VectorMultiplyAdd(InVectors[VectorIndex], VRowGains[OutputChannel][VectorIndex], Sum);
+				}
+
+				VectorStoreFloat1(VectorDot4(Sum, AudioUtils::VOnes), &OutFrame[OutputChannel]);
+
+				if constexpr (bRampT)
+				{
+					for (int32 VectorIndex = 0; VectorIndex < NumInputVectors; ++VectorIndex)
+					{
+						VRowGains[OutputChannel][VectorIndex] = VectorAdd(VRowGains[OutputChannel][VectorIndex], VRowGainSteps[OutputChannel][VectorIndex]);
+					}
+				}
+			}
+		}
+	}
+
+	template <bool bRampT>
+	void FGainMatrix::ProcessSparse(const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
+	{
+		FMemory::Memzero(OutBuffer, sizeof(float) * InNumFrames * NumOutputChannels);
+
+		// One strided pass per non zero coefficient, left for the channel counts the vector kernels don't cover (odd counts, mono outputs)
+		for (const FMatrixEntry& Entry : Entries)
+		{
+			const float* In = &InBuffer[Entry.InputChannel];
+			float* Out		= &OutBuffer[Entry.OutputChannel];
+
+			float Gain = Entry.Gain;
+
+			for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+			{
+				Out[Frame * NumOutputChannels] += Gain * In[Frame * NumInputChannels];
+
+				if constexpr (bRampT)
+				{
+					Gain += Entry.GainDelta;
+				}
+			}
+		}
+	}
+}
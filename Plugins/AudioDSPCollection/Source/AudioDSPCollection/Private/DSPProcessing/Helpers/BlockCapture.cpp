@@ -0,0 +1,342 @@
+#include "DSPProcessing/Helpers/BlockCapture.h"
+#include "AudioDSPCollection.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace DSPProcessing
+{
+	namespace BlockCapturePrivate
+	{
+		constexpr uint32 FileMagic   = 0x50414344; // "DCAP"
+		constexpr uint32 FileVersion = 1;
+
+		struct FFileHeader
+		{
+			uint32 Magic    = FileMagic;
+			uint32 Version  = FileVersion;
+			uint64 NumBytes = 0; // Records that follow
+		};
+
+		// The records keep the alignment they had in the capture buffer
+		static_assert(sizeof(FFileHeader) % 16 == 0);
+
+		static std::atomic<uint64> NextInstanceId = 1;
+
+		// Written by the capturing threads
+		static std::atomic<uint64> WriteOffset        = 0;
+		static std::atomic<int32>  NumWritersInFlight = 0;
+		static std::atomic<int32>  NumDroppedBlocks   = 0;
+
+		// Game thread, fixed while capturing
+		static TArray<uint8, TAlignedHeapAllocator<16>> Buffer;
+		static uint64 EndCycles = 0;
+		static FTSTicker::FDelegateHandle TickerHandle;
+
+		static int32 GetParamsOffset()
+		{
+			return Align(static_cast<int32>(sizeof(FBlockCaptureHeader)), 16);
+		}
+
+		static int32 GetSamplesOffset(const int32 InParamsBytes)
+		{
+			return GetParamsOffset() + Align(InParamsBytes, 16);
+		}
+
+		static int32 GetRecordBytes(const int32 InParamsBytes, const int32 InNumSamples)
+		{
+			return GetSamplesOffset(InParamsBytes) + Align(InNumSamples * static_cast<int32>(sizeof(float)), 16);
+		}
+
+		static FBlockCaptureHeader MakeHeader(const EBlockCaptureProcessor InProcessor, const uint64 InInstanceId, const float InSampleRate, const int32 InNumChannels,
+											  const EBlockCaptureFlags InFlags, const int32 InNumSamples, const int32 InParamsBytes)
+		{
+			FBlockCaptureHeader Header;
+			Header.RecordBytes = GetRecordBytes(InParamsBytes, InNumSamples);
+			Header.InstanceId  = InInstanceId;
+			Header.Processor   = InProcessor;
+			Header.Flags       = InFlags;
+			Header.SampleRate  = InSampleRate;
+			Header.NumChannels = InNumChannels;
+			Header.NumSamples  = InNumSamples;
+			Header.ParamsBytes = InParamsBytes;
+
+			return Header;
+		}
+
+		// Bytes of complete records from the start of the buffer, a capture stops at the first one that is missing
+		static uint64 GetNumUsedBytes(const uint8* InData, const uint64 InNumBytes, int32& OutNumRecords)
+		{
+			uint64 Offset = 0;
+			OutNumRecords = 0;
+
+			while (Offset + sizeof(FBlockCaptureHeader) <= InNumBytes)
+			{
+				const FBlockCaptureHeader* Header = reinterpret_cast<const FBlockCaptureHeader*>(InData + Offset);
+
+				if (Header->Magic != FBlockCapture::RecordMagic || Header->RecordBytes == 0 || Offset + Header->RecordBytes > InNumBytes)
+				{
+					break;
+				}
+
+				Offset += Header->RecordBytes;
+				++OutNumRecords;
+			}
+
+			return Offset;
+		}
+	}
+
+	std::atomic<bool> FBlockCapture::bCapturing = false;
+
+	uint64 FBlockCapture::NewInstanceId()
+	{
+		return BlockCapturePrivate::NextInstanceId.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint8* FBlockCapture::BeginRecord(const FBlockCaptureHeader& InHeader, const void* InParams)
+	{
+		using namespace BlockCapturePrivate;
+
+		// Stop waits for the writers that got past this point, so the buffer stays alive until they are done
+		NumWritersInFlight.fetch_add(1);
+
+		if (!bCapturing.load())
+		{
+			NumWritersInFlight.fetch_sub(1);
+			return nullptr;
+		}
+
+		if (FPlatformTime::Cycles64() > EndCycles)
+		{
+			bCapturing.store(false);
+			NumWritersInFlight.fetch_sub(1);
+			return nullptr;
+		}
+
+		const uint64 Offset = WriteOffset.fetch_add(InHeader.RecordBytes, std::memory_order_relaxed);
+
+		if (Offset + InHeader.RecordBytes > static_cast<uint64>(Buffer.Num()))
+		{
+			// Full, the record stays zeroed and ends the capture
+			NumDroppedBlocks.fetch_add(1, std::memory_order_relaxed);
+			bCapturing.store(false);
+			NumWritersInFlight.fetch_sub(1);
+			return nullptr;
+		}
+
+		uint8* Record = Buffer.GetData() + Offset;
+
+		// The magic is written last, by EndRecord
+		FMemory::Memcpy(Record, &InHeader, sizeof(FBlockCaptureHeader));
+		FMemory::Memcpy(Record + GetParamsOffset(), InParams, InHeader.ParamsBytes);
+
+		return Record;
+	}
+
+	void FBlockCapture::EndRecord(uint8* InRecord)
+	{
+		reinterpret_cast<FBlockCaptureHeader*>(InRecord)->Magic = RecordMagic;
+
+		BlockCapturePrivate::NumWritersInFlight.fetch_sub(1);
+	}
+
+	void FBlockCapture::CaptureBlock(const EBlockCaptureProcessor InProcessor, const uint64 InInstanceId, const float InSampleRate, const int32 InNumChannels, const EBlockCaptureFlags InFlags,
+									 const void* InParams, const int32 InParamsBytes, const float* InBuffer, const int32 InNumSamples)
+	{
+		using namespace BlockCapturePrivate;
+
+		const FBlockCaptureHeader Header = MakeHeader(InProcessor, InInstanceId, InSampleRate, InNumChannels, InFlags, InNumSamples, InParamsBytes);
+
+		if (uint8* Record = BeginRecord(Header, InParams))
+		{
+			FMemory::Memcpy(Record + GetSamplesOffset(InParamsBytes), InBuffer, sizeof(float) * InNumSamples);
+			EndRecord(Record);
+		}
+	}
+
+	void FBlockCapture::CapturePlanarBlock(const EBlockCaptureProcessor InProcessor, const uint64 InInstanceId, const float InSampleRate, const EBlockCaptureFlags InFlags,
+										   const void* InParams, const int32 InParamsBytes, const float* const* InBuffers, const int32 InNumChannels, const int32 InNumFrames)
+	{
+		using namespace BlockCapturePrivate;
+
+		const FBlockCaptureHeader Header = MakeHeader(InProcessor, InInstanceId, InSampleRate, InNumChannels, InFlags | EBlockCaptureFlags::Planar, InNumChannels * InNumFrames, InParamsBytes);
+
+		if (uint8* Record = BeginRecord(Header, InParams))
+		{
+			float* Samples = reinterpret_cast<float*>(Record + GetSamplesOffset(InParamsBytes));
+
+			for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+			{
+				FMemory::Memcpy(Samples + Channel * InNumFrames, InBuffers[Channel], sizeof(float) * InNumFrames);
+			}
+
+			EndRecord(Record);
+		}
+	}
+
+	bool FBlockCapture::Start(const float InNumSeconds, const int32 InMaxMegabytes)
+	{
+		using namespace BlockCapturePrivate;
+
+		check(IsInGameThread());
+
+		if (bCapturing.load() || TickerHandle.IsValid())
+		{
+			UE_LOG(LogAudioDSPCollection, Warning, TEXT("Block capture: already capturing"));
+			return false;
+		}
+
+		Buffer.SetNumZeroed(FMath::Clamp(InMaxMegabytes, 1, 1024) * 1024 * 1024);
+
+		WriteOffset.store(0);
+		NumDroppedBlocks.store(0);
+		EndCycles = FPlatformTime::Cycles64() + static_cast<uint64>(FMath::Max(InNumSeconds, 0.001f) / FPlatformTime::GetSecondsPerCycle64());
+
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FBlockCapture::Tick));
+
+		bCapturing.store(true);
+
+		UE_LOG(LogAudioDSPCollection, Display, TEXT("Block capture: started, %.1f s at most in %d MB"), InNumSeconds, Buffer.Num() / (1024 * 1024));
+		return true;
+	}
+
+	void FBlockCapture::Stop()
+	{
+		check(IsInGameThread());
+
+		using namespace BlockCapturePrivate;
+
+		if (TickerHandle.IsValid())
+		{
+			bCapturing.store(false);
+
+			FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			TickerHandle.Reset();
+
+			Finish();
+		}
+	}
+
+	bool FBlockCapture::Tick(float InDeltaTime)
+	{
+		using namespace BlockCapturePrivate;
+
+		// The writers only notice the end when they have a block to capture
+		if (bCapturing.load() && FPlatformTime::Cycles64() > EndCycles)
+		{
+			bCapturing.store(false);
+		}
+
+		if (bCapturing.load())
+		{
+			return true;
+		}
+
+		TickerHandle.Reset();
+
+		Finish();
+		return false;
+	}
+
+	void FBlockCapture::Finish()
+	{
+		using namespace BlockCapturePrivate;
+
+		while (NumWritersInFlight.load() > 0)
+		{
+			FPlatformProcess::Yield();
+		}
+
+		int32 NumRecords = 0;
+		const uint64 NumBytes = GetNumUsedBytes(Buffer.GetData(), Buffer.Num(), NumRecords);
+
+		FFileHeader FileHeader;
+		FileHeader.NumBytes = NumBytes;
+
+		TArray<uint8> FileData;
+		FileData.Reserve(sizeof(FFileHeader) + NumBytes);
+		FileData.Append(reinterpret_cast<const uint8*>(&FileHeader), sizeof(FFileHeader));
+		FileData.Append(Buffer.GetData(), NumBytes);
+
+		Buffer.Empty();
+
+		const FString Path = FPaths::ProfilingDir() / TEXT("DSPCollection") / FString::Printf(TEXT("Capture_%s.dspcap"), *FDateTime::Now().ToString());
+
+		if (FFileHelper::SaveArrayToFile(FileData, *Path))
+		{
+			UE_LOG(LogAudioDSPCollection, Display, TEXT("Block capture: %d blocks (%.1f MB) saved to %s%s"), NumRecords, NumBytes / (1024.0 * 1024.0), *Path,
+				   NumDroppedBlocks.load() > 0 ? TEXT(", the buffer got full") : TEXT(""));
+		}
+		else
+		{
+			UE_LOG(LogAudioDSPCollection, Error, TEXT("Block capture: could not write %s"), *Path);
+		}
+	}
+
+	bool FBlockCapture::LoadFile(const FString& InPath, TArray<uint8>& OutData, TArray<FBlockCaptureRecord>& OutRecords)
+	{
+		using namespace BlockCapturePrivate;
+
+		OutRecords.Reset();
+
+		if (!FFileHelper::LoadFileToArray(OutData, *InPath))
+		{
+			UE_LOG(LogAudioDSPCollection, Error, TEXT("Block capture: could not read %s"), *InPath);
+			return false;
+		}
+
+		const FFileHeader* FileHeader = reinterpret_cast<const FFileHeader*>(OutData.GetData());
+
+		const uint64 NumFileBytes = static_cast<uint64>(OutData.Num());
+
+		if (NumFileBytes < sizeof(FFileHeader) || FileHeader->Magic != FileMagic || FileHeader->Version != FileVersion || FileHeader->NumBytes > NumFileBytes - sizeof(FFileHeader))
+		{
+			UE_LOG(LogAudioDSPCollection, Error, TEXT("Block capture: %s is not a capture of this version"), *InPath);
+			return false;
+		}
+
+		const uint8* Data = OutData.GetData() + sizeof(FFileHeader);
+
+		int32 NumRecords = 0;
+		const uint64 NumBytes = GetNumUsedBytes(Data, FileHeader->NumBytes, NumRecords);
+
+		OutRecords.Reserve(NumRecords);
+
+		for (uint64 Offset = 0; Offset < NumBytes; Offset += reinterpret_cast<const FBlockCaptureHeader*>(Data + Offset)->RecordBytes)
+		{
+			const FBlockCaptureHeader* Header = reinterpret_cast<const FBlockCaptureHeader*>(Data + Offset);
+
+			FBlockCaptureRecord& Record = OutRecords.AddDefaulted_GetRef();
+			Record.Header  = Header;
+			Record.Params  = Data + Offset + GetParamsOffset();
+			Record.Samples = reinterpret_cast<const float*>(Data + Offset + GetSamplesOffset(Header->ParamsBytes));
+		}
+
+		return true;
+	}
+
+	static void RunBlockCaptureStart(const TArray<FString>& Args)
+	{
+		const float NumSeconds   = (Args.Num() > 0) ? FMath::Clamp(FCString::Atof(*Args[0]), 0.1f, 600.0f) : 10.0f;
+		const int32 MaxMegabytes = (Args.Num() > 1) ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 1024)      : 256;
+
+		FBlockCapture::Start(NumSeconds, MaxMegabytes);
+	}
+
+	static FAutoConsoleCommand BlockCaptureStartCommand(
+		TEXT("au.DSPCollection.Capture.Start"),
+		TEXT("Records the input blocks and parameters of every Saturation and Gain instance, then saves them to Saved/Profiling/DSPCollection for au.DSPCollection.Capture.Replay. Args: [NumSeconds=10] [MaxMB=256]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBlockCaptureStart)
+	);
+
+	static FAutoConsoleCommand BlockCaptureStopCommand(
+		TEXT("au.DSPCollection.Capture.Stop"),
+		TEXT("Ends the running block capture now and saves it."),
+		FConsoleCommandDelegate::CreateStatic(&FBlockCapture::Stop)
+	);
+}
@@ -0,0 +1,117 @@
+#include "DSPProcessing/Helpers/DCBlocker.h"
+
+namespace DSPProcessing
+{
+	void FDCBlocker::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		constexpr float DefaultCutoffFrequencyHz = 10.0f;
+
+		SampleRate = InSampleRate;
+
+		// The smoothers are initialized by SetNumChannels, their step rate depends on the channel count
+		NumChannels = 0;
+		SetNumChannels(InNumChannels);
+
+		EnableParamSmoother.SetNewParamValue(bEnabled ? 1.0f : 0.0f);
+
+		if (CutoffFrequency == 0.0f)
+		{
+			CutoffParamSmoother.SetNewParamValue(DefaultCutoffFrequencyHz);
+			UpdateCoefficients(DefaultCutoffFrequencyHz);
+		}
+		else
+		{
+			UpdateCoefficients(CutoffFrequency);
+		}
+	}
+
+	void FDCBlocker::SetNumChannels(const int32 InNumChannels)
+	{
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels == NumChannels)
+		{
+			return;
+		}
+
+		NumChannels = NewNumChannels;
+		NumGroups   = NumChannels / 4;
+
+		// Stepped once per vector
+		constexpr float SmoothingTimeInMs = 21.33f;
+		EnableParamSmoother.Init(SmoothingTimeInMs, AudioUtils::GetVectorRate(SampleRate, NumChannels));
+		CutoffParamSmoother.Init(SmoothingTimeInMs, AudioUtils::GetVectorRate(SampleRate, NumChannels));
+
+		if (NumChannels == 1)
+		{
+			ChannelLayout = EChannelLayout::Mono;
+		}
+		else if (NumChannels == 2)
+		{
+			ChannelLayout = EChannelLayout::Stereo;
+		}
+		else if (NumChannels % 4 == 0)
+		{
+			ChannelLayout = EChannelLayout::MultipleOfFour;
+		}
+		else
+		{
+			ChannelLayout = EChannelLayout::Generic;
+		}
+
+		XPrevStates.SetNumZeroed(NumChannels);
+		YPrevStates.SetNumZeroed(NumChannels);
+
+		Reset();
+	}
+
+	void FDCBlocker::SetEnabled(const bool bInEnabled)
+	{
+		bEnabled = bInEnabled;
+		EnableParamSmoother.SetNewParamValue(bEnabled ? 1.0f : 0.0f);
+	}
+
+	void FDCBlocker::SetCutoffFrequency(const float InCutoffFrequency)
+	{
+		const float Cutoff = FMath::Clamp(InCutoffFrequency, 5.0f, 200.0f);
+		CutoffParamSmoother.SetNewParamValue(Cutoff);
+	}
+
+	void FDCBlocker::Reset()
+	{
+		XPrev = AudioUtils::VZeros;
+		YPrev = AudioUtils::VZeros;
+
+		FMemory::Memzero(XPrevStates.GetData(), sizeof(float) * XPrevStates.Num());
+		FMemory::Memzero(YPrevStates.GetData(), sizeof(float) * YPrevStates.Num());
+
+		GroupIndex   = 0;
+		ChannelIndex = 0;
+		bNeedsReset  = false;
+	}
+
+	SIZE_T FDCBlocker::GetAllocatedSize() const
+	{
+		return XPrevStates.GetAllocatedSize() + YPrevStates.GetAllocatedSize();
+	}
+
+	void FDCBlocker::UpdateCoefficients(const float InCutoffFrequency)
+	{
+		CutoffFrequency = InCutoffFrequency;
+
+		// R = exp(-2 * PI * Fc / Fs) ~= 1 - 2 * PI * Fc / Fs, accurate enough for the low cutoffs a DC blocker uses
+		R = FMath::Clamp(1.0f - UE_TWO_PI * InCutoffFrequency / SampleRate, 0.0f, 1.0f);
+
+		const float R2 = R * R;
+		const float R3 = R2 * R;
+		const float R4 = R3 * R;
+
+		VR           = VectorSetFloat1(R);
+		VRPowsMono   = MakeVectorRegisterFloat(R,    R2,   R3,   R4);
+		VRPowsStereo = MakeVectorRegisterFloat(R,    R,    R2,   R2);
+		VCol0        = MakeVectorRegisterFloat(1.0f, R,    R2,   R3);
+		VCol1        = MakeVectorRegisterFloat(0.0f, 1.0f, R,    R2);
+		VCol2        = MakeVectorRegisterFloat(0.0f, 0.0f, 1.0f, R);
+		VCol3        = MakeVectorRegisterFloat(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
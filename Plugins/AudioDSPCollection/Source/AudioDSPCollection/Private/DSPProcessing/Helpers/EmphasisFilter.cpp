@@ -0,0 +1,281 @@
+#include "DSPProcessing/Helpers/EmphasisFilter.h"
+
+namespace DSPProcessing
+{
+	namespace EmphasisFilterUtils
+	{
+		constexpr float SmoothingTimeInMs = 21.33f;
+
+		// Scalar TDF-II over InNumSteps samples from the given state, used to build the block-parallel columns
+		static void Simulate(const FBiquadCoefficients& Coefs, const float* InX, const int32 InNumSteps, float Z1, float Z2, float* OutY, float& OutZ1, float& OutZ2)
+		{
+			for (int32 Step = 0; Step < InNumSteps; ++Step)
+			{
+				const float Y = Coefs.B0 * InX[Step] + Z1;
+				Z1            = Coefs.B1 * InX[Step] - Coefs.A1 * Y + Z2;
+				Z2            = Coefs.B2 * InX[Step] - Coefs.A2 * Y;
+				OutY[Step]    = Y;
+			}
+
+			OutZ1 = Z1;
+			OutZ2 = Z2;
+		}
+	}
+
+	void FEmphasisFilter::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		SampleRate = InSampleRate;
+
+		// The coefficients depend on the sample rate, jump to the new ones
+		for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+		{
+			TargetCoefficients[BandIndex]  = MakeCoefficients(Bands[BandIndex]);
+			CurrentCoefficients[BandIndex] = TargetCoefficients[BandIndex];
+			StartCoefficients[BandIndex]   = TargetCoefficients[BandIndex];
+			bBandActive[BandIndex]         = !TargetCoefficients[BandIndex].IsIdentity();
+		}
+
+		RampAlpha = 1.0f;
+		bRamping  = false;
+
+		NumChannels = 0;
+		SetNumChannels(InNumChannels);
+	}
+
+	void FEmphasisFilter::SetNumChannels(const int32 InNumChannels)
+	{
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels == NumChannels)
+		{
+			return;
+		}
+
+		NumChannels = NewNumChannels;
+		NumGroups   = NumChannels / 4;
+
+		if (NumChannels == 1)
+		{
+			ChannelLayout = EChannelLayout::Mono;
+		}
+		else if (NumChannels == 2)
+		{
+			ChannelLayout = EChannelLayout::Stereo;
+		}
+		else if (NumChannels % 4 == 0)
+		{
+			ChannelLayout = EChannelLayout::MultipleOfFour;
+		}
+		else
+		{
+			ChannelLayout = EChannelLayout::Generic;
+		}
+
+		const float RampFrames = FMath::Max(EmphasisFilterUtils::SmoothingTimeInMs * 0.001f * SampleRate, 1.0f);
+		RampIncrement = 4.0f / (NumChannels * RampFrames);
+
+		GroupStates.SetNum(ChannelLayout == EChannelLayout::MultipleOfFour ? MaxNumBands * NumGroups : 0);
+		ChannelStates.SetNumZeroed(ChannelLayout == EChannelLayout::Generic ? MaxNumBands * NumChannels * 2 : 0);
+
+		for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+		{
+			UpdateBandCoefficients(BandIndex);
+		}
+
+		Reset();
+	}
+
+	void FEmphasisFilter::SetBand(const int32 InBandIndex, const FEmphasisBand& InBand)
+	{
+		if (InBandIndex < 0 || InBandIndex >= MaxNumBands || Bands[InBandIndex] == InBand)
+		{
+			return;
+		}
+
+		Bands[InBandIndex] = InBand;
+
+		const FBiquadCoefficients NewTarget = MakeCoefficients(InBand);
+
+		if (!bBandActive[InBandIndex])
+		{
+			if (NewTarget.IsIdentity())
+			{
+				TargetCoefficients[InBandIndex] = NewTarget;
+				return;
+			}
+
+			// Starts from silence and from the identity, so it fades in
+			ResetBand(InBandIndex);
+			bBandActive[InBandIndex] = true;
+		}
+
+		// A change in the middle of a ramp restarts it from where the coefficients are now
+		for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+		{
+			StartCoefficients[BandIndex] = CurrentCoefficients[BandIndex];
+		}
+
+		TargetCoefficients[InBandIndex] = NewTarget;
+
+		RampAlpha = 0.0f;
+		bRamping  = true;
+	}
+
+	void FEmphasisFilter::Reset()
+	{
+		for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+		{
+			ResetBand(BandIndex);
+		}
+
+		GroupIndex   = 0;
+		ChannelIndex = 0;
+		bNeedsReset  = false;
+	}
+
+	SIZE_T FEmphasisFilter::GetAllocatedSize() const
+	{
+		return GroupStates.GetAllocatedSize() + ChannelStates.GetAllocatedSize();
+	}
+
+	FBiquadCoefficients FEmphasisFilter::MakeCoefficients(const FEmphasisBand& InBand) const
+	{
+		const float Frequency = FMath::Clamp(InBand.Frequency, 10.0f, 0.45f * SampleRate);
+		const float Q         = FMath::Clamp(InBand.Q, 0.1f, 20.0f);
+		const float GainDb    = FMath::Clamp(InBand.GainDb, -36.0f, 36.0f);
+
+		switch (InBand.Type)
+		{
+			default:
+			case EEmphasisFilterType::Off:
+				return FBiquadCoefficients::MakeIdentity();
+			case EEmphasisFilterType::LowCut:
+				return FBiquadCoefficients::MakeHighPass(Frequency, Q, SampleRate);
+			case EEmphasisFilterType::HighCut:
+				return FBiquadCoefficients::MakeLowPass(Frequency, Q, SampleRate);
+			case EEmphasisFilterType::LowShelf:
+				return FBiquadCoefficients::MakeLowShelf(Frequency, Q, GainDb, SampleRate);
+			case EEmphasisFilterType::HighShelf:
+				return FBiquadCoefficients::MakeHighShelf(Frequency, Q, GainDb, SampleRate);
+			case EEmphasisFilterType::Peak:
+				return FBiquadCoefficients::MakePeak(Frequency, Q, GainDb, SampleRate);
+		}
+	}
+
+	void FEmphasisFilter::UpdateBandCoefficients(const int32 InBandIndex)
+	{
+		const FBiquadCoefficients& Coefs = CurrentCoefficients[InBandIndex];
+		FBandCoefficients& BandCoefs     = BandCoefficients[InBandIndex];
+
+		switch (ChannelLayout)
+		{
+			default:
+			case EChannelLayout::Mono:
+			{
+				// Response of the 4 outputs and of the final state to a unit x0..x3, Z1 and Z2
+				float Y[6][4];
+				float Z[6][2];
+
+				for (int32 Unit = 0; Unit < 6; ++Unit)
+				{
+					float X[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+					if (Unit < 4)
+					{
+						X[Unit] = 1.0f;
+					}
+
+					EmphasisFilterUtils::Simulate(Coefs, X, 4, Unit == 4 ? 1.0f : 0.0f, Unit == 5 ? 1.0f : 0.0f, Y[Unit], Z[Unit][0], Z[Unit][1]);
+				}
+
+				for (int32 k = 0; k < 4; ++k)
+				{
+					BandCoefs.OutX[k]   = MakeVectorRegisterFloat(Y[k][0], Y[k][1], Y[k][2], Y[k][3]);
+					BandCoefs.StateX[k] = MakeVectorRegisterFloat(Z[k][0], Z[k][1], 0.0f,    0.0f);
+				}
+
+				BandCoefs.OutZ1   = MakeVectorRegisterFloat(Y[4][0], Y[4][1], Y[4][2], Y[4][3]);
+				BandCoefs.OutZ2   = MakeVectorRegisterFloat(Y[5][0], Y[5][1], Y[5][2], Y[5][3]);
+				BandCoefs.StateZ1 = MakeVectorRegisterFloat(Z[4][0], Z[4][1], 0.0f,    0.0f);
+				BandCoefs.StateZ2 = MakeVectorRegisterFloat(Z[5][0], Z[5][1], 0.0f,    0.0f);
+				break;
+			}
+			case EChannelLayout::Stereo:
+			{
+				// Same with 2 steps per channel: unit x0, x1, Z1 and Z2, every value duplicated for L and R
+				float Y[4][2];
+				float Z[4][2];
+
+				for (int32 Unit = 0; Unit < 4; ++Unit)
+				{
+					float X[2] = { 0.0f, 0.0f };
+					if (Unit < 2)
+					{
+						X[Unit] = 1.0f;
+					}
+
+					EmphasisFilterUtils::Simulate(Coefs, X, 2, Unit == 2 ? 1.0f : 0.0f, Unit == 3 ? 1.0f : 0.0f, Y[Unit], Z[Unit][0], Z[Unit][1]);
+				}
+
+				for (int32 k = 0; k < 2; ++k)
+				{
+					BandCoefs.OutX[k]   = MakeVectorRegisterFloat(Y[k][0], Y[k][0], Y[k][1], Y[k][1]);
+					BandCoefs.StateX[k] = MakeVectorRegisterFloat(Z[k][0], Z[k][0], Z[k][1], Z[k][1]);
+				}
+
+				BandCoefs.OutZ1   = MakeVectorRegisterFloat(Y[2][0], Y[2][0], Y[2][1], Y[2][1]);
+				BandCoefs.OutZ2   = MakeVectorRegisterFloat(Y[3][0], Y[3][0], Y[3][1], Y[3][1]);
+				BandCoefs.StateZ1 = MakeVectorRegisterFloat(Z[2][0], Z[2][0], Z[2][1], Z[2][1]);
+				BandCoefs.StateZ2 = MakeVectorRegisterFloat(Z[3][0], Z[3][0], Z[3][1], Z[3][1]);
+				break;
+			}
+			case EChannelLayout::MultipleOfFour:
+				BandCoefs.Lanes = FVectorBiquadCoefficients::MakeFromLanes(Coefs, Coefs, Coefs, Coefs);
+				break;
+			case EChannelLayout::Generic:
+				// Reads CurrentCoefficients directly
+				break;
+		}
+	}
+
+	void FEmphasisFilter::ResetBand(const int32 InBandIndex)
+	{
+		BandStates[InBandIndex] = AudioUtils::VZeros;
+
+		for (int32 Group = 0; Group < NumGroups && GroupStates.Num() > 0; ++Group)
+		{
+			GroupStates[InBandIndex * NumGroups + Group] = FVectorBiquadState();
+		}
+
+		if (ChannelStates.Num() > 0)
+		{
+			FMemory::Memzero(&ChannelStates[InBandIndex * NumChannels * 2], sizeof(float) * NumChannels * 2);
+		}
+	}
+
+	void FEmphasisFilter::AdvanceRamp()
+	{
+		RampAlpha = FMath::Min(RampAlpha + RampIncrement, 1.0f);
+
+		const bool bRampDone = (RampAlpha == 1.0f);
+
+		for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+		{
+			if (!bBandActive[BandIndex])
+			{
+				continue;
+			}
+
+			CurrentCoefficients[BandIndex] = bRampDone ? TargetCoefficients[BandIndex] : FBiquadCoefficients::Lerp(StartCoefficients[BandIndex], TargetCoefficients[BandIndex], RampAlpha);
+			UpdateBandCoefficients(BandIndex);
+
+			// A band that reached Off is skipped from now on, its state is cleared for the next time it is turned on
+			if (bRampDone && CurrentCoefficients[BandIndex].IsIdentity())
+			{
+				bBandActive[BandIndex] = false;
+				ResetBand(BandIndex);
+			}
+		}
+
+		bRamping = !bRampDone;
+	}
+}
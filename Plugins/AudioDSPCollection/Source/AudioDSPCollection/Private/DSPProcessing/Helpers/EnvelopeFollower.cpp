@@ -0,0 +1,72 @@
+#include "DSPProcessing/Helpers/EnvelopeFollower.h"
+
+namespace DSPProcessing
+{
+	void FEnvelopeFollower::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		SampleRate  = InSampleRate;
+		NumChannels = FMath::Max(InNumChannels, 1);
+
+		UpdateCoefficients();
+		Reset();
+	}
+
+	void FEnvelopeFollower::SetNumChannels(const int32 InNumChannels)
+	{
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels != NumChannels)
+		{
+			NumChannels = NewNumChannels;
+			UpdateCoefficients();
+		}
+	}
+
+	void FEnvelopeFollower::SetDetectorMode(const EEnvelopeDetectorMode InDetectorMode)
+	{
+		if (InDetectorMode == DetectorMode)
+		{
+			return;
+		}
+
+		// Peak and RMS states are not interchangeable
+		DetectorMode = InDetectorMode;
+		Reset();
+	}
+
+	void FEnvelopeFollower::SetAttackTimeMs(const float InAttackTimeMs)
+	{
+		const float NewAttackTimeMs = FMath::Clamp(InAttackTimeMs, 0.1f, 500.0f);
+
+		if (NewAttackTimeMs != AttackTimeMs)
+		{
+			AttackTimeMs = NewAttackTimeMs;
+			UpdateCoefficients();
+		}
+	}
+
+	void FEnvelopeFollower::SetReleaseTimeMs(const float InReleaseTimeMs)
+	{
+		const float NewReleaseTimeMs = FMath::Clamp(InReleaseTimeMs, 1.0f, 5000.0f);
+
+		if (NewReleaseTimeMs != ReleaseTimeMs)
+		{
+			ReleaseTimeMs = NewReleaseTimeMs;
+			UpdateCoefficients();
+		}
+	}
+
+	void FEnvelopeFollower::Reset()
+	{
+		EnvelopeState = 0.0f;
+	}
+
+	void FEnvelopeFollower::UpdateCoefficients()
+	{
+		// ProcessVector steps every 4 interleaved samples, i.e. NumChannels / 4 times per frame
+		const float StepsPerMs = AudioUtils::GetVectorRate(SampleRate, NumChannels) * 0.001f;
+
+		AttackCoefficient  = FMath::Exp(-1.0f / (AttackTimeMs * StepsPerMs));
+		ReleaseCoefficient = FMath::Exp(-1.0f / (ReleaseTimeMs * StepsPerMs));
+	}
+}
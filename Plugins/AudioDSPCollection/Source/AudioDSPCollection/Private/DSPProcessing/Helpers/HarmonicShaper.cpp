@@ -0,0 +1,132 @@
+#include "DSPProcessing/Helpers/HarmonicShaper.h"
+
+namespace DSPProcessing
+{
+	namespace HarmonicShaperUtils
+	{
+		constexpr float SmoothingTimeInMs = 21.33f;
+	}
+
+	FHarmonicShaper::FHarmonicShaper()
+	{
+		// Fundamental only, the clamped identity
+		for (int32 k = 0; k <= MaxHarmonic; ++k)
+		{
+			Weights[k] = (k == 1) ? 1.0f : 0.0f;
+		}
+
+		UpdateTargetCoefficients();
+		Reset();
+	}
+
+	void FHarmonicShaper::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		SampleRate = InSampleRate;
+
+		SetNumChannels(InNumChannels);
+		Reset();
+	}
+
+	void FHarmonicShaper::SetNumChannels(const int32 InNumChannels)
+	{
+		const float RampFrames = FMath::Max(HarmonicShaperUtils::SmoothingTimeInMs * 0.001f * SampleRate, 1.0f);
+		RampIncrement = 4.0f / (FMath::Max(InNumChannels, 1) * RampFrames);
+	}
+
+	void FHarmonicShaper::SetHarmonicWeight(const int32 InHarmonic, const float InWeight)
+	{
+		const float Weight = FMath::Clamp(InWeight, -1.0f, 1.0f);
+
+		if (InHarmonic < 1 || InHarmonic > MaxHarmonic || Weights[InHarmonic] == Weight)
+		{
+			return;
+		}
+
+		Weights[InHarmonic] = Weight;
+
+		// A change in the middle of a ramp restarts it from where the coefficients are now
+		FMemory::Memcpy(StartCoefficients, CurrentCoefficients, sizeof(CurrentCoefficients));
+
+		UpdateTargetCoefficients();
+
+		Degree    = FMath::Max(Degree, TargetDegree);
+		RampAlpha = 0.0f;
+		bRamping  = true;
+	}
+
+	void FHarmonicShaper::Reset()
+	{
+		FMemory::Memcpy(CurrentCoefficients, TargetCoefficients, sizeof(TargetCoefficients));
+		FMemory::Memcpy(StartCoefficients, TargetCoefficients, sizeof(TargetCoefficients));
+
+		for (int32 k = 0; k <= MaxHarmonic; ++k)
+		{
+			Coefficients[k] = VectorSetFloat1(CurrentCoefficients[k]);
+		}
+
+		Degree    = TargetDegree;
+		RampAlpha = 1.0f;
+		bRamping  = false;
+	}
+
+	void FHarmonicShaper::UpdateTargetCoefficients()
+	{
+		// Power basis coefficients of T_0..T_MaxHarmonic, from T_k+1(x) = 2x * T_k(x) - T_k-1(x)
+		float Chebyshev[MaxHarmonic + 1][MaxHarmonic + 1] = {};
+		Chebyshev[0][0] = 1.0f;
+		Chebyshev[1][1] = 1.0f;
+
+		for (int32 k = 1; k < MaxHarmonic; ++k)
+		{
+			for (int32 j = 0; j <= k + 1; ++j)
+			{
+				Chebyshev[k + 1][j] = ((j > 0) ? 2.0f * Chebyshev[k][j - 1] : 0.0f) - Chebyshev[k - 1][j];
+			}
+		}
+
+		// |T_k| <= 1 on [-1, 1], so the sum of the absolute weights bounds the output
+		float SumOfWeights = 0.0f;
+		for (int32 k = 1; k <= MaxHarmonic; ++k)
+		{
+			SumOfWeights += FMath::Abs(Weights[k]);
+		}
+
+		const float Scale = 1.0f / FMath::Max(SumOfWeights, 1.0f);
+
+		TargetDegree = 0;
+
+		for (int32 j = 0; j <= MaxHarmonic; ++j)
+		{
+			float Coefficient = 0.0f;
+			for (int32 k = FMath::Max(j, 1); k <= MaxHarmonic; ++k)
+			{
+				Coefficient += Weights[k] * Chebyshev[k][j];
+			}
+
+			// The constant term is the output for silence (even harmonics), dropped so the curve goes through 0
+			TargetCoefficients[j] = (j == 0) ? 0.0f : Coefficient * Scale;
+
+			if (TargetCoefficients[j] != 0.0f)
+			{
+				TargetDegree = j;
+			}
+		}
+	}
+
+	void FHarmonicShaper::AdvanceRamp()
+	{
+		RampAlpha = FMath::Min(RampAlpha + RampIncrement, 1.0f);
+
+		for (int32 k = 0; k <= Degree; ++k)
+		{
+			CurrentCoefficients[k] = StartCoefficients[k] + RampAlpha * (TargetCoefficients[k] - StartCoefficients[k]);
+			Coefficients[k]        = VectorSetFloat1(CurrentCoefficients[k]);
+		}
+
+		if (RampAlpha == 1.0f)
+		{
+			Degree   = TargetDegree;
+			bRamping = false;
+		}
+	}
+}
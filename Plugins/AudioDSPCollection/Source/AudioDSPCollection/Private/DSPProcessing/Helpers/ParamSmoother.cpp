@@ -2,59 +2,213 @@
 
 namespace DSPProcessing
 {
-	ParamSmootherLPF::ParamSmootherLPF()
-		: SmoothedValueFuncPtr(&ParamSmootherLPF::DirectResult)
+	namespace ParamSmootherUtils
 	{
-		
+		static constexpr float Epsilon = 1.58489e-05f; // -96dB
+
+		FORCEINLINE float ComputeOnePoleStep(const float InTransitionTimeInMs, const float SampleRate)
+		{
+			const float TransitionTimeInSamples = FMath::Max(InTransitionTimeInMs * SampleRate * 0.001f, 1.0f); // ms to samples
+
+			return 1.0f - FMath::Exp(-UE_TWO_PI / TransitionTimeInSamples);
+		}
+	}
+
+	//------------------------------------------------------------------------------------
+	// ParamSmootherLPF
+	//------------------------------------------------------------------------------------
+	void ParamSmootherLPF::Init(float InTransitionTimeInMs, float SampleRate)
+	{
+		Step = ParamSmootherUtils::ComputeOnePoleStep(InTransitionTimeInMs, SampleRate);
 	}
 
-	ParamSmootherLPF::~ParamSmootherLPF()
+	void ParamSmootherLPF::SetNewParamValue(float InNewParamValue)
 	{
+		const bool AreValuesEqual = FMath::Abs(InNewParamValue - CurrentValue) < ParamSmootherUtils::Epsilon;
 
+		if (AreValuesEqual || FirstTime)
+		{
+			ResetParamValue(InNewParamValue);
+			return;
+		}
+
+		NewParamValue = InNewParamValue;
+		bIsSettled    = false;
 	}
 
-	void ParamSmootherLPF::Init(int32 InTransitionTimeInMs, float SampleRate)
+	void ParamSmootherLPF::ResetParamValue(float InParamValue)
 	{
-		const float TransitionTimeInSamples = InTransitionTimeInMs * SampleRate * 0.001; // ms to samples
+		FirstTime     = false;
+		CurrentValue  = InParamValue;
+		NewParamValue = InParamValue;
+		bIsSettled    = true;
+	}
 
-		Step = 1.0f - FMath::Exp(-UE_TWO_PI / TransitionTimeInSamples);
+	bool ParamSmootherLPF::IsSettled() const
+	{
+		return bIsSettled;
 	}
 
-	void ParamSmootherLPF::SetNewParamValue(float InNewParamValue)
+	float ParamSmootherLPF::GetTargetValue() const
 	{
-		static constexpr float Epsilon = 1.58489e-05f; // -96dB
+		return NewParamValue;
+	}
 
-		const bool AreValuesEqual = FMath::Abs(InNewParamValue - CurrentValue) < Epsilon;
+	float ParamSmootherLPF::GetCurrentValue() const
+	{
+		return CurrentValue;
+	}
 
-		if (AreValuesEqual || FirstTime)
+	float ParamSmootherLPF::SmoothedResult()
+	{
+		CurrentValue += Step * (NewParamValue - CurrentValue);
+
+		// The exponential approach never gets there, snap so the callers see the exact target
+		if (FMath::Abs(NewParamValue - CurrentValue) < ParamSmootherUtils::Epsilon)
 		{
-			FirstTime     = false;
-			CurrentValue  = InNewParamValue;
-			NewParamValue = InNewParamValue;
+			CurrentValue = NewParamValue;
+			bIsSettled   = true;
+		}
+
+		return CurrentValue;
+	}
+
+	//------------------------------------------------------------------------------------
+	// ParamSmootherLinear
+	//------------------------------------------------------------------------------------
+	void ParamSmootherLinear::Init(float InTransitionTimeInMs, float SampleRate)
+	{
+		TransitionTimeInSteps = FMath::Max(FMath::RoundToInt(InTransitionTimeInMs * SampleRate * 0.001f), 1); // ms to samples
+	}
 
-			SmoothedValueFuncPtr = &ParamSmootherLPF::DirectResult;
+	void ParamSmootherLinear::SetNewParamValue(float InNewParamValue)
+	{
+		const bool AreValuesEqual = FMath::Abs(InNewParamValue - CurrentValue) < ParamSmootherUtils::Epsilon;
 
+		if (AreValuesEqual || FirstTime)
+		{
+			ResetParamValue(InNewParamValue);
+			return;
+		}
+
+		if (InNewParamValue == NewParamValue && !IsSettled())
+		{
 			return;
 		}
 
 		NewParamValue        = InNewParamValue;
-		SmoothedValueFuncPtr = &ParamSmootherLPF::SmoothedResult;
+		RemainingSteps       = TransitionTimeInSteps;
+		Delta                = (NewParamValue - CurrentValue) / TransitionTimeInSteps;
+		bIsSettled           = false;
 	}
 
-	float ParamSmootherLPF::GetValue()
+	void ParamSmootherLinear::ResetParamValue(float InParamValue)
 	{
-		return (this->*(SmoothedValueFuncPtr))();
+		FirstTime      = false;
+		CurrentValue   = InParamValue;
+		NewParamValue  = InParamValue;
+		RemainingSteps = 0;
+		bIsSettled     = true;
 	}
 
-	float ParamSmootherLPF::SmoothedResult()
+	bool ParamSmootherLinear::IsSettled() const
 	{
-		CurrentValue += Step * (NewParamValue - CurrentValue);
+		return bIsSettled;
+	}
 
+	float ParamSmootherLinear::GetTargetValue() const
+	{
+		return NewParamValue;
+	}
+
+	float ParamSmootherLinear::GetCurrentValue() const
+	{
 		return CurrentValue;
 	}
 
-	float ParamSmootherLPF::DirectResult()
+	float ParamSmootherLinear::SmoothedResult()
 	{
+		if (--RemainingSteps <= 0)
+		{
+			CurrentValue = NewParamValue;
+			bIsSettled   = true;
+		}
+		else
+		{
+			CurrentValue += Delta;
+		}
+
 		return CurrentValue;
 	}
+
+	//------------------------------------------------------------------------------------
+	// ParamSmootherBlock
+	//------------------------------------------------------------------------------------
+	void ParamSmootherBlock::Init(float InTransitionTimeInMs, float SampleRate)
+	{
+		OneMinusStep = 1.0f - ParamSmootherUtils::ComputeOnePoleStep(InTransitionTimeInMs, SampleRate);
+	}
+
+	void ParamSmootherBlock::SetNewParamValue(float InNewParamValue)
+	{
+		const bool AreValuesEqual = FMath::Abs(InNewParamValue - BlockEndValue) < ParamSmootherUtils::Epsilon;
+
+		if (AreValuesEqual || FirstTime)
+		{
+			ResetParamValue(InNewParamValue);
+			return;
+		}
+
+		NewParamValue = InNewParamValue;
+		bIsSettled    = false;
+	}
+
+	void ParamSmootherBlock::ResetParamValue(float InParamValue)
+	{
+		FirstTime     = false;
+		CurrentValue  = InParamValue;
+		NewParamValue = InParamValue;
+		BlockEndValue = InParamValue;
+		Delta         = 0.0f;
+		bIsSettled    = true;
+	}
+
+	void ParamSmootherBlock::PrepareBlock(int32 InNumValues, float InStepsPerValue)
+	{
+		// Start exactly where the previous block was meant to end, without the accumulated rounding of GetValue
+		CurrentValue = BlockEndValue;
+
+		if (CurrentValue == NewParamValue || InNumValues <= 0)
+		{
+			Delta      = 0.0f;
+			bIsSettled = (CurrentValue == NewParamValue);
+			return;
+		}
+
+		//BlockEndValue = Target + (Current - Target) * (1 - Step)^(NumValues * StepsPerValue);
+		BlockEndValue = NewParamValue + (CurrentValue - NewParamValue) * FMath::Pow(OneMinusStep, InNumValues * InStepsPerValue);
+
+		if (FMath::Abs(NewParamValue - BlockEndValue) < ParamSmootherUtils::Epsilon)
+		{
+			BlockEndValue = NewParamValue;
+		}
+
+		Delta      = (BlockEndValue - CurrentValue) / InNumValues;
+		bIsSettled = false;
+	}
+
+	bool ParamSmootherBlock::IsSettled() const
+	{
+		return bIsSettled;
+	}
+
+	float ParamSmootherBlock::GetTargetValue() const
+	{
+		return NewParamValue;
+	}
+
+	float ParamSmootherBlock::GetCurrentValue() const
+	{
+		return BlockEndValue;
+	}
 }
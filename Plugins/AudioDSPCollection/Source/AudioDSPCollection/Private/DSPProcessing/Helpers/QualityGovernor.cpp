@@ -0,0 +1,214 @@
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "AudioDSPCollection.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+
+#include <atomic>
+
+static int32 QualityGovernorEnabledCVar = 0;
+FAutoConsoleVariableRef CVarDSPCollectionQualityGovernorEnabled(
+	TEXT("au.DSPCollection.QualityGovernor.Enabled"),
+	QualityGovernorEnabledCVar,
+	TEXT("Lowers the quality of the Saturation effects and nodes when the plugin processing goes over au.DSPCollection.QualityGovernor.BudgetPercent. Off by default, 0 keeps the full quality."),
+	ECVF_Default);
+
+static float QualityGovernorBudgetPercentCVar = 40.0f;
+FAutoConsoleVariableRef CVarDSPCollectionQualityGovernorBudgetPercent(
+	TEXT("au.DSPCollection.QualityGovernor.BudgetPercent"),
+	QualityGovernorBudgetPercentCVar,
+	TEXT("Time the Saturation and Gain processing may take, in percent of real time (of the render block duration). Over it the quality goes down one step per window."),
+	ECVF_Default);
+
+static float QualityGovernorRestorePercentCVar = 25.0f;
+FAutoConsoleVariableRef CVarDSPCollectionQualityGovernorRestorePercent(
+	TEXT("au.DSPCollection.QualityGovernor.RestorePercent"),
+	QualityGovernorRestorePercentCVar,
+	TEXT("Load under which the quality goes back up one step, after au.DSPCollection.QualityGovernor.RestoreWindows windows in a row. Keep it well under the budget so a restored step doesn't go over it again."),
+	ECVF_Default);
+
+static float QualityGovernorWindowMsCVar = 100.0f;
+FAutoConsoleVariableRef CVarDSPCollectionQualityGovernorWindowMs(
+	TEXT("au.DSPCollection.QualityGovernor.WindowMs"),
+	QualityGovernorWindowMsCVar,
+	TEXT("Measurement window of the quality governor (ms), a few render blocks so a single late block doesn't change the quality."),
+	ECVF_Default);
+
+static int32 QualityGovernorRestoreWindowsCVar = 20;
+FAutoConsoleVariableRef CVarDSPCollectionQualityGovernorRestoreWindows(
+	TEXT("au.DSPCollection.QualityGovernor.RestoreWindows"),
+	QualityGovernorRestoreWindowsCVar,
+	TEXT("Windows in a row under au.DSPCollection.QualityGovernor.RestorePercent before the quality goes back up one step."),
+	ECVF_Default);
+
+namespace DSPProcessing
+{
+	namespace QualityGovernorPrivate
+	{
+		static std::atomic<int32>  QualityLevel      = static_cast<int32>(EQualityLevel::Full);
+		static std::atomic<int32>  NumDisableScopes  = 0;
+		static std::atomic<uint64> ProcessingCycles  = 0;
+		static std::atomic<uint64> WindowStartCycles = 0;
+
+		// Only changed by the thread that closes the window, but that thread changes from one window to the next
+		static std::atomic<int32> NumWindowsWithHeadroom = 0;
+		static std::atomic<bool>  bSettling              = false; // The window after a transition still holds blocks processed at the previous level
+
+		static bool IsEnabled()
+		{
+			return QualityGovernorEnabledCVar != 0 && NumDisableScopes.load(std::memory_order_relaxed) == 0;
+		}
+
+		// The transitions happen on the audio render thread (or a pipeline worker), UE_LOG locks and may write to disk so it runs on the game thread
+		static void LogTransition(const int32 InPreviousLevel, const int32 InNewLevel, const float InLoadPercent)
+		{
+			const float BudgetPercent  = QualityGovernorBudgetPercentCVar;
+			const float RestorePercent = QualityGovernorRestorePercentCVar;
+
+			AsyncTask(ENamedThreads::GameThread, [InPreviousLevel, InNewLevel, InLoadPercent, BudgetPercent, RestorePercent]()
+			{
+				UE_LOG(LogAudioDSPCollection, Log, TEXT("Quality governor: %s -> %s (load %.1f%%, budget %.1f%%, restore under %.1f%%)"),
+					FQualityGovernor::GetQualityLevelName(static_cast<EQualityLevel>(InPreviousLevel)), FQualityGovernor::GetQualityLevelName(static_cast<EQualityLevel>(InNewLevel)),
+					InLoadPercent, BudgetPercent, RestorePercent);
+			});
+		}
+
+		static void ResetToFull(const TCHAR* InReason)
+		{
+			const int32 PreviousLevel = QualityLevel.exchange(static_cast<int32>(EQualityLevel::Full));
+
+			NumWindowsWithHeadroom.store(0, std::memory_order_relaxed);
+			bSettling.store(false, std::memory_order_relaxed);
+
+			if (PreviousLevel != static_cast<int32>(EQualityLevel::Full))
+			{
+				// InReason is a literal
+				AsyncTask(ENamedThreads::GameThread, [PreviousLevel, InReason]()
+				{
+					UE_LOG(LogAudioDSPCollection, Log, TEXT("Quality governor: %s -> %s (%s)"),
+						FQualityGovernor::GetQualityLevelName(static_cast<EQualityLevel>(PreviousLevel)), FQualityGovernor::GetQualityLevelName(EQualityLevel::Full), InReason);
+				});
+			}
+		}
+	}
+
+	EQualityLevel FQualityGovernor::GetQualityLevel()
+	{
+		using namespace QualityGovernorPrivate;
+
+		if (!IsEnabled())
+		{
+			return EQualityLevel::Full;
+		}
+
+		return static_cast<EQualityLevel>(QualityLevel.load(std::memory_order_relaxed));
+	}
+
+	const TCHAR* FQualityGovernor::GetQualityLevelName(const EQualityLevel InQualityLevel)
+	{
+		switch (InQualityLevel)
+		{
+			default:
+			case EQualityLevel::Full:                return TEXT("Full");
+			case EQualityLevel::ReducedOversampling: return TEXT("ReducedOversampling");
+			case EQualityLevel::ReducedPrecision:    return TEXT("ReducedPrecision");
+			case EQualityLevel::Memoryless:          return TEXT("Memoryless");
+		}
+	}
+
+	FQualityGovernor::FScopedDisable::FScopedDisable()
+	{
+		using namespace QualityGovernorPrivate;
+
+		if (NumDisableScopes.fetch_add(1) == 0)
+		{
+			ResetToFull(TEXT("disabled"));
+		}
+	}
+
+	FQualityGovernor::FScopedDisable::~FScopedDisable()
+	{
+		using namespace QualityGovernorPrivate;
+
+		if (NumDisableScopes.fetch_sub(1) == 1)
+		{
+			// The time measured before the scope doesn't belong to the next window
+			ProcessingCycles.store(0);
+			WindowStartCycles.store(FPlatformTime::Cycles64());
+		}
+	}
+
+	void FQualityGovernor::AddProcessingCycles(const uint64 InStartCycles, const uint64 InEndCycles)
+	{
+		using namespace QualityGovernorPrivate;
+
+		if (!IsEnabled())
+		{
+			if (QualityGovernorEnabledCVar == 0 && QualityLevel.load(std::memory_order_relaxed) != static_cast<int32>(EQualityLevel::Full))
+			{
+				ResetToFull(TEXT("disabled"));
+			}
+			return;
+		}
+
+		ProcessingCycles.fetch_add(InEndCycles - InStartCycles, std::memory_order_relaxed);
+
+		const uint64 WindowCycles = static_cast<uint64>(FMath::Max(QualityGovernorWindowMsCVar, 1.0f) * 0.001 / FPlatformTime::GetSecondsPerCycle64());
+
+		uint64 WindowStart = WindowStartCycles.load(std::memory_order_relaxed);
+
+		if (InEndCycles < WindowStart + WindowCycles)
+		{
+			return;
+		}
+
+		// One thread closes the window, the others keep adding to the next one
+		if (!WindowStartCycles.compare_exchange_strong(WindowStart, InEndCycles))
+		{
+			return;
+		}
+
+		CloseWindow(InEndCycles - WindowStart, ProcessingCycles.exchange(0));
+	}
+
+	void FQualityGovernor::CloseWindow(const uint64 InWindowCycles, const uint64 InProcessingCycles)
+	{
+		using namespace QualityGovernorPrivate;
+
+		const float LoadPercent = 100.0f * static_cast<float>(static_cast<double>(InProcessingCycles) / static_cast<double>(InWindowCycles));
+		const int32 Level       = QualityLevel.load();
+
+		if (bSettling.exchange(false))
+		{
+			return;
+		}
+
+		int32 NewLevel = Level;
+
+		if (LoadPercent > QualityGovernorBudgetPercentCVar)
+		{
+			NumWindowsWithHeadroom.store(0);
+			NewLevel = FMath::Min(Level + 1, static_cast<int32>(EQualityLevel::Count) - 1);
+		}
+		else if (LoadPercent < QualityGovernorRestorePercentCVar)
+		{
+			if (Level > static_cast<int32>(EQualityLevel::Full) && NumWindowsWithHeadroom.fetch_add(1) + 1 >= QualityGovernorRestoreWindowsCVar)
+			{
+				NumWindowsWithHeadroom.store(0);
+				NewLevel = Level - 1;
+			}
+		}
+		else
+		{
+			NumWindowsWithHeadroom.store(0);
+		}
+
+		// Staying over budget at the lowest quality isn't logged, it would be every window
+		if (NewLevel != Level)
+		{
+			QualityLevel.store(NewLevel);
+			bSettling.store(true);
+
+			LogTransition(Level, NewLevel, LoadPercent);
+		}
+	}
+}
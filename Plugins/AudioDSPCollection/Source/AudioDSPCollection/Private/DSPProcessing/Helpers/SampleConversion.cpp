@@ -0,0 +1,143 @@
+#include "DSPProcessing/Helpers/SampleConversion.h"
+
+namespace DSPProcessing
+{
+	namespace SampleConversion
+	{
+		constexpr float Pcm16ToFloatScale = 1.0f / 32768.0f;
+		constexpr float FloatToPcm16Scale = 32767.0f;
+		constexpr float Pcm24ToFloatScale = 1.0f / 8388608.0f;
+		constexpr float FloatToPcm24Scale = 8388607.0f;
+
+		constexpr VectorRegister4Float VPcm16ToFloatScale = MakeVectorRegisterFloatConstant(Pcm16ToFloatScale, Pcm16ToFloatScale, Pcm16ToFloatScale, Pcm16ToFloatScale);
+		constexpr VectorRegister4Float VFloatToPcm16Scale = MakeVectorRegisterFloatConstant(FloatToPcm16Scale, FloatToPcm16Scale, FloatToPcm16Scale, FloatToPcm16Scale);
+		constexpr VectorRegister4Float VPcm24ToFloatScale = MakeVectorRegisterFloatConstant(Pcm24ToFloatScale, Pcm24ToFloatScale, Pcm24ToFloatScale, Pcm24ToFloatScale);
+		constexpr VectorRegister4Float VFloatToPcm24Scale = MakeVectorRegisterFloatConstant(FloatToPcm24Scale, FloatToPcm24Scale, FloatToPcm24Scale, FloatToPcm24Scale);
+		constexpr VectorRegister4Float VMinusOneHalf      = MakeVectorRegisterFloatConstant(-0.5f, -0.5f, -0.5f, -0.5f);
+
+		const VectorRegister4Int VLow16BitsMask = MakeVectorRegisterInt(0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF);
+
+		FORCEINLINE int32 ScalarFloatToPcm(const float In, const float Scale)
+		{
+			const float Scaled = FMath::Clamp(In, -1.0f, 1.0f) * Scale;
+			return static_cast<int32>(Scaled + (Scaled < 0.0f ? -0.5f : 0.5f));
+		}
+
+		FORCEINLINE VectorRegister4Int VectorFloatToPcm(const VectorRegister4Float& In, const VectorRegister4Float& Scale)
+		{
+			//Out = (int32)(Clamp(In, -1, 1) * Scale +/- 0.5), rounds half away from zero
+			const VectorRegister4Float Scaled   = VectorMultiply(AudioUtils::VectorClampMinusOneToOne(In), Scale);
+			const VectorRegister4Float Rounding = VectorSelect(VectorCompareLT(Scaled, AudioUtils::VZeros), VMinusOneHalf, AudioUtils::VOneHalf);
+
+			return VectorFloatToInt(VectorAdd(Scaled, Rounding));
+		}
+
+		void Pcm16ToFloat(const int16* InBuffer, float* OutBuffer, const int32 InNumSamples)
+		{
+			const int32 NumVectorizedSamples = InNumSamples & ~7;
+
+			// 8 samples per iteration: the 8 int16 are loaded as 4 int32 lanes [s0|s1, s2|s3, s4|s5, s6|s7] and sign extended in place
+			for (int32 i = 0; i < NumVectorizedSamples; i += 8)
+			{
+				const VectorRegister4Int Packed = VectorIntLoad(InBuffer + i);
+				const VectorRegister4Int Even   = VectorShiftRightImmArithmetic(VectorShiftLeftImm(Packed, 16), 16); // [s0, s2, s4, s6]
+				const VectorRegister4Int Odd    = VectorShiftRightImmArithmetic(Packed, 16);                         // [s1, s3, s5, s7]
+
+				const VectorRegister4Float EvenFloat = VectorMultiply(VectorIntToFloat(Even), VPcm16ToFloatScale);
+				const VectorRegister4Float OddFloat  = VectorMultiply(VectorIntToFloat(Odd),  VPcm16ToFloatScale);
+
+				// [e0, e1, o0, o1] -> [s0, s1, s2, s3]
+				VectorStore(VectorSwizzle(VectorShuffle(EvenFloat, OddFloat, 0, 1, 0, 1), 0, 2, 1, 3), OutBuffer + i);
+				VectorStore(VectorSwizzle(VectorShuffle(EvenFloat, OddFloat, 2, 3, 2, 3), 0, 2, 1, 3), OutBuffer + i + 4);
+			}
+
+			for (int32 i = NumVectorizedSamples; i < InNumSamples; ++i)
+			{
+				OutBuffer[i] = InBuffer[i] * Pcm16ToFloatScale;
+			}
+		}
+
+		void FloatToPcm16(const float* InBuffer, int16* OutBuffer, const int32 InNumSamples)
+		{
+			const int32 NumVectorizedSamples = InNumSamples & ~7;
+
+			// 8 samples per iteration, even and odd samples are packed back into the low and high halves of 4 int32 lanes
+			for (int32 i = 0; i < NumVectorizedSamples; i += 8)
+			{
+				const VectorRegister4Float In0 = VectorLoad(InBuffer + i);
+				const VectorRegister4Float In1 = VectorLoad(InBuffer + i + 4);
+
+				const VectorRegister4Int Even = VectorFloatToPcm(VectorShuffle(In0, In1, 0, 2, 0, 2), VFloatToPcm16Scale);
+				const VectorRegister4Int Odd  = VectorFloatToPcm(VectorShuffle(In0, In1, 1, 3, 1, 3), VFloatToPcm16Scale);
+
+				const VectorRegister4Int Packed = VectorIntOr(VectorIntAnd(Even, VLow16BitsMask), VectorShiftLeftImm(Odd, 16));
+
+				VectorIntStore(Packed, OutBuffer + i);
+			}
+
+			for (int32 i = NumVectorizedSamples; i < InNumSamples; ++i)
+			{
+				OutBuffer[i] = static_cast<int16>(ScalarFloatToPcm(InBuffer[i], FloatToPcm16Scale));
+			}
+		}
+
+		void Pcm24ToFloat(const uint8* InBuffer, float* OutBuffer, const int32 InNumSamples)
+		{
+			const int32 NumVectorizedSamples = InNumSamples & ~3;
+
+			// The 3 byte samples are gathered in the top of 4 int32 lanes, then shifted down with sign extension
+			for (int32 i = 0; i < NumVectorizedSamples; i += 4)
+			{
+				const uint8* In = InBuffer + i * 3;
+
+				const VectorRegister4Int Gathered = MakeVectorRegisterInt((In[0] << 8) | (In[1]  << 16) | (In[2]  << 24),
+																		  (In[3] << 8) | (In[4]  << 16) | (In[5]  << 24),
+																		  (In[6] << 8) | (In[7]  << 16) | (In[8]  << 24),
+																		  (In[9] << 8) | (In[10] << 16) | (In[11] << 24));
+
+				const VectorRegister4Int Samples = VectorShiftRightImmArithmetic(Gathered, 8);
+
+				VectorStore(VectorMultiply(VectorIntToFloat(Samples), VPcm24ToFloatScale), OutBuffer + i);
+			}
+
+			for (int32 i = NumVectorizedSamples; i < InNumSamples; ++i)
+			{
+				const uint8* In = InBuffer + i * 3;
+				const int32 Sample = static_cast<int32>((In[0] << 8) | (In[1] << 16) | (In[2] << 24)) >> 8;
+
+				OutBuffer[i] = Sample * Pcm24ToFloatScale;
+			}
+		}
+
+		void FloatToPcm24(const float* InBuffer, uint8* OutBuffer, const int32 InNumSamples)
+		{
+			const int32 NumVectorizedSamples = InNumSamples & ~3;
+
+			alignas(16) int32 Samples[4];
+
+			for (int32 i = 0; i < NumVectorizedSamples; i += 4)
+			{
+				VectorIntStoreAligned(VectorFloatToPcm(VectorLoad(InBuffer + i), VFloatToPcm24Scale), Samples);
+
+				uint8* Out = OutBuffer + i * 3;
+
+				for (int32 j = 0; j < 4; ++j)
+				{
+					Out[j * 3]     = static_cast<uint8>(Samples[j]);
+					Out[j * 3 + 1] = static_cast<uint8>(Samples[j] >> 8);
+					Out[j * 3 + 2] = static_cast<uint8>(Samples[j] >> 16);
+				}
+			}
+
+			for (int32 i = NumVectorizedSamples; i < InNumSamples; ++i)
+			{
+				const int32 Sample = ScalarFloatToPcm(InBuffer[i], FloatToPcm24Scale);
+
+				uint8* Out = OutBuffer + i * 3;
+				Out[0] = static_cast<uint8>(Sample);
+				Out[1] = static_cast<uint8>(Sample >> 8);
+				Out[2] = static_cast<uint8>(Sample >> 16);
+			}
+		}
+	}
+}
@@ -0,0 +1,260 @@
+#include "DSPProcessing/Helpers/TapeHysteresis.h"
+
+namespace DSPProcessing
+{
+	namespace TapeHysteresisUtils
+	{
+		// Normalized model (Ms = 1), the input gain of the saturation stage plays the role of the tape drive
+		constexpr float A         = 0.25f;     // Anhysteretic shape
+		constexpr float Alpha     = 1.6e-3f;   // Inter-domain coupling
+		constexpr float K         = 0.47875f;  // Coercivity, width of the loop
+		constexpr float C         = 0.2f;      // Reversible magnetization ratio
+		constexpr float OneMinusC = 1.0f - C;
+
+		constexpr VectorRegister4Float VAlpha            = MakeVectorRegisterFloatConstant(Alpha, Alpha, Alpha, Alpha);
+		constexpr VectorRegister4Float VOneOverA         = MakeVectorRegisterFloatConstant(1.0f / A, 1.0f / A, 1.0f / A, 1.0f / A);
+		constexpr VectorRegister4Float VOneMinusC_x_K    = MakeVectorRegisterFloatConstant(OneMinusC * K, OneMinusC * K, OneMinusC * K, OneMinusC * K);
+		constexpr VectorRegister4Float VOneMinusC        = MakeVectorRegisterFloatConstant(OneMinusC, OneMinusC, OneMinusC, OneMinusC);
+		constexpr VectorRegister4Float VC_Over_A         = MakeVectorRegisterFloatConstant(C / A, C / A, C / A, C / A);
+		constexpr VectorRegister4Float VC_x_Alpha_Over_A = MakeVectorRegisterFloatConstant(C * Alpha / A, C * Alpha / A, C * Alpha / A, C * Alpha / A);
+		constexpr VectorRegister4Float VMinusTwos        = MakeVectorRegisterFloatConstant(-2.0f, -2.0f, -2.0f, -2.0f);
+		constexpr VectorRegister4Float VOneThird         = MakeVectorRegisterFloatConstant(1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f);
+		constexpr VectorRegister4Float VOneOver15        = MakeVectorRegisterFloatConstant(1.0f / 15.0f, 1.0f / 15.0f, 1.0f / 15.0f, 1.0f / 15.0f);
+		constexpr VectorRegister4Float VOneOver45        = MakeVectorRegisterFloatConstant(1.0f / 45.0f, 1.0f / 45.0f, 1.0f / 45.0f, 1.0f / 45.0f);
+		constexpr VectorRegister4Float VOneSixth         = MakeVectorRegisterFloatConstant(1.0f / 6.0f, 1.0f / 6.0f, 1.0f / 6.0f, 1.0f / 6.0f);
+		constexpr VectorRegister4Float VSmallQ           = MakeVectorRegisterFloatConstant(1.e-2f, 1.e-2f, 1.e-2f, 1.e-2f);
+
+		// dM/dt of the Jiles-Atherton model
+		FORCEINLINE VectorRegister4Float VectorHysteresisDerivative(const VectorRegister4Float& M, const VectorRegister4Float& H, const VectorRegister4Float& Hd)
+		{
+			//const float Q = (H + Alpha * M) / A;
+			const VectorRegister4Float Q = VectorMultiply(VectorMultiplyAdd(VAlpha, M, H), VOneOverA);
+
+			// Langevin function L(Q) = coth(Q) - 1/Q and its derivative, with their Taylor series around 0 to avoid the cancellation
+			const VectorRegister4Float IsSmallQ = VectorCompareLT(VectorAbs(Q), VSmallQ);
+			const VectorRegister4Float SafeQ    = VectorSelect(IsSmallQ, AudioUtils::VOnes, Q);
+
+			//const float Coth = Sign(Q) * (1.0f + FMath::Exp(-2.0f * |Q|)) / (1.0f - FMath::Exp(-2.0f * |Q|));
+			const VectorRegister4Float Exp_Minus_Two_Abs_Q = VectorExp(VectorMultiply(VMinusTwos, VectorAbs(SafeQ)));
+			VectorRegister4Float Coth = VectorDivide(VectorAdd(AudioUtils::VOnes, Exp_Minus_Two_Abs_Q), VectorSubtract(AudioUtils::VOnes, Exp_Minus_Two_Abs_Q));
+			Coth = VectorSelect(VectorCompareLT(SafeQ, AudioUtils::VZeros), VectorNegate(Coth), Coth);
+
+			const VectorRegister4Float OneOverQ = VectorDivide(AudioUtils::VOnes, SafeQ);
+			const VectorRegister4Float Q_Sqr    = VectorMultiply(Q, Q);
+
+			//const float Langevin = IsSmallQ ? Q / 3 - Q^3 / 45 : Coth - 1 / Q;
+			const VectorRegister4Float SmallLangevin = VectorMultiply(Q, VectorNegateMultiplyAdd(Q_Sqr, VOneOver45, VOneThird));
+			const VectorRegister4Float Langevin      = VectorSelect(IsSmallQ, SmallLangevin, VectorSubtract(Coth, OneOverQ));
+
+			//const float LangevinDerivative = IsSmallQ ? 1 / 3 - Q^2 / 15 : 1 - Coth^2 + 1 / Q^2;
+			const VectorRegister4Float SmallLangevinDerivative = VectorNegateMultiplyAdd(Q_Sqr, VOneOver15, VOneThird);
+			const VectorRegister4Float LangevinDerivative      = VectorSelect(IsSmallQ, SmallLangevinDerivative, VectorMultiplyAdd(OneOverQ, OneOverQ, VectorNegateMultiplyAdd(Coth, Coth, AudioUtils::VOnes)));
+
+			//const float M_Diff = M_Anhysteretic - M;
+			const VectorRegister4Float M_Diff = VectorSubtract(Langevin, M);
+
+			//const float Delta = (Hd >= 0.0f) ? 1.0f : -1.0f;
+			const VectorRegister4Float Delta = VectorSelect(VectorCompareGE(Hd, AudioUtils::VZeros), AudioUtils::VOnes, AudioUtils::VMinusOnes);
+
+			//const float Irreversible = (Delta * M_Diff > 0.0f) ? (1 - C) * M_Diff / ((1 - C) * Delta * K - Alpha * M_Diff) : 0.0f;
+			const VectorRegister4Float Denominator  = VectorNegateMultiplyAdd(VAlpha, M_Diff, VectorMultiply(VOneMinusC_x_K, Delta));
+			const VectorRegister4Float Irreversible = VectorSelect(VectorCompareGT(VectorMultiply(Delta, M_Diff), AudioUtils::VZeros),
+																   VectorDivide(VectorMultiply(VOneMinusC, M_Diff), Denominator),
+																   AudioUtils::VZeros);
+
+			//const float Reversible = C / A * LangevinDerivative;
+			const VectorRegister4Float Reversible = VectorMultiply(VC_Over_A, LangevinDerivative);
+
+			//return Hd * (Irreversible + Reversible) / (1 - C * Alpha / A * LangevinDerivative);
+			const VectorRegister4Float Normalization = VectorNegateMultiplyAdd(VC_x_Alpha_Over_A, LangevinDerivative, AudioUtils::VOnes);
+
+			return VectorDivide(VectorMultiply(Hd, VectorAdd(Irreversible, Reversible)), Normalization);
+		}
+	}
+
+	void FTapeHysteresis::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		SampleRate = InSampleRate;
+
+		UpdateTimeStep();
+
+		NumChannels = 0;
+		SetNumChannels(InNumChannels);
+	}
+
+	void FTapeHysteresis::SetNumChannels(const int32 InNumChannels)
+	{
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels == NumChannels)
+		{
+			return;
+		}
+
+		NumChannels = NewNumChannels;
+		NumGroups   = FMath::DivideAndRoundUp(NumChannels, 4);
+
+		GroupStates.SetNum(NumGroups);
+
+		Reset();
+	}
+
+	void FTapeHysteresis::SetSolver(const ETapeHysteresisSolver InSolver)
+	{
+		Solver = InSolver;
+	}
+
+	void FTapeHysteresis::SetOversampling(const int32 InOversampling)
+	{
+		const int32 NewOversampling = FMath::Clamp(InOversampling, 1, MaxOversampling);
+
+		if (NewOversampling != Oversampling)
+		{
+			Oversampling = NewOversampling;
+			UpdateTimeStep();
+		}
+	}
+
+	void FTapeHysteresis::Reset()
+	{
+		for (FGroupState& GroupState : GroupStates)
+		{
+			GroupState = FGroupState();
+		}
+	}
+
+	int32 FTapeHysteresis::GetSolverEvaluationsPerFrame() const
+	{
+		const int32 NumStages = (Solver == ETapeHysteresisSolver::RK4) ? 4 : 2;
+
+		return NumStages * Oversampling;
+	}
+
+	SIZE_T FTapeHysteresis::GetAllocatedSize() const
+	{
+		return GroupStates.GetAllocatedSize();
+	}
+
+	void FTapeHysteresis::UpdateTimeStep()
+	{
+		const float OversampledSampleRate = SampleRate * Oversampling;
+		const float TimeStep              = 1.0f / OversampledSampleRate;
+		const float OneOverOversampling   = 1.0f / Oversampling;
+
+		VTimeStep              = VectorLoadFloat1(&TimeStep);
+		VOversampledSampleRate = VectorLoadFloat1(&OversampledSampleRate);
+		VOneOverOversampling   = VectorLoadFloat1(&OneOverOversampling);
+	}
+
+	void FTapeHysteresis::ProcessInterleaved(float* InOutBuffer, const int32 InNumSamples)
+	{
+		if (Solver == ETapeHysteresisSolver::RK4)
+		{
+			ProcessInterleavedWithSolver<ETapeHysteresisSolver::RK4>(InOutBuffer, InNumSamples);
+		}
+		else
+		{
+			ProcessInterleavedWithSolver<ETapeHysteresisSolver::RK2>(InOutBuffer, InNumSamples);
+		}
+	}
+
+	template <ETapeHysteresisSolver SolverT>
+	FORCEINLINE VectorRegister4Float FTapeHysteresis::ProcessGroup(const VectorRegister4Float& InH, FGroupState& State) const
+	{
+		using namespace TapeHysteresisUtils;
+
+		// H is linearly interpolated across the oversampled steps and the output is the average of the oversampled M values
+		const VectorRegister4Float HStart = State.H;
+		const VectorRegister4Float HStep  = VectorMultiply(VectorSubtract(InH, HStart), VOneOverOversampling);
+
+		VectorRegister4Float MSum = AudioUtils::VZeros;
+
+		for (int32 Step = 1; Step <= Oversampling; ++Step)
+		{
+			const float StepFloat = static_cast<float>(Step);
+
+			//const float H  = HStart + HStep * Step;
+			//const float Hd = (H - HPrev) * OversampledSampleRate;
+			const VectorRegister4Float H  = VectorMultiplyAdd(HStep, VectorLoadFloat1(&StepFloat), HStart);
+			const VectorRegister4Float Hd = VectorMultiply(VectorSubtract(H, State.H), VOversampledSampleRate);
+
+			VectorRegister4Float M;
+
+			if constexpr (SolverT == ETapeHysteresisSolver::RK4)
+			{
+				const VectorRegister4Float HMid  = VectorMultiply(VectorAdd(H, State.H), AudioUtils::VOneHalf);
+				const VectorRegister4Float HdMid = VectorMultiply(VectorAdd(Hd, State.Hd), AudioUtils::VOneHalf);
+
+				//k1 = T * f(M, HPrev, HdPrev);
+				//k2 = T * f(M + k1 / 2, HMid, HdMid);
+				//k3 = T * f(M + k2 / 2, HMid, HdMid);
+				//k4 = T * f(M + k3, H, Hd);
+				const VectorRegister4Float K1 = VectorMultiply(VTimeStep, VectorHysteresisDerivative(State.M, State.H, State.Hd));
+				const VectorRegister4Float K2 = VectorMultiply(VTimeStep, VectorHysteresisDerivative(VectorMultiplyAdd(K1, AudioUtils::VOneHalf, State.M), HMid, HdMid));
+				const VectorRegister4Float K3 = VectorMultiply(VTimeStep, VectorHysteresisDerivative(VectorMultiplyAdd(K2, AudioUtils::VOneHalf, State.M), HMid, HdMid));
+				const VectorRegister4Float K4 = VectorMultiply(VTimeStep, VectorHysteresisDerivative(VectorAdd(State.M, K3), H, Hd));
+
+				//M = M + (k1 + 2 * k2 + 2 * k3 + k4) / 6;
+				const VectorRegister4Float KSum = VectorAdd(VectorAdd(K1, K4), VectorMultiply(AudioUtils::VTwos, VectorAdd(K2, K3)));
+				M = VectorMultiplyAdd(KSum, VOneSixth, State.M);
+			}
+			else
+			{
+				//k1 = T * f(M, HPrev, HdPrev);
+				//k2 = T * f(M + k1, H, Hd);
+				const VectorRegister4Float K1 = VectorMultiply(VTimeStep, VectorHysteresisDerivative(State.M, State.H, State.Hd));
+				const VectorRegister4Float K2 = VectorMultiply(VTimeStep, VectorHysteresisDerivative(VectorAdd(State.M, K1), H, Hd));
+
+				//M = M + (k1 + k2) / 2;
+				M = VectorMultiplyAdd(VectorAdd(K1, K2), AudioUtils::VOneHalf, State.M);
+			}
+
+			// |M| can't go above saturation, this also keeps the explicit solver bounded on steep inputs
+			State.M  = AudioUtils::VectorClampMinusOneToOne(M);
+			State.H  = H;
+			State.Hd = Hd;
+
+			MSum = VectorAdd(MSum, State.M);
+		}
+
+		return VectorMultiply(MSum, VOneOverOversampling);
+	}
+
+	template <ETapeHysteresisSolver SolverT>
+	void FTapeHysteresis::ProcessInterleavedWithSolver(float* InOutBuffer, const int32 InNumSamples)
+	{
+		const int32 NumFrames         = InNumSamples / NumChannels;
+		const int32 NumFullGroups     = NumChannels / 4;
+		const int32 NumRemainingLanes = NumChannels - NumFullGroups * 4;
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			float* FramePtr = &InOutBuffer[Frame * NumChannels];
+
+			// 4 contiguous channels per vector
+			for (int32 Group = 0; Group < NumFullGroups; ++Group)
+			{
+				const VectorRegister4Float H = VectorLoad(&FramePtr[Group * 4]);
+				VectorStore(ProcessGroup<SolverT>(H, GroupStates[Group]), &FramePtr[Group * 4]);
+			}
+
+			// Last 1-3 channels (e.g. mono, stereo or the 2 last channels of 5.1), the unused lanes stay at 0
+			if (NumRemainingLanes > 0)
+			{
+				AlignedFloat4 Lanes(AudioUtils::VZeros);
+
+				for (int32 Lane = 0; Lane < NumRemainingLanes; ++Lane)
+				{
+					Lanes[Lane] = FramePtr[NumFullGroups * 4 + Lane];
+				}
+
+				Lanes = AlignedFloat4(ProcessGroup<SolverT>(Lanes.ToVectorRegister(), GroupStates[NumFullGroups]));
+
+				for (int32 Lane = 0; Lane < NumRemainingLanes; ++Lane)
+				{
+					FramePtr[NumFullGroups * 4 + Lane] = Lanes[Lane];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#include "DSPProcessing/Helpers/TransferCurve.h"
+
+namespace DSPProcessing
+{
+	FSharedTransferCurve::FSharedTransferCurve(const TArray<float>& InKnots)
+	{
+		TArray<float> Knots(InKnots);
+
+		if (Knots.Num() < 2)
+		{
+			// Identity
+			Knots = { -1.0f, 1.0f };
+		}
+
+		NumSegments      = Knots.Num() - 1;
+		VHalfNumSegments = VectorSetFloat1(0.5f * NumSegments);
+
+		const float SegmentWidth = 2.0f / NumSegments;
+
+		TArray<float> Slopes;
+		Slopes.SetNumUninitialized(NumSegments);
+
+		for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+		{
+			Slopes[Segment] = (Knots[Segment + 1] - Knots[Segment]) / SegmentWidth;
+		}
+
+		// Fritsch-Butland tangents: the harmonic mean of the neighbouring slopes, 0 at local extrema, which keeps every segment
+		// within its knots. One-sided at both ends
+		TArray<float> Tangents;
+		Tangents.SetNumUninitialized(NumSegments + 1);
+
+		Tangents[0]           = Slopes[0];
+		Tangents[NumSegments] = Slopes[NumSegments - 1];
+
+		for (int32 Knot = 1; Knot < NumSegments; ++Knot)
+		{
+			const float SlopeBefore = Slopes[Knot - 1];
+			const float SlopeAfter  = Slopes[Knot];
+
+			Tangents[Knot] = (SlopeBefore * SlopeAfter > 0.0f) ? 2.0f * SlopeBefore * SlopeAfter / (SlopeBefore + SlopeAfter) : 0.0f;
+		}
+
+		Coefficients.SetNumZeroed((NumSegments + 1) * 4);
+
+		for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+		{
+			// Hermite basis rewritten in powers of t, with the tangents scaled to t in [0, 1)
+			const float Y0    = Knots[Segment];
+			const float Delta = Knots[Segment + 1] - Y0;
+			const float M0    = Tangents[Segment] * SegmentWidth;
+			const float M1    = Tangents[Segment + 1] * SegmentWidth;
+
+			float* Row = &Coefficients[Segment * 4];
+			Row[0] = Y0;
+			Row[1] = M0;
+			Row[2] = 3.0f * Delta - 2.0f * M0 - M1;
+			Row[3] = M0 + M1 - 2.0f * Delta;
+		}
+
+		Coefficients[NumSegments * 4] = Knots[NumSegments];
+	}
+
+	SIZE_T FSharedTransferCurve::GetAllocatedSize() const
+	{
+		return Coefficients.GetAllocatedSize();
+	}
+}
@@ -0,0 +1,132 @@
+#include "DSPProcessing/Helpers/VectorBiquad.h"
+
+namespace DSPProcessing
+{
+	namespace BiquadUtils
+	{
+		struct FBiquadIntermediates
+		{
+			float CosW0;
+			float Alpha;
+		};
+
+		FORCEINLINE FBiquadIntermediates ComputeIntermediates(const float InFrequency, const float InQ, const float InSampleRate)
+		{
+			const float Frequency = FMath::Clamp(InFrequency, 10.0f, 0.49f * InSampleRate);
+			const float W0        = UE_TWO_PI * Frequency / InSampleRate;
+
+			return { FMath::Cos(W0), FMath::Sin(W0) / (2.0f * FMath::Max(InQ, 0.01f)) };
+		}
+
+		FORCEINLINE FBiquadCoefficients Normalize(const float B0, const float B1, const float B2, const float A0, const float A1, const float A2)
+		{
+			const float OneOverA0 = 1.0f / A0;
+
+			FBiquadCoefficients Coefficients;
+			Coefficients.B0 = B0 * OneOverA0;
+			Coefficients.B1 = B1 * OneOverA0;
+			Coefficients.B2 = B2 * OneOverA0;
+			Coefficients.A1 = A1 * OneOverA0;
+			Coefficients.A2 = A2 * OneOverA0;
+
+			return Coefficients;
+		}
+	}
+
+	FBiquadCoefficients FBiquadCoefficients::MakeIdentity()
+	{
+		return FBiquadCoefficients();
+	}
+
+	FBiquadCoefficients FBiquadCoefficients::MakeLowPass(const float InFrequency, const float InQ, const float InSampleRate)
+	{
+		const BiquadUtils::FBiquadIntermediates I = BiquadUtils::ComputeIntermediates(InFrequency, InQ, InSampleRate);
+
+		const float One_Minus_CosW0 = 1.0f - I.CosW0;
+
+		return BiquadUtils::Normalize(0.5f * One_Minus_CosW0, One_Minus_CosW0, 0.5f * One_Minus_CosW0, 1.0f + I.Alpha, -2.0f * I.CosW0, 1.0f - I.Alpha);
+	}
+
+	FBiquadCoefficients FBiquadCoefficients::MakeHighPass(const float InFrequency, const float InQ, const float InSampleRate)
+	{
+		const BiquadUtils::FBiquadIntermediates I = BiquadUtils::ComputeIntermediates(InFrequency, InQ, InSampleRate);
+
+		const float One_Plus_CosW0 = 1.0f + I.CosW0;
+
+		return BiquadUtils::Normalize(0.5f * One_Plus_CosW0, -One_Plus_CosW0, 0.5f * One_Plus_CosW0, 1.0f + I.Alpha, -2.0f * I.CosW0, 1.0f - I.Alpha);
+	}
+
+	FBiquadCoefficients FBiquadCoefficients::MakeAllPass(const float InFrequency, const float InQ, const float InSampleRate)
+	{
+		const BiquadUtils::FBiquadIntermediates I = BiquadUtils::ComputeIntermediates(InFrequency, InQ, InSampleRate);
+
+		return BiquadUtils::Normalize(1.0f - I.Alpha, -2.0f * I.CosW0, 1.0f + I.Alpha, 1.0f + I.Alpha, -2.0f * I.CosW0, 1.0f - I.Alpha);
+	}
+
+	FBiquadCoefficients FBiquadCoefficients::MakeLowShelf(const float InFrequency, const float InQ, const float InGainDb, const float InSampleRate)
+	{
+		const BiquadUtils::FBiquadIntermediates I = BiquadUtils::ComputeIntermediates(InFrequency, InQ, InSampleRate);
+
+		const float A               = FMath::Pow(10.0f, InGainDb / 40.0f);
+		const float Two_SqrtA_Alpha = 2.0f * FMath::Sqrt(A) * I.Alpha;
+		const float A_Plus_One      = A + 1.0f;
+		const float A_Minus_One     = A - 1.0f;
+
+		return BiquadUtils::Normalize(A * (A_Plus_One - A_Minus_One * I.CosW0 + Two_SqrtA_Alpha),
+									  2.0f * A * (A_Minus_One - A_Plus_One * I.CosW0),
+									  A * (A_Plus_One - A_Minus_One * I.CosW0 - Two_SqrtA_Alpha),
+									  A_Plus_One + A_Minus_One * I.CosW0 + Two_SqrtA_Alpha,
+									  -2.0f * (A_Minus_One + A_Plus_One * I.CosW0),
+									  A_Plus_One + A_Minus_One * I.CosW0 - Two_SqrtA_Alpha);
+	}
+
+	FBiquadCoefficients FBiquadCoefficients::MakeHighShelf(const float InFrequency, const float InQ, const float InGainDb, const float InSampleRate)
+	{
+		const BiquadUtils::FBiquadIntermediates I = BiquadUtils::ComputeIntermediates(InFrequency, InQ, InSampleRate);
+
+		const float A               = FMath::Pow(10.0f, InGainDb / 40.0f);
+		const float Two_SqrtA_Alpha = 2.0f * FMath::Sqrt(A) * I.Alpha;
+		const float A_Plus_One      = A + 1.0f;
+		const float A_Minus_One     = A - 1.0f;
+
+		return BiquadUtils::Normalize(A * (A_Plus_One + A_Minus_One * I.CosW0 + Two_SqrtA_Alpha),
+									  -2.0f * A * (A_Minus_One + A_Plus_One * I.CosW0),
+									  A * (A_Plus_One + A_Minus_One * I.CosW0 - Two_SqrtA_Alpha),
+									  A_Plus_One - A_Minus_One * I.CosW0 + Two_SqrtA_Alpha,
+									  2.0f * (A_Minus_One - A_Plus_One * I.CosW0),
+									  A_Plus_One - A_Minus_One * I.CosW0 - Two_SqrtA_Alpha);
+	}
+
+	FBiquadCoefficients FBiquadCoefficients::MakePeak(const float InFrequency, const float InQ, const float InGainDb, const float InSampleRate)
+	{
+		const BiquadUtils::FBiquadIntermediates I = BiquadUtils::ComputeIntermediates(InFrequency, InQ, InSampleRate);
+
+		const float A = FMath::Pow(10.0f, InGainDb / 40.0f);
+
+		return BiquadUtils::Normalize(1.0f + I.Alpha * A, -2.0f * I.CosW0, 1.0f - I.Alpha * A, 1.0f + I.Alpha / A, -2.0f * I.CosW0, 1.0f - I.Alpha / A);
+	}
+
+	FBiquadCoefficients FBiquadCoefficients::Lerp(const FBiquadCoefficients& InA, const FBiquadCoefficients& InB, const float InAlpha)
+	{
+		FBiquadCoefficients Coefficients;
+		Coefficients.B0 = FMath::Lerp(InA.B0, InB.B0, InAlpha);
+		Coefficients.B1 = FMath::Lerp(InA.B1, InB.B1, InAlpha);
+		Coefficients.B2 = FMath::Lerp(InA.B2, InB.B2, InAlpha);
+		Coefficients.A1 = FMath::Lerp(InA.A1, InB.A1, InAlpha);
+		Coefficients.A2 = FMath::Lerp(InA.A2, InB.A2, InAlpha);
+
+		return Coefficients;
+	}
+
+	FVectorBiquadCoefficients FVectorBiquadCoefficients::MakeFromLanes(const FBiquadCoefficients& InLane0, const FBiquadCoefficients& InLane1, const FBiquadCoefficients& InLane2, const FBiquadCoefficients& InLane3)
+	{
+		FVectorBiquadCoefficients Coefficients;
+		Coefficients.B0 = MakeVectorRegisterFloat(InLane0.B0, InLane1.B0, InLane2.B0, InLane3.B0);
+		Coefficients.B1 = MakeVectorRegisterFloat(InLane0.B1, InLane1.B1, InLane2.B1, InLane3.B1);
+		Coefficients.B2 = MakeVectorRegisterFloat(InLane0.B2, InLane1.B2, InLane2.B2, InLane3.B2);
+		Coefficients.A1 = MakeVectorRegisterFloat(InLane0.A1, InLane1.A1, InLane2.A1, InLane3.A1);
+		Coefficients.A2 = MakeVectorRegisterFloat(InLane0.A2, InLane1.A2, InLane2.A2, InLane3.A2);
+
+		return Coefficients;
+	}
+}
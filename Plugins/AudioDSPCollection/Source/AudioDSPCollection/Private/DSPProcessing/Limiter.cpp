@@ -0,0 +1,439 @@
+#include "DSPProcessing/Limiter.h"
+#include "DSP/Dsp.h"
+
+namespace DSPProcessing
+{
+	namespace LimiterUtils
+	{
+		constexpr float ReleasedEpsilon = 1.58489e-05f; // -96dB, the release snaps back to unity gain
+
+		// Hann windowed sinc over the TruePeakTapsPerPhase taps, each phase normalized to unity DC gain
+		static void ComputeTruePeakCoefs(VectorRegister4Float* OutCoefs)
+		{
+			constexpr int32 NumTaps   = FLimiter::TruePeakTapsPerPhase;
+			constexpr int32 NumPhases = 4;
+
+			float Coefs[NumPhases][NumTaps];
+
+			for (int32 Phase = 0; Phase < NumPhases; ++Phase)
+			{
+				float Sum = 0.0f;
+
+				for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+				{
+					// Distance from the tap to the interpolated point, which sits Phase / 4 after the tap NumTaps / 2 - 1
+					const float T = (NumTaps / 2 - 1) + Phase * 0.25f - Tap;
+
+					const float Sinc   = (T == 0.0f) ? 1.0f : FMath::Sin(UE_PI * T) / (UE_PI * T);
+					const float Window = 0.5f * (1.0f + FMath::Cos(UE_PI * T / (NumTaps / 2)));
+
+					Coefs[Phase][Tap] = Sinc * Window;
+					Sum += Coefs[Phase][Tap];
+				}
+
+				for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+				{
+					Coefs[Phase][Tap] /= Sum;
+				}
+			}
+
+			// One vector per tap, one lane per phase
+			for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+			{
+				OutCoefs[Tap] = MakeVectorRegisterFloat(Coefs[0][Tap], Coefs[1][Tap], Coefs[2][Tap], Coefs[3][Tap]);
+			}
+		}
+
+		FORCEINLINE float VectorHorizontalMax(const VectorRegister4Float& Vec)
+		{
+			const VectorRegister4Float Max2 = VectorMax(Vec, VectorSwizzle(Vec, 2, 3, 0, 1));
+			const VectorRegister4Float Max1 = VectorMax(Max2, VectorSwizzle(Max2, 1, 0, 3, 2));
+			return VectorGetComponent(Max1, 0);
+		}
+	}
+
+	void FLimiter::Init(const float InSampleRate, const int32 InNumChannels, const int32 InMaxNumChannels, const int32 InMaxBlockFrames)
+	{
+		SampleRate     = InSampleRate;
+		NumChannels    = FMath::Max(InNumChannels, 1);
+		MaxNumChannels = FMath::Max(InMaxNumChannels, NumChannels);
+		MaxBlockFrames = (InMaxBlockFrames > 0) ? InMaxBlockFrames : DefaultMaxBlockFrames;
+
+		LimiterUtils::ComputeTruePeakCoefs(VTruePeakCoefs);
+
+		SetReleaseTimeMs(ReleaseTimeMs);
+		AllocateBuffers();
+		UpdateWindows();
+	}
+
+	void FLimiter::SetNumChannels(const int32 InNumChannels)
+	{
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels == NumChannels)
+		{
+			return;
+		}
+
+		NumChannels = NewNumChannels;
+
+		if (NumChannels > MaxNumChannels)
+		{
+			MaxNumChannels = NumChannels;
+			AllocateBuffers();
+		}
+
+		UpdateWindows();
+	}
+
+	void FLimiter::SetCeilingDb(const float InCeilingDb)
+	{
+		// No smoother needed, a new ceiling goes through the attack ramp or the release like any level change
+		Ceiling = Audio::ConvertToLinear(FMath::Clamp(InCeilingDb, -24.0f, 0.0f));
+	}
+
+	void FLimiter::SetReleaseTimeMs(const float InReleaseTimeMs)
+	{
+		ReleaseTimeMs = FMath::Clamp(InReleaseTimeMs, 1.0f, 5000.0f);
+
+		const float ReleaseTimeInFrames = FMath::Max(ReleaseTimeMs * 0.001f * SampleRate, 1.0f); // ms to frames
+		ReleaseCoef = FMath::Exp(-1.0f / ReleaseTimeInFrames);
+	}
+
+	void FLimiter::SetLookAheadMs(const float InLookAheadMs)
+	{
+		const float NewLookAheadMs = FMath::Clamp(InLookAheadMs, MinLookAheadMs, MaxLookAheadMs);
+
+		if (NewLookAheadMs == LookAheadMs)
+		{
+			return;
+		}
+
+		LookAheadMs = NewLookAheadMs;
+		UpdateWindows();
+	}
+
+	void FLimiter::SetTruePeakEnabled(const bool bInTruePeakEnabled)
+	{
+		if (bInTruePeakEnabled == bTruePeak)
+		{
+			return;
+		}
+
+		bTruePeak = bInTruePeakEnabled;
+		UpdateWindows();
+	}
+
+	void FLimiter::AllocateBuffers()
+	{
+		// The longest window is MaxLookAheadMs with the sample peak detector, the true peak history is there whether it's enabled or not
+		const int32 MaxLookAheadFrames = LookAheadMsToFrames(MaxLookAheadMs, SampleRate);
+		const int32 MaxWindowFrames    = MaxLookAheadFrames + 1;
+
+		DelayBuffer.SetNumUninitialized((MaxLookAheadFrames + MaxBlockFrames) * MaxNumChannels);
+
+		DequePeaks.SetNumUninitialized(MaxWindowFrames);
+		DequeFrames.SetNumUninitialized(MaxWindowFrames);
+		AttackRing.SetNumUninitialized(MaxWindowFrames);
+
+		TruePeakHistory.SetNumUninitialized(2 * TruePeakTapsPerPhase * MaxNumChannels);
+
+		// Whole vectors, ApplyFrameGains reads them 4 at a time
+		FrameGains.SetNumUninitialized(Align(MaxBlockFrames, 4));
+	}
+
+	void FLimiter::UpdateWindows()
+	{
+		// The latency doesn't depend on the detector, toggling the true peak mode doesn't move the audio
+		LookAheadFrames = LookAheadMsToFrames(LookAheadMs, SampleRate);
+		WindowFrames    = LookAheadFrames - (bTruePeak ? TruePeakDelayInFrames : 0) + 1;
+
+		check(WindowFrames <= AttackRing.Num());
+
+		Reset();
+	}
+
+	void FLimiter::Reset()
+	{
+		FMemory::Memzero(DelayBuffer.GetData(), sizeof(float) * LookAheadFrames * NumChannels);
+
+		DequeHead  = 0;
+		DequeCount = 0;
+		FrameIndex = 0;
+
+		for (int32 Index = 0; Index < WindowFrames; ++Index)
+		{
+			AttackRing[Index] = 1.0f;
+		}
+
+		AttackRingIndex = 0;
+		AttackSum       = WindowFrames;
+		ReleasedGain    = 1.0f;
+
+		FMemory::Memzero(TruePeakHistory.GetData(), sizeof(float) * 2 * TruePeakTapsPerPhase * NumChannels);
+		TruePeakHistoryIndex = 0;
+
+		MinBlockGain = 1.0f;
+	}
+
+	int32 FLimiter::GetLatencyInFrames() const
+	{
+		return LookAheadFrames;
+	}
+
+	int32 FLimiter::LookAheadMsToFrames(const float InLookAheadMs, const float InSampleRate)
+	{
+		const float ClampedLookAheadMs = FMath::Clamp(InLookAheadMs, MinLookAheadMs, MaxLookAheadMs);
+
+		return FMath::Max(FMath::RoundToInt(ClampedLookAheadMs * 0.001f * InSampleRate), TruePeakDelayInFrames); // ms to frames
+	}
+
+	float FLimiter::GetGainReductionDb() const
+	{
+		return (MinBlockGain < 1.0f) ? Audio::ConvertToDecibels(MinBlockGain) : 0.0f;
+	}
+
+	SIZE_T FLimiter::GetAllocatedSize() const
+	{
+		SIZE_T AllocatedSize = DelayBuffer.GetAllocatedSize() + FrameGains.GetAllocatedSize() + TruePeakHistory.GetAllocatedSize();
+		AllocatedSize += DequePeaks.GetAllocatedSize() + DequeFrames.GetAllocatedSize() + AttackRing.GetAllocatedSize();
+
+		return AllocatedSize;
+	}
+
+	void FLimiter::ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FLimiter::ProcessAudioBuffer"))
+
+		const int32 NumDelaySamples = LookAheadFrames * NumChannels;
+		const int32 MaxChunkSamples = MaxBlockFrames * NumChannels;
+
+		float BlockMinGain = 1.0f;
+
+		// The buffers hold MaxBlockFrames, longer blocks go in chunks
+		for (int32 ChunkOffset = 0; ChunkOffset < InNumSamples; ChunkOffset += MaxChunkSamples)
+		{
+			const float* ChunkInBuffer  = InBuffer + ChunkOffset;
+			float* ChunkOutBuffer       = OutBuffer + ChunkOffset;
+			const int32 NumChunkSamples = FMath::Min(MaxChunkSamples, InNumSamples - ChunkOffset);
+			const int32 NumChunkFrames  = NumChunkSamples / NumChannels;
+
+			// The input goes in behind the history, so the delayed sample of output index i is at index i too
+			FMemory::Memcpy(DelayBuffer.GetData() + NumDelaySamples, ChunkInBuffer, sizeof(float) * NumChunkSamples);
+
+			if (bTruePeak)
+			{
+				ComputeFrameGains<true>(ChunkInBuffer, NumChunkFrames);
+			}
+			else
+			{
+				ComputeFrameGains<false>(ChunkInBuffer, NumChunkFrames);
+			}
+
+			ApplyFrameGains(DelayBuffer.GetData(), ChunkOutBuffer, NumChunkFrames);
+			BlockMinGain = FMath::Min(BlockMinGain, MinBlockGain);
+
+			// Keep the last LookAheadFrames for the next buffer, the ranges overlap when the buffer is shorter than the look-ahead
+			FMemory::Memmove(DelayBuffer.GetData(), DelayBuffer.GetData() + NumChunkSamples, sizeof(float) * NumDelaySamples);
+		}
+
+		MinBlockGain = BlockMinGain;
+	}
+
+	FORCEINLINE float FLimiter::DetectSamplePeak(const float* InFrame) const
+	{
+		float Peak = 0.0f;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Peak = FMath::Max(Peak, FMath::Abs(InFrame[Channel]));
+		}
+
+		return Peak;
+	}
+
+	FORCEINLINE float FLimiter::DetectTruePeak(const float* InFrame)
+	{
+		// The 4 phases are computed at once, lane 0 is the sample TruePeakDelayInFrames frames back and lanes 1-3 the points between it and the next one
+		VectorRegister4Float VPeak = AudioUtils::VZeros;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			float* History = &TruePeakHistory[Channel * 2 * TruePeakTapsPerPhase];
+
+			History[TruePeakHistoryIndex]                        = InFrame[Channel];
+			History[TruePeakHistoryIndex + TruePeakTapsPerPhase] = InFrame[Channel];
+
+			// Oldest to newest
+			const float* Taps = History + TruePeakHistoryIndex + 1;
+
+			VectorRegister4Float Interpolated = AudioUtils::VZeros;
+
+			for (int32 Tap = 0; Tap < TruePeakTapsPerPhase; ++Tap)
+			{
+				//Interpolated[Phase] += Taps[Tap] * Coefs[Phase][Tap];
+				Interpolated = VectorMultiplyAdd(VectorLoadFloat1(&Taps[Tap]), VTruePeakCoefs[Tap], Interpolated);
+			}
+
+			VPeak = VectorMax(VPeak, VectorAbs(Interpolated));
+		}
+
+		TruePeakHistoryIndex = (TruePeakHistoryIndex + 1 == TruePeakTapsPerPhase) ? 0 : TruePeakHistoryIndex + 1;
+
+		return LimiterUtils::VectorHorizontalMax(VPeak);
+	}
+
+	FORCEINLINE float FLimiter::SlidingMaxPeak(const float InPeak)
+	{
+		// At most one entry gets older than the window per frame
+		if (DequeCount > 0 && FrameIndex - DequeFrames[DequeHead] >= (uint32)WindowFrames)
+		{
+			DequeHead = (DequeHead + 1 == WindowFrames) ? 0 : DequeHead + 1;
+			--DequeCount;
+		}
+
+		// The entries smaller than the new peak can't be the max anymore, each entry is pushed and popped once so this is O(1) amortized
+		while (DequeCount > 0)
+		{
+			const int32 Back = (DequeHead + DequeCount - 1) % WindowFrames;
+
+			if (DequePeaks[Back] > InPeak)
+			{
+				break;
+			}
+
+			--DequeCount;
+		}
+
+		const int32 NewBack = (DequeHead + DequeCount) % WindowFrames;
+		DequePeaks[NewBack]  = InPeak;
+		DequeFrames[NewBack] = FrameIndex;
+		++DequeCount;
+
+		++FrameIndex;
+
+		return DequePeaks[DequeHead];
+	}
+
+	template <bool bTruePeakT>
+	void FLimiter::ComputeFrameGains(const float* InBuffer, const int32 InNumFrames)
+	{
+		const double InvWindowFrames = 1.0 / WindowFrames;
+
+		MinBlockGain = 1.0f;
+
+		for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+		{
+			const float* InFrame = InBuffer + Frame * NumChannels;
+
+			float Peak;
+			if constexpr (bTruePeakT)
+			{
+				Peak = DetectTruePeak(InFrame);
+			}
+			else
+			{
+				Peak = DetectSamplePeak(InFrame);
+			}
+
+			// Gain that keeps every peak of the window under the ceiling
+			const float WindowPeak = SlidingMaxPeak(Peak);
+			const float HeldGain   = (WindowPeak > Ceiling) ? Ceiling / WindowPeak : 1.0f;
+
+			// Instant attack, one-pole release, never above HeldGain
+			if (HeldGain < ReleasedGain)
+			{
+				ReleasedGain = HeldGain;
+			}
+			else
+			{
+				ReleasedGain = HeldGain + (ReleasedGain - HeldGain) * ReleaseCoef;
+				ReleasedGain = (HeldGain - ReleasedGain < LimiterUtils::ReleasedEpsilon) ? HeldGain : ReleasedGain;
+			}
+
+			// Moving average over the window: every value of the window is under the gain needed by the frame leaving the delay,
+			// so the average is too, and it ramps down linearly over the look-ahead instead of jumping
+			AttackSum += ReleasedGain - AttackRing[AttackRingIndex];
+			AttackRing[AttackRingIndex] = ReleasedGain;
+
+			if (++AttackRingIndex == WindowFrames)
+			{
+				AttackRingIndex = 0;
+
+				AttackSum = 0.0;
+				for (int32 Index = 0; Index < WindowFrames; ++Index)
+				{
+					AttackSum += AttackRing[Index];
+				}
+			}
+
+			const float Gain  = (float)(AttackSum * InvWindowFrames);
+			FrameGains[Frame] = Gain;
+			MinBlockGain      = FMath::Min(MinBlockGain, Gain);
+		}
+	}
+
+	void FLimiter::ApplyFrameGains(const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
+	{
+		const int32 NumSamples = InNumFrames * NumChannels;
+
+		// Skip the gain if the limiter is idle
+		if (MinBlockGain >= 1.0f)
+		{
+			FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * NumSamples);
+			return;
+		}
+
+		const float* Gains = FrameGains.GetData();
+
+		// Sequential version
+		//for (int32 i = 0; i < NumSamples; ++i)
+		//{
+		//    OutBuffer[i] = InBuffer[i] * Gains[i / NumChannels];
+		//}
+
+		// Vectorized versions
+		if (NumChannels == 1)
+		{
+			for (int32 i = 0; i < NumSamples; i += 4)
+			{
+				const VectorRegister4Float VGain = VectorLoadAligned(&Gains[i]);
+				const VectorRegister4Float In    = VectorLoadAligned(&InBuffer[i]);
+				VectorStoreAligned(VectorMultiply(VGain, In), &OutBuffer[i]);
+			}
+		}
+		else if (NumChannels == 2)
+		{
+			for (int32 i = 0, Frame = 0; i < NumSamples; i += 4, Frame += 2)
+			{
+				const VectorRegister4Float VGain = MakeVectorRegisterFloat(Gains[Frame], Gains[Frame], Gains[Frame + 1], Gains[Frame + 1]);
+				const VectorRegister4Float In    = VectorLoadAligned(&InBuffer[i]);
+				VectorStoreAligned(VectorMultiply(VGain, In), &OutBuffer[i]);
+			}
+		}
+		else if ((NumChannels % 4) == 0)
+		{
+			for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+			{
+				const VectorRegister4Float VGain = VectorLoadFloat1(&Gains[Frame]);
+
+				for (int32 i = Frame * NumChannels; i < (Frame + 1) * NumChannels; i += 4)
+				{
+					const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+					VectorStoreAligned(VectorMultiply(VGain, In), &OutBuffer[i]);
+				}
+			}
+		}
+		else
+		{
+			// 5.1 and other odd layouts, the frames don't line up with the vectors
+			for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+			{
+				for (int32 i = Frame * NumChannels; i < (Frame + 1) * NumChannels; ++i)
+				{
+					OutBuffer[i] = InBuffer[i] * Gains[Frame];
+				}
+			}
+		}
+	}
+}
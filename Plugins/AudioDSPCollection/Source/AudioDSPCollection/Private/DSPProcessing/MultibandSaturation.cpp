@@ -0,0 +1,352 @@
+#include "DSPProcessing/MultibandSaturation.h"
+#include "DSPProcessing/Helpers/AudioUtils.h"
+#include "DSPProcessing/Helpers/SaturationUtils.h"
+#include "DSP/Dsp.h"
+
+namespace DSPProcessing
+{
+	FMultibandSaturation::FMultibandSaturation()
+		: VActiveBands(AudioUtils::VZeros)
+		, VCurrentGains(AudioUtils::VOnes)
+		, VTargetGains(AudioUtils::VOnes)
+		, VCurrentMix(AudioUtils::VOnes)
+		, VTargetMix(AudioUtils::VOnes)
+	{
+
+	}
+
+	FMultibandSaturation::~FMultibandSaturation()
+	{
+
+	}
+
+	void FMultibandSaturation::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		constexpr float SmoothingTimeInMs = 21.33f;
+
+		SampleRate = InSampleRate;
+
+		BiasParamSmoother.Init(SmoothingTimeInMs, InSampleRate);
+		OutLevelParamSmoother.Init(SmoothingTimeInMs, InSampleRate);
+
+		// Same one-pole response as ParamSmootherLPF, stepped once per frame for all bands at once
+		const float SmoothingTimeInSamples = SmoothingTimeInMs * InSampleRate * 0.001f;
+		SmoothingStep = 1.0f - FMath::Exp(-UE_TWO_PI / SmoothingTimeInSamples);
+
+		bCrossoversDirty = true;
+		bBandParamsDirty = true;
+
+		NumChannels = 0;
+		SetNumChannels(InNumChannels);
+	}
+
+	void FMultibandSaturation::SetNumChannels(const int32 InNumChannels)
+	{
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels == NumChannels)
+		{
+			return;
+		}
+
+		NumChannels = NewNumChannels;
+		FilterStates.SetNum(NumChannels * NumBiquadsPerChannel);
+
+		ResetFilterStates();
+	}
+
+	void FMultibandSaturation::SetNumBands(const int32 InNumBands)
+	{
+		const int32 NewNumBands = FMath::Clamp(InNumBands, MinNumBands, MaxNumBands);
+
+		if (NewNumBands == NumBands)
+		{
+			return;
+		}
+
+		NumBands         = NewNumBands;
+		bCrossoversDirty = true;
+		bBandParamsDirty = true;
+
+		ResetFilterStates();
+	}
+
+	void FMultibandSaturation::SetCrossoverFrequency(const int32 InCrossoverIndex, const float InFrequency)
+	{
+		if (InCrossoverIndex < 0 || InCrossoverIndex >= MaxNumStages)
+		{
+			return;
+		}
+
+		const float Frequency = FMath::Clamp(InFrequency, 20.0f, 20000.0f);
+
+		if (Frequency != CrossoverFrequencies[InCrossoverIndex])
+		{
+			CrossoverFrequencies[InCrossoverIndex] = Frequency;
+			bCrossoversDirty = true;
+		}
+	}
+
+	bool FMultibandSaturation::IsBandSaturationTypeSupported(const ESaturationType InSaturationType)
+	{
+		return SaturationUtils::IsMemoryless(InSaturationType);
+	}
+
+	void FMultibandSaturation::SetBandSaturationType(const int32 InBandIndex, const ESaturationType InSaturationType)
+	{
+		if (InBandIndex < 0 || InBandIndex >= MaxNumBands)
+		{
+			return;
+		}
+
+		// Silently, the callers warn off the render thread
+		const ESaturationType SaturationType = IsBandSaturationTypeSupported(InSaturationType) ? InSaturationType : ESaturationType::Tape;
+
+		if (SaturationType != BandSaturationTypes[InBandIndex])
+		{
+			BandSaturationTypes[InBandIndex] = SaturationType;
+			bBandParamsDirty = true;
+		}
+	}
+
+	void FMultibandSaturation::SetBandGain(const int32 InBandIndex, const float InGain)
+	{
+		if (InBandIndex < 0 || InBandIndex >= MaxNumBands)
+		{
+			return;
+		}
+
+		const float Gain = FMath::Clamp(InGain, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize [0, 1]
+
+		if (Gain != BandGains[InBandIndex])
+		{
+			BandGains[InBandIndex] = Gain;
+			bBandParamsDirty = true;
+		}
+	}
+
+	void FMultibandSaturation::SetBandMix(const int32 InBandIndex, const float InMixAmount)
+	{
+		if (InBandIndex < 0 || InBandIndex >= MaxNumBands)
+		{
+			return;
+		}
+
+		const float MixAmount = FMath::Clamp(InMixAmount, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize [0, 1]
+
+		if (MixAmount != BandMixAmounts[InBandIndex])
+		{
+			BandMixAmounts[InBandIndex] = MixAmount;
+			bBandParamsDirty = true;
+		}
+	}
+
+	void FMultibandSaturation::SetBias(const float InBias)
+	{
+		const float Bias = FMath::Clamp(InBias, -1.0f, 1.0f);
+		BiasParamSmoother.SetNewParamValue(Bias);
+	}
+
+	void FMultibandSaturation::SetOutLevelDb(const float InOutLevelDb)
+	{
+		const float OutLevelDb = FMath::Clamp(InOutLevelDb, -96.0f, 24.0f);
+		const float InOutLevelLinear = (OutLevelDb == -96.0f) ? 0.0f : Audio::ConvertToLinear(OutLevelDb);
+
+		OutLevelParamSmoother.SetNewParamValue(InOutLevelLinear);
+	}
+
+	SIZE_T FMultibandSaturation::GetAllocatedSize() const
+	{
+		return FilterStates.GetAllocatedSize();
+	}
+
+	void FMultibandSaturation::UpdateCrossoverCoefficients()
+	{
+		constexpr float ButterworthQ = 0.70710678f; // LR4 = 2 cascaded Butterworth biquads
+
+		const FBiquadCoefficients Identity = FBiquadCoefficients::MakeIdentity();
+
+		float MinFrequency = 20.0f;
+
+		for (int32 Stage = 0; Stage < MaxNumStages; ++Stage)
+		{
+			// Keep the crossovers sorted, otherwise the bands overlap
+			const float Frequency = FMath::Clamp(CrossoverFrequencies[Stage], MinFrequency, 0.45f * SampleRate);
+			MinFrequency = Frequency;
+
+			const FBiquadCoefficients LowPass  = FBiquadCoefficients::MakeLowPass(Frequency, ButterworthQ, SampleRate);
+			const FBiquadCoefficients HighPass = FBiquadCoefficients::MakeHighPass(Frequency, ButterworthQ, SampleRate);
+			const FBiquadCoefficients AllPass  = FBiquadCoefficients::MakeAllPass(Frequency, ButterworthQ, SampleRate); // LR4 LowPass + HighPass
+
+			FBiquadCoefficients FirstBiquads[MaxNumBands];
+			FBiquadCoefficients SecondBiquads[MaxNumBands];
+
+			for (int32 Band = 0; Band < MaxNumBands; ++Band)
+			{
+				if (Band >= NumBands || Stage >= NumBands - 1)
+				{
+					FirstBiquads[Band]  = Identity;
+					SecondBiquads[Band] = Identity;
+				}
+				else if (Stage < Band)
+				{
+					FirstBiquads[Band]  = HighPass;
+					SecondBiquads[Band] = HighPass;
+				}
+				else if (Stage == Band)
+				{
+					FirstBiquads[Band]  = LowPass;
+					SecondBiquads[Band] = LowPass;
+				}
+				else
+				{
+					FirstBiquads[Band]  = AllPass;
+					SecondBiquads[Band] = Identity;
+				}
+			}
+
+			StageCoefficients[Stage][0] = FVectorBiquadCoefficients::MakeFromLanes(FirstBiquads[0],  FirstBiquads[1],  FirstBiquads[2],  FirstBiquads[3]);
+			StageCoefficients[Stage][1] = FVectorBiquadCoefficients::MakeFromLanes(SecondBiquads[0], SecondBiquads[1], SecondBiquads[2], SecondBiquads[3]);
+		}
+
+		bCrossoversDirty = false;
+	}
+
+	void FMultibandSaturation::UpdateBandParams()
+	{
+		float TargetGains[MaxNumBands];
+		float ActiveBands[MaxNumBands];
+		float GroupLanes[MaxNumBands][MaxNumBands] = {};
+
+		NumCurveGroups = 0;
+
+		for (int32 Band = 0; Band < MaxNumBands; ++Band)
+		{
+			TargetGains[Band] = SaturationUtils::MapNormalizedGain(BandSaturationTypes[Band], BandGains[Band]);
+			ActiveBands[Band] = (Band < NumBands) ? 1.0f : 0.0f;
+
+			if (Band >= NumBands)
+			{
+				continue;
+			}
+
+			int32 Group = 0;
+
+			while (Group < NumCurveGroups && CurveGroupTypes[Group] != BandSaturationTypes[Band])
+			{
+				++Group;
+			}
+
+			if (Group == NumCurveGroups)
+			{
+				CurveGroupTypes[NumCurveGroups++] = BandSaturationTypes[Band];
+			}
+
+			GroupLanes[Group][Band] = 1.0f;
+		}
+
+		for (int32 Group = 0; Group < NumCurveGroups; ++Group)
+		{
+			const VectorRegister4Float Lanes = MakeVectorRegisterFloat(GroupLanes[Group][0], GroupLanes[Group][1], GroupLanes[Group][2], GroupLanes[Group][3]);
+			CurveGroupMasks[Group] = VectorCompareGT(Lanes, AudioUtils::VZeros);
+		}
+
+		VTargetGains = MakeVectorRegisterFloat(TargetGains[0], TargetGains[1], TargetGains[2], TargetGains[3]);
+		VTargetMix   = MakeVectorRegisterFloat(BandMixAmounts[0], BandMixAmounts[1], BandMixAmounts[2], BandMixAmounts[3]);
+		VActiveBands = MakeVectorRegisterFloat(ActiveBands[0], ActiveBands[1], ActiveBands[2], ActiveBands[3]);
+
+		if (bFirstBandParamsUpdate)
+		{
+			VCurrentGains = VTargetGains;
+			VCurrentMix   = VTargetMix;
+
+			bFirstBandParamsUpdate = false;
+		}
+
+		bBandParamsDirty = false;
+	}
+
+	void FMultibandSaturation::ResetFilterStates()
+	{
+		for (FVectorBiquadState& FilterState : FilterStates)
+		{
+			FilterState = FVectorBiquadState();
+		}
+	}
+
+	void FMultibandSaturation::ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FMultibandSaturation::ProcessAudioBuffer"))
+
+		if (bCrossoversDirty)
+		{
+			UpdateCrossoverCoefficients();
+		}
+
+		if (bBandParamsDirty)
+		{
+			UpdateBandParams();
+		}
+
+		// Skip processing if OutLevel == 0
+		if (OutLevelParamSmoother.IsSettled() && OutLevelParamSmoother.GetCurrentValue() == 0.0f)
+		{
+			FMemory::Memzero(OutBuffer, sizeof(float) * InNumSamples);
+			return;
+		}
+
+		const int32 NumFrames = InNumSamples / NumChannels;
+		const int32 NumStages = NumBands - 1;
+
+		const VectorRegister4Float VSmoothingStep = VectorLoadFloat1(&SmoothingStep);
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			//CurrentGains += SmoothingStep * (TargetGains - CurrentGains);
+			VCurrentGains = VectorMultiplyAdd(VSmoothingStep, VectorSubtract(VTargetGains, VCurrentGains), VCurrentGains);
+			VCurrentMix   = VectorMultiplyAdd(VSmoothingStep, VectorSubtract(VTargetMix, VCurrentMix), VCurrentMix);
+
+			const float CurrentBias     = BiasParamSmoother.GetValue();
+			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
+
+			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
+			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				const int32 SampleIndex = Frame * NumChannels + Channel;
+
+				FVectorBiquadState* ChannelFilterStates = &FilterStates[Channel * NumBiquadsPerChannel];
+
+				//Bands = [In, In, In, In];
+				VectorRegister4Float Bands = VectorLoadFloat1(&InBuffer[SampleIndex]);
+
+				// Crossovers, all the bands are filtered at once
+				for (int32 Stage = 0; Stage < NumStages; ++Stage)
+				{
+					Bands = AudioUtils::VectorBiquad(Bands, StageCoefficients[Stage][0], ChannelFilterStates[Stage * NumBiquadsPerStage]);
+					Bands = AudioUtils::VectorBiquad(Bands, StageCoefficients[Stage][1], ChannelFilterStates[Stage * NumBiquadsPerStage + 1]);
+				}
+
+				//const float In_Plus_Bias = Band + Bias;
+				const VectorRegister4Float In_Plus_Bias = VectorAdd(Bands, VBias);
+
+				//float Out = Saturate(In_Plus_Bias, BandGain); (with the curve of each band)
+				VectorRegister4Float Out = SaturationUtils::VectorSaturate(CurveGroupTypes[0], In_Plus_Bias, VCurrentGains);
+
+				for (int32 Group = 1; Group < NumCurveGroups; ++Group)
+				{
+					const VectorRegister4Float GroupOut = SaturationUtils::VectorSaturate(CurveGroupTypes[Group], In_Plus_Bias, VCurrentGains);
+					Out = VectorSelect(CurveGroupMasks[Group], GroupOut, Out);
+				}
+
+				//Out = Out * Mix + (1.0f - Mix) * Band;
+				AudioUtils::VectorMix(Bands, VCurrentMix, Out);
+
+				//OutBuffer[i] = (Band0 + Band1 + Band2 + Band3) * OutLevel;
+				Out = VectorMultiply(VectorDot4(Out, VActiveBands), VOutLevel);
+				VectorStoreFloat1(Out, &OutBuffer[SampleIndex]);
+			}
+		}
+	}
+}
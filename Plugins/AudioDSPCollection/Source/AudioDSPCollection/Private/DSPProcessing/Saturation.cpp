@@ -1,1022 +1,1322 @@
 #include "DSPProcessing/Saturation.h"
 #include "DSPProcessing/Helpers/AudioUtils.h"
+#include "DSPProcessing/Helpers/SaturationUtils.h"
+#include "Async/ParallelFor.h"
 
 namespace DSPProcessing
 {
-	namespace SaturationUtils
+	FSaturation::FSaturation()
+		: SelectedSaturationTypePtr(&FSaturation::ProcessSaturation<ESaturationType::Tape, false, false>)
+		, SelectedPartitionSaturationTypePtr(&FSaturation::ProcessPartitionSaturation<ESaturationType::Tape, false>)
+	{
+		
+	}
+
+	FSaturation::~FSaturation()
 	{
-		FORCEINLINE float FastTanh(const float x)
+		
+	}
+
+	void FSaturation::Init(const float InSampleRate, const int32 InNumChannels, const int32 InMaxNumChannels, const int32 InMaxBlockFrames)
+	{
+		SampleRate     = InSampleRate;
+		NumChannels    = FMath::Max(InNumChannels, 1);
+		MaxNumChannels = FMath::Max(InMaxNumChannels, NumChannels);
+		MaxBlockFrames = (InMaxBlockFrames > 0) ? InMaxBlockFrames : DefaultMaxBlockFrames;
+
+		CaptureInstanceId     = FBlockCapture::NewInstanceId();
+		bCaptureParamsChanged = true;
+
+		InitParamSmoothers();
+
+		EnvelopeFollower.Init(InSampleRate, NumChannels);
+
+		TapeHysteresis.Init(InSampleRate, InNumChannels);
+
+		HarmonicShaper.Init(InSampleRate, InNumChannels);
+
+		DCBlocker.Init(InSampleRate, InNumChannels);
+
+		PreEmphasis.Init(InSampleRate, InNumChannels);
+		PostEmphasis.Init(InSampleRate, InNumChannels);
+
+		bHasProcessedAudio   = false;
+		bTypeCrossfadeActive = false;
+		bMidSideActive       = bMidSideEnabled && NumChannels == 2;
+		UpdateSelectedKernels();
+
+		AllocateScratchBuffers();
+		UpdateChannelPartitions();
+	}
+
+	void FSaturation::SetNumChannels(const int32 InNumChannels)
+	{
+		TapeHysteresis.SetNumChannels(InNumChannels);
+		HarmonicShaper.SetNumChannels(InNumChannels);
+		DCBlocker.SetNumChannels(InNumChannels);
+		PreEmphasis.SetNumChannels(InNumChannels);
+		PostEmphasis.SetNumChannels(InNumChannels);
+		EnvelopeFollower.SetNumChannels(InNumChannels);
+
+		const int32 NewNumChannels = FMath::Max(InNumChannels, 1);
+
+		if (NewNumChannels != NumChannels)
 		{
-			const float AbsX = FMath::Abs(x);
-			const float XSqr = x * x;
+			NumChannels = NewNumChannels;
 
-			const float Z = x * (1.0f + AbsX + (1.05622909486427f + 0.215166815390934f * XSqr * AbsX) * XSqr);
+			if (NumChannels > MaxNumChannels)
+			{
+				MaxNumChannels = NumChannels;
+				AllocateScratchBuffers();
+			}
 
-			return Z / (1.02718982441289f + FMath::Abs(Z));
+			InitParamSmoothers();
+			UpdateChannelPartitions();
+			UpdateMidSideActive();
 		}
+	}
+
+	void FSaturation::SetMaxBlockFrames(const int32 InMaxBlockFrames)
+	{
+		const int32 NewMaxBlockFrames = FMath::Max(InMaxBlockFrames, 1);
 
-		// Vectorized functions
-		FORCEINLINE VectorRegister4Float VectorTanh(const VectorRegister4Float& X)
+		if (NewMaxBlockFrames != MaxBlockFrames)
 		{
-		#if UE_PLATFORM_MATH_USE_SVML
-			return _mm_tanh_ps(X);
-		#else
-			AlignedFloat4 Floats(X);
-			Floats[0] = FastTanh(Floats[0]);
-			Floats[1] = FastTanh(Floats[1]);
-			Floats[2] = FastTanh(Floats[2]);
-			Floats[3] = FastTanh(Floats[3]);
-			return Floats.ToVectorRegister();
-		#endif
+			MaxBlockFrames = NewMaxBlockFrames;
+			AllocateScratchBuffers();
+			AllocatePartitionBuffers();
 		}
 	}
 
-	FSaturation::FSaturation()
-		: SaturationType(ESaturationType::Tape)
-		, SelectedSaturationTypePtr(&FSaturation::Tape)
+	void FSaturation::InitParamSmoothers()
 	{
-		
+		constexpr float SmoothingTimeInMs = 21.33f;
+
+		// Stepped once per vector, i.e. NumChannels / 4 times per frame
+		const float VectorRate = AudioUtils::GetVectorRate(SampleRate, NumChannels);
+
+		GainParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		BiasParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		MixParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		OutLevelParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		SideGainParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		SideBiasParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		SideMixParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		TypeCrossfadeParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		EnvelopeToGainParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		EnvelopeToBiasParamSmoother.Init(SmoothingTimeInMs, VectorRate);
 	}
 
-	FSaturation::~FSaturation()
+	void FSaturation::SetSaturationType(const ESaturationType InSaturationType)
 	{
-		
+		SetCaptureParam(CaptureParams.SaturationType, InSaturationType);
+
+		RequestedSaturationType = InSaturationType;
+		SwitchSaturationType(GetGovernedSaturationType());
 	}
 
-	void FSaturation::Init(const float InSampleRate)
+	void FSaturation::SwitchSaturationType(const ESaturationType InSaturationType)
 	{
-		constexpr float SmoothingTimeInMs = 21.33f;
+		// Metasound nodes set the type every block
+		if (InSaturationType == SaturationType)
+		{
+			return;
+		}
+
+		// Unless TapeHysteresis is still being crossfaded out, then it keeps its state
+		const bool bIsTapeHysteresisRunning = bTypeCrossfadeActive && PreviousSaturationType == ESaturationType::TapeHysteresis;
+
+		if (InSaturationType == ESaturationType::TapeHysteresis && !bIsTapeHysteresisRunning)
+		{
+			TapeHysteresis.Reset();
+
+			for (FChannelPartition& Partition : ChannelPartitions)
+			{
+				Partition.TapeHysteresis.Reset();
+			}
+		}
+
+		// Same for the harmonic weights: while the curve isn't heard they just jump to their last value
+		const bool bIsHarmonicRunning = bTypeCrossfadeActive && PreviousSaturationType == ESaturationType::Harmonic;
+
+		if (InSaturationType == ESaturationType::Harmonic && !bIsHarmonicRunning)
+		{
+			HarmonicShaper.Reset();
 
-		GainParamSmoother.Init(SmoothingTimeInMs, InSampleRate);
-		BiasParamSmoother.Init(SmoothingTimeInMs, InSampleRate);
-		MixParamSmoother.Init(SmoothingTimeInMs, InSampleRate);
-		OutLevelParamSmoother.Init(SmoothingTimeInMs, InSampleRate);
+			for (FChannelPartition& Partition : ChannelPartitions)
+			{
+				Partition.HarmonicShaper.Reset();
+			}
+		}
+
+		if (bHasProcessedAudio)
+		{
+			// Keep the smoothed gains at the same normalized position, so they don't sweep across the new range
+			for (ParamSmootherLPF* Smoother : { &GainParamSmoother, &SideGainParamSmoother })
+			{
+				const float TargetGain = SaturationUtils::RemapGain(SaturationType, InSaturationType, Smoother->GetTargetValue());
+				Smoother->ResetParamValue(SaturationUtils::RemapGain(SaturationType, InSaturationType, Smoother->GetCurrentValue()));
+				Smoother->SetNewParamValue(TargetGain);
+			}
+
+			// A change during a transition restarts it from the curve that was being faded in
+			PreviousSaturationType = SaturationType;
+			PreviousGainOffset     = SaturationUtils::RemapGain(InSaturationType, PreviousSaturationType, 0.0f);
+			PreviousGainScale      = SaturationUtils::RemapGain(InSaturationType, PreviousSaturationType, 1.0f) - PreviousGainOffset;
+
+			TypeCrossfadeParamSmoother.ResetParamValue(0.0f);
+			TypeCrossfadeParamSmoother.SetNewParamValue(1.0f);
+			bTypeCrossfadeActive = true;
+		}
+
+		SaturationType = InSaturationType;
+		MinGain        = SaturationUtils::MapNormalizedGain(SaturationType, 0.0f);
+		MaxGain        = SaturationUtils::MapNormalizedGain(SaturationType, 1.0f);
+
+		UpdateSelectedKernels();
 	}
 
-	void FSaturation::SetSaturationType(const ESaturationType InSaturationType)
+	void FSaturation::UpdateSelectedKernels()
 	{
-		SaturationType = InSaturationType;
+		// Transitions from or to TapeHysteresis need its separate pass
+		if (SaturationType == ESaturationType::TapeHysteresis || (bTypeCrossfadeActive && PreviousSaturationType == ESaturationType::TapeHysteresis))
+		{
+			if (bTypeCrossfadeActive)
+			{
+				SelectedSaturationTypePtr          = bMidSideActive ? &FSaturation::ProcessTapeHysteresis<true, true> : &FSaturation::ProcessTapeHysteresis<true, false>;
+				SelectedPartitionSaturationTypePtr = &FSaturation::ProcessPartitionTapeHysteresis<true>;
+			}
+			else
+			{
+				SelectedSaturationTypePtr          = bMidSideActive ? &FSaturation::ProcessTapeHysteresis<false, true> : &FSaturation::ProcessTapeHysteresis<false, false>;
+				SelectedPartitionSaturationTypePtr = &FSaturation::ProcessPartitionTapeHysteresis<false>;
+			}
+			return;
+		}
 
 		switch (SaturationType)
 		{
 			default:
 			case ESaturationType::Tape:
-				SelectedSaturationTypePtr = &FSaturation::Tape;
+				SelectKernels<ESaturationType::Tape>();
 				break;
 			case ESaturationType::Tape2:
-				SelectedSaturationTypePtr = &FSaturation::Tape2;
+				SelectKernels<ESaturationType::Tape2>();
 				break;
 			case ESaturationType::Overdrive:
-				SelectedSaturationTypePtr = &FSaturation::Overdrive;
+				SelectKernels<ESaturationType::Overdrive>();
 				break;
 			case ESaturationType::Tube:
-				SelectedSaturationTypePtr = &FSaturation::Tube;
+				SelectKernels<ESaturationType::Tube>();
 				break;
 			case ESaturationType::Tube2:
-				SelectedSaturationTypePtr = &FSaturation::Tube2;
+				SelectKernels<ESaturationType::Tube2>();
 				break;
 			case ESaturationType::Distortion:
-				SelectedSaturationTypePtr = &FSaturation::Distortion;
+				SelectKernels<ESaturationType::Distortion>();
 				break;
 			case ESaturationType::Metal:
-				SelectedSaturationTypePtr = &FSaturation::Metal;
+				SelectKernels<ESaturationType::Metal>();
 				break;
 			case ESaturationType::Fuzz:
-				SelectedSaturationTypePtr = &FSaturation::Fuzz;
+				SelectKernels<ESaturationType::Fuzz>();
 				break;
 			case ESaturationType::HardClip:
-				SelectedSaturationTypePtr = &FSaturation::HardClip;
+				SelectKernels<ESaturationType::HardClip>();
 				break;
 			case ESaturationType::Foldback:
-				SelectedSaturationTypePtr = &FSaturation::Foldback;
+				SelectKernels<ESaturationType::Foldback>();
 				break;
 			case ESaturationType::HalfWaveRectifier:
-				SelectedSaturationTypePtr = &FSaturation::HalfWaveRectifier;
+				SelectKernels<ESaturationType::HalfWaveRectifier>();
 				break;
 			case ESaturationType::FullWaveRectifier:
-				SelectedSaturationTypePtr = &FSaturation::FullWaveRectifier;
+				SelectKernels<ESaturationType::FullWaveRectifier>();
+				break;
+			case ESaturationType::Harmonic:
+				SelectKernels<ESaturationType::Harmonic>();
+				break;
+			case ESaturationType::Custom:
+				SelectKernels<ESaturationType::Custom>();
 				break;
 		}
 	}
 
-	void FSaturation::SetGain(const float InGain)
+	template <ESaturationType SaturationTypeT>
+	void FSaturation::SelectKernels()
 	{
-		float Gain = FMath::Clamp(InGain, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize [0, 1]
-
-		switch (SaturationType)
+		// The partitions only exist for multiples of 4 channels, so they never run in mid/side
+		if (bTypeCrossfadeActive)
 		{
-			default:
-			case ESaturationType::Tape:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 1.0f, 20.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::Tape2:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 0.000001f, 35.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::Overdrive:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 1.0f, 20.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::Tube:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 1.0f, 40.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::Tube2:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 1.0f, 45.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::Distortion:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 0.000001f, 80.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::Metal:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 1.0f, 100.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::Fuzz:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 0.5f, 35.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::HardClip:
-				Gain = AudioUtils::MapFromNormalizedRange(Gain, 1.0f, 100.0f);
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::Foldback:
-				GainParamSmoother.SetNewParamValue(Gain);
-				break;
-			case ESaturationType::HalfWaveRectifier:
-				break;
-			case ESaturationType::FullWaveRectifier:
-				break;
+			SelectedSaturationTypePtr          = bMidSideActive ? &FSaturation::ProcessSaturation<SaturationTypeT, true, true> : &FSaturation::ProcessSaturation<SaturationTypeT, true, false>;
+			SelectedPartitionSaturationTypePtr = &FSaturation::ProcessPartitionSaturation<SaturationTypeT, true>;
 		}
+		else
+		{
+			SelectedSaturationTypePtr          = bMidSideActive ? &FSaturation::ProcessSaturation<SaturationTypeT, false, true> : &FSaturation::ProcessSaturation<SaturationTypeT, false, false>;
+			SelectedPartitionSaturationTypePtr = &FSaturation::ProcessPartitionSaturation<SaturationTypeT, false>;
+		}
+	}
+
+	void FSaturation::SetGain(const float InGain)
+	{
+		SetCaptureParam(CaptureParams.Gain, InGain);
+
+		const float Gain = FMath::Clamp(InGain, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize [0, 1]
+
+		GainParamSmoother.SetNewParamValue(SaturationUtils::MapNormalizedGain(SaturationType, Gain));
 	}
 
 	void FSaturation::SetBias(const float InBias)
 	{
+		SetCaptureParam(CaptureParams.Bias, InBias);
+
 		const float Bias = FMath::Clamp(InBias, -1.0f, 1.0f);
 		BiasParamSmoother.SetNewParamValue(Bias);
 	}
 
 	void FSaturation::SetMix(const float InMixAmount)
 	{
+		SetCaptureParam(CaptureParams.Mix, InMixAmount);
+
 		const float MixAmount = FMath::Clamp(InMixAmount, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize
 		MixParamSmoother.SetNewParamValue(MixAmount);
 	}
 
+	void FSaturation::SetMidSideEnabled(const bool bInMidSideEnabled)
+	{
+		SetCaptureParam(CaptureParams.bMidSideEnabled, bInMidSideEnabled);
+
+		bMidSideEnabled = bInMidSideEnabled;
+		UpdateMidSideActive();
+	}
+
+	void FSaturation::SetSideGain(const float InGain)
+	{
+		SetCaptureParam(CaptureParams.SideGain, InGain);
+
+		const float Gain = FMath::Clamp(InGain, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize [0, 1]
+
+		SideGainParamSmoother.SetNewParamValue(SaturationUtils::MapNormalizedGain(SaturationType, Gain));
+	}
+
+	void FSaturation::SetSideBias(const float InBias)
+	{
+		SetCaptureParam(CaptureParams.SideBias, InBias);
+
+		const float Bias = FMath::Clamp(InBias, -1.0f, 1.0f);
+		SideBiasParamSmoother.SetNewParamValue(Bias);
+	}
+
+	void FSaturation::SetSideMix(const float InMixAmount)
+	{
+		SetCaptureParam(CaptureParams.SideMix, InMixAmount);
+
+		const float MixAmount = FMath::Clamp(InMixAmount, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize
+		SideMixParamSmoother.SetNewParamValue(MixAmount);
+	}
+
 	void FSaturation::SetOutLevelDb(float InOutLevelDb)
 	{
+		SetCaptureParam(CaptureParams.OutLevelDb, InOutLevelDb);
+
 		const float OutLevelDb = FMath::Clamp(InOutLevelDb, -96.0f, 24.0f);
 		const float InOutLevelLinear = (OutLevelDb == -96.0f) ? 0.0f : Audio::ConvertToLinear(OutLevelDb);
 
 		OutLevelParamSmoother.SetNewParamValue(InOutLevelLinear);
 	}
 
-	void FSaturation::ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	void FSaturation::SetDCBlockerEnabled(const bool bInDCBlockerEnabled)
 	{
-		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSaturation::ProcessAudioBuffer"))
-		
-		// Skip processing if OutLevel == 0
-		if (OutLevelParamSmoother.GetValue() == 0.0f)
+		SetCaptureParam(CaptureParams.bDCBlockerEnabled, bInDCBlockerEnabled);
+
+		DCBlocker.SetEnabled(bInDCBlockerEnabled);
+
+		for (FChannelPartition& Partition : ChannelPartitions)
 		{
-			FMemory::Memzero(OutBuffer, sizeof(float) * InNumSamples);
-			return;
+			Partition.DCBlocker.SetEnabled(bInDCBlockerEnabled);
 		}
+	}
+
+	void FSaturation::SetDCBlockerCutoffFrequency(const float InCutoffFrequency)
+	{
+		SetCaptureParam(CaptureParams.DCBlockerCutoffFrequency, InCutoffFrequency);
+
+		DCBlocker.SetCutoffFrequency(InCutoffFrequency);
 
-		// Skip processing if OutLevel==1 and Mix == 0
-		if (OutLevelParamSmoother.GetValue() == 1.0f && MixParamSmoother.GetValue() == 0.0f)
+		for (FChannelPartition& Partition : ChannelPartitions)
 		{
-			FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * InNumSamples);
-			return;
+			Partition.DCBlocker.SetCutoffFrequency(InCutoffFrequency);
+		}
+	}
+
+	void FSaturation::SetPreEmphasisBand(const int32 InBandIndex, const FEmphasisBand& InBand)
+	{
+		if (InBandIndex >= 0 && InBandIndex < FEmphasisFilter::MaxNumBands)
+		{
+			SetCaptureParam(CaptureParams.PreEmphasisBands[InBandIndex], InBand);
 		}
 
-		// Process with selected saturation algorithm
-		(this->*(SelectedSaturationTypePtr))(InBuffer, OutBuffer, InNumSamples);
+		PreEmphasis.SetBand(InBandIndex, InBand);
+
+		for (FChannelPartition& Partition : ChannelPartitions)
+		{
+			Partition.PreEmphasis.SetBand(InBandIndex, InBand);
+		}
 	}
 
-	void FSaturation::Tape(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	void FSaturation::SetPostEmphasisBand(const int32 InBandIndex, const FEmphasisBand& InBand)
 	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Gain_x_In	   = Gain * In_Plus_Bias;
-		//
-		//	  float Out = Gain_x_In / FMath::Sqrt(Gain_x_In * Gain_x_In + 1.0f);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		if (InBandIndex >= 0 && InBandIndex < FEmphasisFilter::MaxNumBands)
+		{
+			SetCaptureParam(CaptureParams.PostEmphasisBands[InBandIndex], InBand);
+		}
 
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
+		PostEmphasis.SetBand(InBandIndex, InBand);
+
+		for (FChannelPartition& Partition : ChannelPartitions)
 		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+			Partition.PostEmphasis.SetBand(InBandIndex, InBand);
+		}
+	}
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
+	void FSaturation::SetEnvelopeFollowerEnabled(const bool bInEnvelopeFollowerEnabled)
+	{
+		SetCaptureParam(CaptureParams.bEnvelopeFollowerEnabled, bInEnvelopeFollowerEnabled);
 
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+		bEnvelopeFollowerEnabled = bInEnvelopeFollowerEnabled;
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+		// Fade the modulation in/out instead of switching it
+		EnvelopeToGainParamSmoother.SetNewParamValue(bEnvelopeFollowerEnabled ? EnvelopeToGain : 0.0f);
+		EnvelopeToBiasParamSmoother.SetNewParamValue(bEnvelopeFollowerEnabled ? EnvelopeToBias : 0.0f);
+	}
 
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+	void FSaturation::SetEnvelopeDetectorMode(const EEnvelopeDetectorMode InDetectorMode)
+	{
+		SetCaptureParam(CaptureParams.EnvelopeDetectorMode, InDetectorMode);
 
-			//float Out = Gain_x_In / FMath::Sqrt(Gain_x_In * Gain_x_In + 1.0f);
-			VectorRegister4Float Out = VectorMultiplyAdd(Gain_x_In, Gain_x_In, AudioUtils::VOnes);
-			Out = VectorMultiply(Gain_x_In, VectorReciprocalSqrt(Out));
+		EnvelopeFollower.SetDetectorMode(InDetectorMode);
+	}
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+	void FSaturation::SetEnvelopeAttackTimeMs(const float InAttackTimeMs)
+	{
+		SetCaptureParam(CaptureParams.EnvelopeAttackTimeMs, InAttackTimeMs);
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
-		}
+		EnvelopeFollower.SetAttackTimeMs(InAttackTimeMs);
 	}
 
-	void FSaturation::Tape2(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	void FSaturation::SetEnvelopeReleaseTimeMs(const float InReleaseTimeMs)
 	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Gain_x_In	   = Gain * In_Plus_Bias;
-		//
-		//	  float Out = FMath::Atan(Gain_x_In) / FMath::Atan(Gain);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		SetCaptureParam(CaptureParams.EnvelopeReleaseTimeMs, InReleaseTimeMs);
 
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
-		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+		EnvelopeFollower.SetReleaseTimeMs(InReleaseTimeMs);
+	}
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
+	void FSaturation::SetEnvelopeToGain(const float InEnvelopeToGain)
+	{
+		SetCaptureParam(CaptureParams.EnvelopeToGain, InEnvelopeToGain);
 
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+		EnvelopeToGain = FMath::Clamp(InEnvelopeToGain, -100.0f, 100.0f) * 0.01f; // Clamp and Normalize [-1, 1]
+		EnvelopeToGainParamSmoother.SetNewParamValue(bEnvelopeFollowerEnabled ? EnvelopeToGain : 0.0f);
+	}
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+	void FSaturation::SetEnvelopeToBias(const float InEnvelopeToBias)
+	{
+		SetCaptureParam(CaptureParams.EnvelopeToBias, InEnvelopeToBias);
 
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+		EnvelopeToBias = FMath::Clamp(InEnvelopeToBias, -1.0f, 1.0f);
+		EnvelopeToBiasParamSmoother.SetNewParamValue(bEnvelopeFollowerEnabled ? EnvelopeToBias : 0.0f);
+	}
 
-			//float Out = FMath::Atan(Gain_x_In) / FMath::Atan(Gain);
-			const VectorRegister4Float OneOverAtanGain = VectorReciprocal(VectorATan(VGain));
-			VectorRegister4Float Out = VectorATan(Gain_x_In);
-			Out = VectorMultiply(Out, OneOverAtanGain);
+	void FSaturation::SetTapeHysteresisSolver(const ETapeHysteresisSolver InSolver)
+	{
+		SetCaptureParam(CaptureParams.TapeHysteresisSolver, InSolver);
 
-			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
-			Out = AudioUtils::VectorClampMinusOneToOne(Out);
+		RequestedTapeHysteresisSolver = InSolver;
+		ApplyTapeHysteresisQuality();
+	}
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+	void FSaturation::SetTapeHysteresisOversampling(const int32 InOversampling)
+	{
+		SetCaptureParam(CaptureParams.TapeHysteresisOversampling, InOversampling);
 
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+		RequestedTapeHysteresisOversampling = InOversampling;
+		ApplyTapeHysteresisQuality();
+	}
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
+	void FSaturation::ApplyTapeHysteresisQuality()
+	{
+		const int32 Oversampling           = (QualityLevel >= EQualityLevel::ReducedOversampling) ? 1 : RequestedTapeHysteresisOversampling;
+		const ETapeHysteresisSolver Solver = (QualityLevel >= EQualityLevel::ReducedPrecision) ? ETapeHysteresisSolver::RK2 : RequestedTapeHysteresisSolver;
+
+		TapeHysteresis.SetOversampling(Oversampling);
+		TapeHysteresis.SetSolver(Solver);
+
+		for (FChannelPartition& Partition : ChannelPartitions)
+		{
+			Partition.TapeHysteresis.SetOversampling(Oversampling);
+			Partition.TapeHysteresis.SetSolver(Solver);
 		}
 	}
 
-	void FSaturation::Overdrive(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	ESaturationType FSaturation::GetGovernedSaturationType() const
 	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Gain_x_In	   = Gain * In_Plus_Bias;
-		//
-		//	  const float Gain_x_ClampIn	   = Gain * FMath::Clamp(In_Plus_Bias, -1.0f, 1.0f);
-		//	  const float Clamp_Gain_x_ClampIn = FMath::Clamp(Gain_x_ClampIn, -1.0f, 1.0f);
-		//
-		//	  float Out = 0.5f * FMath::Clamp(Gain_x_In, -1.0f, 1.0f) * (3.0f - Clamp_Gain_x_ClampIn * Clamp_Gain_x_ClampIn);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		if (QualityLevel >= EQualityLevel::Memoryless && RequestedSaturationType == ESaturationType::TapeHysteresis)
+		{
+			return ESaturationType::Tape;
+		}
 
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
+		return RequestedSaturationType;
+	}
+
+	void FSaturation::UpdateQualityLevel()
+	{
+		const EQualityLevel NewQualityLevel = FQualityGovernor::GetQualityLevel();
+
+		if (NewQualityLevel != QualityLevel)
 		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+			QualityLevel = NewQualityLevel;
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
+			ApplyTapeHysteresisQuality();
+			SwitchSaturationType(GetGovernedSaturationType());
+		}
+	}
 
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+	void FSaturation::SetHarmonicWeight(const int32 InHarmonic, const float InWeight)
+	{
+		if (InHarmonic >= 1 && InHarmonic <= FHarmonicShaper::MaxHarmonic)
+		{
+			SetCaptureParam(CaptureParams.HarmonicWeights[InHarmonic], InWeight);
+		}
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+		HarmonicShaper.SetHarmonicWeight(InHarmonic, InWeight);
 
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+		for (FChannelPartition& Partition : ChannelPartitions)
+		{
+			Partition.HarmonicShaper.SetHarmonicWeight(InHarmonic, InWeight);
+		}
+	}
 
-			//const float Gain_x_ClampIn = Gain * FMath::Clamp(In_Plus_Bias, -1.0f, 1.0f);
-			const VectorRegister4Float ClampIn        = AudioUtils::VectorClampMinusOneToOne(In_Plus_Bias);
-			const VectorRegister4Float Gain_x_ClampIn = VectorMultiply(VGain, ClampIn);
+	void FSaturation::SetCustomCurve(const TSharedPtr<const FSharedTransferCurve>& InCustomCurve)
+	{
+		CustomCurve = InCustomCurve;
+	}
 
-			//const float Clamp_Gain_x_ClampIn = FMath::Clamp(Gain_x_ClampIn, -1.0f, 1.0f);
-			const VectorRegister4Float Clamp_Gain_x_ClampIn = AudioUtils::VectorClampMinusOneToOne(Gain_x_ClampIn);
+	void FSaturation::ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSaturation::ProcessAudioBuffer"))
 
-			//float Out = 0.5f * FMath::Clamp(Gain_x_In, -1.0f, 1.0f) * (3.0f - Clamp_Gain_x_ClampIn * Clamp_Gain_x_ClampIn);
-			const VectorRegister4Float Clamp_Gain_x_In                      = AudioUtils::VectorClampMinusOneToOne(Gain_x_In);
-			const VectorRegister4Float Clamp_Gain_x_ClampIn_Sqr             = VectorMultiply(Clamp_Gain_x_ClampIn, Clamp_Gain_x_ClampIn);
-			const VectorRegister4Float Three_Minus_Clamp_Gain_x_ClampIn_Sqr = VectorSubtract(AudioUtils::VThrees, Clamp_Gain_x_ClampIn_Sqr);
+		if (FBlockCapture::IsCapturing())
+		{
+			CaptureBlock(InBuffer, InNumSamples, EBlockCaptureFlags::None);
+		}
 
-			VectorRegister4Float Out = VectorMultiply(AudioUtils::VOneHalf, VectorMultiply(Clamp_Gain_x_In, Three_Minus_Clamp_Gain_x_ClampIn_Sqr));
+		FQualityGovernor::FScopedMeasure QualityGovernorMeasure;
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+		UpdateQualityLevel();
+		UpdateTypeCrossfade();
 
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+		if (ProcessStaticFastPaths(InBuffer, OutBuffer, InNumSamples))
+		{
+			return;
+		}
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
+		bDCBlockerActive    = DCBlocker.BeginBuffer();
+		bPreEmphasisActive  = PreEmphasis.BeginBuffer();
+		bPostEmphasisActive = PostEmphasis.BeginBuffer();
+
+		UpdateEnvelopeFollowerActive();
+
+		// The scratch buffers hold MaxBlockFrames, longer blocks go in chunks. The kernels step the smoothers per vector, so this is seamless
+		const int32 MaxChunkSamples = MaxBlockFrames * NumChannels;
+
+		for (int32 ChunkOffset = 0; ChunkOffset < InNumSamples; ChunkOffset += MaxChunkSamples)
+		{
+			// Process with selected saturation algorithm
+			(this->*(SelectedSaturationTypePtr))(InBuffer + ChunkOffset, OutBuffer + ChunkOffset, FMath::Min(MaxChunkSamples, InNumSamples - ChunkOffset));
 		}
 	}
 
-	void FSaturation::Tube(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	void FSaturation::CaptureBlock(const float* InBuffer, const int32 InNumSamples, const EBlockCaptureFlags InFlags)
 	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Gain_x_In	   = Gain * In_Plus_Bias;
-		//
-		//	  float Out = (In_Plus_Bias > 0.0f) ? Gain_x_In : Gain_x_In * FMath::InvSqrt(Gain_x_In * Gain_x_In + 1.0f);
-		//	  Out = FMath::Clamp(Out, -1.0f, 1.0f);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		const EBlockCaptureFlags Flags = bCaptureParamsChanged ? InFlags | EBlockCaptureFlags::ParamsChanged : InFlags;
 
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
+		FBlockCapture::CaptureBlock(EBlockCaptureProcessor::Saturation, CaptureInstanceId, SampleRate, NumChannels, Flags, &CaptureParams, sizeof(CaptureParams), InBuffer, InNumSamples);
+
+		bCaptureParamsChanged = false;
+	}
+
+	void FSaturation::ApplyCaptureParams(const FCaptureParams& InParams)
+	{
+		// Same order as the effects: the gain range depends on the type
+		SetSaturationType(InParams.SaturationType);
+		SetGain(InParams.Gain);
+		SetBias(InParams.Bias);
+		SetMix(InParams.Mix);
+		SetOutLevelDb(InParams.OutLevelDb);
+		SetMidSideEnabled(InParams.bMidSideEnabled);
+		SetSideGain(InParams.SideGain);
+		SetSideBias(InParams.SideBias);
+		SetSideMix(InParams.SideMix);
+		SetDCBlockerEnabled(InParams.bDCBlockerEnabled);
+
+		// 0 until a cutoff was set, the blocker keeps its default then
+		if (InParams.DCBlockerCutoffFrequency > 0.0f)
 		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+			SetDCBlockerCutoffFrequency(InParams.DCBlockerCutoffFrequency);
+		}
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
+		SetEnvelopeFollowerEnabled(InParams.bEnvelopeFollowerEnabled);
+		SetEnvelopeDetectorMode(InParams.EnvelopeDetectorMode);
+		SetEnvelopeAttackTimeMs(InParams.EnvelopeAttackTimeMs);
+		SetEnvelopeReleaseTimeMs(InParams.EnvelopeReleaseTimeMs);
+		SetEnvelopeToGain(InParams.EnvelopeToGain);
+		SetEnvelopeToBias(InParams.EnvelopeToBias);
+		SetTapeHysteresisSolver(InParams.TapeHysteresisSolver);
+		SetTapeHysteresisOversampling(InParams.TapeHysteresisOversampling);
+		SetMaxChannelPartitions(InParams.MaxChannelPartitions);
+
+		for (int32 Harmonic = 1; Harmonic <= FHarmonicShaper::MaxHarmonic; ++Harmonic)
+		{
+			SetHarmonicWeight(Harmonic, InParams.HarmonicWeights[Harmonic]);
+		}
 
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+		for (int32 BandIndex = 0; BandIndex < FEmphasisFilter::MaxNumBands; ++BandIndex)
+		{
+			SetPreEmphasisBand(BandIndex, InParams.PreEmphasisBands[BandIndex]);
+			SetPostEmphasisBand(BandIndex, InParams.PostEmphasisBands[BandIndex]);
+		}
+	}
+
+	bool FSaturation::SupportsChannelPartitions(const int32 InNumChannels)
+	{
+		return InNumChannels % 4 == 0;
+	}
+
+	void FSaturation::SetMaxChannelPartitions(const int32 InMaxChannelPartitions)
+	{
+		SetCaptureParam(CaptureParams.MaxChannelPartitions, InMaxChannelPartitions);
+
+		const int32 NewMaxChannelPartitions = FMath::Max(InMaxChannelPartitions, 1);
+
+		if (NewMaxChannelPartitions != MaxChannelPartitions)
+		{
+			MaxChannelPartitions = NewMaxChannelPartitions;
+			UpdateChannelPartitions();
+		}
+	}
+
+	int32 FSaturation::GetNumChannelPartitions() const
+	{
+		return ChannelPartitions.Num();
+	}
+
+	void FSaturation::ProcessAudioBufferPartitioned(const float* InBuffer, float* OutBuffer, const int32 InNumSamples, const bool bInUseWorkers)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSaturation::ProcessAudioBufferPartitioned"))
+
+		if (ChannelPartitions.IsEmpty())
+		{
+			ProcessAudioBuffer(InBuffer, OutBuffer, InNumSamples);
+			return;
+		}
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+		if (FBlockCapture::IsCapturing())
+		{
+			CaptureBlock(InBuffer, InNumSamples, bInUseWorkers ? EBlockCaptureFlags::Partitioned | EBlockCaptureFlags::UseWorkers : EBlockCaptureFlags::Partitioned);
+		}
+
+		FQualityGovernor::FScopedMeasure QualityGovernorMeasure;
+
+		UpdateQualityLevel();
+		UpdateTypeCrossfade();
+
+		if (ProcessStaticFastPaths(InBuffer, OutBuffer, InNumSamples))
+		{
+			return;
+		}
+
+		UpdateEnvelopeFollowerActive();
 
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+		// The VectorParam arrays and the partition buffers hold MaxBlockFrames, longer blocks go in chunks
+		const int32 MaxChunkSamples = MaxBlockFrames * NumChannels;
 
-			//float Out = (In_Plus_Bias > 0.0f) ? Gain_x_In : Gain_x_In * FMath::InvSqrt(Gain_x_In * Gain_x_In + 1.0f);
-			const VectorRegister4Float Gain_x_In_Sqr_Plus_One = VectorMultiplyAdd(Gain_x_In, Gain_x_In, AudioUtils::VOnes);
-			const VectorRegister4Float Gain_x_In_Over_Sqrt_Gain_x_In_Sqr_Plus_One = VectorMultiply(Gain_x_In, VectorReciprocalSqrt(Gain_x_In_Sqr_Plus_One));
+		for (int32 ChunkOffset = 0; ChunkOffset < InNumSamples; ChunkOffset += MaxChunkSamples)
+		{
+			const float* ChunkInBuffer  = InBuffer + ChunkOffset;
+			float* ChunkOutBuffer       = OutBuffer + ChunkOffset;
+			const int32 NumChunkSamples = FMath::Min(MaxChunkSamples, InNumSamples - ChunkOffset);
+			const int32 NumChunkFrames  = NumChunkSamples / NumChannels;
 
-			AlignedFloat4 Out_Float4(Gain_x_In);
+			// Reads the whole chunk before any partition writes, so in place processing is fine
+			StepVectorParams(ChunkInBuffer, NumChunkSamples);
 
-			for (uint32 j = 0; j < 4; ++j)
+			// The partitions only share read-only state, ParallelFor joins before returning
+			ParallelFor(ChannelPartitions.Num(), [this, ChunkInBuffer, ChunkOutBuffer, NumChunkFrames](int32 PartitionIndex)
 			{
-				if (VectorGetComponentDynamic(In_Plus_Bias, j) < 0.0f)
-				{
-					Out_Float4[j] = VectorGetComponentDynamic(Gain_x_In_Over_Sqrt_Gain_x_In_Sqr_Plus_One, j);
-				}
+				FChannelPartition& Partition = ChannelPartitions[PartitionIndex];
+				Partition.bDCBlockerActive    = Partition.DCBlocker.BeginBuffer();
+				Partition.bPreEmphasisActive  = Partition.PreEmphasis.BeginBuffer();
+				Partition.bPostEmphasisActive = Partition.PostEmphasis.BeginBuffer();
+
+				(this->*(SelectedPartitionSaturationTypePtr))(Partition, ChunkInBuffer, ChunkOutBuffer, NumChunkFrames);
+			},
+			bInUseWorkers ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+		}
+	}
+
+	SIZE_T FSaturation::GetAllocatedSize() const
+	{
+		SIZE_T AllocatedSize = TapeHysteresisBuffer.GetAllocatedSize() + TapeHysteresis.GetAllocatedSize() + DCBlocker.GetAllocatedSize();
+		AllocatedSize += PreEmphasis.GetAllocatedSize() + PostEmphasis.GetAllocatedSize();
+
+		AllocatedSize += ChannelPartitions.GetAllocatedSize();
+		for (const FChannelPartition& Partition : ChannelPartitions)
+		{
+			AllocatedSize += Partition.TapeHysteresisBuffer.GetAllocatedSize() + Partition.TapeHysteresis.GetAllocatedSize() + Partition.DCBlocker.GetAllocatedSize();
+			AllocatedSize += Partition.TypeCrossfadeBuffer.GetAllocatedSize();
+			AllocatedSize += Partition.PreEmphasis.GetAllocatedSize() + Partition.PostEmphasis.GetAllocatedSize();
+		}
+
+		AllocatedSize += VectorGains.GetAllocatedSize() + VectorBiases.GetAllocatedSize() + VectorMixes.GetAllocatedSize() + VectorOutLevels.GetAllocatedSize();
+		AllocatedSize += VectorTypeCrossfades.GetAllocatedSize() + VectorPreviousGains.GetAllocatedSize();
+		AllocatedSize += TypeCrossfadeBuffer.GetAllocatedSize() + TypeCrossfadeWeights.GetAllocatedSize();
+
+		return AllocatedSize;
+	}
+
+	bool FSaturation::ProcessStaticFastPaths(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	{
+		// Skip processing if OutLevel == 0
+		if (OutLevelParamSmoother.IsSettled() && OutLevelParamSmoother.GetCurrentValue() == 0.0f)
+		{
+			FMemory::Memzero(OutBuffer, sizeof(float) * InNumSamples);
+			return true;
+		}
+
+		// Skip processing if OutLevel==1 and Mix == 0, in mid/side mode the side Mix has to be 0 as well
+		if (OutLevelParamSmoother.IsSettled() && OutLevelParamSmoother.GetCurrentValue() == 1.0f
+			&& MixParamSmoother.IsSettled() && MixParamSmoother.GetCurrentValue() == 0.0f
+			&& (!bMidSideActive || (SideMixParamSmoother.IsSettled() && SideMixParamSmoother.GetCurrentValue() == 0.0f)))
+		{
+			if (OutBuffer != InBuffer)
+			{
+				FMemory::Memcpy(OutBuffer, InBuffer, sizeof(float) * InNumSamples);
 			}
+			return true;
+		}
 
-			VectorRegister4Float Out = Out_Float4.ToVectorRegister();
-			
-			//Out = FMath::Clamp(Gain_x_In, -1.0f, 1.0f);
-			Out = AudioUtils::VectorClampMinusOneToOne(Gain_x_In);
+		return false;
+	}
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+	void FSaturation::UpdateEnvelopeFollowerActive()
+	{
+		// Keep running while the modulation fades out after disabling the envelope follower
+		const bool bWasEnvelopeFollowerActive = bEnvelopeFollowerActive;
+		bEnvelopeFollowerActive = bEnvelopeFollowerEnabled
+							   || !EnvelopeToGainParamSmoother.IsSettled() || EnvelopeToGainParamSmoother.GetCurrentValue() != 0.0f
+							   || !EnvelopeToBiasParamSmoother.IsSettled() || EnvelopeToBiasParamSmoother.GetCurrentValue() != 0.0f;
 
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+		if (bEnvelopeFollowerActive && !bWasEnvelopeFollowerActive)
+		{
+			EnvelopeFollower.Reset();
+		}
+	}
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
+	void FSaturation::UpdateMidSideActive()
+	{
+		const bool bNewMidSideActive = bMidSideEnabled && NumChannels == 2;
+
+		if (bNewMidSideActive != bMidSideActive)
+		{
+			bMidSideActive = bNewMidSideActive;
+			UpdateSelectedKernels();
 		}
 	}
 
-	void FSaturation::Tube2(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	void FSaturation::UpdateTypeCrossfade()
 	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//
-		//	  float Out = FMath::Pow(FMath::Clamp(In_Plus_Bias, -1.0f, 1.0f) + 1.0f, Gain) - 1.0f;
-		//
-		//	  Out = FMath::Clamp(Out, -1.0f, 1.0f);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		bHasProcessedAudio = true;
 
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
+		if (bTypeCrossfadeActive && TypeCrossfadeParamSmoother.IsSettled())
 		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+			bTypeCrossfadeActive = false;
+			UpdateSelectedKernels();
+		}
+	}
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
+	void FSaturation::UpdateChannelPartitions()
+	{
+		if (!SupportsChannelPartitions(NumChannels) || MaxChannelPartitions < 2)
+		{
+			ChannelPartitions.Empty();
+			AllocatePartitionBuffers();
+			return;
+		}
 
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+		const int32 NumGroups     = NumChannels / 4;
+		const int32 NumPartitions = FMath::Min(MaxChannelPartitions, NumGroups);
+
+		ChannelPartitions.SetNum(NumPartitions);
+
+		for (int32 PartitionIndex = 0; PartitionIndex < NumPartitions; ++PartitionIndex)
+		{
+			// Whole groups of 4 channels, spread as evenly as possible
+			const int32 FirstGroup = PartitionIndex * NumGroups / NumPartitions;
+			const int32 EndGroup   = (PartitionIndex + 1) * NumGroups / NumPartitions;
+
+			FChannelPartition& Partition = ChannelPartitions[PartitionIndex];
+			Partition.ChannelOffset = FirstGroup * 4;
+			Partition.NumChannels   = (EndGroup - FirstGroup) * 4;
+
+			// Copy the settings and smoothing state of the full width processors, then resize, which also clears the filter states
+			Partition.DCBlocker      = DCBlocker;
+			Partition.TapeHysteresis = TapeHysteresis;
+			Partition.HarmonicShaper = HarmonicShaper;
+			Partition.PreEmphasis    = PreEmphasis;
+			Partition.PostEmphasis   = PostEmphasis;
+			Partition.DCBlocker.SetNumChannels(Partition.NumChannels);
+			Partition.TapeHysteresis.SetNumChannels(Partition.NumChannels);
+			Partition.HarmonicShaper.SetNumChannels(Partition.NumChannels);
+			Partition.PreEmphasis.SetNumChannels(Partition.NumChannels);
+			Partition.PostEmphasis.SetNumChannels(Partition.NumChannels);
+			Partition.DCBlocker.Reset();
+			Partition.TapeHysteresis.Reset();
+			Partition.PreEmphasis.Reset();
+			Partition.PostEmphasis.Reset();
+		}
+
+		AllocatePartitionBuffers();
+	}
+
+	void FSaturation::AllocateScratchBuffers()
+	{
+		// The type can change on any block (and crossfade from/to TapeHysteresis), so they're always there. The oversampling runs per vector, no buffer
+		const int32 MaxNumSamples = MaxBlockFrames * MaxNumChannels;
+
+		TapeHysteresisBuffer.SetNumUninitialized(MaxNumSamples);
+		TypeCrossfadeBuffer.SetNumUninitialized(MaxNumSamples);
+		TypeCrossfadeWeights.SetNumUninitialized(MaxNumSamples / 4);
+	}
+
+	void FSaturation::AllocatePartitionBuffers()
+	{
+		if (ChannelPartitions.IsEmpty())
+		{
+			VectorGains.Empty();
+			VectorBiases.Empty();
+			VectorMixes.Empty();
+			VectorOutLevels.Empty();
+			VectorTypeCrossfades.Empty();
+			VectorPreviousGains.Empty();
+			return;
+		}
+
+		// The type crossfade can start on any block, so its arrays are always there
+		const int32 MaxNumVectors = MaxBlockFrames * NumChannels / 4;
+
+		VectorGains.SetNumUninitialized(MaxNumVectors);
+		VectorBiases.SetNumUninitialized(MaxNumVectors);
+		VectorMixes.SetNumUninitialized(MaxNumVectors);
+		VectorOutLevels.SetNumUninitialized(MaxNumVectors);
+		VectorTypeCrossfades.SetNumUninitialized(MaxNumVectors);
+		VectorPreviousGains.SetNumUninitialized(MaxNumVectors);
+
+		for (FChannelPartition& Partition : ChannelPartitions)
+		{
+			Partition.TapeHysteresisBuffer.SetNumUninitialized(MaxBlockFrames * Partition.NumChannels);
+			Partition.TypeCrossfadeBuffer.SetNumUninitialized(MaxBlockFrames * Partition.NumChannels);
+		}
+	}
+
+	void FSaturation::StepVectorParams(const float* InBuffer, const int32 InNumSamples)
+	{
+		const int32 NumVectors = InNumSamples / 4;
+
+		// Sized by AllocatePartitionBuffers
+		check(NumVectors <= VectorGains.Num());
+
+		// Same steps as ProcessSaturation/ProcessTapeHysteresis, the smoothers and the envelope run at the rate they were initialized for
+		for (int32 Vector = 0; Vector < NumVectors; ++Vector)
+		{
+			float CurrentGain = GainParamSmoother.GetValue();
+			float CurrentBias = BiasParamSmoother.GetValue();
+
+			ApplyEnvelopeModulation(VectorLoadAligned(&InBuffer[Vector * 4]), CurrentGain, CurrentBias);
+
+			VectorGains[Vector]     = CurrentGain;
+			VectorBiases[Vector]    = CurrentBias;
+			VectorMixes[Vector]     = MixParamSmoother.GetValue();
+			VectorOutLevels[Vector] = OutLevelParamSmoother.GetValue();
+
+			if (bTypeCrossfadeActive)
+			{
+				VectorTypeCrossfades[Vector] = TypeCrossfadeParamSmoother.GetValue();
+				VectorPreviousGains[Vector]  = CurrentGain * PreviousGainScale + PreviousGainOffset;
+			}
+		}
+	}
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+	template <ESaturationType SaturationTypeT>
+	FORCEINLINE VectorRegister4Float FSaturation::Saturate(FHarmonicShaper& InOutHarmonicShaper, const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain) const
+	{
+		if constexpr (SaturationTypeT == ESaturationType::Harmonic)
+		{
+			return InOutHarmonicShaper.ProcessVector(In_Plus_Bias, VGain);
+		}
+		else if constexpr (SaturationTypeT == ESaturationType::Custom)
+		{
+			return SaturateCustom(In_Plus_Bias, VGain);
+		}
+		else
+		{
+			return SaturationUtils::VectorSaturate<SaturationTypeT>(In_Plus_Bias, VGain);
+		}
+	}
 
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+	FORCEINLINE VectorRegister4Float FSaturation::Saturate(FHarmonicShaper& InOutHarmonicShaper, const ESaturationType InSaturationType, const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain) const
+	{
+		switch (InSaturationType)
+		{
+			case ESaturationType::Harmonic: return InOutHarmonicShaper.ProcessVector(In_Plus_Bias, VGain);
+			case ESaturationType::Custom:   return SaturateCustom(In_Plus_Bias, VGain);
+			default:                        return SaturationUtils::VectorSaturate(InSaturationType, In_Plus_Bias, VGain);
+		}
+	}
 
-			//float Out = FMath::Pow(FMath::Clamp(In_Plus_Bias, -1.0f, 1.0f) + 1.0f, Gain) - 1.0f;
-			const VectorRegister4Float Clamp_In_Plus_Bias_Plus_One = VectorAdd(AudioUtils::VectorClampMinusOneToOne(In_Plus_Bias), AudioUtils::VOnes);
-			const VectorRegister4Float Pow_Clamp_In_Plus_Bias_Plus_One_To_Gain = VectorPow(Clamp_In_Plus_Bias_Plus_One, VGain);
-			VectorRegister4Float Out = VectorSubtract(Pow_Clamp_In_Plus_Bias_Plus_One_To_Gain, AudioUtils::VOnes);
+	FORCEINLINE VectorRegister4Float FSaturation::SaturateCustom(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain) const
+	{
+		const FSharedTransferCurve* Curve = CustomCurve.Get();
 
-			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
-			Out = AudioUtils::VectorClampMinusOneToOne(Out);
+		return Curve ? Curve->ProcessVector(In_Plus_Bias, VGain) : SaturationUtils::VectorSaturate<ESaturationType::Tape>(In_Plus_Bias, VGain);
+	}
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+	FORCEINLINE void FSaturation::ApplyEnvelopeModulation(const VectorRegister4Float& In, float& InOutGain, float& InOutBias)
+	{
+		// Envelope modulation, once per vector
+		if (bEnvelopeFollowerActive)
+		{
+			const float Envelope = FMath::Min(EnvelopeFollower.ProcessVector(In), 1.0f);
+			ModulateGainAndBias(Envelope, EnvelopeToGainParamSmoother.GetValue(), EnvelopeToBiasParamSmoother.GetValue(), InOutGain, InOutBias);
+		}
+	}
 
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+	FORCEINLINE void FSaturation::ApplyEnvelopeModulation(const VectorRegister4Float& In, float& InOutGain, float& InOutBias, float& InOutSideGain, float& InOutSideBias)
+	{
+		// Mid/side, one envelope and one step of the modulation depths for both components
+		if (bEnvelopeFollowerActive)
+		{
+			const float Envelope         = FMath::Min(EnvelopeFollower.ProcessVector(In), 1.0f);
+			const float CurrentEnvToGain = EnvelopeToGainParamSmoother.GetValue();
+			const float CurrentEnvToBias = EnvelopeToBiasParamSmoother.GetValue();
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
+			ModulateGainAndBias(Envelope, CurrentEnvToGain, CurrentEnvToBias, InOutGain, InOutBias);
+			ModulateGainAndBias(Envelope, CurrentEnvToGain, CurrentEnvToBias, InOutSideGain, InOutSideBias);
 		}
 	}
 
-	void FSaturation::Distortion(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	FORCEINLINE void FSaturation::ModulateGainAndBias(const float InEnvelope, const float InEnvelopeToGain, const float InEnvelopeToBias, float& InOutGain, float& InOutBias) const
+	{
+		// A negative depth pushes the gain up on quiet parts, it stays in the range of the type like a positive one
+		InOutGain = FMath::Clamp(InOutGain * (1.0f + InEnvelopeToGain * (InEnvelope - 1.0f)), MinGain, MaxGain);
+		InOutBias = FMath::Clamp(InOutBias + InEnvelopeToBias * InEnvelope, -1.0f, 1.0f);
+	}
+
+	template <ESaturationType SaturationTypeT, bool bCrossfadeT, bool bMidSideT>
+	void FSaturation::ProcessSaturation(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
 	{
 		// Sequential version
 		//for (int32 i = 0; i < InNumSamples; ++i)
 		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
+		//	  float Gain		   = GainParamSmoother.GetValue();
+		//	  float Bias		   = BiasParamSmoother.GetValue();
 		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
 		//	  const float Mix	   = MixParamSmoother.GetValue();
 		//
 		//	  const float In = InBuffer[i];
 		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Gain_x_In	   = Gain * In_Plus_Bias;
+		//	  const float Envelope = FMath::Min(EnvelopeFollower(In), 1.0f);
+		//	  Gain = FMath::Clamp(Gain * (1.0f + EnvelopeToGain * (Envelope - 1.0f)), MinGain, MaxGain);
+		//	  Bias = FMath::Clamp(Bias + EnvelopeToBias * Envelope, -1.0f, 1.0f);
 		//
-		//	  float Out = SaturationUtils::FastTanh(Gain_x_In) / SaturationUtils::FastTanh(Gain);
+		//	  const float In_Plus_Bias = PreEmphasis(In) + Bias;
 		//
-		//	  Out = FMath::Clamp(Out, -1.0f, 1.0f);
+		//	  float Out = Saturate(In_Plus_Bias, Gain);
+		//	  Out = PostEmphasis(Out);
 		//
 		//	  Out = Out * Mix + (1.0f - Mix) * In;
 		//	  Out = Out * OutLevel;
 		//
+		//	  Out = DCBlocker(Out);
+		//
 		//	  OutBuffer[i] = Out;
 		//}
+		//
+		// In mid/side mode In is the M or S component, with the side Gain/Bias/Mix on the S lanes, and Out is decoded back before OutLevel
 
 		// Vectorized version
 		for (int32 i = 0; i < InNumSamples; i += 4)
 		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
+			float CurrentGain           = GainParamSmoother.GetValue();
+			float CurrentBias           = BiasParamSmoother.GetValue();
 			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
 			const float CurrentMix      = MixParamSmoother.GetValue();
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
-
 			//const float In = InBuffer[i];
 			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
-
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
-
-			//float Out = FMath::Atan(Gain_x_In) / FMath::Atan(Gain);
-			const VectorRegister4Float OneOverAtanGain = VectorReciprocal(SaturationUtils::VectorTanh(VGain));
-			VectorRegister4Float Out = SaturationUtils::VectorTanh(Gain_x_In);
-			Out = VectorMultiply(Out, OneOverAtanGain);
-
-			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
-			Out = AudioUtils::VectorClampMinusOneToOne(Out);
-
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
-
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
-
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
-		}
-	}
+			VectorRegister4Float Dry;
+			VectorRegister4Float VGain;
+			VectorRegister4Float VBias;
+			VectorRegister4Float VMix;
 
-	void FSaturation::Metal(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
-	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Gain_x_In	   = Gain * In_Plus_Bias;
-		//
-		//	  const float Abs_Clamp_Gain_x_In			= FMath::Abs(FMath::Clamp(Gain_x_In, -1.0f, 1.0f));
-		//	  const float Two_Minus_Abs_Clamp_Gain_x_In = 2.0f - Abs_Clamp_Gain_x_In;
-		//
-		//	  const float Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In = Abs_Clamp_Gain_x_In * Two_Minus_Abs_Clamp_Gain_x_In;
-		//
-		//	  float Out = (In_Plus_Bias > 0.0f) ? Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In : -Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In;
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+			if constexpr (bMidSideT)
+			{
+				float CurrentSideGain      = SideGainParamSmoother.GetValue();
+				float CurrentSideBias      = SideBiasParamSmoother.GetValue();
+				const float CurrentSideMix = SideMixParamSmoother.GetValue();
+
+				// The envelope follows L/R, and modulates both components
+				ApplyEnvelopeModulation(In, CurrentGain, CurrentBias, CurrentSideGain, CurrentSideBias);
+
+				//const float Dry = IsMidLane ? 0.5f * (L + R) : 0.5f * (L - R);
+				Dry   = AudioUtils::VectorMidSideEncode(In);
+				VGain = MakeVectorRegisterFloat(CurrentGain, CurrentSideGain, CurrentGain, CurrentSideGain);
+				VBias = MakeVectorRegisterFloat(CurrentBias, CurrentSideBias, CurrentBias, CurrentSideBias);
+				VMix  = MakeVectorRegisterFloat(CurrentMix,  CurrentSideMix,  CurrentMix,  CurrentSideMix);
+			}
+			else
+			{
+				ApplyEnvelopeModulation(In, CurrentGain, CurrentBias);
 
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
-		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+				Dry   = In;
+				VGain = VectorLoadFloat1(&CurrentGain);
+				VBias = VectorLoadFloat1(&CurrentBias);
+				VMix  = VectorLoadFloat1(&CurrentMix);
+			}
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
 			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
 
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+			//const float Driven = PreEmphasis(Dry);
+			const VectorRegister4Float Driven = bPreEmphasisActive ? PreEmphasis.ProcessVector(Dry) : Dry;
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+			//const float In_Plus_Bias = Driven + Bias;
+			const VectorRegister4Float In_Plus_Bias = VectorAdd(Driven, VBias);
 
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+			//float Out = Saturate(In_Plus_Bias, Gain);
+			VectorRegister4Float Out = Saturate<SaturationTypeT>(HarmonicShaper, In_Plus_Bias, VGain);
 
-			//const float Abs_Clamp_Gain_x_In = FMath::Abs(FMath::Clamp(Gain_x_In, -1.0f, 1.0f));
-			const VectorRegister4Float Abs_Clamp_Gain_x_In = VectorAbs(AudioUtils::VectorClampMinusOneToOne(Gain_x_In));
+			if constexpr (bCrossfadeT)
+			{
+				const float TypeCrossfade = TypeCrossfadeParamSmoother.GetValue();
 
-			//const float Two_Minus_Abs_Clamp_Gain_x_In = 2.0f - Abs_Clamp_Gain_x_In;
-			const VectorRegister4Float Two_Minus_Abs_Clamp_Gain_x_In = VectorSubtract(AudioUtils::VTwos, Abs_Clamp_Gain_x_In);
+				//const float PreviousGain = Gain * PreviousGainScale + PreviousGainOffset;
+				const VectorRegister4Float VPreviousGain = VectorMultiplyAdd(VGain, VectorLoadFloat1(&PreviousGainScale), VectorLoadFloat1(&PreviousGainOffset));
 
-			//const float Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In = Abs_Clamp_Gain_x_In * Two_Minus_Abs_Clamp_Gain_x_In;
-			const VectorRegister4Float Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In = VectorMultiply(Abs_Clamp_Gain_x_In, Two_Minus_Abs_Clamp_Gain_x_In);
+				//const float PreviousOut = PreviousSaturate(In_Plus_Bias, PreviousGain);
+				const VectorRegister4Float PreviousOut = Saturate(HarmonicShaper, PreviousSaturationType, In_Plus_Bias, VPreviousGain);
 
-			//float Out = (In_Plus_Bias > 0.0f) ? Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In : -Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In;
-			AlignedFloat4 Out_Float4(Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In);
+				//Out = PreviousOut + TypeCrossfade * (Out - PreviousOut);
+				Out = VectorMultiplyAdd(VectorLoadFloat1(&TypeCrossfade), VectorSubtract(Out, PreviousOut), PreviousOut);
+			}
 
-			for (uint32 j = 0; j < 4; ++j)
+			//Out = PostEmphasis(Out);
+			if (bPostEmphasisActive)
 			{
-				if (VectorGetComponentDynamic(In_Plus_Bias, j) < 0.0f)
-				{
-					Out_Float4[j] = -Out_Float4[j];
-				}
+				Out = PostEmphasis.ProcessVector(Out);
 			}
 
-			VectorRegister4Float Out = Out_Float4.ToVectorRegister();
+			//Out = Out * Mix + (1.0f - Mix) * Dry;
+			AudioUtils::VectorMix(Dry, VMix, Out);
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+			if constexpr (bMidSideT)
+			{
+				//Out = IsLeftLane ? M + S : M - S;
+				Out = AudioUtils::VectorMidSideDecode(Out);
+			}
 
 			//Out = Out * OutputLevel;
 			Out = VectorMultiply(Out, VOutLevel);
 
+			//Out = DCBlocker(Out);
+			if (bDCBlockerActive)
+			{
+				Out = DCBlocker.ProcessVector(Out);
+			}
+
 			//OutBuffer[i] = Out;
 			VectorStoreAligned(Out, &OutBuffer[i]);
 		}
 	}
 
-	void FSaturation::Fuzz(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	template <bool bCrossfadeT, bool bMidSideT>
+	void FSaturation::ProcessTapeHysteresis(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
 	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Gain_x_In	   = Gain * In_Plus_Bias;
-		//
-		//	  const float Gain_x_In_Over_Abs_Gain_x_In = Gain_x_In / (FMath::Abs(Gain_x_In) + AudioUtils::Eps);
-		//
-		//	  float Out = -Gain_x_In_Over_Abs_Gain_x_In * (1.0f - FMath::Exp(Gain_x_In * Gain_x_In_Over_Abs_Gain_x_In));
-		//
-		//	  Out = FMath::Clamp(Out, -1.0f, 1.0f);
-		//	  
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		// Sized by AllocateScratchBuffers, ProcessAudioBuffer chunks the longer blocks
+		check(InNumSamples <= TapeHysteresisBuffer.Num());
 
-		// Vectorized version
+		float* HysteresisBuffer = TapeHysteresisBuffer.GetData();
+
+		// 1st pass: H = (PreEmphasis(Dry) + Bias) * Gain, Dry being In or its M/S encoding
 		for (int32 i = 0; i < InNumSamples; i += 4)
 		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
-
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
+			float CurrentGain = GainParamSmoother.GetValue();
+			float CurrentBias = BiasParamSmoother.GetValue();
 
-			//const float In = InBuffer[i];
 			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+			VectorRegister4Float Dry;
+			VectorRegister4Float VGain;
+			VectorRegister4Float VBias;
 
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+			if constexpr (bMidSideT)
+			{
+				float CurrentSideGain = SideGainParamSmoother.GetValue();
+				float CurrentSideBias = SideBiasParamSmoother.GetValue();
 
-			//const float Gain_x_In_Over_Abs_Gain_x_In = Gain_x_In / (FMath::Abs(Gain_x_In) + AudioUtils::Eps);
-			const VectorRegister4Float Gain_x_In_Over_Abs_Gain_x_In = VectorDivide(Gain_x_In, VectorAdd(VectorAbs(Gain_x_In), AudioUtils::VEps));
+				ApplyEnvelopeModulation(In, CurrentGain, CurrentBias, CurrentSideGain, CurrentSideBias);
 
-			//float Out = -Gain_x_In_Over_Abs_Gain_x_In * (1.0f - FMath::Exp(Gain_x_In * Gain_x_In_Over_Abs_Gain_x_In));
-			const VectorRegister4Float Gain_x_Gain_x_In_Over_Abs_Gain_x_In = VectorMultiply(Gain_x_In, Gain_x_In_Over_Abs_Gain_x_In);
-			const VectorRegister4Float Exp_Gain_x_Gain_x_In_Over_Abs_Gain_x_In = VectorExp(Gain_x_Gain_x_In_Over_Abs_Gain_x_In);
-			const VectorRegister4Float One_Minus_Exp_Gain_x_Gain_x_In_Over_Abs_Gain_x_In = VectorSubtract(AudioUtils::VOnes, Exp_Gain_x_Gain_x_In_Over_Abs_Gain_x_In);
-			VectorRegister4Float Out = VectorMultiply(VectorNegate(Gain_x_In_Over_Abs_Gain_x_In), One_Minus_Exp_Gain_x_Gain_x_In_Over_Abs_Gain_x_In);
+				Dry   = AudioUtils::VectorMidSideEncode(In);
+				VGain = MakeVectorRegisterFloat(CurrentGain, CurrentSideGain, CurrentGain, CurrentSideGain);
+				VBias = MakeVectorRegisterFloat(CurrentBias, CurrentSideBias, CurrentBias, CurrentSideBias);
+			}
+			else
+			{
+				ApplyEnvelopeModulation(In, CurrentGain, CurrentBias);
 
-			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
-			Out = AudioUtils::VectorClampMinusOneToOne(Out);
+				Dry   = In;
+				VGain = VectorLoadFloat1(&CurrentGain);
+				VBias = VectorLoadFloat1(&CurrentBias);
+			}
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+			const VectorRegister4Float Driven       = bPreEmphasisActive ? PreEmphasis.ProcessVector(Dry) : Dry;
+			const VectorRegister4Float In_Plus_Bias = VectorAdd(Driven, VBias);
 
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+			if constexpr (bCrossfadeT)
+			{
+				// TapeHysteresis is either the new curve or the previous one
+				const bool bIsTapeHysteresisFadingIn = (SaturationType == ESaturationType::TapeHysteresis);
+				const ESaturationType OtherType      = bIsTapeHysteresisFadingIn ? PreviousSaturationType : SaturationType;
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
+				const float TypeCrossfade    = TypeCrossfadeParamSmoother.GetValue();
+				const float HysteresisWeight = bIsTapeHysteresisFadingIn ? TypeCrossfade : 1.0f - TypeCrossfade;
+				const float OtherWeight      = 1.0f - HysteresisWeight;
+
+				const VectorRegister4Float VPreviousGain = VectorMultiplyAdd(VGain, VectorLoadFloat1(&PreviousGainScale), VectorLoadFloat1(&PreviousGainOffset));
+				const VectorRegister4Float VOtherGain    = bIsTapeHysteresisFadingIn ? VPreviousGain : VGain;
+
+				//TypeCrossfadeBuffer[i] = OtherSaturate(In + Bias, OtherGain) * OtherWeight;
+				const VectorRegister4Float OtherOut = Saturate(HarmonicShaper, OtherType, In_Plus_Bias, VOtherGain);
+				VectorStoreAligned(VectorMultiply(OtherOut, VectorLoadFloat1(&OtherWeight)), &TypeCrossfadeBuffer[i]);
+
+				TypeCrossfadeWeights[i / 4] = HysteresisWeight;
+				VGain                       = bIsTapeHysteresisFadingIn ? VGain : VPreviousGain;
+			}
+
+			VectorStoreAligned(VectorMultiply(In_Plus_Bias, VGain), &HysteresisBuffer[i]);
 		}
-	}
 
-	void FSaturation::HardClip(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
-	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Gain_x_In	   = Gain * In_Plus_Bias;
-		//
-		//	  float Out = FMath::Clamp(Gain_x_In, -1.0f, 1.0f);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		// 2nd pass: M = Hysteresis(H), channels in parallel
+		TapeHysteresis.ProcessInterleaved(HysteresisBuffer, InNumSamples);
 
-		// Vectorized version
+		// 3rd pass: PostEmphasis, Mix, M/S decoding, OutLevel and DC blocker
 		for (int32 i = 0; i < InNumSamples; i += 4)
 		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
 			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
 			const float CurrentMix      = MixParamSmoother.GetValue();
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
 			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
 
-			//const float In = InBuffer[i];
 			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+			VectorRegister4Float Out      = VectorLoadAligned(&HysteresisBuffer[i]);
+
+			VectorRegister4Float Dry;
+			VectorRegister4Float VMix;
+
+			if constexpr (bMidSideT)
+			{
+				const float CurrentSideMix = SideMixParamSmoother.GetValue();
+
+				Dry  = AudioUtils::VectorMidSideEncode(In);
+				VMix = MakeVectorRegisterFloat(CurrentMix, CurrentSideMix, CurrentMix, CurrentSideMix);
+			}
+			else
+			{
+				Dry  = In;
+				VMix = VectorLoadFloat1(&CurrentMix);
+			}
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+			if constexpr (bCrossfadeT)
+			{
+				//Out = Out * HysteresisWeight + TypeCrossfadeBuffer[i];
+				Out = VectorMultiplyAdd(Out, VectorLoadFloat1(&TypeCrossfadeWeights[i / 4]), VectorLoadAligned(&TypeCrossfadeBuffer[i]));
+			}
 
-			//const float Gain_x_In = Gain * In_Plus_Bias;
-			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+			//Out = PostEmphasis(Out);
+			if (bPostEmphasisActive)
+			{
+				Out = PostEmphasis.ProcessVector(Out);
+			}
 
-			//float Out = FMath::Clamp(Gain_x_In, -1.0f, 1.0f);
-			VectorRegister4Float Out = AudioUtils::VectorClampMinusOneToOne(Gain_x_In);
+			//Out = Out * Mix + (1.0f - Mix) * Dry;
+			AudioUtils::VectorMix(Dry, VMix, Out);
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+			if constexpr (bMidSideT)
+			{
+				Out = AudioUtils::VectorMidSideDecode(Out);
+			}
 
 			//Out = Out * OutputLevel;
 			Out = VectorMultiply(Out, VOutLevel);
 
-			//OutBuffer[i] = Out;
+			//Out = DCBlocker(Out);
+			if (bDCBlockerActive)
+			{
+				Out = DCBlocker.ProcessVector(Out);
+			}
+
 			VectorStoreAligned(Out, &OutBuffer[i]);
 		}
 	}
 
-	void FSaturation::Foldback(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	//------------------------------------------------------------------------------------
+	// Channel partitions
+	//------------------------------------------------------------------------------------
+	template <ESaturationType SaturationTypeT, bool bCrossfadeT>
+	void FSaturation::ProcessPartitionSaturation(FChannelPartition& Partition, const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
 	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Gain	   = GainParamSmoother.GetValue();
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//	  const float Two_x_Gain   = 2.0f * Gain;
-		//	  
-		//	  float Out = (In_Plus_Bias > Gain) ? Two_x_Gain - In_Plus_Bias
-		//										: (In_Plus_Bias < -Gain) ? -Two_x_Gain - In_Plus_Bias
-		//																 : In_Plus_Bias;
-		//
-		//	  Out = FMath::Clamp(Out, -1.0f, 1.0f);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
-
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
+		for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
 		{
-			const float CurrentGain     = GainParamSmoother.GetValue();
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+			const int32 FrameOffset = Frame * NumChannels + Partition.ChannelOffset;
 
-			const VectorRegister4Float VGain     = VectorLoadFloat1(&CurrentGain);
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
-
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
-
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+			for (int32 Channel = 0; Channel < Partition.NumChannels; Channel += 4)
+			{
+				// Index of this vector in the interleaved buffer, the parameters were stepped per vector
+				const int32 Vector = (FrameOffset + Channel) / 4;
 
-			//const float Two_x_Gain = 2.0f * Gain;
-			const VectorRegister4Float Two_x_Gain = VectorMultiply(AudioUtils::VTwos, VGain);
+				const VectorRegister4Float VGain     = VectorLoadFloat1(&VectorGains[Vector]);
+				const VectorRegister4Float VBias     = VectorLoadFloat1(&VectorBiases[Vector]);
+				const VectorRegister4Float VOutLevel = VectorLoadFloat1(&VectorOutLevels[Vector]);
+				const VectorRegister4Float VMix      = VectorLoadFloat1(&VectorMixes[Vector]);
 
-			//float Out = (In_Plus_Bias > Gain) ? Two_x_Gain - In_Plus_Bias
-			//									: (In_Plus_Bias < -Gain) ? -Two_x_Gain - In_Plus_Bias
-			//															 : In_Plus_Bias;
-			const VectorRegister4Float Two_x_Gain_Minus_In_Plus_Bias = VectorSubtract(Two_x_Gain, In_Plus_Bias);
+				const VectorRegister4Float In = VectorLoadAligned(&InBuffer[FrameOffset + Channel]);
 
-			AlignedFloat4 Out_Float4(In_Plus_Bias);
+				const VectorRegister4Float Driven       = Partition.bPreEmphasisActive ? Partition.PreEmphasis.ProcessVector(In) : In;
+				const VectorRegister4Float In_Plus_Bias = VectorAdd(Driven, VBias);
 
-			for (uint32 j = 0; j < 4; ++j)
-			{
-				const float In_Plus_Bias_Float = VectorGetComponentDynamic(In_Plus_Bias, j);
-				const float VGain_Float        = VectorGetComponentDynamic(VGain, j);
+				VectorRegister4Float Out = Saturate<SaturationTypeT>(Partition.HarmonicShaper, In_Plus_Bias, VGain);
 
-				if (In_Plus_Bias_Float > VGain_Float)
+				if constexpr (bCrossfadeT)
 				{
-					Out_Float4[j] = VectorGetComponentDynamic(Two_x_Gain_Minus_In_Plus_Bias, j);
+					const VectorRegister4Float PreviousOut = Saturate(Partition.HarmonicShaper, PreviousSaturationType, In_Plus_Bias, VectorLoadFloat1(&VectorPreviousGains[Vector]));
+					Out = VectorMultiplyAdd(VectorLoadFloat1(&VectorTypeCrossfades[Vector]), VectorSubtract(Out, PreviousOut), PreviousOut);
 				}
-				else if (In_Plus_Bias_Float < -VGain_Float)
+
+				if (Partition.bPostEmphasisActive)
 				{
-					Out_Float4[j] = -VectorGetComponentDynamic(Two_x_Gain, j) - In_Plus_Bias_Float;
+					Out = Partition.PostEmphasis.ProcessVector(Out);
 				}
-			}
-
-			VectorRegister4Float Out = Out_Float4.ToVectorRegister();
 
-			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
-			Out = AudioUtils::VectorClampMinusOneToOne(Out);
+				AudioUtils::VectorMix(In, VMix, Out);
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+				Out = VectorMultiply(Out, VOutLevel);
 
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+				if (Partition.bDCBlockerActive)
+				{
+					Out = Partition.DCBlocker.ProcessVector(Out);
+				}
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
+				VectorStoreAligned(Out, &OutBuffer[FrameOffset + Channel]);
+			}
 		}
 	}
 
-	void FSaturation::HalfWaveRectifier(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	template <bool bCrossfadeT>
+	void FSaturation::ProcessPartitionTapeHysteresis(FChannelPartition& Partition, const float* InBuffer, float* OutBuffer, const int32 InNumFrames)
 	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//
-		//	  float Out = (In_Plus_Bias > 0.0f) ? In_Plus_Bias : 0.0f;
-		//	  Out = FMath::Clamp(Out, -1.0f, 1.0f);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		const int32 NumPartitionSamples = InNumFrames * Partition.NumChannels;
 
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
-		{ 
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+		// Sized by AllocatePartitionBuffers
+		check(NumPartitionSamples <= Partition.TapeHysteresisBuffer.Num());
 
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
-
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+		float* HysteresisBuffer = Partition.TapeHysteresisBuffer.GetData();
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+		// TapeHysteresis is either the new curve or the previous one
+		const bool bIsTapeHysteresisFadingIn = (SaturationType == ESaturationType::TapeHysteresis);
+		const bool bUsePreviousGain          = bCrossfadeT && !bIsTapeHysteresisFadingIn;
 
-			//float Out = (In_Plus_Bias > 0.0f) ? In_Plus_Bias : 0.0f;
-			AlignedFloat4 Out_Float4(In_Plus_Bias);
+		// 1st pass: H = (PreEmphasis(In) + Bias) * Gain, gathered into the partition's own interleaved buffer
+		for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+		{
+			const int32 FrameOffset = Frame * NumChannels + Partition.ChannelOffset;
 
-			for (uint32 j = 0; j < 4; ++j)
+			for (int32 Channel = 0; Channel < Partition.NumChannels; Channel += 4)
 			{
-				if (Out_Float4[j] < 0.0f)
-				{
-					Out_Float4[j] = 0.0f;
-				}
-			}
+				const int32 Vector = (FrameOffset + Channel) / 4;
 
-			VectorRegister4Float Out = Out_Float4.ToVectorRegister();
+				const VectorRegister4Float VGain = VectorLoadFloat1(bUsePreviousGain ? &VectorPreviousGains[Vector] : &VectorGains[Vector]);
+				const VectorRegister4Float VBias = VectorLoadFloat1(&VectorBiases[Vector]);
 
-			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
-			Out = AudioUtils::VectorClampMinusOneToOne(Out);
+				const VectorRegister4Float In           = VectorLoadAligned(&InBuffer[FrameOffset + Channel]);
+				const VectorRegister4Float Driven       = Partition.bPreEmphasisActive ? Partition.PreEmphasis.ProcessVector(In) : In;
+				const VectorRegister4Float In_Plus_Bias = VectorAdd(Driven, VBias);
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+				if constexpr (bCrossfadeT)
+				{
+					const ESaturationType OtherType = bIsTapeHysteresisFadingIn ? PreviousSaturationType : SaturationType;
+					const float OtherGain           = bIsTapeHysteresisFadingIn ? VectorPreviousGains[Vector] : VectorGains[Vector];
+					const float OtherWeight         = bIsTapeHysteresisFadingIn ? 1.0f - VectorTypeCrossfades[Vector] : VectorTypeCrossfades[Vector];
 
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+					//TypeCrossfadeBuffer[i] = OtherSaturate(In + Bias, OtherGain) * OtherWeight;
+					const VectorRegister4Float OtherOut = Saturate(Partition.HarmonicShaper, OtherType, In_Plus_Bias, VectorLoadFloat1(&OtherGain));
+					VectorStoreAligned(VectorMultiply(OtherOut, VectorLoadFloat1(&OtherWeight)), &Partition.TypeCrossfadeBuffer[Frame * Partition.NumChannels + Channel]);
+				}
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
+				VectorStoreAligned(VectorMultiply(In_Plus_Bias, VGain), &HysteresisBuffer[Frame * Partition.NumChannels + Channel]);
+			}
 		}
-	}
 
-	void FSaturation::FullWaveRectifier(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
-	{
-		// Sequential version
-		//for (int32 i = 0; i < InNumSamples; ++i)
-		//{
-		//	  const float Bias	   = BiasParamSmoother.GetValue();
-		//	  const float OutLevel = OutLevelParamSmoother.GetValue();
-		//	  const float Mix	   = MixParamSmoother.GetValue();
-		//
-		//	  const float In = InBuffer[i];
-		//
-		//	  const float In_Plus_Bias = In + Bias;
-		//
-		//	  float Out = FMath::Abs(In_Plus_Bias);
-		//	  Out = FMath::Clamp(Out, -1.0f, 1.0f);
-		//
-		//	  Out = Out * Mix + (1.0f - Mix) * In;
-		//	  Out = Out * OutLevel;
-		//
-		//	  OutBuffer[i] = Out;
-		//}
+		// 2nd pass: M = Hysteresis(H)
+		Partition.TapeHysteresis.ProcessInterleaved(HysteresisBuffer, NumPartitionSamples);
 
-		// Vectorized version
-		for (int32 i = 0; i < InNumSamples; i += 4)
+		// 3rd pass: PostEmphasis, Mix, OutLevel and DC blocker, scattered back
+		for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
 		{
-			const float CurrentBias     = BiasParamSmoother.GetValue();
-			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
-			const float CurrentMix      = MixParamSmoother.GetValue();
+			const int32 FrameOffset = Frame * NumChannels + Partition.ChannelOffset;
 
-			const VectorRegister4Float VBias     = VectorLoadFloat1(&CurrentBias);
-			const VectorRegister4Float VOutLevel = VectorLoadFloat1(&CurrentOutLevel);
-			const VectorRegister4Float VMix      = VectorLoadFloat1(&CurrentMix);
+			for (int32 Channel = 0; Channel < Partition.NumChannels; Channel += 4)
+			{
+				const int32 Vector = (FrameOffset + Channel) / 4;
 
-			//const float In = InBuffer[i];
-			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+				const VectorRegister4Float VOutLevel = VectorLoadFloat1(&VectorOutLevels[Vector]);
+				const VectorRegister4Float VMix      = VectorLoadFloat1(&VectorMixes[Vector]);
 
-			//const float In_Plus_Bias = InBuffer[i] + Bias;
-			const VectorRegister4Float In_Plus_Bias = VectorAdd(In, VBias);
+				const VectorRegister4Float In = VectorLoadAligned(&InBuffer[FrameOffset + Channel]);
+				VectorRegister4Float Out      = VectorLoadAligned(&HysteresisBuffer[Frame * Partition.NumChannels + Channel]);
 
-			//float Out = FMath::Abs(In_Plus_Bias);
-			VectorRegister4Float Out = VectorAbs(In_Plus_Bias);
+				if constexpr (bCrossfadeT)
+				{
+					//Out = Out * HysteresisWeight + TypeCrossfadeBuffer[i];
+					const float HysteresisWeight = bIsTapeHysteresisFadingIn ? VectorTypeCrossfades[Vector] : 1.0f - VectorTypeCrossfades[Vector];
+					Out = VectorMultiplyAdd(Out, VectorLoadFloat1(&HysteresisWeight), VectorLoadAligned(&Partition.TypeCrossfadeBuffer[Frame * Partition.NumChannels + Channel]));
+				}
+
+				if (Partition.bPostEmphasisActive)
+				{
+					Out = Partition.PostEmphasis.ProcessVector(Out);
+				}
 
-			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
-			Out = AudioUtils::VectorClampMinusOneToOne(Out);
+				AudioUtils::VectorMix(In, VMix, Out);
 
-			//Out = Out * Mix + (1.0f - Mix) * In;
-			AudioUtils::VectorMix(In, VMix, Out);
+				Out = VectorMultiply(Out, VOutLevel);
 
-			//Out = Out * OutputLevel;
-			Out = VectorMultiply(Out, VOutLevel);
+				if (Partition.bDCBlockerActive)
+				{
+					Out = Partition.DCBlocker.ProcessVector(Out);
+				}
 
-			//OutBuffer[i] = Out;
-			VectorStoreAligned(Out, &OutBuffer[i]);
+				VectorStoreAligned(Out, &OutBuffer[FrameOffset + Channel]);
+			}
 		}
 	}
 }
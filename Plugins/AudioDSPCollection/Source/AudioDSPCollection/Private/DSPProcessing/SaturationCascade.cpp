@@ -0,0 +1,314 @@
+#include "DSPProcessing/SaturationCascade.h"
+#include "DSPProcessing/Helpers/AudioUtils.h"
+#include "DSPProcessing/Helpers/SaturationUtils.h"
+#include "DSP/Dsp.h"
+
+namespace DSPProcessing
+{
+	namespace SaturationCascadeUtils
+	{
+		// -96dB, same snapping threshold as ParamSmootherLPF
+		constexpr VectorRegister4Float VSettledThreshold = MakeVectorRegisterFloatConstant(1.58489e-05f, 1.58489e-05f, 1.58489e-05f, 1.58489e-05f);
+
+		// Same signature as FSaturationCascade::FVectorSaturateKernel
+		using FVectorSaturateKernel = VectorRegister4Float (*)(const VectorRegister4Float&, const VectorRegister4Float&);
+
+		// Only called with memoryless types (see SaturationUtils::IsMemoryless)
+		static FVectorSaturateKernel GetVectorSaturateKernel(const ESaturationType InSaturationType)
+		{
+			using namespace SaturationUtils;
+
+			switch (InSaturationType)
+			{
+				default:
+				case ESaturationType::Tape:              return &VectorSaturate<ESaturationType::Tape>;
+				case ESaturationType::Tape2:             return &VectorSaturate<ESaturationType::Tape2>;
+				case ESaturationType::Overdrive:         return &VectorSaturate<ESaturationType::Overdrive>;
+				case ESaturationType::Tube:              return &VectorSaturate<ESaturationType::Tube>;
+				case ESaturationType::Tube2:             return &VectorSaturate<ESaturationType::Tube2>;
+				case ESaturationType::Distortion:        return &VectorSaturate<ESaturationType::Distortion>;
+				case ESaturationType::Metal:             return &VectorSaturate<ESaturationType::Metal>;
+				case ESaturationType::Fuzz:              return &VectorSaturate<ESaturationType::Fuzz>;
+				case ESaturationType::HardClip:          return &VectorSaturate<ESaturationType::HardClip>;
+				case ESaturationType::Foldback:          return &VectorSaturate<ESaturationType::Foldback>;
+				case ESaturationType::HalfWaveRectifier: return &VectorSaturate<ESaturationType::HalfWaveRectifier>;
+				case ESaturationType::FullWaveRectifier: return &VectorSaturate<ESaturationType::FullWaveRectifier>;
+			}
+		}
+	}
+
+	FSaturationCascade::FSaturationCascade()
+		: VCurrentGains(AudioUtils::VOnes)
+		, VTargetGains(AudioUtils::VOnes)
+		, VCurrentBiases(AudioUtils::VZeros)
+		, VTargetBiases(AudioUtils::VZeros)
+		, VCurrentLevels(AudioUtils::VOnes)
+		, VTargetLevels(AudioUtils::VOnes)
+	{
+		for (int32 Stage = 0; Stage < MaxNumStages; ++Stage)
+		{
+			StageKernels[Stage] = SaturationCascadeUtils::GetVectorSaturateKernel(StageSaturationTypes[Stage]);
+		}
+	}
+
+	FSaturationCascade::~FSaturationCascade()
+	{
+
+	}
+
+	void FSaturationCascade::Init(const float InSampleRate, const int32 InNumChannels)
+	{
+		constexpr float SmoothingTimeInMs = 21.33f;
+
+		// Stepped once per vector, like the FSaturation smoothers
+		const float VectorRate = AudioUtils::GetVectorRate(InSampleRate, FMath::Max(InNumChannels, 1));
+
+		MixParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+		OutLevelParamSmoother.Init(SmoothingTimeInMs, VectorRate);
+
+		// Same one-pole response as ParamSmootherLPF
+		const float SmoothingTimeInSteps = FMath::Max(SmoothingTimeInMs * VectorRate * 0.001f, 1.0f);
+		SmoothingStep = 1.0f - FMath::Exp(-UE_TWO_PI / SmoothingTimeInSteps);
+
+		bStageParamsDirty       = true;
+		bFirstStageParamsUpdate = true;
+	}
+
+	void FSaturationCascade::SetNumStages(const int32 InNumStages)
+	{
+		NumStages = FMath::Clamp(InNumStages, MinNumStages, MaxNumStages);
+	}
+
+	void FSaturationCascade::SetStageSaturationType(const int32 InStageIndex, const ESaturationType InSaturationType)
+	{
+		if (InStageIndex < 0 || InStageIndex >= MaxNumStages)
+		{
+			return;
+		}
+
+		if (InSaturationType != StageSaturationTypes[InStageIndex])
+		{
+			StageSaturationTypes[InStageIndex] = InSaturationType;
+			bStageParamsDirty = true;
+		}
+	}
+
+	void FSaturationCascade::SetStageGain(const int32 InStageIndex, const float InGain)
+	{
+		if (InStageIndex < 0 || InStageIndex >= MaxNumStages)
+		{
+			return;
+		}
+
+		const float Gain = FMath::Clamp(InGain, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize [0, 1]
+
+		if (Gain != StageGains[InStageIndex])
+		{
+			StageGains[InStageIndex] = Gain;
+			bStageParamsDirty = true;
+		}
+	}
+
+	void FSaturationCascade::SetStageBias(const int32 InStageIndex, const float InBias)
+	{
+		if (InStageIndex < 0 || InStageIndex >= MaxNumStages)
+		{
+			return;
+		}
+
+		const float Bias = FMath::Clamp(InBias, -1.0f, 1.0f);
+
+		if (Bias != StageBiases[InStageIndex])
+		{
+			StageBiases[InStageIndex] = Bias;
+			bStageParamsDirty = true;
+		}
+	}
+
+	void FSaturationCascade::SetStageLevelDb(const int32 InStageIndex, const float InLevelDb)
+	{
+		if (InStageIndex < 0 || InStageIndex >= MaxNumStages)
+		{
+			return;
+		}
+
+		const float LevelDb = FMath::Clamp(InLevelDb, -96.0f, 24.0f);
+		const float Level   = (LevelDb == -96.0f) ? 0.0f : Audio::ConvertToLinear(LevelDb);
+
+		if (Level != StageLevels[InStageIndex])
+		{
+			StageLevels[InStageIndex] = Level;
+			bStageParamsDirty = true;
+		}
+	}
+
+	void FSaturationCascade::SetMix(const float InMixAmount)
+	{
+		const float MixAmount = FMath::Clamp(InMixAmount, 0.0f, 100.0f) * 0.01f; // Clamp and Normalize
+		MixParamSmoother.SetNewParamValue(MixAmount);
+	}
+
+	void FSaturationCascade::SetOutLevelDb(const float InOutLevelDb)
+	{
+		const float OutLevelDb = FMath::Clamp(InOutLevelDb, -96.0f, 24.0f);
+		const float InOutLevelLinear = (OutLevelDb == -96.0f) ? 0.0f : Audio::ConvertToLinear(OutLevelDb);
+
+		OutLevelParamSmoother.SetNewParamValue(InOutLevelLinear);
+	}
+
+	void FSaturationCascade::UpdateStageParams()
+	{
+		float TargetGains[MaxNumStages];
+
+		for (int32 Stage = 0; Stage < MaxNumStages; ++Stage)
+		{
+			// The stages can't hold state or per-stage tables, the other types run as Tape (with the Tape gain range)
+			const ESaturationType SaturationType = SaturationUtils::IsMemoryless(StageSaturationTypes[Stage]) ? StageSaturationTypes[Stage] : ESaturationType::Tape;
+
+			StageKernels[Stage] = SaturationCascadeUtils::GetVectorSaturateKernel(SaturationType);
+
+			// A new type jumps to its curve, the gain is smoothed from the previous range
+			TargetGains[Stage] = SaturationUtils::MapNormalizedGain(SaturationType, StageGains[Stage]);
+		}
+
+		VTargetGains  = MakeVectorRegisterFloat(TargetGains[0], TargetGains[1], TargetGains[2], TargetGains[3]);
+		VTargetBiases = MakeVectorRegisterFloat(StageBiases[0], StageBiases[1], StageBiases[2], StageBiases[3]);
+		VTargetLevels = MakeVectorRegisterFloat(StageLevels[0], StageLevels[1], StageLevels[2], StageLevels[3]);
+
+		if (bFirstStageParamsUpdate)
+		{
+			VCurrentGains  = VTargetGains;
+			VCurrentBiases = VTargetBiases;
+			VCurrentLevels = VTargetLevels;
+
+			bFirstStageParamsUpdate = false;
+		}
+
+		bStageParamsSettled = false;
+		bStageParamsDirty   = false;
+	}
+
+	void FSaturationCascade::StepStageParams(VectorRegister4Float& InOutGains, VectorRegister4Float& InOutBiases, VectorRegister4Float& InOutLevels)
+	{
+		const VectorRegister4Float VSmoothingStep = VectorLoadFloat1(&SmoothingStep);
+
+		const VectorRegister4Float GainsDelta  = VectorSubtract(VTargetGains,  InOutGains);
+		const VectorRegister4Float BiasesDelta = VectorSubtract(VTargetBiases, InOutBiases);
+		const VectorRegister4Float LevelsDelta = VectorSubtract(VTargetLevels, InOutLevels);
+
+		const VectorRegister4Float MaxDelta = VectorMax(VectorAbs(GainsDelta), VectorMax(VectorAbs(BiasesDelta), VectorAbs(LevelsDelta)));
+
+		if (VectorAnyGreaterThan(MaxDelta, SaturationCascadeUtils::VSettledThreshold))
+		{
+			//Current += SmoothingStep * (Target - Current);
+			InOutGains  = VectorMultiplyAdd(VSmoothingStep, GainsDelta,  InOutGains);
+			InOutBiases = VectorMultiplyAdd(VSmoothingStep, BiasesDelta, InOutBiases);
+			InOutLevels = VectorMultiplyAdd(VSmoothingStep, LevelsDelta, InOutLevels);
+		}
+		else
+		{
+			InOutGains  = VTargetGains;
+			InOutBiases = VTargetBiases;
+			InOutLevels = VTargetLevels;
+
+			bStageParamsSettled = true;
+		}
+	}
+
+	void FSaturationCascade::ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	{
+		//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSaturationCascade::ProcessAudioBuffer"))
+
+		if (bStageParamsDirty)
+		{
+			UpdateStageParams();
+		}
+
+		// Skip processing if OutLevel == 0
+		if (OutLevelParamSmoother.IsSettled() && OutLevelParamSmoother.GetCurrentValue() == 0.0f)
+		{
+			FMemory::Memzero(OutBuffer, sizeof(float) * InNumSamples);
+			return;
+		}
+
+		// Sequential version
+		//for (int32 i = 0; i < InNumSamples; ++i)
+		//{
+		//    const float In = InBuffer[i];
+		//    float Out = In;
+		//
+		//    for (int32 Stage = 0; Stage < NumStages; ++Stage)
+		//    {
+		//        Out = Saturate[Stage](Out + StageBias[Stage], StageGain[Stage]) * StageLevel[Stage];
+		//    }
+		//
+		//    Out = Out * Mix + (1.0f - Mix) * In;
+		//    OutBuffer[i] = Out * OutLevel;
+		//}
+
+		// Vectorized version, unrolled over the stages so their parameters are splatted from the smoother lanes
+		switch (NumStages)
+		{
+			case 1:  ProcessStages<1>(InBuffer, OutBuffer, InNumSamples); break;
+			case 2:  ProcessStages<2>(InBuffer, OutBuffer, InNumSamples); break;
+			case 3:  ProcessStages<3>(InBuffer, OutBuffer, InNumSamples); break;
+			default: ProcessStages<4>(InBuffer, OutBuffer, InNumSamples); break;
+		}
+	}
+
+	template <int32 NumStagesT>
+	void FSaturationCascade::ProcessStages(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+	{
+		// Local copies, the kernel calls would otherwise reload the members after every stage
+		VectorRegister4Float Gains  = VCurrentGains;
+		VectorRegister4Float Biases = VCurrentBiases;
+		VectorRegister4Float Levels = VCurrentLevels;
+
+		FVectorSaturateKernel Kernels[MaxNumStages];
+		FMemory::Memcpy(Kernels, StageKernels, sizeof(Kernels));
+
+		for (int32 i = 0; i < InNumSamples; i += 4)
+		{
+			if (!bStageParamsSettled)
+			{
+				StepStageParams(Gains, Biases, Levels);
+			}
+
+			const float CurrentMix      = MixParamSmoother.GetValue();
+			const float CurrentOutLevel = OutLevelParamSmoother.GetValue();
+
+			//const float In = InBuffer[i];
+			const VectorRegister4Float In = VectorLoadAligned(&InBuffer[i]);
+
+			VectorRegister4Float Out = In;
+
+			//Out = Saturate(Out + StageBias, StageGain) * StageLevel;
+			Out = VectorMultiply(Kernels[0](VectorAdd(Out, VectorReplicate(Biases, 0)), VectorReplicate(Gains, 0)), VectorReplicate(Levels, 0));
+
+			if constexpr (NumStagesT > 1)
+			{
+				Out = VectorMultiply(Kernels[1](VectorAdd(Out, VectorReplicate(Biases, 1)), VectorReplicate(Gains, 1)), VectorReplicate(Levels, 1));
+			}
+
+			if constexpr (NumStagesT > 2)
+			{
+				Out = VectorMultiply(Kernels[2](VectorAdd(Out, VectorReplicate(Biases, 2)), VectorReplicate(Gains, 2)), VectorReplicate(Levels, 2));
+			}
+
+			if constexpr (NumStagesT > 3)
+			{
+				Out = VectorMultiply(Kernels[3](VectorAdd(Out, VectorReplicate(Biases, 3)), VectorReplicate(Gains, 3)), VectorReplicate(Levels, 3));
+			}
+
+			//Out = Out * Mix + (1.0f - Mix) * In;
+			AudioUtils::VectorMix(In, VectorLoadFloat1(&CurrentMix), Out);
+
+			//OutBuffer[i] = Out * OutLevel;
+			VectorStoreAligned(VectorMultiply(Out, VectorLoadFloat1(&CurrentOutLevel)), &OutBuffer[i]);
+		}
+
+		VCurrentGains  = Gains;
+		VCurrentBiases = Biases;
+		VCurrentLevels = Levels;
+	}
+}
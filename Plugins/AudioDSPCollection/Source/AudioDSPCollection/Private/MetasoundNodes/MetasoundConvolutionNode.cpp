@@ -0,0 +1,355 @@
+#include "MetasoundNodes/MetasoundConvolutionNode.h"
+#include "Assets/DSPCollectionImpulseResponse.h"
+#include "MetasoundDataTypeRegistrationMacro.h"
+
+#define LOCTEXT_NAMESPACE "DSPCollection_MetasoundConvolutionNode"
+
+namespace Metasound
+{
+	FImpulseResponseAsset::FImpulseResponseAsset(const TSharedPtr<Audio::IProxyData>& InInitData)
+	{
+		if (InInitData.IsValid() && InInitData->CheckTypeCast<FDSPCollectionImpulseResponseProxy>())
+		{
+			ImpulseResponse = InInitData->GetAs<FDSPCollectionImpulseResponseProxy>().GetImpulseResponse();
+		}
+	}
+
+	REGISTER_METASOUND_DATATYPE(FImpulseResponseAsset, "DSPCollectionImpulseResponse", ELiteralType::UObjectProxy, UDSPCollectionImpulseResponse);
+}
+
+namespace DSPCollection
+{
+	using namespace Metasound;
+
+	namespace ConvolutionNode
+	{
+		METASOUND_PARAM(InParamNameAudioInput,           "In",               "Audio input.")
+		METASOUND_PARAM(InParamNameImpulseResponse,      "Impulse Response", "DSPCollection Impulse Response asset, no asset bypasses the node.")
+		METASOUND_PARAM(InParamNameNonUniformPartitions, "Non-Uniform",      "Longer partitions for the tail of the IR: cheaper on average for long IRs, with a heavier block every 8 blocks.")
+		METASOUND_PARAM(OutParamNameAudio,               "Out",              "Audio output.")
+		METASOUND_PARAM(InParamNameAudioInputChannel,    "In {0}",           "Audio input of channel {0}.")
+		METASOUND_PARAM(OutParamNameAudioChannel,        "Out {0}",          "Audio output of channel {0}.")
+
+		static const TCHAR* GetChannelConfigName(const int32 NumChannels)
+		{
+			switch (NumChannels)
+			{
+				case 2:  return TEXT("Stereo");
+				case 4:  return TEXT("Quad");
+				case 6:  return TEXT("5.1");
+				case 8:  return TEXT("7.1");
+				default: return TEXT("Multichannel");
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------
+	// FConvolutionNodeControls
+	//------------------------------------------------------------------------------------
+	FConvolutionNodeControls FConvolutionNodeControls::Create(const FBuildOperatorParams& InParams)
+	{
+		using namespace ConvolutionNode;
+
+		const FInputVertexInterfaceData& InputData = InParams.InputData;
+		const FOperatorSettings& Settings          = InParams.OperatorSettings;
+
+		return FConvolutionNodeControls
+		{
+			InputData.GetOrCreateDefaultDataReadReference<FImpulseResponseAsset>(METASOUND_GET_PARAM_NAME(InParamNameImpulseResponse), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InParamNameNonUniformPartitions), Settings)
+		};
+	}
+
+	void FConvolutionNodeControls::AddInputVertices(FInputVertexInterface& InOutInterface)
+	{
+		using namespace ConvolutionNode;
+
+		InOutInterface.Add(TInputDataVertex<FImpulseResponseAsset>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameImpulseResponse)));
+		InOutInterface.Add(TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameNonUniformPartitions), false));
+	}
+
+	void FConvolutionNodeControls::Bind(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace ConvolutionNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameImpulseResponse), ImpulseResponse);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameNonUniformPartitions), NonUniformPartitions);
+	}
+
+	void FConvolutionNodeControls::Apply(DSPProcessing::FConvolution& InOutConvolution) const
+	{
+		// Both only flag a rebuild when the value actually changes
+		InOutConvolution.SetImpulseResponse(ImpulseResponse->GetImpulseResponse());
+		InOutConvolution.SetNonUniformPartitions(*NonUniformPartitions);
+	}
+
+	//------------------------------------------------------------------------------------
+	// FConvolutionOperator
+	//------------------------------------------------------------------------------------
+	FConvolutionOperator::FConvolutionOperator(const FOperatorSettings& InSettings,
+											   const FAudioBufferReadRef& InAudioInput,
+											   const FConvolutionNodeControls& InControls)
+		: AudioInput(InAudioInput)
+		, AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings))
+		, Controls(InControls)
+	{
+		ConvolutionDSPProcessor.Init(InSettings.GetSampleRate());
+
+		// The partitioned IR and the buffers are ready before the first Execute, the operators aren't created on the audio render thread
+		Controls.Apply(ConvolutionDSPProcessor);
+		ConvolutionDSPProcessor.PrepareBlocking(InSettings.GetNumFramesPerBlock());
+	}
+
+	const FNodeClassMetadata& FConvolutionOperator::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("Convolution"), TEXT("Audio") };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 0;
+			Info.DisplayName       = LOCTEXT("DSPCollection_ConvolutionDisplayName",     "Convolution");
+			Info.Description       = LOCTEXT("DSPCollection_ConvolutionNodeDescription", "Partitioned FFT convolution with an impulse response (cabinet, mic, coloring), no latency.");
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_ConvolutionNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	void FConvolutionOperator::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace ConvolutionNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
+		Controls.Bind(InOutVertexData);
+	}
+
+	void FConvolutionOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace ConvolutionNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudio), AudioOutput);
+	}
+
+	const FVertexInterface& FConvolutionOperator::GetVertexInterface()
+	{
+		using namespace ConvolutionNode;
+
+		auto CreateVertexInterface = []() -> FVertexInterface
+		{
+			FInputVertexInterface InputInterface;
+			FOutputVertexInterface OutputInterface;
+
+			InputInterface.Add(TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInput)));
+			FConvolutionNodeControls::AddInputVertices(InputInterface);
+
+			OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameAudio)));
+
+			return FVertexInterface(InputInterface, OutputInterface);
+		};
+
+		static const FVertexInterface Interface = CreateVertexInterface();
+
+		return Interface;
+	}
+
+	TUniquePtr<IOperator> FConvolutionOperator::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace ConvolutionNode;
+
+		FAudioBufferReadRef AudioIn = InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), InParams.OperatorSettings);
+
+		return MakeUnique<FConvolutionOperator>(InParams.OperatorSettings, AudioIn, FConvolutionNodeControls::Create(InParams));
+	}
+
+	void FConvolutionOperator::Execute()
+	{
+		Controls.Apply(ConvolutionDSPProcessor);
+
+		const float* InputAudio = AudioInput->GetData();
+		float* OutputAudio      = AudioOutput->GetData();
+		const int32 NumSamples  = AudioInput->Num();
+
+		ConvolutionDSPProcessor.ProcessAudioBuffer(InputAudio, OutputAudio, NumSamples);
+	}
+	
+	void FConvolutionOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		AudioOutput->Zero();
+
+		ConvolutionDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate());
+		Controls.Apply(ConvolutionDSPProcessor);
+		ConvolutionDSPProcessor.Prepare(InParams.OperatorSettings.GetNumFramesPerBlock());
+	}
+
+	METASOUND_REGISTER_NODE(FConvolutionNode)
+
+	//------------------------------------------------------------------------------------
+	// TConvolutionMultichannelOperator
+	//------------------------------------------------------------------------------------
+	template <int32 NumChannels>
+	TConvolutionMultichannelOperator<NumChannels>::TConvolutionMultichannelOperator(const FOperatorSettings& InSettings,
+																					const TArray<FAudioBufferReadRef>& InAudioInputs,
+																					const FConvolutionNodeControls& InControls)
+		: AudioInputs(InAudioInputs)
+		, Controls(InControls)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			AudioOutputs.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+		}
+
+		InterleavedBuffer.SetNumZeroed(InSettings.GetNumFramesPerBlock() * NumChannels);
+
+		ConvolutionDSPProcessor.Init(InSettings.GetSampleRate(), NumChannels);
+		Controls.Apply(ConvolutionDSPProcessor);
+		ConvolutionDSPProcessor.PrepareBlocking(InSettings.GetNumFramesPerBlock());
+	}
+
+	template <int32 NumChannels>
+	const FNodeClassMetadata& TConvolutionMultichannelOperator<NumChannels>::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			const TCHAR* ChannelConfigName = ConvolutionNode::GetChannelConfigName(NumChannels);
+
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("Convolution"), ChannelConfigName };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 0;
+			Info.DisplayName       = FText::Format(LOCTEXT("DSPCollection_ConvolutionMultichannelDisplayName",     "Convolution ({0})"), FText::FromString(ChannelConfigName));
+			Info.Description       = FText::Format(LOCTEXT("DSPCollection_ConvolutionMultichannelNodeDescription", "Partitioned FFT convolution of a {0} audio input with an impulse response, no latency."), FText::FromString(ChannelConfigName));
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_ConvolutionNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	template <int32 NumChannels>
+	void TConvolutionMultichannelOperator<NumChannels>::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace ConvolutionNode;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME_WITH_INDEX(InParamNameAudioInputChannel, Channel), AudioInputs[Channel]);
+		}
+
+		Controls.Bind(InOutVertexData);
+	}
+
+	template <int32 NumChannels>
+	void TConvolutionMultichannelOperator<NumChannels>::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace ConvolutionNode;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME_WITH_INDEX(OutParamNameAudioChannel, Channel), AudioOutputs[Channel]);
+		}
+	}
+
+	template <int32 NumChannels>
+	const FVertexInterface& TConvolutionMultichannelOperator<NumChannels>::GetVertexInterface()
+	{
+		using namespace ConvolutionNode;
+
+		auto CreateVertexInterface = []() -> FVertexInterface
+		{
+			FInputVertexInterface InputInterface;
+			FOutputVertexInterface OutputInterface;
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InputInterface.Add(TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(InParamNameAudioInputChannel, Channel)));
+				OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(OutParamNameAudioChannel, Channel)));
+			}
+
+			FConvolutionNodeControls::AddInputVertices(InputInterface);
+
+			return FVertexInterface(InputInterface, OutputInterface);
+		};
+
+		static const FVertexInterface Interface = CreateVertexInterface();
+
+		return Interface;
+	}
+
+	template <int32 NumChannels>
+	TUniquePtr<IOperator> TConvolutionMultichannelOperator<NumChannels>::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace ConvolutionNode;
+
+		TArray<FAudioBufferReadRef> AudioIns;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			AudioIns.Add(InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX(InParamNameAudioInputChannel, Channel), InParams.OperatorSettings));
+		}
+
+		return MakeUnique<TConvolutionMultichannelOperator<NumChannels>>(InParams.OperatorSettings, AudioIns, FConvolutionNodeControls::Create(InParams));
+	}
+
+	template <int32 NumChannels>
+	void TConvolutionMultichannelOperator<NumChannels>::Execute()
+	{
+		Controls.Apply(ConvolutionDSPProcessor);
+
+		const float* InputAudio[NumChannels];
+		float* OutputAudio[NumChannels];
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InputAudio[Channel]  = AudioInputs[Channel]->GetData();
+			OutputAudio[Channel] = AudioOutputs[Channel]->GetData();
+		}
+
+		const int32 NumFrames  = AudioInputs[0]->Num();
+		const int32 NumSamples = NumFrames * NumChannels;
+
+		// Sized for the block in the constructor, the block size of an operator never changes
+		check(NumSamples <= InterleavedBuffer.Num());
+
+		float* Interleaved = InterleavedBuffer.GetData();
+
+		DSPProcessing::AudioUtils::InterleaveBuffers(InputAudio, Interleaved, NumChannels, NumFrames);
+		ConvolutionDSPProcessor.ProcessAudioBuffer(Interleaved, Interleaved, NumSamples);
+		DSPProcessing::AudioUtils::DeinterleaveBuffer(Interleaved, OutputAudio, NumChannels, NumFrames);
+	}
+
+	template <int32 NumChannels>
+	void TConvolutionMultichannelOperator<NumChannels>::Reset(const IOperator::FResetParams& InParams)
+	{
+		for (FAudioBufferWriteRef& AudioOutput : AudioOutputs)
+		{
+			AudioOutput->Zero();
+		}
+
+		ConvolutionDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate(), NumChannels);
+		Controls.Apply(ConvolutionDSPProcessor);
+		ConvolutionDSPProcessor.Prepare(InParams.OperatorSettings.GetNumFramesPerBlock());
+	}
+
+	METASOUND_REGISTER_NODE(FConvolutionStereoNode)
+	METASOUND_REGISTER_NODE(FConvolutionQuadNode)
+	METASOUND_REGISTER_NODE(FConvolution51Node)
+	METASOUND_REGISTER_NODE(FConvolution71Node)
+}
+
+#undef LOCTEXT_NAMESPACE
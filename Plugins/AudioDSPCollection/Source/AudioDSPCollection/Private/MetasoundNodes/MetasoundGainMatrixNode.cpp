@@ -0,0 +1,153 @@
+#include "MetasoundNodes/MetasoundGainMatrixNode.h"
+
+#define LOCTEXT_NAMESPACE "DSPCollection_MetasoundGainMatrixNode"
+
+namespace DSPCollection
+{
+	using namespace Metasound;
+
+	namespace GainMatrixNode
+	{
+		METASOUND_PARAM(InParamNameAudioInputLeft,  "In L",   "Left audio input.")
+		METASOUND_PARAM(InParamNameAudioInputRight, "In R",   "Right audio input.")
+		METASOUND_PARAM(InParamNameLeftToLeft,      "L to L", "Gain of the left input in the left output. Range = [-4.0, 4.0]")
+		METASOUND_PARAM(InParamNameRightToLeft,     "R to L", "Gain of the right input in the left output. Range = [-4.0, 4.0]")
+		METASOUND_PARAM(InParamNameLeftToRight,     "L to R", "Gain of the left input in the right output. Range = [-4.0, 4.0]")
+		METASOUND_PARAM(InParamNameRightToRight,    "R to R", "Gain of the right input in the right output. Range = [-4.0, 4.0]")
+		METASOUND_PARAM(OutParamNameAudioLeft,      "Out L",  "Left audio output.")
+		METASOUND_PARAM(OutParamNameAudioRight,     "Out R",  "Right audio output.")
+	}
+
+	FGainMatrixOperator::FGainMatrixOperator(const FOperatorSettings& InSettings,
+											 const FAudioBufferReadRef& InAudioInputLeft,
+											 const FAudioBufferReadRef& InAudioInputRight,
+											 const FFloatReadRef& InLeftToLeft,
+											 const FFloatReadRef& InRightToLeft,
+											 const FFloatReadRef& InLeftToRight,
+											 const FFloatReadRef& InRightToRight)
+		: AudioInputLeft(InAudioInputLeft)
+		, AudioInputRight(InAudioInputRight)
+		, AudioOutputLeft(FAudioBufferWriteRef::CreateNew(InSettings))
+		, AudioOutputRight(FAudioBufferWriteRef::CreateNew(InSettings))
+		, LeftToLeft(InLeftToLeft)
+		, RightToLeft(InRightToLeft)
+		, LeftToRight(InLeftToRight)
+		, RightToRight(InRightToRight)
+	{
+
+		GainMatrixDSPProcessor.Init(InSettings.GetSampleRate(), 2, 2);
+	}
+
+	const FNodeClassMetadata& FGainMatrixOperator::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("GainMatrix"), TEXT("Audio") };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 0;
+			Info.DisplayName       = LOCTEXT("DSPCollection_GainMatrixDisplayName",     "Gain Matrix (Stereo)");
+			Info.Description       = LOCTEXT("DSPCollection_GainMatrixNodeDescription", "Routes a stereo input to a stereo output through a smoothed 2x2 gain matrix.");
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_GainMatrixNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	void FGainMatrixOperator::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace GainMatrixNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInputLeft),  AudioInputLeft);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInputRight), AudioInputRight);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameLeftToLeft),      LeftToLeft);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameRightToLeft),     RightToLeft);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameLeftToRight),     LeftToRight);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameRightToRight),    RightToRight);
+	}
+
+	void FGainMatrixOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace GainMatrixNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudioLeft),  AudioOutputLeft);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudioRight), AudioOutputRight);
+	}
+
+	const FVertexInterface& FGainMatrixOperator::GetVertexInterface()
+	{
+		using namespace GainMatrixNode;
+
+		static const FVertexInterface Interface(
+			FInputVertexInterface(
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInputLeft)),
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInputRight)),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameLeftToLeft),   1.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameRightToLeft),  0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameLeftToRight),  0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameRightToRight), 1.0f)
+			),
+
+			FOutputVertexInterface(
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameAudioLeft)),
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameAudioRight))
+			)
+		);
+
+		return Interface;
+	}
+
+	TUniquePtr<IOperator> FGainMatrixOperator::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace GainMatrixNode;
+
+		FAudioBufferReadRef AudioInLeft  = InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InParamNameAudioInputLeft),  InParams.OperatorSettings);
+		FAudioBufferReadRef AudioInRight = InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InParamNameAudioInputRight), InParams.OperatorSettings);
+
+		FFloatReadRef InLeftToLeft   = InParams.InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameLeftToLeft),   InParams.OperatorSettings);
+		FFloatReadRef InRightToLeft  = InParams.InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameRightToLeft),  InParams.OperatorSettings);
+		FFloatReadRef InLeftToRight  = InParams.InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameLeftToRight),  InParams.OperatorSettings);
+		FFloatReadRef InRightToRight = InParams.InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameRightToRight), InParams.OperatorSettings);
+
+		return MakeUnique<FGainMatrixOperator>(InParams.OperatorSettings, AudioInLeft, AudioInRight, InLeftToLeft, InRightToLeft, InLeftToRight, InRightToRight);
+	}
+
+	void FGainMatrixOperator::UpdateGains()
+	{
+		// Unchanged coefficients don't restart the smoothing
+		GainMatrixDSPProcessor.SetGain(0, 0, *LeftToLeft);
+		GainMatrixDSPProcessor.SetGain(0, 1, *RightToLeft);
+		GainMatrixDSPProcessor.SetGain(1, 0, *LeftToRight);
+		GainMatrixDSPProcessor.SetGain(1, 1, *RightToRight);
+	}
+
+	void FGainMatrixOperator::Execute()
+	{
+		UpdateGains();
+
+		const float* InputAudio[2] = { AudioInputLeft->GetData(), AudioInputRight->GetData() };
+		float* OutputAudio[2]      = { AudioOutputLeft->GetData(), AudioOutputRight->GetData() };
+		const int32 NumFrames      = AudioInputLeft->Num();
+
+		GainMatrixDSPProcessor.ProcessPlanarBuffers(InputAudio, OutputAudio, NumFrames);
+	}
+	
+	void FGainMatrixOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		AudioOutputLeft->Zero();
+		AudioOutputRight->Zero();
+		GainMatrixDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate(), 2, 2);
+	}
+
+	METASOUND_REGISTER_NODE(FGainMatrixNode)
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -2,24 +2,176 @@
 
 #define LOCTEXT_NAMESPACE "DSPCollection_MetasoundGainNode"
 
+namespace Metasound
+{
+	DEFINE_METASOUND_ENUM_BEGIN(DSPProcessing::EGainRampShape, FEnumEGainRampShape, "GainRampShape")
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EGainRampShape::Linear,      "LinearDescription",      "Linear",      "LinearTT",      "Linear in amplitude"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EGainRampShape::Exponential, "ExponentialDescription", "Exponential", "ExponentialTT", "Linear in dB"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EGainRampShape::SCurve,      "SCurveDescription",      "SCurve",      "SCurveTT",      "Smoothstep, slow start and slow end"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EGainRampShape::EqualPower,  "EqualPowerDescription",  "EqualPower",  "EqualPowerTT",  "Sine/cosine, for fade ins and fade outs")
+	DEFINE_METASOUND_ENUM_END()
+}
+
 namespace DSPCollection
 {
 	using namespace Metasound;
 
 	namespace GainNode
 	{
-		METASOUND_PARAM(InParamNameAudioInput, "In",   "Audio input.")
-		METASOUND_PARAM(InParamNameGain,       "Gain", "The amount of gain to apply to the input signal. Range = [0.0, 1.0]")
-		METASOUND_PARAM(OutParamNameAudio,     "Out",  "Audio output.")
+		METASOUND_PARAM(InParamNameAudioInput,        "In",         "Audio input.")
+		METASOUND_PARAM(InParamNameAudioInputChannel, "In {0}",     "Audio input of channel {0}.")
+		METASOUND_PARAM(InParamNameGain,              "Gain",       "The amount of gain to apply to the input signal. Range = [0.0, 1.0]")
+		METASOUND_PARAM(InParamNameFadeTimeMs,        "Fade Time",    "Time in ms to ramp to a new Gain value, and of the fades started by the triggers. 0 smooths a Gain change instead, and makes the triggers jump. Range = [0.0, 10000.0]")
+		METASOUND_PARAM(InParamNameFadeShape,         "Fade Shape",   "Shape of the ramp when Fade Time > 0.")
+		METASOUND_PARAM(InParamNameFadeIn,            "Fade In",      "Fades from silence to Gain over Fade Time, from the frame of the trigger.")
+		METASOUND_PARAM(InParamNameFadeOut,           "Fade Out",     "Fades to silence over Fade Time, from the frame of the trigger. The gain stays at 0 until the Gain input changes or another fade is triggered.")
+		METASOUND_PARAM(InParamNameFadeTo,            "Fade To",      "Fades from the current gain to Fade To Gain over Fade Time, from the frame of the trigger.")
+		METASOUND_PARAM(InParamNameFadeToGain,        "Fade To Gain", "Target of the Fade To trigger. Range = [0.0, 1.0]")
+		METASOUND_PARAM(OutParamNameAudio,            "Out",        "Audio output.")
+		METASOUND_PARAM(OutParamNameAudioChannel,     "Out {0}",    "Audio output of channel {0}.")
+
+		static const TCHAR* GetChannelConfigName(const int32 NumChannels)
+		{
+			switch (NumChannels)
+			{
+				case 2:  return TEXT("Stereo");
+				case 4:  return TEXT("Quad");
+				case 6:  return TEXT("5.1");
+				case 8:  return TEXT("7.1");
+				default: return TEXT("Multichannel");
+			}
+		}
+
+		// Only a change of the Gain input starts a new ramp, so a running ramp isn't cancelled every block
+		static void UpdateGain(DSPProcessing::FGain& GainDSPProcessor, const float InGain, const float InFadeTimeMs, const DSPProcessing::EGainRampShape InFadeShape, const float InSampleRate, float& InOutPreviousGain)
+		{
+			if (InGain == InOutPreviousGain)
+			{
+				return;
+			}
+
+			InOutPreviousGain = InGain;
+
+			const float CurrentFadeTimeMs = FMath::Clamp(InFadeTimeMs, 0.0f, 10000.0f);
+
+			if (CurrentFadeTimeMs > 0.0f)
+			{
+				const int32 FadeTimeInFrames = FMath::RoundToInt(CurrentFadeTimeMs * 0.001f * InSampleRate);
+				GainDSPProcessor.StartRamp(InGain, FadeTimeInFrames, InFadeShape);
+			}
+			else
+			{
+				GainDSPProcessor.SetGain(InGain);
+			}
+		}
+
+		enum class EFadeTrigger : uint8
+		{
+			FadeIn,
+			FadeOut,
+			FadeTo
+		};
+
+		struct FFadeEvent
+		{
+			int32        Frame;
+			EFadeTrigger Trigger;
+		};
+
+		using FFadeEvents = TArray<FFadeEvent, TInlineAllocator<8>>;
+
+		// In frame order, triggers on the same frame are applied In, Out, To
+		static void GatherFadeEvents(const FTrigger& InFadeIn, const FTrigger& InFadeOut, const FTrigger& InFadeTo, FFadeEvents& OutEvents)
+		{
+			OutEvents.Reset();
+
+			for (int32 Index = 0; Index < InFadeIn.Num(); ++Index)
+			{
+				OutEvents.Add({ InFadeIn[Index], EFadeTrigger::FadeIn });
+			}
+
+			for (int32 Index = 0; Index < InFadeOut.Num(); ++Index)
+			{
+				OutEvents.Add({ InFadeOut[Index], EFadeTrigger::FadeOut });
+			}
+
+			for (int32 Index = 0; Index < InFadeTo.Num(); ++Index)
+			{
+				OutEvents.Add({ InFadeTo[Index], EFadeTrigger::FadeTo });
+			}
+
+			OutEvents.StableSort([](const FFadeEvent& A, const FFadeEvent& B) { return A.Frame < B.Frame; });
+		}
+
+		static void StartFade(DSPProcessing::FGain& GainDSPProcessor, const EFadeTrigger InTrigger, const float InGain, const float InFadeToGain,
+							  const float InFadeTimeMs, const DSPProcessing::EGainRampShape InFadeShape, const float InSampleRate)
+		{
+			const int32 FadeTimeInFrames = FMath::RoundToInt(FMath::Clamp(InFadeTimeMs, 0.0f, 10000.0f) * 0.001f * InSampleRate);
+
+			switch (InTrigger)
+			{
+				case EFadeTrigger::FadeIn:
+					// A 0 frame ramp jumps
+					GainDSPProcessor.StartRamp(0.0f, 0);
+					GainDSPProcessor.StartRamp(InGain, FadeTimeInFrames, InFadeShape);
+					break;
+				case EFadeTrigger::FadeOut:
+					GainDSPProcessor.StartRamp(0.0f, FadeTimeInFrames, InFadeShape);
+					break;
+				case EFadeTrigger::FadeTo:
+					GainDSPProcessor.StartRamp(InFadeToGain, FadeTimeInFrames, InFadeShape);
+					break;
+			}
+		}
+
+		// The block is split at the trigger frames, each fade starts on its exact frame
+		static void ProcessFades(DSPProcessing::FGain& GainDSPProcessor, const FFadeEvents& InEvents, const float InGain, const float InFadeToGain, const float InFadeTimeMs,
+								 const DSPProcessing::EGainRampShape InFadeShape, const float InSampleRate, const float* const* InBuffers, float* const* OutBuffers,
+								 const int32 InNumChannels, const int32 InNumFrames)
+		{
+			// Captured and measured as one block, not per segment
+			DSPProcessing::FGain::FScopedPlanarSegments ScopedSegments(GainDSPProcessor, InBuffers, InNumChannels, InNumFrames);
+
+			int32 Frame = 0;
+
+			for (const FFadeEvent& Event : InEvents)
+			{
+				const int32 EventFrame = FMath::Clamp(Event.Frame, Frame, InNumFrames);
+
+				GainDSPProcessor.ProcessPlanarSegment(InBuffers, OutBuffers, InNumChannels, Frame, EventFrame - Frame);
+				StartFade(GainDSPProcessor, Event.Trigger, InGain, InFadeToGain, InFadeTimeMs, InFadeShape, InSampleRate);
+
+				Frame = EventFrame;
+			}
+
+			GainDSPProcessor.ProcessPlanarSegment(InBuffers, OutBuffers, InNumChannels, Frame, InNumFrames - Frame);
+		}
 	}
 
-	FGainOperator::FGainOperator(const FOperatorSettings& InSettings, const FAudioBufferReadRef& InAudioInput, const FFloatReadRef& InGain)
+	FGainOperator::FGainOperator(const FOperatorSettings& InSettings,
+								 const FAudioBufferReadRef& InAudioInput,
+								 const FFloatReadRef& InGain,
+								 const FFloatReadRef& InFadeTimeMs,
+								 const FEnumGainRampShapeReadRef& InFadeShape,
+								 const FTriggerReadRef& InFadeInTrigger,
+								 const FTriggerReadRef& InFadeOutTrigger,
+								 const FTriggerReadRef& InFadeToTrigger,
+								 const FFloatReadRef& InFadeToGain)
 		: AudioInput(InAudioInput)
 		, AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings))
 		, Gain(InGain)
+		, FadeTimeMs(InFadeTimeMs)
+		, FadeShape(InFadeShape)
+		, FadeInTrigger(InFadeInTrigger)
+		, FadeOutTrigger(InFadeOutTrigger)
+		, FadeToTrigger(InFadeToTrigger)
+		, FadeToGain(InFadeToGain)
+		, SampleRate(InSettings.GetSampleRate())
+		, PreviousGain(*InGain)
 	{
 
-		GainDSPProcessor.Init(InSettings.GetSampleRate());
+		GainDSPProcessor.Init(SampleRate);
+		GainDSPProcessor.SetGain(PreviousGain);
 	}
 
 	const FNodeClassMetadata& FGainOperator::GetNodeInfo()
@@ -30,7 +182,7 @@ namespace DSPCollection
 
 			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("Gain"), TEXT("Audio") };
 			Info.MajorVersion      = 1;
-			Info.MinorVersion      = 1;
+			Info.MinorVersion      = 3;
 			Info.DisplayName       = LOCTEXT("DSPCollection_GainDisplayName",     "Gain");
 			Info.Description       = LOCTEXT("DSPCollection_GainNodeDescription", "Applies gain to the audio input.");
 			Info.Author            = "Alex Perez";
@@ -52,6 +204,12 @@ namespace DSPCollection
 
         InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameGain), Gain);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeTimeMs), FadeTimeMs);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeShape), FadeShape);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeIn), FadeInTrigger);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeOut), FadeOutTrigger);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeTo), FadeToTrigger);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeToGain), FadeToGain);
 	}
 
     void FGainOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
@@ -68,7 +226,13 @@ namespace DSPCollection
 		static const FVertexInterface Interface(
 			FInputVertexInterface(
 				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInput)),
-				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameGain), 1.0f)
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameGain), 1.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeTimeMs), 0.0f),
+				TInputDataVertex<FEnumEGainRampShape>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeShape), (int32)DSPProcessing::EGainRampShape::Linear),
+				TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeIn)),
+				TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeOut)),
+				TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeTo)),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeToGain), 1.0f)
 			),
 
 			FOutputVertexInterface(
@@ -83,30 +247,247 @@ namespace DSPCollection
 	{
 		using namespace GainNode;
 
-		FAudioBufferReadRef AudioIn = InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), InParams.OperatorSettings);
-		FFloatReadRef InGain        = InParams.InputData.GetOrCreateDefaultDataReadReference<float>       (METASOUND_GET_PARAM_NAME(InParamNameGain),       InParams.OperatorSettings);
+		FAudioBufferReadRef AudioIn             = InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>       (METASOUND_GET_PARAM_NAME(InParamNameAudioInput), InParams.OperatorSettings);
+		FFloatReadRef InGain                    = InParams.InputData.GetOrCreateDefaultDataReadReference<float>              (METASOUND_GET_PARAM_NAME(InParamNameGain),       InParams.OperatorSettings);
+		FFloatReadRef InFadeTimeMs              = InParams.InputData.GetOrCreateDefaultDataReadReference<float>              (METASOUND_GET_PARAM_NAME(InParamNameFadeTimeMs), InParams.OperatorSettings);
+		FEnumGainRampShapeReadRef InFadeShape   = InParams.InputData.GetOrCreateDefaultDataReadReference<FEnumEGainRampShape>(METASOUND_GET_PARAM_NAME(InParamNameFadeShape),  InParams.OperatorSettings);
+		FTriggerReadRef InFadeIn                = InParams.InputData.GetOrCreateDefaultDataReadReference<FTrigger>           (METASOUND_GET_PARAM_NAME(InParamNameFadeIn),     InParams.OperatorSettings);
+		FTriggerReadRef InFadeOut               = InParams.InputData.GetOrCreateDefaultDataReadReference<FTrigger>           (METASOUND_GET_PARAM_NAME(InParamNameFadeOut),    InParams.OperatorSettings);
+		FTriggerReadRef InFadeTo                = InParams.InputData.GetOrCreateDefaultDataReadReference<FTrigger>           (METASOUND_GET_PARAM_NAME(InParamNameFadeTo),     InParams.OperatorSettings);
+		FFloatReadRef InFadeToGain              = InParams.InputData.GetOrCreateDefaultDataReadReference<float>              (METASOUND_GET_PARAM_NAME(InParamNameFadeToGain), InParams.OperatorSettings);
 
-		return MakeUnique<FGainOperator>(InParams.OperatorSettings, AudioIn, InGain);
+		return MakeUnique<FGainOperator>(InParams.OperatorSettings, AudioIn, InGain, InFadeTimeMs, InFadeShape, InFadeIn, InFadeOut, InFadeTo, InFadeToGain);
 	}
 
 	void FGainOperator::Execute()
 	{
-		GainDSPProcessor.SetGain(*Gain);
+		using namespace GainNode;
+
+		UpdateGain(GainDSPProcessor, *Gain, *FadeTimeMs, *FadeShape, SampleRate, PreviousGain);
 
 		const float* InputAudio = AudioInput->GetData();
 		float* OutputAudio      = AudioOutput->GetData();
 		const int32 NumSamples  = AudioInput->Num();
 
+		FFadeEvents FadeEvents;
+		GatherFadeEvents(*FadeInTrigger, *FadeOutTrigger, *FadeToTrigger, FadeEvents);
+
+		if (FadeEvents.Num() > 0)
+		{
+			// Mono is a single planar channel
+			ProcessFades(GainDSPProcessor, FadeEvents, *Gain, *FadeToGain, *FadeTimeMs, *FadeShape, SampleRate, &InputAudio, &OutputAudio, 1, NumSamples);
+			return;
+		}
+
 		GainDSPProcessor.ProcessAudioBuffer(InputAudio, OutputAudio, NumSamples);
 	}
 	
 	void FGainOperator::Reset(const IOperator::FResetParams& InParams)
 	{
 		AudioOutput->Zero();
-		GainDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate());
+		SampleRate   = InParams.OperatorSettings.GetSampleRate();
+		PreviousGain = *Gain;
+
+		GainDSPProcessor.Init(SampleRate);
+		GainDSPProcessor.SetGain(PreviousGain);
 	}
 
 	METASOUND_REGISTER_NODE(FGainNode)
+
+	//------------------------------------------------------------------------------------
+	// TGainMultichannelOperator
+	//------------------------------------------------------------------------------------
+	template <int32 NumChannels>
+	TGainMultichannelOperator<NumChannels>::TGainMultichannelOperator(const FOperatorSettings& InSettings,
+																	  const TArray<FAudioBufferReadRef>& InAudioInputs,
+																	  const FFloatReadRef& InGain,
+																	  const FFloatReadRef& InFadeTimeMs,
+																	  const FEnumGainRampShapeReadRef& InFadeShape,
+																	  const FTriggerReadRef& InFadeInTrigger,
+																	  const FTriggerReadRef& InFadeOutTrigger,
+																	  const FTriggerReadRef& InFadeToTrigger,
+																	  const FFloatReadRef& InFadeToGain)
+		: AudioInputs(InAudioInputs)
+		, Gain(InGain)
+		, FadeTimeMs(InFadeTimeMs)
+		, FadeShape(InFadeShape)
+		, FadeInTrigger(InFadeInTrigger)
+		, FadeOutTrigger(InFadeOutTrigger)
+		, FadeToTrigger(InFadeToTrigger)
+		, FadeToGain(InFadeToGain)
+		, SampleRate(InSettings.GetSampleRate())
+		, PreviousGain(*InGain)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			AudioOutputs.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+		}
+
+		GainDSPProcessor.Init(SampleRate, NumChannels);
+		GainDSPProcessor.SetGain(PreviousGain);
+	}
+
+	template <int32 NumChannels>
+	const FNodeClassMetadata& TGainMultichannelOperator<NumChannels>::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			const TCHAR* ChannelConfigName = GainNode::GetChannelConfigName(NumChannels);
+
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("Gain"), ChannelConfigName };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 1;
+			Info.DisplayName       = FText::Format(LOCTEXT("DSPCollection_GainMultichannelDisplayName",     "Gain ({0})"), FText::FromString(ChannelConfigName));
+			Info.Description       = FText::Format(LOCTEXT("DSPCollection_GainMultichannelNodeDescription", "Applies gain to a {0} audio input."), FText::FromString(ChannelConfigName));
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_GainNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	template <int32 NumChannels>
+	void TGainMultichannelOperator<NumChannels>::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace GainNode;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME_WITH_INDEX(InParamNameAudioInputChannel, Channel), AudioInputs[Channel]);
+		}
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameGain), Gain);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeTimeMs), FadeTimeMs);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeShape), FadeShape);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeIn), FadeInTrigger);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeOut), FadeOutTrigger);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeTo), FadeToTrigger);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFadeToGain), FadeToGain);
+	}
+
+	template <int32 NumChannels>
+	void TGainMultichannelOperator<NumChannels>::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace GainNode;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME_WITH_INDEX(OutParamNameAudioChannel, Channel), AudioOutputs[Channel]);
+		}
+	}
+
+	template <int32 NumChannels>
+	const FVertexInterface& TGainMultichannelOperator<NumChannels>::GetVertexInterface()
+	{
+		using namespace GainNode;
+
+		auto CreateVertexInterface = []() -> FVertexInterface
+		{
+			FInputVertexInterface InputInterface;
+			FOutputVertexInterface OutputInterface;
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InputInterface.Add(TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(InParamNameAudioInputChannel, Channel)));
+				OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(OutParamNameAudioChannel, Channel)));
+			}
+
+			InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameGain), 1.0f));
+			InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeTimeMs), 0.0f));
+			InputInterface.Add(TInputDataVertex<FEnumEGainRampShape>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeShape), (int32)DSPProcessing::EGainRampShape::Linear));
+			InputInterface.Add(TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeIn)));
+			InputInterface.Add(TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeOut)));
+			InputInterface.Add(TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeTo)));
+			InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFadeToGain), 1.0f));
+
+			return FVertexInterface(InputInterface, OutputInterface);
+		};
+
+		static const FVertexInterface Interface = CreateVertexInterface();
+
+		return Interface;
+	}
+
+	template <int32 NumChannels>
+	TUniquePtr<IOperator> TGainMultichannelOperator<NumChannels>::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace GainNode;
+
+		TArray<FAudioBufferReadRef> AudioIns;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			AudioIns.Add(InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX(InParamNameAudioInputChannel, Channel), InParams.OperatorSettings));
+		}
+
+		FFloatReadRef InGain                    = InParams.InputData.GetOrCreateDefaultDataReadReference<float>              (METASOUND_GET_PARAM_NAME(InParamNameGain),       InParams.OperatorSettings);
+		FFloatReadRef InFadeTimeMs              = InParams.InputData.GetOrCreateDefaultDataReadReference<float>              (METASOUND_GET_PARAM_NAME(InParamNameFadeTimeMs), InParams.OperatorSettings);
+		FEnumGainRampShapeReadRef InFadeShape   = InParams.InputData.GetOrCreateDefaultDataReadReference<FEnumEGainRampShape>(METASOUND_GET_PARAM_NAME(InParamNameFadeShape),  InParams.OperatorSettings);
+		FTriggerReadRef InFadeIn                = InParams.InputData.GetOrCreateDefaultDataReadReference<FTrigger>           (METASOUND_GET_PARAM_NAME(InParamNameFadeIn),     InParams.OperatorSettings);
+		FTriggerReadRef InFadeOut               = InParams.InputData.GetOrCreateDefaultDataReadReference<FTrigger>           (METASOUND_GET_PARAM_NAME(InParamNameFadeOut),    InParams.OperatorSettings);
+		FTriggerReadRef InFadeTo                = InParams.InputData.GetOrCreateDefaultDataReadReference<FTrigger>           (METASOUND_GET_PARAM_NAME(InParamNameFadeTo),     InParams.OperatorSettings);
+		FFloatReadRef InFadeToGain              = InParams.InputData.GetOrCreateDefaultDataReadReference<float>              (METASOUND_GET_PARAM_NAME(InParamNameFadeToGain), InParams.OperatorSettings);
+
+		return MakeUnique<TGainMultichannelOperator<NumChannels>>(InParams.OperatorSettings, AudioIns, InGain, InFadeTimeMs, InFadeShape, InFadeIn, InFadeOut, InFadeTo, InFadeToGain);
+	}
+
+	template <int32 NumChannels>
+	void TGainMultichannelOperator<NumChannels>::Execute()
+	{
+		using namespace GainNode;
+
+		UpdateGain(GainDSPProcessor, *Gain, *FadeTimeMs, *FadeShape, SampleRate, PreviousGain);
+
+		const float* InputAudio[NumChannels];
+		float* OutputAudio[NumChannels];
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InputAudio[Channel]  = AudioInputs[Channel]->GetData();
+			OutputAudio[Channel] = AudioOutputs[Channel]->GetData();
+		}
+
+		const int32 NumFrames = AudioInputs[0]->Num();
+
+		FFadeEvents FadeEvents;
+		GatherFadeEvents(*FadeInTrigger, *FadeOutTrigger, *FadeToTrigger, FadeEvents);
+
+		if (FadeEvents.Num() > 0)
+		{
+			ProcessFades(GainDSPProcessor, FadeEvents, *Gain, *FadeToGain, *FadeTimeMs, *FadeShape, SampleRate, InputAudio, OutputAudio, NumChannels, NumFrames);
+			return;
+		}
+
+		GainDSPProcessor.ProcessPlanarBuffers(InputAudio, OutputAudio, NumChannels, NumFrames);
+	}
+
+	template <int32 NumChannels>
+	void TGainMultichannelOperator<NumChannels>::Reset(const IOperator::FResetParams& InParams)
+	{
+		for (FAudioBufferWriteRef& AudioOutput : AudioOutputs)
+		{
+			AudioOutput->Zero();
+		}
+
+		SampleRate   = InParams.OperatorSettings.GetSampleRate();
+		PreviousGain = *Gain;
+
+		GainDSPProcessor.Init(SampleRate, NumChannels);
+		GainDSPProcessor.SetGain(PreviousGain);
+	}
+
+	METASOUND_REGISTER_NODE(FGainStereoNode)
+	METASOUND_REGISTER_NODE(FGainQuadNode)
+	METASOUND_REGISTER_NODE(FGain51Node)
+	METASOUND_REGISTER_NODE(FGain71Node)
 }
 
 #undef LOCTEXT_NAMESPACE
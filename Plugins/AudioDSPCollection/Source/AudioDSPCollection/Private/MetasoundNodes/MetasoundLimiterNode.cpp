@@ -0,0 +1,355 @@
+#include "MetasoundNodes/MetasoundLimiterNode.h"
+
+#define LOCTEXT_NAMESPACE "DSPCollection_MetasoundLimiterNode"
+
+namespace DSPCollection
+{
+	using namespace Metasound;
+
+	namespace LimiterNode
+	{
+		METASOUND_PARAM(InParamNameAudioInput,        "In",              "Audio input.")
+		METASOUND_PARAM(InParamNameCeilingDb,         "Ceiling (dB)",    "Maximum output level. Range = [-24dB, 0dB]")
+		METASOUND_PARAM(InParamNameReleaseTimeMs,     "Release",         "Time (in ms) to recover from the gain reduction. Range = [1.0, 5000.0]")
+		METASOUND_PARAM(InParamNameLookAheadMs,       "Look-Ahead",      "Attack time and latency (in ms) of the limiter, a change clears the delayed audio. Range = [0.5, 20.0]")
+		METASOUND_PARAM(InParamNameTruePeak,          "True Peak",       "Detects the peaks between the samples with a 4x oversampled detector.")
+		METASOUND_PARAM(OutParamNameAudio,            "Out",             "Audio output, delayed by the look-ahead.")
+		METASOUND_PARAM(OutParamNameGainReductionDb,  "Gain Reduction",  "Largest gain reduction (in dB) applied during the last block, 0 when the limiter is idle.")
+		METASOUND_PARAM(InParamNameAudioInputChannel, "In {0}",          "Audio input of channel {0}.")
+		METASOUND_PARAM(OutParamNameAudioChannel,     "Out {0}",         "Audio output of channel {0}, delayed by the look-ahead.")
+
+		static const TCHAR* GetChannelConfigName(const int32 NumChannels)
+		{
+			switch (NumChannels)
+			{
+				case 2:  return TEXT("Stereo");
+				case 4:  return TEXT("Quad");
+				case 6:  return TEXT("5.1");
+				case 8:  return TEXT("7.1");
+				default: return TEXT("Multichannel");
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------
+	// FLimiterNodeControls
+	//------------------------------------------------------------------------------------
+	FLimiterNodeControls FLimiterNodeControls::Create(const FBuildOperatorParams& InParams)
+	{
+		using namespace LimiterNode;
+
+		const FInputVertexInterfaceData& InputData = InParams.InputData;
+		const FOperatorSettings& Settings          = InParams.OperatorSettings;
+
+		return FLimiterNodeControls
+		{
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameCeilingDb), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameReleaseTimeMs), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameLookAheadMs), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InParamNameTruePeak), Settings)
+		};
+	}
+
+	void FLimiterNodeControls::AddInputVertices(FInputVertexInterface& InOutInterface)
+	{
+		using namespace LimiterNode;
+
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameCeilingDb),     -1.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameReleaseTimeMs), 100.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameLookAheadMs),   5.0f));
+		InOutInterface.Add(TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameTruePeak),       false));
+	}
+
+	void FLimiterNodeControls::Bind(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace LimiterNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameCeilingDb), CeilingDb);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameReleaseTimeMs), ReleaseTimeMs);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameLookAheadMs), LookAheadMs);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameTruePeak), TruePeakEnabled);
+	}
+
+	void FLimiterNodeControls::Apply(DSPProcessing::FLimiter& InOutLimiter) const
+	{
+		InOutLimiter.SetCeilingDb(*CeilingDb);
+		InOutLimiter.SetReleaseTimeMs(*ReleaseTimeMs);
+		InOutLimiter.SetLookAheadMs(*LookAheadMs);
+		InOutLimiter.SetTruePeakEnabled(*TruePeakEnabled);
+	}
+
+	//------------------------------------------------------------------------------------
+	// FLimiterOperator
+	//------------------------------------------------------------------------------------
+	FLimiterOperator::FLimiterOperator(const FOperatorSettings& InSettings,
+									   const FAudioBufferReadRef& InAudioInput,
+									   const FLimiterNodeControls& InControls)
+		: AudioInput(InAudioInput)
+		, AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings))
+		, GainReductionDb(FFloatWriteRef::CreateNew(0.0f))
+		, Controls(InControls)
+	{
+		LimiterDSPProcessor.Init(InSettings.GetSampleRate(), 1, 1, InSettings.GetNumFramesPerBlock());
+	}
+
+	const FNodeClassMetadata& FLimiterOperator::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("Limiter"), TEXT("Audio") };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 0;
+			Info.DisplayName       = LOCTEXT("DSPCollection_LimiterDisplayName",     "Limiter");
+			Info.Description       = LOCTEXT("DSPCollection_LimiterNodeDescription", "Look-ahead brickwall limiter, keeps the audio input under the ceiling.");
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_LimiterNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	void FLimiterOperator::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace LimiterNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
+		Controls.Bind(InOutVertexData);
+	}
+
+	void FLimiterOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace LimiterNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudio), AudioOutput);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameGainReductionDb), GainReductionDb);
+	}
+
+	const FVertexInterface& FLimiterOperator::GetVertexInterface()
+	{
+		using namespace LimiterNode;
+
+		auto CreateVertexInterface = []() -> FVertexInterface
+		{
+			FInputVertexInterface InputInterface;
+			FOutputVertexInterface OutputInterface;
+
+			InputInterface.Add(TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInput)));
+			FLimiterNodeControls::AddInputVertices(InputInterface);
+
+			OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameAudio)));
+			OutputInterface.Add(TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameGainReductionDb)));
+
+			return FVertexInterface(InputInterface, OutputInterface);
+		};
+
+		static const FVertexInterface Interface = CreateVertexInterface();
+
+		return Interface;
+	}
+
+	TUniquePtr<IOperator> FLimiterOperator::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace LimiterNode;
+
+		FAudioBufferReadRef AudioIn = InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), InParams.OperatorSettings);
+
+		return MakeUnique<FLimiterOperator>(InParams.OperatorSettings, AudioIn, FLimiterNodeControls::Create(InParams));
+	}
+
+	void FLimiterOperator::Execute()
+	{
+		Controls.Apply(LimiterDSPProcessor);
+
+		const float* InputAudio = AudioInput->GetData();
+		float* OutputAudio      = AudioOutput->GetData();
+		const int32 NumSamples  = AudioInput->Num();
+
+		LimiterDSPProcessor.ProcessAudioBuffer(InputAudio, OutputAudio, NumSamples);
+
+		*GainReductionDb = LimiterDSPProcessor.GetGainReductionDb();
+	}
+	
+	void FLimiterOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		AudioOutput->Zero();
+		*GainReductionDb = 0.0f;
+
+		LimiterDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate(), 1, 1, InParams.OperatorSettings.GetNumFramesPerBlock());
+	}
+
+	METASOUND_REGISTER_NODE(FLimiterNode)
+
+	//------------------------------------------------------------------------------------
+	// TLimiterMultichannelOperator
+	//------------------------------------------------------------------------------------
+	template <int32 NumChannels>
+	TLimiterMultichannelOperator<NumChannels>::TLimiterMultichannelOperator(const FOperatorSettings& InSettings,
+																			const TArray<FAudioBufferReadRef>& InAudioInputs,
+																			const FLimiterNodeControls& InControls)
+		: AudioInputs(InAudioInputs)
+		, GainReductionDb(FFloatWriteRef::CreateNew(0.0f))
+		, Controls(InControls)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			AudioOutputs.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+		}
+
+		InterleavedBuffer.SetNumZeroed(InSettings.GetNumFramesPerBlock() * NumChannels);
+
+		LimiterDSPProcessor.Init(InSettings.GetSampleRate(), NumChannels, NumChannels, InSettings.GetNumFramesPerBlock());
+	}
+
+	template <int32 NumChannels>
+	const FNodeClassMetadata& TLimiterMultichannelOperator<NumChannels>::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			const TCHAR* ChannelConfigName = LimiterNode::GetChannelConfigName(NumChannels);
+
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("Limiter"), ChannelConfigName };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 0;
+			Info.DisplayName       = FText::Format(LOCTEXT("DSPCollection_LimiterMultichannelDisplayName",     "Limiter ({0})"), FText::FromString(ChannelConfigName));
+			Info.Description       = FText::Format(LOCTEXT("DSPCollection_LimiterMultichannelNodeDescription", "Look-ahead brickwall limiter, keeps a {0} audio input under the ceiling."), FText::FromString(ChannelConfigName));
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_LimiterNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	template <int32 NumChannels>
+	void TLimiterMultichannelOperator<NumChannels>::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace LimiterNode;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME_WITH_INDEX(InParamNameAudioInputChannel, Channel), AudioInputs[Channel]);
+		}
+
+		Controls.Bind(InOutVertexData);
+	}
+
+	template <int32 NumChannels>
+	void TLimiterMultichannelOperator<NumChannels>::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace LimiterNode;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME_WITH_INDEX(OutParamNameAudioChannel, Channel), AudioOutputs[Channel]);
+		}
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameGainReductionDb), GainReductionDb);
+	}
+
+	template <int32 NumChannels>
+	const FVertexInterface& TLimiterMultichannelOperator<NumChannels>::GetVertexInterface()
+	{
+		using namespace LimiterNode;
+
+		auto CreateVertexInterface = []() -> FVertexInterface
+		{
+			FInputVertexInterface InputInterface;
+			FOutputVertexInterface OutputInterface;
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InputInterface.Add(TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(InParamNameAudioInputChannel, Channel)));
+				OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(OutParamNameAudioChannel, Channel)));
+			}
+
+			FLimiterNodeControls::AddInputVertices(InputInterface);
+
+			OutputInterface.Add(TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameGainReductionDb)));
+
+			return FVertexInterface(InputInterface, OutputInterface);
+		};
+
+		static const FVertexInterface Interface = CreateVertexInterface();
+
+		return Interface;
+	}
+
+	template <int32 NumChannels>
+	TUniquePtr<IOperator> TLimiterMultichannelOperator<NumChannels>::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace LimiterNode;
+
+		TArray<FAudioBufferReadRef> AudioIns;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			AudioIns.Add(InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX(InParamNameAudioInputChannel, Channel), InParams.OperatorSettings));
+		}
+
+		return MakeUnique<TLimiterMultichannelOperator<NumChannels>>(InParams.OperatorSettings, AudioIns, FLimiterNodeControls::Create(InParams));
+	}
+
+	template <int32 NumChannels>
+	void TLimiterMultichannelOperator<NumChannels>::Execute()
+	{
+		Controls.Apply(LimiterDSPProcessor);
+
+		const float* InputAudio[NumChannels];
+		float* OutputAudio[NumChannels];
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InputAudio[Channel]  = AudioInputs[Channel]->GetData();
+			OutputAudio[Channel] = AudioOutputs[Channel]->GetData();
+		}
+
+		const int32 NumFrames  = AudioInputs[0]->Num();
+		const int32 NumSamples = NumFrames * NumChannels;
+
+		// Sized for the block in the constructor, the block size of an operator never changes
+		check(NumSamples <= InterleavedBuffer.Num());
+
+		float* Interleaved = InterleavedBuffer.GetData();
+
+		DSPProcessing::AudioUtils::InterleaveBuffers(InputAudio, Interleaved, NumChannels, NumFrames);
+		LimiterDSPProcessor.ProcessAudioBuffer(Interleaved, Interleaved, NumSamples);
+		DSPProcessing::AudioUtils::DeinterleaveBuffer(Interleaved, OutputAudio, NumChannels, NumFrames);
+
+		*GainReductionDb = LimiterDSPProcessor.GetGainReductionDb();
+	}
+
+	template <int32 NumChannels>
+	void TLimiterMultichannelOperator<NumChannels>::Reset(const IOperator::FResetParams& InParams)
+	{
+		for (FAudioBufferWriteRef& AudioOutput : AudioOutputs)
+		{
+			AudioOutput->Zero();
+		}
+
+		*GainReductionDb = 0.0f;
+
+		LimiterDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate(), NumChannels, NumChannels, InParams.OperatorSettings.GetNumFramesPerBlock());
+	}
+
+	METASOUND_REGISTER_NODE(FLimiterStereoNode)
+	METASOUND_REGISTER_NODE(FLimiterQuadNode)
+	METASOUND_REGISTER_NODE(FLimiter51Node)
+	METASOUND_REGISTER_NODE(FLimiter71Node)
+}
+
+#undef LOCTEXT_NAMESPACE
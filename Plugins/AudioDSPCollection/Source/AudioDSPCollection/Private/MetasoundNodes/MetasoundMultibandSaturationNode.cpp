@@ -0,0 +1,238 @@
+#include "MetasoundNodes/MetasoundMultibandSaturationNode.h"
+#include "AudioDSPCollection.h"
+
+#define LOCTEXT_NAMESPACE "DSPCollection_MetasoundMultibandSaturationNode"
+
+namespace DSPCollection
+{
+	using namespace Metasound;
+
+	namespace MultibandSaturationNode
+	{
+		METASOUND_PARAM(InParamNameAudioInput,     "In",                "Audio input.")
+		METASOUND_PARAM(InParamNameNumBands,       "Num Bands",         "Number of bands the input is split in. Range = [2, 4]")
+		METASOUND_PARAM(InParamNameCrossover1,     "Crossover 1",       "Crossover frequency (in Hz) between band 1 and band 2. Range = [20.0, 20000.0]")
+		METASOUND_PARAM(InParamNameCrossover2,     "Crossover 2",       "Crossover frequency (in Hz) between band 2 and band 3. Range = [20.0, 20000.0]")
+		METASOUND_PARAM(InParamNameCrossover3,     "Crossover 3",       "Crossover frequency (in Hz) between band 3 and band 4. Range = [20.0, 20000.0]")
+		METASOUND_PARAM(InParamNameBand1Type,      "Band 1 Type",       "Saturation algorithm to use in band 1. TapeHysteresis, Harmonic and Custom are not available per band and run as Tape.")
+		METASOUND_PARAM(InParamNameBand1Gain,      "Band 1 Gain",       "The amount of gain to apply to band 1. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBand1Mix,       "Band 1 Mix",        "The amount of mix between the saturated and the direct signal in band 1. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBand2Type,      "Band 2 Type",       "Saturation algorithm to use in band 2. TapeHysteresis, Harmonic and Custom are not available per band and run as Tape.")
+		METASOUND_PARAM(InParamNameBand2Gain,      "Band 2 Gain",       "The amount of gain to apply to band 2. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBand2Mix,       "Band 2 Mix",        "The amount of mix between the saturated and the direct signal in band 2. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBand3Type,      "Band 3 Type",       "Saturation algorithm to use in band 3. TapeHysteresis, Harmonic and Custom are not available per band and run as Tape.")
+		METASOUND_PARAM(InParamNameBand3Gain,      "Band 3 Gain",       "The amount of gain to apply to band 3. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBand3Mix,       "Band 3 Mix",        "The amount of mix between the saturated and the direct signal in band 3. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBand4Type,      "Band 4 Type",       "Saturation algorithm to use in band 4. TapeHysteresis, Harmonic and Custom are not available per band and run as Tape.")
+		METASOUND_PARAM(InParamNameBand4Gain,      "Band 4 Gain",       "The amount of gain to apply to band 4. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBand4Mix,       "Band 4 Mix",        "The amount of mix between the saturated and the direct signal in band 4. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBias,           "Bias",              "The amount of DC bias to apply to every band, this generates even harmonics in the saturated signal. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameOutLevelDb,     "Out Level (dB)",    "The amount of gain (in dB) to apply to the output signal. Range = [-96dB, +24dB]")
+		METASOUND_PARAM(OutParamNameAudio,         "Out",               "Audio output.")
+
+		static const FVertexName& GetCrossoverParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameCrossover1), METASOUND_GET_PARAM_NAME(InParamNameCrossover2), METASOUND_GET_PARAM_NAME(InParamNameCrossover3) };
+			return Names[InIndex];
+		}
+
+		static const FVertexName& GetBandTypeParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameBand1Type), METASOUND_GET_PARAM_NAME(InParamNameBand2Type), METASOUND_GET_PARAM_NAME(InParamNameBand3Type), METASOUND_GET_PARAM_NAME(InParamNameBand4Type) };
+			return Names[InIndex];
+		}
+
+		static const FVertexName& GetBandGainParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameBand1Gain), METASOUND_GET_PARAM_NAME(InParamNameBand2Gain), METASOUND_GET_PARAM_NAME(InParamNameBand3Gain), METASOUND_GET_PARAM_NAME(InParamNameBand4Gain) };
+			return Names[InIndex];
+		}
+
+		static const FVertexName& GetBandMixParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameBand1Mix), METASOUND_GET_PARAM_NAME(InParamNameBand2Mix), METASOUND_GET_PARAM_NAME(InParamNameBand3Mix), METASOUND_GET_PARAM_NAME(InParamNameBand4Mix) };
+			return Names[InIndex];
+		}
+	}
+
+	FMultibandSaturationOperator::FMultibandSaturationOperator(const FOperatorSettings& InSettings,
+															   const FAudioBufferReadRef& InAudioInput,
+															   const FInt32ReadRef& InNumBands,
+															   const TArray<FFloatReadRef>& InCrossoverFrequencies,
+															   const TArray<FBandInputs>& InBands,
+															   const FFloatReadRef& InBias,
+															   const FFloatReadRef& InOutLevelDb)
+		: AudioInput(InAudioInput)
+		, AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings))
+		, NumBands(InNumBands)
+		, CrossoverFrequencies(InCrossoverFrequencies)
+		, Bands(InBands)
+		, Bias(InBias)
+		, OutLevelDb(InOutLevelDb)
+	{
+		MultibandSaturationDSPProcessor.Init(InSettings.GetSampleRate());
+	}
+
+	const FNodeClassMetadata& FMultibandSaturationOperator::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("MultibandSaturation"), TEXT("Audio") };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 0;
+			Info.DisplayName       = LOCTEXT("DSPCollection_MultibandSaturationDisplayName",     "Multiband Saturation");
+			Info.Description       = LOCTEXT("DSPCollection_MultibandSaturationNodeDescription", "Splits the audio input in 2-4 bands with Linkwitz-Riley crossovers and saturates every band with its own curve.");
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_MultibandSaturationNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	void FMultibandSaturationOperator::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace MultibandSaturationNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameNumBands), NumBands);
+
+		for (int32 Index = 0; Index < NumCrossovers; ++Index)
+		{
+			InOutVertexData.BindReadVertex(GetCrossoverParamName(Index), CrossoverFrequencies[Index]);
+		}
+
+		for (int32 Index = 0; Index < MaxNumBands; ++Index)
+		{
+			InOutVertexData.BindReadVertex(GetBandTypeParamName(Index), Bands[Index].SaturationType);
+			InOutVertexData.BindReadVertex(GetBandGainParamName(Index), Bands[Index].Gain);
+			InOutVertexData.BindReadVertex(GetBandMixParamName(Index), Bands[Index].Mix);
+		}
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameBias), Bias);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameOutLevelDb), OutLevelDb);
+	}
+
+	void FMultibandSaturationOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace MultibandSaturationNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudio), AudioOutput);
+	}
+
+	const FVertexInterface& FMultibandSaturationOperator::GetVertexInterface()
+	{
+		using namespace MultibandSaturationNode;
+
+		constexpr int32 DefaultSaturationType = static_cast<int32>(DSPProcessing::ESaturationType::Tape);
+
+		static const FVertexInterface Interface(
+			FInputVertexInterface(
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInput)),
+				TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameNumBands),                 3),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameCrossover1),               200.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameCrossover2),               2000.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameCrossover3),               8000.0f),
+				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand1Type), DefaultSaturationType),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand1Gain),                100.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand1Mix),                 100.0f),
+				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand2Type), DefaultSaturationType),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand2Gain),                100.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand2Mix),                 100.0f),
+				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand3Type), DefaultSaturationType),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand3Gain),                100.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand3Mix),                 100.0f),
+				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand4Type), DefaultSaturationType),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand4Gain),                100.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBand4Mix),                 100.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBias),                     0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameOutLevelDb),               0.0f)
+			),
+			
+			FOutputVertexInterface(
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameAudio))
+			)
+		);
+
+		return Interface;
+	}
+
+	TUniquePtr<IOperator> FMultibandSaturationOperator::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace MultibandSaturationNode;
+
+		const FInputVertexInterfaceData& InputData = InParams.InputData;
+		const FOperatorSettings& Settings          = InParams.OperatorSettings;
+
+		FAudioBufferReadRef AudioIn = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), Settings);
+		FInt32ReadRef InNumBands    = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InParamNameNumBands), Settings);
+
+		TArray<FFloatReadRef> InCrossoverFrequencies;
+		for (int32 Index = 0; Index < NumCrossovers; ++Index)
+		{
+			InCrossoverFrequencies.Add(InputData.GetOrCreateDefaultDataReadReference<float>(GetCrossoverParamName(Index), Settings));
+		}
+
+		TArray<FBandInputs> InBands;
+		for (int32 Index = 0; Index < MaxNumBands; ++Index)
+		{
+			InBands.Add({ InputData.GetOrCreateDefaultDataReadReference<FEnumESaturationType>(GetBandTypeParamName(Index), Settings),
+						  InputData.GetOrCreateDefaultDataReadReference<float>(GetBandGainParamName(Index), Settings),
+						  InputData.GetOrCreateDefaultDataReadReference<float>(GetBandMixParamName(Index), Settings) });
+
+			// Checked once here, off the render thread. Execute maps the unsupported types to Tape silently
+			if (!DSPProcessing::FMultibandSaturation::IsBandSaturationTypeSupported(*InBands.Last().SaturationType))
+			{
+				UE_LOG(LogAudioDSPCollection, Warning, TEXT("Multiband Saturation node: TapeHysteresis, Harmonic and Custom are not available per band, band %d runs as Tape"), Index + 1);
+			}
+		}
+
+		FFloatReadRef InBias       = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameBias),       Settings);
+		FFloatReadRef InOutLevelDb = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameOutLevelDb), Settings);
+
+		return MakeUnique<FMultibandSaturationOperator>(Settings, AudioIn, InNumBands, InCrossoverFrequencies, InBands, InBias, InOutLevelDb);
+	}
+
+	void FMultibandSaturationOperator::Execute()
+	{
+		MultibandSaturationDSPProcessor.SetNumBands(*NumBands);
+
+		for (int32 Index = 0; Index < NumCrossovers; ++Index)
+		{
+			MultibandSaturationDSPProcessor.SetCrossoverFrequency(Index, *CrossoverFrequencies[Index]);
+		}
+
+		for (int32 Index = 0; Index < MaxNumBands; ++Index)
+		{
+			MultibandSaturationDSPProcessor.SetBandSaturationType(Index, *Bands[Index].SaturationType);
+			MultibandSaturationDSPProcessor.SetBandGain(Index, *Bands[Index].Gain);
+			MultibandSaturationDSPProcessor.SetBandMix(Index, *Bands[Index].Mix);
+		}
+
+		MultibandSaturationDSPProcessor.SetBias(*Bias);
+		MultibandSaturationDSPProcessor.SetOutLevelDb(*OutLevelDb);
+
+		const float* InputAudio = AudioInput->GetData();
+		float* OutputAudio      = AudioOutput->GetData();
+		const int32 NumSamples  = AudioInput->Num();
+
+		MultibandSaturationDSPProcessor.ProcessAudioBuffer(InputAudio, OutputAudio, NumSamples);
+	}
+	
+	void FMultibandSaturationOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		AudioOutput->Zero();
+		MultibandSaturationDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate());
+	}
+
+	METASOUND_REGISTER_NODE(FMultibandSaturationNode)
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,216 @@
+#include "MetasoundNodes/MetasoundSaturationCascadeNode.h"
+
+#define LOCTEXT_NAMESPACE "DSPCollection_MetasoundSaturationCascadeNode"
+
+namespace DSPCollection
+{
+	using namespace Metasound;
+
+	namespace SaturationCascadeNode
+	{
+		METASOUND_PARAM(InParamNameAudioInput,     "In",                 "Audio input.")
+		METASOUND_PARAM(InParamNameNumStages,      "Num Stages",         "Number of saturation stages the input goes through, one after the other. Range = [1, 4]")
+		METASOUND_PARAM(InParamNameStage1Type,     "Stage 1 Type",       "Saturation algorithm of stage 1. TapeHysteresis, Harmonic and Custom run as Tape.")
+		METASOUND_PARAM(InParamNameStage1Gain,     "Stage 1 Gain",       "The amount of gain to apply in stage 1. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameStage1Bias,     "Stage 1 Bias",       "The amount of DC bias to apply in stage 1. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameStage1LevelDb,  "Stage 1 Level (dB)", "Gain (in dB) applied to the output of stage 1, before the next stage. Range = [-96dB, +24dB]")
+		METASOUND_PARAM(InParamNameStage2Type,     "Stage 2 Type",       "Saturation algorithm of stage 2. TapeHysteresis, Harmonic and Custom run as Tape.")
+		METASOUND_PARAM(InParamNameStage2Gain,     "Stage 2 Gain",       "The amount of gain to apply in stage 2. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameStage2Bias,     "Stage 2 Bias",       "The amount of DC bias to apply in stage 2. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameStage2LevelDb,  "Stage 2 Level (dB)", "Gain (in dB) applied to the output of stage 2, before the next stage. Range = [-96dB, +24dB]")
+		METASOUND_PARAM(InParamNameStage3Type,     "Stage 3 Type",       "Saturation algorithm of stage 3. TapeHysteresis, Harmonic and Custom run as Tape.")
+		METASOUND_PARAM(InParamNameStage3Gain,     "Stage 3 Gain",       "The amount of gain to apply in stage 3. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameStage3Bias,     "Stage 3 Bias",       "The amount of DC bias to apply in stage 3. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameStage3LevelDb,  "Stage 3 Level (dB)", "Gain (in dB) applied to the output of stage 3, before the next stage. Range = [-96dB, +24dB]")
+		METASOUND_PARAM(InParamNameStage4Type,     "Stage 4 Type",       "Saturation algorithm of stage 4. TapeHysteresis, Harmonic and Custom run as Tape.")
+		METASOUND_PARAM(InParamNameStage4Gain,     "Stage 4 Gain",       "The amount of gain to apply in stage 4. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameStage4Bias,     "Stage 4 Bias",       "The amount of DC bias to apply in stage 4. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameStage4LevelDb,  "Stage 4 Level (dB)", "Gain (in dB) applied to the output of stage 4. Range = [-96dB, +24dB]")
+		METASOUND_PARAM(InParamNameMix,            "Mix",                "The amount of mix between the output of the last stage and the input of the cascade. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameOutLevelDb,     "Out Level (dB)",     "The amount of gain (in dB) to apply to the output signal. Range = [-96dB, +24dB]")
+		METASOUND_PARAM(OutParamNameAudio,         "Out",                "Audio output.")
+
+		static const FVertexName& GetStageTypeParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameStage1Type), METASOUND_GET_PARAM_NAME(InParamNameStage2Type), METASOUND_GET_PARAM_NAME(InParamNameStage3Type), METASOUND_GET_PARAM_NAME(InParamNameStage4Type) };
+			return Names[InIndex];
+		}
+
+		static const FVertexName& GetStageGainParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameStage1Gain), METASOUND_GET_PARAM_NAME(InParamNameStage2Gain), METASOUND_GET_PARAM_NAME(InParamNameStage3Gain), METASOUND_GET_PARAM_NAME(InParamNameStage4Gain) };
+			return Names[InIndex];
+		}
+
+		static const FVertexName& GetStageBiasParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameStage1Bias), METASOUND_GET_PARAM_NAME(InParamNameStage2Bias), METASOUND_GET_PARAM_NAME(InParamNameStage3Bias), METASOUND_GET_PARAM_NAME(InParamNameStage4Bias) };
+			return Names[InIndex];
+		}
+
+		static const FVertexName& GetStageLevelDbParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameStage1LevelDb), METASOUND_GET_PARAM_NAME(InParamNameStage2LevelDb), METASOUND_GET_PARAM_NAME(InParamNameStage3LevelDb), METASOUND_GET_PARAM_NAME(InParamNameStage4LevelDb) };
+			return Names[InIndex];
+		}
+	}
+
+	FSaturationCascadeOperator::FSaturationCascadeOperator(const FOperatorSettings& InSettings,
+														   const FAudioBufferReadRef& InAudioInput,
+														   const FInt32ReadRef& InNumStages,
+														   const TArray<FStageInputs>& InStages,
+														   const FFloatReadRef& InMix,
+														   const FFloatReadRef& InOutLevelDb)
+		: AudioInput(InAudioInput)
+		, AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings))
+		, NumStages(InNumStages)
+		, Stages(InStages)
+		, Mix(InMix)
+		, OutLevelDb(InOutLevelDb)
+	{
+		SaturationCascadeDSPProcessor.Init(InSettings.GetSampleRate());
+	}
+
+	const FNodeClassMetadata& FSaturationCascadeOperator::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("SaturationCascade"), TEXT("Audio") };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 0;
+			Info.DisplayName       = LOCTEXT("DSPCollection_SaturationCascadeDisplayName",     "Saturation Cascade");
+			Info.Description       = LOCTEXT("DSPCollection_SaturationCascadeNodeDescription", "Runs the audio input through 1-4 saturation stages in a single pass, for amp-style chains (e.g. Tube -> Tube2 -> Tape).");
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_SaturationCascadeNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	void FSaturationCascadeOperator::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace SaturationCascadeNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameNumStages), NumStages);
+
+		for (int32 Index = 0; Index < MaxNumStages; ++Index)
+		{
+			InOutVertexData.BindReadVertex(GetStageTypeParamName(Index), Stages[Index].SaturationType);
+			InOutVertexData.BindReadVertex(GetStageGainParamName(Index), Stages[Index].Gain);
+			InOutVertexData.BindReadVertex(GetStageBiasParamName(Index), Stages[Index].Bias);
+			InOutVertexData.BindReadVertex(GetStageLevelDbParamName(Index), Stages[Index].LevelDb);
+		}
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameMix), Mix);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameOutLevelDb), OutLevelDb);
+	}
+
+	void FSaturationCascadeOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace SaturationCascadeNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudio), AudioOutput);
+	}
+
+	const FVertexInterface& FSaturationCascadeOperator::GetVertexInterface()
+	{
+		using namespace SaturationCascadeNode;
+
+		static const FVertexInterface Interface(
+			FInputVertexInterface(
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInput)),
+				TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameNumStages),                 3),
+				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage1Type), static_cast<int32>(DSPProcessing::ESaturationType::Tube)),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage1Gain),                50.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage1Bias),                0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage1LevelDb),             0.0f),
+				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage2Type), static_cast<int32>(DSPProcessing::ESaturationType::Tube2)),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage2Gain),                50.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage2Bias),                0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage2LevelDb),             0.0f),
+				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage3Type), static_cast<int32>(DSPProcessing::ESaturationType::Tape)),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage3Gain),                50.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage3Bias),                0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage3LevelDb),             0.0f),
+				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage4Type), static_cast<int32>(DSPProcessing::ESaturationType::Tape)),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage4Gain),                50.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage4Bias),                0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameStage4LevelDb),             0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameMix),                       100.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameOutLevelDb),                0.0f)
+			),
+
+			FOutputVertexInterface(
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameAudio))
+			)
+		);
+
+		return Interface;
+	}
+
+	TUniquePtr<IOperator> FSaturationCascadeOperator::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace SaturationCascadeNode;
+
+		const FInputVertexInterfaceData& InputData = InParams.InputData;
+		const FOperatorSettings& Settings          = InParams.OperatorSettings;
+
+		FAudioBufferReadRef AudioIn = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), Settings);
+		FInt32ReadRef InNumStages   = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InParamNameNumStages), Settings);
+
+		TArray<FStageInputs> InStages;
+		for (int32 Index = 0; Index < MaxNumStages; ++Index)
+		{
+			InStages.Add({ InputData.GetOrCreateDefaultDataReadReference<FEnumESaturationType>(GetStageTypeParamName(Index), Settings),
+						   InputData.GetOrCreateDefaultDataReadReference<float>(GetStageGainParamName(Index), Settings),
+						   InputData.GetOrCreateDefaultDataReadReference<float>(GetStageBiasParamName(Index), Settings),
+						   InputData.GetOrCreateDefaultDataReadReference<float>(GetStageLevelDbParamName(Index), Settings) });
+		}
+
+		FFloatReadRef InMix        = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameMix),        Settings);
+		FFloatReadRef InOutLevelDb = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameOutLevelDb), Settings);
+
+		return MakeUnique<FSaturationCascadeOperator>(Settings, AudioIn, InNumStages, InStages, InMix, InOutLevelDb);
+	}
+
+	void FSaturationCascadeOperator::Execute()
+	{
+		SaturationCascadeDSPProcessor.SetNumStages(*NumStages);
+
+		for (int32 Index = 0; Index < MaxNumStages; ++Index)
+		{
+			SaturationCascadeDSPProcessor.SetStageSaturationType(Index, *Stages[Index].SaturationType);
+			SaturationCascadeDSPProcessor.SetStageGain(Index, *Stages[Index].Gain);
+			SaturationCascadeDSPProcessor.SetStageBias(Index, *Stages[Index].Bias);
+			SaturationCascadeDSPProcessor.SetStageLevelDb(Index, *Stages[Index].LevelDb);
+		}
+
+		SaturationCascadeDSPProcessor.SetMix(*Mix);
+		SaturationCascadeDSPProcessor.SetOutLevelDb(*OutLevelDb);
+
+		const float* InputAudio = AudioInput->GetData();
+		float* OutputAudio      = AudioOutput->GetData();
+		const int32 NumSamples  = AudioInput->Num();
+
+		SaturationCascadeDSPProcessor.ProcessAudioBuffer(InputAudio, OutputAudio, NumSamples);
+	}
+
+	void FSaturationCascadeOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		AudioOutput->Zero();
+		SaturationCascadeDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate());
+	}
+
+	METASOUND_REGISTER_NODE(FSaturationCascadeNode)
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -1,4 +1,6 @@
 #include "MetasoundNodes/MetasoundSaturationNode.h"
+#include "Assets/DSPCollectionTransferCurve.h"
+#include "MetasoundDataTypeRegistrationMacro.h"
 
 #define LOCTEXT_NAMESPACE "DSPCollection_MetasoundSaturationNode"
 
@@ -16,8 +18,40 @@ namespace Metasound
 		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ESaturationType::HardClip,          "HardClipDescription",          "HardClip",          "HardClipTT",          "Hard Clip Saturation"),
 		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ESaturationType::Foldback,          "FoldbackDescription",          "Foldback",          "FoldbackTT",          "Foldback Saturation"),
 		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ESaturationType::HalfWaveRectifier, "HalfWaveRectifierDescription", "HalfWaveRectifier", "HalfWaveRectifierTT", "Half Wave Rectifier Saturation"),
-		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ESaturationType::FullWaveRectifier, "FullWaveRectifierDescription", "FullWaveRectifier", "FullWaveRectifierTT", "Full Wave Rectifier Saturation")
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ESaturationType::FullWaveRectifier, "FullWaveRectifierDescription", "FullWaveRectifier", "FullWaveRectifierTT", "Full Wave Rectifier Saturation"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ESaturationType::TapeHysteresis,    "TapeHysteresisDescription",    "TapeHysteresis",    "TapeHysteresisTT",    "Tape Saturation with magnetic hysteresis (stateful)"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ESaturationType::Harmonic,          "HarmonicDescription",          "Harmonic",          "HarmonicTT",          "Polynomial curve with the level of each harmonic set by the Harmonic inputs"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ESaturationType::Custom,            "CustomDescription",            "Custom",            "CustomTT",            "Curve of the Custom Curve asset, Tape without one")
 	DEFINE_METASOUND_ENUM_END()
+
+	DEFINE_METASOUND_ENUM_BEGIN(DSPProcessing::ETapeHysteresisSolver, FEnumETapeHysteresisSolver, "TapeHysteresisSolver")
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ETapeHysteresisSolver::RK2, "RK2Description", "RK2", "RK2TT", "2nd order Runge-Kutta, 2 evaluations per step"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::ETapeHysteresisSolver::RK4, "RK4Description", "RK4", "RK4TT", "4th order Runge-Kutta, 4 evaluations per step")
+	DEFINE_METASOUND_ENUM_END()
+
+	DEFINE_METASOUND_ENUM_BEGIN(DSPProcessing::EEnvelopeDetectorMode, FEnumEEnvelopeDetectorMode, "EnvelopeDetectorMode")
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EEnvelopeDetectorMode::Peak, "PeakDescription", "Peak", "PeakTT", "Follows the peak level of the input"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EEnvelopeDetectorMode::RMS,  "RMSDescription",  "RMS",  "RMSTT",  "Follows the RMS level of the input")
+	DEFINE_METASOUND_ENUM_END()
+
+	DEFINE_METASOUND_ENUM_BEGIN(DSPProcessing::EEmphasisFilterType, FEnumEEmphasisFilterType, "EmphasisFilterType")
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EEmphasisFilterType::Off,       "OffDescription",       "Off",       "OffTT",       "No filter"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EEmphasisFilterType::LowCut,    "LowCutDescription",    "LowCut",    "LowCutTT",    "2nd order high-pass"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EEmphasisFilterType::HighCut,   "HighCutDescription",   "HighCut",   "HighCutTT",   "2nd order low-pass"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EEmphasisFilterType::LowShelf,  "LowShelfDescription",  "LowShelf",  "LowShelfTT",  "Boosts or cuts below the frequency"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EEmphasisFilterType::HighShelf, "HighShelfDescription", "HighShelf", "HighShelfTT", "Boosts or cuts above the frequency"),
+		DEFINE_METASOUND_ENUM_ENTRY(DSPProcessing::EEmphasisFilterType::Peak,      "PeakDescription",      "Peak",      "PeakTT",      "Boosts or cuts around the frequency")
+	DEFINE_METASOUND_ENUM_END()
+
+	FTransferCurveAsset::FTransferCurveAsset(const TSharedPtr<Audio::IProxyData>& InInitData)
+	{
+		if (InInitData.IsValid() && InInitData->CheckTypeCast<FDSPCollectionTransferCurveProxy>())
+		{
+			TransferCurve = InInitData->GetAs<FDSPCollectionTransferCurveProxy>().GetTransferCurve();
+		}
+	}
+
+	REGISTER_METASOUND_DATATYPE(FTransferCurveAsset, "DSPCollectionTransferCurve", ELiteralType::UObjectProxy, UDSPCollectionTransferCurve);
 }
 
 namespace DSPCollection
@@ -26,31 +60,72 @@ namespace DSPCollection
 
 	namespace SaturationNode
 	{
-		METASOUND_PARAM(InParamNameAudioInput,     "In",              "Audio input.")
-		METASOUND_PARAM(InParamNameGain,           "Gain",            "The amount of gain to apply to the input signal. Range = [0.0, 100.0]")
-		METASOUND_PARAM(InParamNameBias,           "Bias",            "The amount of DC bias to apply to the input signal, this generates even harmonics in the saturated signal. Range = [-1.0, 1.0]")
-		METASOUND_PARAM(InParamNameMix,            "Mix",             "The amount of mix between the saturated signal and the direct input signal. Range = [0.0, 100.0]")
-		METASOUND_PARAM(InParamNameOutLevelDb,     "Out Level (dB)",  "The amount of gain (in dB) to apply to the output signal. Range = [-96dB, +24dB]")
-		METASOUND_PARAM(InParamNameSaturationType, "Saturation Type", "Saturation algorithm to use to process the audio.")
-		METASOUND_PARAM(OutParamNameAudio,         "Out",             "Audio output.")
-	}
-
-	FSaturationOperator::FSaturationOperator(const FOperatorSettings& InSettings, 
-											 const FAudioBufferReadRef& InAudioInput, 
-											 const FFloatReadRef& InGain, 
-											 const FFloatReadRef& InBias, 
-											 const FFloatReadRef& InMix, 
-											 const FFloatReadRef& InOutLevelDb,
-											 const FEnumSaturationReadRef& InSaturationTypeType)
+		METASOUND_PARAM(InParamNameAudioInput,             "In",                      "Audio input.")
+		METASOUND_PARAM(InParamNameGain,                   "Gain",                    "The amount of gain to apply to the input signal. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameBias,                   "Bias",                    "The amount of DC bias to apply to the input signal, this generates even harmonics in the saturated signal. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameMix,                    "Mix",                     "The amount of mix between the saturated signal and the direct input signal. Range = [0.0, 100.0]")
+		METASOUND_PARAM(InParamNameOutLevelDb,             "Out Level (dB)",          "The amount of gain (in dB) to apply to the output signal. Range = [-96dB, +24dB]")
+		METASOUND_PARAM(InParamNameSaturationType,         "Saturation Type",         "Saturation algorithm to use to process the audio.")
+		METASOUND_PARAM(InParamNameDCBlocker,              "DC Blocker",              "Enables a one-pole high-pass at the output that removes the DC offset introduced by Bias.")
+		METASOUND_PARAM(InParamNameDCBlockerCutoff,        "DC Blocker Cutoff",       "Cutoff frequency (in Hz) of the DC blocker. Range = [5.0, 200.0]")
+		METASOUND_PARAM(InParamNameEnvelopeFollower,       "Envelope Follower",       "Enables the envelope follower that modulates Gain and Bias with the input level.")
+		METASOUND_PARAM(InParamNameEnvelopeDetectorMode,   "Envelope Mode",           "Level detector of the envelope follower.")
+		METASOUND_PARAM(InParamNameEnvelopeAttackTimeMs,   "Envelope Attack",         "Attack time (in ms) of the envelope follower. Range = [0.1, 500.0]")
+		METASOUND_PARAM(InParamNameEnvelopeReleaseTimeMs,  "Envelope Release",        "Release time (in ms) of the envelope follower. Range = [1.0, 5000.0]")
+		METASOUND_PARAM(InParamNameEnvelopeToGain,         "Envelope To Gain",        "Positive values reduce the drive as the level drops, negative values increase it. Range = [-100.0, 100.0]")
+		METASOUND_PARAM(InParamNameEnvelopeToBias,         "Envelope To Bias",        "Amount of Bias added at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameHysteresisSolver,       "Hysteresis Solver",       "Solver of the TapeHysteresis type.")
+		METASOUND_PARAM(InParamNameHysteresisOversampling, "Hysteresis Oversampling", "Internal oversampling of the TapeHysteresis type. Range = [1, 4]")
+		METASOUND_PARAM(InParamNamePreEmphasisType,        "Pre Emphasis",            "Filter applied to the signal that drives the curve, the dry path is not filtered.")
+		METASOUND_PARAM(InParamNamePreEmphasisFrequency,   "Pre Emphasis Freq",       "Frequency (in Hz) of the pre-emphasis filter. Range = [20.0, 20000.0]")
+		METASOUND_PARAM(InParamNamePreEmphasisGainDb,      "Pre Emphasis Gain",       "Gain (in dB) of the pre-emphasis shelf or peak. Range = [-24.0, 24.0]")
+		METASOUND_PARAM(InParamNamePreEmphasisQ,           "Pre Emphasis Q",          "Q of the pre-emphasis filter. Range = [0.1, 10.0]")
+		METASOUND_PARAM(InParamNamePostEmphasisType,       "Post Emphasis",           "Filter applied to the output of the curve, before the mix.")
+		METASOUND_PARAM(InParamNamePostEmphasisFrequency,  "Post Emphasis Freq",      "Frequency (in Hz) of the post-emphasis filter. Range = [20.0, 20000.0]")
+		METASOUND_PARAM(InParamNamePostEmphasisGainDb,     "Post Emphasis Gain",      "Gain (in dB) of the post-emphasis shelf or peak. Range = [-24.0, 24.0]")
+		METASOUND_PARAM(InParamNamePostEmphasisQ,          "Post Emphasis Q",         "Q of the post-emphasis filter. Range = [0.1, 10.0]")
+		METASOUND_PARAM(InParamNameHarmonic1,              "Harmonic 1",              "Level of the fundamental for the Harmonic type, at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameHarmonic2,              "Harmonic 2",              "Level of the 2nd harmonic for the Harmonic type, at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameHarmonic3,              "Harmonic 3",              "Level of the 3rd harmonic for the Harmonic type, at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameHarmonic4,              "Harmonic 4",              "Level of the 4th harmonic for the Harmonic type, at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameHarmonic5,              "Harmonic 5",              "Level of the 5th harmonic for the Harmonic type, at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameHarmonic6,              "Harmonic 6",              "Level of the 6th harmonic for the Harmonic type, at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameHarmonic7,              "Harmonic 7",              "Level of the 7th harmonic for the Harmonic type, at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameHarmonic8,              "Harmonic 8",              "Level of the 8th harmonic for the Harmonic type, at full scale input. Range = [-1.0, 1.0]")
+		METASOUND_PARAM(InParamNameCustomCurve,            "Custom Curve",            "DSPCollection Transfer Curve asset of the Custom type, no asset falls back to Tape.")
+		METASOUND_PARAM(OutParamNameAudio,                 "Out",                     "Audio output.")
+		METASOUND_PARAM(InParamNameAudioInputChannel,      "In {0}",                  "Audio input of channel {0}.")
+		METASOUND_PARAM(OutParamNameAudioChannel,          "Out {0}",                 "Audio output of channel {0}.")
+
+		static const TCHAR* GetChannelConfigName(const int32 NumChannels)
+		{
+			switch (NumChannels)
+			{
+				case 2:  return TEXT("Stereo");
+				case 4:  return TEXT("Quad");
+				case 6:  return TEXT("5.1");
+				case 8:  return TEXT("7.1");
+				default: return TEXT("Multichannel");
+			}
+		}
+
+		static const FVertexName& GetHarmonicParamName(const int32 InIndex)
+		{
+			static const FVertexName Names[] = { METASOUND_GET_PARAM_NAME(InParamNameHarmonic1), METASOUND_GET_PARAM_NAME(InParamNameHarmonic2), METASOUND_GET_PARAM_NAME(InParamNameHarmonic3), METASOUND_GET_PARAM_NAME(InParamNameHarmonic4),
+												 METASOUND_GET_PARAM_NAME(InParamNameHarmonic5), METASOUND_GET_PARAM_NAME(InParamNameHarmonic6), METASOUND_GET_PARAM_NAME(InParamNameHarmonic7), METASOUND_GET_PARAM_NAME(InParamNameHarmonic8) };
+			static_assert(UE_ARRAY_COUNT(Names) == DSPProcessing::FHarmonicShaper::MaxHarmonic);
+			return Names[InIndex];
+		}
+	}
+
+	FSaturationOperator::FSaturationOperator(const FOperatorSettings& InSettings,
+											 const FAudioBufferReadRef& InAudioInput,
+											 const FSaturationNodeControls& InControls)
 		: AudioInput(InAudioInput)
 		, AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings))
-		, Gain(InGain)
-		, Bias(InBias)
-		, Mix(InMix)
-		, OutLevelDb(InOutLevelDb)
-		, SaturationType(InSaturationTypeType)
+		, Controls(InControls)
 	{
-		SaturationDSPProcessor.Init(InSettings.GetSampleRate());
+		SaturationDSPProcessor.Init(InSettings.GetSampleRate(), 1, 1, InSettings.GetNumFramesPerBlock());
 	}
 
 		const FNodeClassMetadata& FSaturationOperator::GetNodeInfo()
@@ -61,7 +136,7 @@ namespace DSPCollection
 
 			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("Saturation"), TEXT("Audio") };
 			Info.MajorVersion      = 1;
-			Info.MinorVersion      = 1;
+			Info.MinorVersion      = 7;
 			Info.DisplayName       = LOCTEXT("DSPCollection_SaturationDisplayName",     "Saturation");
 			Info.Description       = LOCTEXT("DSPCollection_SaturationNodeDescription", "Applies saturation to the audio input.");
 			Info.Author            = "Alex Perez";
@@ -82,11 +157,8 @@ namespace DSPCollection
 		using namespace SaturationNode;
 
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameGain), Gain);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameBias), Bias);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameMix), Mix);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameOutLevelDb), OutLevelDb);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameSaturationType), SaturationType);
+
+		Controls.Bind(InOutVertexData);
 	}
 
 	void FSaturationOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
@@ -100,20 +172,22 @@ namespace DSPCollection
 	{
 		using namespace SaturationNode;
 
-		static const FVertexInterface Interface(
-			FInputVertexInterface(
-				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInput)),
-				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameGain),                          100.0f),
-				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBias),                          0.0f),
-				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameMix),                           100.0f),
-				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameOutLevelDb),                    0.0f),
-				TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameSaturationType), static_cast<int32>(DSPProcessing::ESaturationType::Tape))
-			),
-			
-			FOutputVertexInterface(
+		auto CreateVertexInterface = []() -> FVertexInterface
+		{
+			FInputVertexInterface InputInterface(
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAudioInput))
+			);
+
+			FSaturationNodeControls::AddInputVertices(InputInterface);
+
+			FOutputVertexInterface OutputInterface(
 				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameAudio))
-			)
-		);
+			);
+
+			return FVertexInterface(InputInterface, OutputInterface);
+		};
+
+		static const FVertexInterface Interface = CreateVertexInterface();
 
 		return Interface;
 	}
@@ -124,23 +198,12 @@ namespace DSPCollection
 
 		FAudioBufferReadRef AudioIn = InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), InParams.OperatorSettings);
 
-		FFloatReadRef InGain       = InParams.InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameGain),       InParams.OperatorSettings);
-		FFloatReadRef InBias       = InParams.InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameBias),       InParams.OperatorSettings);
-		FFloatReadRef InMix        = InParams.InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameMix),        InParams.OperatorSettings);
-		FFloatReadRef InOutLevelDb = InParams.InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameOutLevelDb), InParams.OperatorSettings);
-
-		FEnumSaturationReadRef InSaturationType = InParams.InputData.GetOrCreateDefaultDataReadReference<FEnumESaturationType>(METASOUND_GET_PARAM_NAME(InParamNameSaturationType), InParams.OperatorSettings);
-
-		return MakeUnique<FSaturationOperator>(InParams.OperatorSettings, AudioIn, InGain, InBias, InMix, InOutLevelDb, InSaturationType);
+		return MakeUnique<FSaturationOperator>(InParams.OperatorSettings, AudioIn, FSaturationNodeControls::Create(InParams));
 	}
 
 	void FSaturationOperator::Execute()
 	{
-		SaturationDSPProcessor.SetSaturationType(*SaturationType); // Set SaturationType first since Gain depends on it
-		SaturationDSPProcessor.SetGain(*Gain);
-		SaturationDSPProcessor.SetBias(*Bias);
-		SaturationDSPProcessor.SetMix(*Mix);
-		SaturationDSPProcessor.SetOutLevelDb(*OutLevelDb);
+		Controls.Apply(SaturationDSPProcessor);
 
 		const float* InputAudio = AudioInput->GetData();
 		float* OutputAudio      = AudioOutput->GetData();
@@ -152,10 +215,424 @@ namespace DSPCollection
 	void FSaturationOperator::Reset(const IOperator::FResetParams& InParams)
 	{
 		AudioOutput->Zero();
-		SaturationDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate());
+		SaturationDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate(), 1, 1, InParams.OperatorSettings.GetNumFramesPerBlock());
 	}
 
 	METASOUND_REGISTER_NODE(FSaturationNode)
+
+	//------------------------------------------------------------------------------------
+	// FSaturationEmphasisControls
+	//------------------------------------------------------------------------------------
+	FSaturationEmphasisControls FSaturationEmphasisControls::Create(const FBuildOperatorParams& InParams)
+	{
+		using namespace SaturationNode;
+
+		const FInputVertexInterfaceData& InputData = InParams.InputData;
+		const FOperatorSettings& Settings          = InParams.OperatorSettings;
+
+		return FSaturationEmphasisControls
+		{
+			InputData.GetOrCreateDefaultDataReadReference<FEnumEEmphasisFilterType>(METASOUND_GET_PARAM_NAME(InParamNamePreEmphasisType), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNamePreEmphasisFrequency), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNamePreEmphasisGainDb), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNamePreEmphasisQ), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<FEnumEEmphasisFilterType>(METASOUND_GET_PARAM_NAME(InParamNamePostEmphasisType), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNamePostEmphasisFrequency), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNamePostEmphasisGainDb), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNamePostEmphasisQ), Settings)
+		};
+	}
+
+	void FSaturationEmphasisControls::AddInputVertices(FInputVertexInterface& InOutInterface)
+	{
+		using namespace SaturationNode;
+
+		InOutInterface.Add(TInputDataVertex<FEnumEEmphasisFilterType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNamePreEmphasisType),  static_cast<int32>(DSPProcessing::EEmphasisFilterType::Off)));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNamePreEmphasisFrequency),                1000.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNamePreEmphasisGainDb),                   0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNamePreEmphasisQ),                        0.707f));
+		InOutInterface.Add(TInputDataVertex<FEnumEEmphasisFilterType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNamePostEmphasisType), static_cast<int32>(DSPProcessing::EEmphasisFilterType::Off)));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNamePostEmphasisFrequency),               1000.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNamePostEmphasisGainDb),                  0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNamePostEmphasisQ),                       0.707f));
+	}
+
+	void FSaturationEmphasisControls::Bind(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace SaturationNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNamePreEmphasisType), PreType);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNamePreEmphasisFrequency), PreFrequency);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNamePreEmphasisGainDb), PreGainDb);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNamePreEmphasisQ), PreQ);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNamePostEmphasisType), PostType);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNamePostEmphasisFrequency), PostFrequency);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNamePostEmphasisGainDb), PostGainDb);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNamePostEmphasisQ), PostQ);
+	}
+
+	void FSaturationEmphasisControls::Apply(DSPProcessing::FSaturation& InOutSaturation) const
+	{
+		// Unchanged bands are ignored by the filters, so this is cheap to call every block
+		DSPProcessing::FEmphasisBand PreBand;
+		PreBand.Type      = *PreType;
+		PreBand.Frequency = FMath::Clamp(*PreFrequency, 20.0f, 20000.0f);
+		PreBand.GainDb    = FMath::Clamp(*PreGainDb, -24.0f, 24.0f);
+		PreBand.Q         = FMath::Clamp(*PreQ, 0.1f, 10.0f);
+
+		DSPProcessing::FEmphasisBand PostBand;
+		PostBand.Type      = *PostType;
+		PostBand.Frequency = FMath::Clamp(*PostFrequency, 20.0f, 20000.0f);
+		PostBand.GainDb    = FMath::Clamp(*PostGainDb, -24.0f, 24.0f);
+		PostBand.Q         = FMath::Clamp(*PostQ, 0.1f, 10.0f);
+
+		InOutSaturation.SetPreEmphasisBand(0, PreBand);
+		InOutSaturation.SetPostEmphasisBand(0, PostBand);
+	}
+
+	//------------------------------------------------------------------------------------
+	// FSaturationHarmonicControls
+	//------------------------------------------------------------------------------------
+	FSaturationHarmonicControls FSaturationHarmonicControls::Create(const FBuildOperatorParams& InParams)
+	{
+		using namespace SaturationNode;
+
+		FSaturationHarmonicControls Controls;
+
+		for (int32 Index = 0; Index < DSPProcessing::FHarmonicShaper::MaxHarmonic; ++Index)
+		{
+			Controls.Weights.Add(InParams.InputData.GetOrCreateDefaultDataReadReference<float>(GetHarmonicParamName(Index), InParams.OperatorSettings));
+		}
+
+		return Controls;
+	}
+
+	void FSaturationHarmonicControls::AddInputVertices(FInputVertexInterface& InOutInterface)
+	{
+		using namespace SaturationNode;
+
+		// Fundamental only by default
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHarmonic1), 1.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHarmonic2), 0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHarmonic3), 0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHarmonic4), 0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHarmonic5), 0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHarmonic6), 0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHarmonic7), 0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHarmonic8), 0.0f));
+	}
+
+	void FSaturationHarmonicControls::Bind(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace SaturationNode;
+
+		for (int32 Index = 0; Index < Weights.Num(); ++Index)
+		{
+			InOutVertexData.BindReadVertex(GetHarmonicParamName(Index), Weights[Index]);
+		}
+	}
+
+	void FSaturationHarmonicControls::Apply(DSPProcessing::FSaturation& InOutSaturation) const
+	{
+		// The coefficients are only rebuilt for the weights that changed
+		for (int32 Index = 0; Index < Weights.Num(); ++Index)
+		{
+			InOutSaturation.SetHarmonicWeight(Index + 1, *Weights[Index]);
+		}
+	}
+
+	//------------------------------------------------------------------------------------
+	// FSaturationCustomCurveControls
+	//------------------------------------------------------------------------------------
+	FSaturationCustomCurveControls FSaturationCustomCurveControls::Create(const FBuildOperatorParams& InParams)
+	{
+		using namespace SaturationNode;
+
+		return FSaturationCustomCurveControls
+		{
+			InParams.InputData.GetOrCreateDefaultDataReadReference<FTransferCurveAsset>(METASOUND_GET_PARAM_NAME(InParamNameCustomCurve), InParams.OperatorSettings)
+		};
+	}
+
+	void FSaturationCustomCurveControls::AddInputVertices(FInputVertexInterface& InOutInterface)
+	{
+		using namespace SaturationNode;
+
+		InOutInterface.Add(TInputDataVertex<FTransferCurveAsset>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameCustomCurve)));
+	}
+
+	void FSaturationCustomCurveControls::Bind(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace SaturationNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameCustomCurve), Curve);
+	}
+
+	void FSaturationCustomCurveControls::Apply(DSPProcessing::FSaturation& InOutSaturation) const
+	{
+		InOutSaturation.SetCustomCurve(Curve->GetTransferCurve());
+	}
+
+	//------------------------------------------------------------------------------------
+	// FSaturationNodeControls
+	//------------------------------------------------------------------------------------
+	FSaturationNodeControls FSaturationNodeControls::Create(const FBuildOperatorParams& InParams)
+	{
+		using namespace SaturationNode;
+
+		const FInputVertexInterfaceData& InputData = InParams.InputData;
+		const FOperatorSettings& Settings          = InParams.OperatorSettings;
+
+		return FSaturationNodeControls
+		{
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameGain), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameBias), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameMix), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameOutLevelDb), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<FEnumESaturationType>(METASOUND_GET_PARAM_NAME(InParamNameSaturationType), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InParamNameDCBlocker), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameDCBlockerCutoff), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeFollower), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<FEnumEEnvelopeDetectorMode>(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeDetectorMode), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeAttackTimeMs), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeReleaseTimeMs), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeToGain), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeToBias), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<FEnumETapeHysteresisSolver>(METASOUND_GET_PARAM_NAME(InParamNameHysteresisSolver), Settings),
+			InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InParamNameHysteresisOversampling), Settings),
+			FSaturationEmphasisControls::Create(InParams),
+			FSaturationHarmonicControls::Create(InParams),
+			FSaturationCustomCurveControls::Create(InParams)
+		};
+	}
+
+	void FSaturationNodeControls::AddInputVertices(FInputVertexInterface& InOutInterface)
+	{
+		using namespace SaturationNode;
+
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameGain),                          100.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBias),                          0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameMix),                           100.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameOutLevelDb),                    0.0f));
+		InOutInterface.Add(TInputDataVertex<FEnumESaturationType>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameSaturationType), static_cast<int32>(DSPProcessing::ESaturationType::Tape)));
+		InOutInterface.Add(TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameDCBlocker),                      false));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameDCBlockerCutoff),               10.0f));
+		InOutInterface.Add(TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameEnvelopeFollower),               false));
+		InOutInterface.Add(TInputDataVertex<FEnumEEnvelopeDetectorMode>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameEnvelopeDetectorMode), static_cast<int32>(DSPProcessing::EEnvelopeDetectorMode::Peak)));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameEnvelopeAttackTimeMs),          10.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameEnvelopeReleaseTimeMs),         100.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameEnvelopeToGain),                0.0f));
+		InOutInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameEnvelopeToBias),                0.0f));
+		InOutInterface.Add(TInputDataVertex<FEnumETapeHysteresisSolver>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHysteresisSolver), static_cast<int32>(DSPProcessing::ETapeHysteresisSolver::RK4)));
+		InOutInterface.Add(TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameHysteresisOversampling),        1));
+
+		FSaturationEmphasisControls::AddInputVertices(InOutInterface);
+		FSaturationHarmonicControls::AddInputVertices(InOutInterface);
+		FSaturationCustomCurveControls::AddInputVertices(InOutInterface);
+	}
+
+	void FSaturationNodeControls::Bind(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace SaturationNode;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameGain), Gain);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameBias), Bias);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameMix), Mix);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameOutLevelDb), OutLevelDb);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameSaturationType), SaturationType);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameDCBlocker), DCBlockerEnabled);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameDCBlockerCutoff), DCBlockerCutoff);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeFollower), EnvelopeFollowerEnabled);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeDetectorMode), EnvelopeDetectorMode);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeAttackTimeMs), EnvelopeAttackTimeMs);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeReleaseTimeMs), EnvelopeReleaseTimeMs);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeToGain), EnvelopeToGain);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameEnvelopeToBias), EnvelopeToBias);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameHysteresisSolver), TapeHysteresisSolver);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameHysteresisOversampling), TapeHysteresisOversampling);
+
+		Emphasis.Bind(InOutVertexData);
+		Harmonics.Bind(InOutVertexData);
+		CustomCurve.Bind(InOutVertexData);
+	}
+
+	void FSaturationNodeControls::Apply(DSPProcessing::FSaturation& InOutSaturation) const
+	{
+		InOutSaturation.SetSaturationType(*SaturationType); // Set SaturationType first since Gain depends on it
+		InOutSaturation.SetGain(*Gain);
+		InOutSaturation.SetTapeHysteresisSolver(*TapeHysteresisSolver);
+		InOutSaturation.SetTapeHysteresisOversampling(*TapeHysteresisOversampling);
+		InOutSaturation.SetBias(*Bias);
+		InOutSaturation.SetMix(*Mix);
+		InOutSaturation.SetOutLevelDb(*OutLevelDb);
+		InOutSaturation.SetDCBlockerEnabled(*DCBlockerEnabled);
+		InOutSaturation.SetDCBlockerCutoffFrequency(*DCBlockerCutoff);
+		InOutSaturation.SetEnvelopeFollowerEnabled(*EnvelopeFollowerEnabled);
+		InOutSaturation.SetEnvelopeDetectorMode(*EnvelopeDetectorMode);
+		InOutSaturation.SetEnvelopeAttackTimeMs(*EnvelopeAttackTimeMs);
+		InOutSaturation.SetEnvelopeReleaseTimeMs(*EnvelopeReleaseTimeMs);
+		InOutSaturation.SetEnvelopeToGain(*EnvelopeToGain);
+		InOutSaturation.SetEnvelopeToBias(*EnvelopeToBias);
+
+		Emphasis.Apply(InOutSaturation);
+		Harmonics.Apply(InOutSaturation);
+		CustomCurve.Apply(InOutSaturation);
+	}
+
+	//------------------------------------------------------------------------------------
+	// TSaturationMultichannelOperator
+	//------------------------------------------------------------------------------------
+	template <int32 NumChannels>
+	TSaturationMultichannelOperator<NumChannels>::TSaturationMultichannelOperator(const FOperatorSettings& InSettings,
+																				  const TArray<FAudioBufferReadRef>& InAudioInputs,
+																				  const FSaturationNodeControls& InControls)
+		: AudioInputs(InAudioInputs)
+		, Controls(InControls)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			AudioOutputs.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+		}
+
+		InterleavedBuffer.SetNumZeroed(InSettings.GetNumFramesPerBlock() * NumChannels);
+
+		SaturationDSPProcessor.Init(InSettings.GetSampleRate(), NumChannels, NumChannels, InSettings.GetNumFramesPerBlock());
+	}
+
+	template <int32 NumChannels>
+	const FNodeClassMetadata& TSaturationMultichannelOperator<NumChannels>::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			const TCHAR* ChannelConfigName = SaturationNode::GetChannelConfigName(NumChannels);
+
+			FNodeClassMetadata Info;
+
+			Info.ClassName         = { TEXT("MetasoundDSPCollection"), TEXT("Saturation"), ChannelConfigName };
+			Info.MajorVersion      = 1;
+			Info.MinorVersion      = 3;
+			Info.DisplayName       = FText::Format(LOCTEXT("DSPCollection_SaturationMultichannelDisplayName",     "Saturation ({0})"), FText::FromString(ChannelConfigName));
+			Info.Description       = FText::Format(LOCTEXT("DSPCollection_SaturationMultichannelNodeDescription", "Applies saturation to a {0} audio input."), FText::FromString(ChannelConfigName));
+			Info.Author            = "Alex Perez";
+			Info.PromptIfMissing   = PluginNodeMissingPrompt;
+			Info.DefaultInterface  = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("DSPCollection_SaturationNodeCategory", "Saturation") };
+
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	template <int32 NumChannels>
+	void TSaturationMultichannelOperator<NumChannels>::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace SaturationNode;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME_WITH_INDEX(InParamNameAudioInputChannel, Channel), AudioInputs[Channel]);
+		}
+
+		Controls.Bind(InOutVertexData);
+	}
+
+	template <int32 NumChannels>
+	void TSaturationMultichannelOperator<NumChannels>::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace SaturationNode;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME_WITH_INDEX(OutParamNameAudioChannel, Channel), AudioOutputs[Channel]);
+		}
+	}
+
+	template <int32 NumChannels>
+	const FVertexInterface& TSaturationMultichannelOperator<NumChannels>::GetVertexInterface()
+	{
+		using namespace SaturationNode;
+
+		auto CreateVertexInterface = []() -> FVertexInterface
+		{
+			FInputVertexInterface InputInterface;
+			FOutputVertexInterface OutputInterface;
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InputInterface.Add(TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(InParamNameAudioInputChannel, Channel)));
+				OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(OutParamNameAudioChannel, Channel)));
+			}
+
+			FSaturationNodeControls::AddInputVertices(InputInterface);
+
+			return FVertexInterface(InputInterface, OutputInterface);
+		};
+
+		static const FVertexInterface Interface = CreateVertexInterface();
+
+		return Interface;
+	}
+
+	template <int32 NumChannels>
+	TUniquePtr<IOperator> TSaturationMultichannelOperator<NumChannels>::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		using namespace SaturationNode;
+
+		TArray<FAudioBufferReadRef> AudioIns;
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			AudioIns.Add(InParams.InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME_WITH_INDEX(InParamNameAudioInputChannel, Channel), InParams.OperatorSettings));
+		}
+
+		return MakeUnique<TSaturationMultichannelOperator<NumChannels>>(InParams.OperatorSettings, AudioIns, FSaturationNodeControls::Create(InParams));
+	}
+
+	template <int32 NumChannels>
+	void TSaturationMultichannelOperator<NumChannels>::Execute()
+	{
+		Controls.Apply(SaturationDSPProcessor);
+
+		const float* InputAudio[NumChannels];
+		float* OutputAudio[NumChannels];
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			InputAudio[Channel]  = AudioInputs[Channel]->GetData();
+			OutputAudio[Channel] = AudioOutputs[Channel]->GetData();
+		}
+
+		const int32 NumFrames  = AudioInputs[0]->Num();
+		const int32 NumSamples = NumFrames * NumChannels;
+
+		// Sized for the block in the constructor, the block size of an operator never changes
+		check(NumSamples <= InterleavedBuffer.Num());
+
+		float* Interleaved = InterleavedBuffer.GetData();
+
+		DSPProcessing::AudioUtils::InterleaveBuffers(InputAudio, Interleaved, NumChannels, NumFrames);
+		SaturationDSPProcessor.ProcessAudioBuffer(Interleaved, Interleaved, NumSamples);
+		DSPProcessing::AudioUtils::DeinterleaveBuffer(Interleaved, OutputAudio, NumChannels, NumFrames);
+	}
+
+	template <int32 NumChannels>
+	void TSaturationMultichannelOperator<NumChannels>::Reset(const IOperator::FResetParams& InParams)
+	{
+		for (FAudioBufferWriteRef& AudioOutput : AudioOutputs)
+		{
+			AudioOutput->Zero();
+		}
+
+		SaturationDSPProcessor.Init(InParams.OperatorSettings.GetSampleRate(), NumChannels, NumChannels, InParams.OperatorSettings.GetNumFramesPerBlock());
+	}
+
+	METASOUND_REGISTER_NODE(FSaturationStereoNode)
+	METASOUND_REGISTER_NODE(FSaturationQuadNode)
+	METASOUND_REGISTER_NODE(FSaturation51Node)
+	METASOUND_REGISTER_NODE(FSaturation71Node)
 }
 
 #undef LOCTEXT_NAMESPACE
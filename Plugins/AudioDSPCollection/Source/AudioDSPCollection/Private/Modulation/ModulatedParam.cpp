@@ -0,0 +1,42 @@
+#include "Modulation/ModulatedParam.h"
+#include "DSP/Dsp.h"
+
+namespace DSPCollection
+{
+	void FModulatedParam::Init(const Audio::FDeviceId InDeviceId, const bool bInVolume)
+	{
+		bVolume    = bInVolume;
+		bModulated = false;
+
+		// Volume is registered by the AudioModulation plugin (dB unit, linear normalized), any other name gets the default normalized parameter
+		static const FName VolumeParamName(TEXT("Volume"));
+		static const FName NormalizedParamName(TEXT("DSPCollectionNormalized"));
+
+		Destination.Init(InDeviceId, bVolume ? VolumeParamName : NormalizedParamName);
+	}
+
+	void FModulatedParam::UpdateModulators(const FModulators& InModulators)
+	{
+		Destination.UpdateModulators(InModulators);
+		bModulated = (InModulators.Num() > 0);
+	}
+
+	float FModulatedParam::ProcessDb(const float InBaseValueDb)
+	{
+		check(bVolume);
+
+		Destination.ProcessControl(InBaseValueDb);
+		return Destination.GetValue();
+	}
+
+	float FModulatedParam::ProcessScale()
+	{
+		if (bVolume)
+		{
+			return Audio::ConvertToLinear(ProcessDb(0.0f));
+		}
+
+		Destination.ProcessControl(1.0f);
+		return Destination.GetValue();
+	}
+}
@@ -0,0 +1,53 @@
+#include "SourceEffects/SourceEffectConvolution.h"
+#include "Assets/DSPCollectionImpulseResponse.h"
+
+
+//------------------------------------------------------------------------------------
+// FSourceEffectConvolution
+//------------------------------------------------------------------------------------
+DEFINE_SOURCE_EFFECT_POOLED_ALLOCATION(FSourceEffectConvolution)
+
+void FSourceEffectConvolution::Init(const FSoundEffectSourceInitData& InitData)
+{
+	bIsActive   = true;
+	NumChannels = InitData.NumSourceChannels;
+	BlockFrames = UDSPCollectionImpulseResponse::GetDeviceBlockFrames(InitData.AudioDeviceId);
+
+	ConvolutionDSPProcessor.Init(InitData.SampleRate, NumChannels);
+}
+
+void FSourceEffectConvolution::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SourceEffectConvolution);
+
+	// The preset keeps the asset alive, GetSharedImpulseResponse is thread safe
+	ConvolutionDSPProcessor.SetImpulseResponse(Settings.ImpulseResponse ? Settings.ImpulseResponse->GetSharedImpulseResponse() : nullptr);
+	ConvolutionDSPProcessor.SetNonUniformPartitions(Settings.bNonUniformPartitions);
+
+	// Requests the state for the device block size, built on a background task (with the partitions the asset built on the game thread) and swapped in by the first blocks
+	if (BlockFrames > 0)
+	{
+		ConvolutionDSPProcessor.Prepare(BlockFrames);
+	}
+}
+
+void FSourceEffectConvolution::ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData)
+{
+	//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSourceEffectConvolution::ProcessAudio"))
+
+	const float* InAudioBuffer = InData.InputSourceEffectBufferPtr;
+	float* OutAudioBuffer      = OutAudioBufferData;
+
+	const int32 NumSamples = InData.NumSamples;
+
+	ConvolutionDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
+}
+
+
+//------------------------------------------------------------------------------------
+// USourceEffectConvolutionPreset
+//------------------------------------------------------------------------------------
+void USourceEffectConvolutionPreset::SetSettings(const FSourceEffectConvolutionSettings& InSettings)
+{
+	UpdateSettings(InSettings);
+}
@@ -1,22 +1,56 @@
 #include "SourceEffects/SourceEffectGain.h"
 
 
+DSPProcessing::EGainRampShape SourceEffectGainRampShapeToGainRampShape(ESourceEffectGainRampShape SourceEffectGainRampShape)
+{
+	switch (SourceEffectGainRampShape)
+	{
+		default:
+		case ESourceEffectGainRampShape::Linear:
+			return DSPProcessing::EGainRampShape::Linear;
+		case ESourceEffectGainRampShape::Exponential:
+			return DSPProcessing::EGainRampShape::Exponential;
+		case ESourceEffectGainRampShape::SCurve:
+			return DSPProcessing::EGainRampShape::SCurve;
+		case ESourceEffectGainRampShape::EqualPower:
+			return DSPProcessing::EGainRampShape::EqualPower;
+	}
+}
+
 //------------------------------------------------------------------------------------
 // FSourceEffectGain
 //------------------------------------------------------------------------------------
+DEFINE_SOURCE_EFFECT_POOLED_ALLOCATION(FSourceEffectGain)
+
 void FSourceEffectGain::Init(const FSoundEffectSourceInitData& InitData)
 {
 	bIsActive   = true;
 	NumChannels = InitData.NumSourceChannels;
+	SampleRate  = InitData.SampleRate;
 
-	GainDSPProcessor.Init(InitData.SampleRate);
+	GainModulation.Init(InitData.AudioDeviceId, true);
+
+	GainDSPProcessor.Init(SampleRate, NumChannels);
 }
 
 void FSourceEffectGain::OnPresetChanged()
 {
 	GET_EFFECT_SETTINGS(SourceEffectGain);
 
-	GainDSPProcessor.SetGain(Settings.Gain);
+	BaseGain = Settings.Gain;
+	GainModulation.UpdateModulators(Settings.GainModulators);
+
+	const float TargetGain = GainModulation.IsModulated() ? BaseGain * GainModulation.ProcessScale() : BaseGain;
+
+	if (Settings.FadeTimeMs > 0.0f)
+	{
+		const int32 FadeTimeInFrames = FMath::RoundToInt(Settings.FadeTimeMs * 0.001f * SampleRate);
+		GainDSPProcessor.StartRamp(TargetGain, FadeTimeInFrames, SourceEffectGainRampShapeToGainRampShape(Settings.FadeShape));
+	}
+	else
+	{
+		GainDSPProcessor.SetGain(TargetGain);
+	}
 }
 
 void FSourceEffectGain::ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData)
@@ -28,6 +62,12 @@ void FSourceEffectGain::ProcessAudio(const FSoundEffectSourceInputData& InData,
 
 	const int32 NumSamples = InData.NumSamples;
 
+	// SetGain would cut a running fade short
+	if (GainModulation.IsModulated() && !GainDSPProcessor.IsRamping())
+	{
+		GainDSPProcessor.SetGain(BaseGain * GainModulation.ProcessScale());
+	}
+
 	GainDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
 }
 
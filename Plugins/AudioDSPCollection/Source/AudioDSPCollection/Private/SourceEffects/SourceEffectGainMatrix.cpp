@@ -0,0 +1,84 @@
+#include "SourceEffects/SourceEffectGainMatrix.h"
+
+
+DSPProcessing::EGainMatrixLayout SourceEffectGainMatrixLayoutToGainMatrixLayout(ESourceEffectGainMatrixLayout SourceEffectGainMatrixLayout)
+{
+	switch (SourceEffectGainMatrixLayout)
+	{
+		default:
+		case ESourceEffectGainMatrixLayout::Identity:
+			return DSPProcessing::EGainMatrixLayout::Identity;
+		case ESourceEffectGainMatrixLayout::Custom:
+			return DSPProcessing::EGainMatrixLayout::Custom;
+		case ESourceEffectGainMatrixLayout::DownmixToMono:
+			return DSPProcessing::EGainMatrixLayout::DownmixToMono;
+		case ESourceEffectGainMatrixLayout::DownmixToStereo:
+			return DSPProcessing::EGainMatrixLayout::DownmixToStereo;
+		case ESourceEffectGainMatrixLayout::MonoToStereo:
+			return DSPProcessing::EGainMatrixLayout::MonoToStereo;
+		case ESourceEffectGainMatrixLayout::SwapStereo:
+			return DSPProcessing::EGainMatrixLayout::SwapStereo;
+	}
+}
+
+//------------------------------------------------------------------------------------
+// FSourceEffectGainMatrix
+//------------------------------------------------------------------------------------
+DEFINE_SOURCE_EFFECT_POOLED_ALLOCATION(FSourceEffectGainMatrix)
+
+void FSourceEffectGainMatrix::Init(const FSoundEffectSourceInitData& InitData)
+{
+	bIsActive   = true;
+	NumChannels = InitData.NumSourceChannels;
+
+	GainMatrixDSPProcessor.Init(InitData.SampleRate, NumChannels, NumChannels);
+}
+
+void FSourceEffectGainMatrix::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SourceEffectGainMatrix);
+
+	const DSPProcessing::EGainMatrixLayout Layout = SourceEffectGainMatrixLayoutToGainMatrixLayout(Settings.Layout);
+
+	if (Layout == DSPProcessing::EGainMatrixLayout::Custom)
+	{
+		GainMatrixDSPProcessor.ClearGains();
+
+		for (const FSourceEffectGainMatrixEntry& Entry : Settings.CustomEntries)
+		{
+			GainMatrixDSPProcessor.SetGain(Entry.OutputChannel, Entry.InputChannel, Entry.Gain);
+		}
+	}
+	else
+	{
+		GainMatrixDSPProcessor.SetLayout(Layout);
+	}
+}
+
+void FSourceEffectGainMatrix::ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData)
+{
+	//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSourceEffectGainMatrix::ProcessAudio"))
+
+	const float* InAudioBuffer = InData.InputSourceEffectBufferPtr;
+	float* OutAudioBuffer      = OutAudioBufferData;
+
+	// Sources keep their channel count, the matrix is NumChannels x NumChannels
+	if (NumChannels > DSPProcessing::FGainMatrix::MaxNumChannels)
+	{
+		FMemory::Memcpy(OutAudioBuffer, InAudioBuffer, sizeof(float) * InData.NumSamples);
+		return;
+	}
+
+	const int32 NumFrames = InData.NumSamples / NumChannels;
+
+	GainMatrixDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumFrames);
+}
+
+
+//------------------------------------------------------------------------------------
+// USourceEffectGainMatrixPreset
+//------------------------------------------------------------------------------------
+void USourceEffectGainMatrixPreset::SetSettings(const FSourceEffectGainMatrixSettings& InSettings)
+{
+	UpdateSettings(InSettings);
+}
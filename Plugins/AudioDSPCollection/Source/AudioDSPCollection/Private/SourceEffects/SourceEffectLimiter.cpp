@@ -0,0 +1,47 @@
+#include "SourceEffects/SourceEffectLimiter.h"
+#include "Assets/DSPCollectionImpulseResponse.h"
+
+
+//------------------------------------------------------------------------------------
+// FSourceEffectLimiter
+//------------------------------------------------------------------------------------
+DEFINE_SOURCE_EFFECT_POOLED_ALLOCATION(FSourceEffectLimiter)
+
+void FSourceEffectLimiter::Init(const FSoundEffectSourceInitData& InitData)
+{
+	bIsActive   = true;
+	NumChannels = InitData.NumSourceChannels;
+
+	LimiterDSPProcessor.Init(InitData.SampleRate, NumChannels, NumChannels, UDSPCollectionImpulseResponse::GetDeviceBlockFrames(InitData.AudioDeviceId));
+}
+
+void FSourceEffectLimiter::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SourceEffectLimiter);
+
+	LimiterDSPProcessor.SetCeilingDb(Settings.CeilingDb);
+	LimiterDSPProcessor.SetReleaseTimeMs(Settings.ReleaseTimeMs);
+	LimiterDSPProcessor.SetLookAheadMs(Settings.LookAheadMs);
+	LimiterDSPProcessor.SetTruePeakEnabled(Settings.bTruePeak);
+}
+
+void FSourceEffectLimiter::ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData)
+{
+	//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSourceEffectLimiter::ProcessAudio"))
+
+	const float* InAudioBuffer = InData.InputSourceEffectBufferPtr;
+	float* OutAudioBuffer      = OutAudioBufferData;
+
+	const int32 NumSamples = InData.NumSamples;
+
+	LimiterDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
+}
+
+
+//------------------------------------------------------------------------------------
+// USourceEffectLimiterPreset
+//------------------------------------------------------------------------------------
+void USourceEffectLimiterPreset::SetSettings(const FSourceEffectLimiterSettings& InSettings)
+{
+	UpdateSettings(InSettings);
+}
@@ -0,0 +1,68 @@
+#include "SourceEffects/SourceEffectMultibandSaturation.h"
+#include "AudioDSPCollection.h"
+
+
+//------------------------------------------------------------------------------------
+// FSourceEffectMultibandSaturation
+//------------------------------------------------------------------------------------
+DEFINE_SOURCE_EFFECT_POOLED_ALLOCATION(FSourceEffectMultibandSaturation)
+
+void FSourceEffectMultibandSaturation::Init(const FSoundEffectSourceInitData& InitData)
+{
+	bIsActive   = true;
+	NumChannels = InitData.NumSourceChannels;
+
+	MultibandSaturationDSPProcessor.Init(InitData.SampleRate, NumChannels);
+}
+
+void FSourceEffectMultibandSaturation::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SourceEffectMultibandSaturation);
+
+	const FSourceEffectMultibandSaturationBandSettings* BandSettings[] = { &Settings.Band1, &Settings.Band2, &Settings.Band3, &Settings.Band4 };
+
+	MultibandSaturationDSPProcessor.SetNumBands(Settings.NumBands);
+	MultibandSaturationDSPProcessor.SetCrossoverFrequency(0, Settings.CrossoverFrequency1);
+	MultibandSaturationDSPProcessor.SetCrossoverFrequency(1, Settings.CrossoverFrequency2);
+	MultibandSaturationDSPProcessor.SetCrossoverFrequency(2, Settings.CrossoverFrequency3);
+
+	for (int32 BandIndex = 0; BandIndex < DSPProcessing::FMultibandSaturation::MaxNumBands; ++BandIndex)
+	{
+		MultibandSaturationDSPProcessor.SetBandSaturationType(BandIndex, SourceEffectSaturationTypeToSaturationType(BandSettings[BandIndex]->SaturationType));
+		MultibandSaturationDSPProcessor.SetBandGain(BandIndex, BandSettings[BandIndex]->Gain);
+		MultibandSaturationDSPProcessor.SetBandMix(BandIndex, BandSettings[BandIndex]->Mix);
+	}
+
+	MultibandSaturationDSPProcessor.SetBias(Settings.Bias);
+	MultibandSaturationDSPProcessor.SetOutLevelDb(Settings.OutLevelDb);
+}
+
+void FSourceEffectMultibandSaturation::ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData)
+{
+	const float* InAudioBuffer = InData.InputSourceEffectBufferPtr;
+	float* OutAudioBuffer      = OutAudioBufferData;
+
+	const int32 NumSamples = InData.NumSamples;
+
+	MultibandSaturationDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
+}
+
+
+//------------------------------------------------------------------------------------
+// USourceEffectMultibandSaturationPreset
+//------------------------------------------------------------------------------------
+void USourceEffectMultibandSaturationPreset::SetSettings(const FSourceEffectMultibandSaturationSettings& InSettings)
+{
+	// Validated here on the game thread, the effect maps the unsupported types to Tape silently on the render thread
+	const FSourceEffectMultibandSaturationBandSettings* BandSettings[] = { &InSettings.Band1, &InSettings.Band2, &InSettings.Band3, &InSettings.Band4 };
+
+	for (int32 BandIndex = 0; BandIndex < DSPProcessing::FMultibandSaturation::MaxNumBands; ++BandIndex)
+	{
+		if (!DSPProcessing::FMultibandSaturation::IsBandSaturationTypeSupported(SourceEffectSaturationTypeToSaturationType(BandSettings[BandIndex]->SaturationType)))
+		{
+			UE_LOG(LogAudioDSPCollection, Warning, TEXT("%s: TapeHysteresis, Harmonic and Custom are not available per band, band %d runs as Tape"), *GetName(), BandIndex + 1);
+		}
+	}
+
+	UpdateSettings(InSettings);
+}
@@ -1,51 +1,134 @@
 #include "SourceEffects/SourceEffectSaturation.h"
+#include "Assets/DSPCollectionImpulseResponse.h"
+#include "Assets/DSPCollectionTransferCurve.h"
 
 
-namespace
+DSPProcessing::ESaturationType SourceEffectSaturationTypeToSaturationType(ESourceEffectSaturationType SourceEffectSaturationType)
 {
-	DSPProcessing::ESaturationType SourceEffectSaturationTypeToSaturationType(ESourceEffectSaturationType SourceEffectSaturationType)
+	switch (SourceEffectSaturationType)
 	{
-		switch (SourceEffectSaturationType)
-		{
-			default:
-			case ESourceEffectSaturationType::Tape:
-				return DSPProcessing::ESaturationType::Tape;
-			case ESourceEffectSaturationType::Tape2:
-				return DSPProcessing::ESaturationType::Tape2;
-			case ESourceEffectSaturationType::Overdrive:
-				return DSPProcessing::ESaturationType::Overdrive;
-			case ESourceEffectSaturationType::Tube:
-				return DSPProcessing::ESaturationType::Tube;
-			case ESourceEffectSaturationType::Tube2:
-				return DSPProcessing::ESaturationType::Tube2;
-			case ESourceEffectSaturationType::Distortion:
-				return DSPProcessing::ESaturationType::Distortion;
-			case ESourceEffectSaturationType::Metal:
-				return DSPProcessing::ESaturationType::Metal;
-			case ESourceEffectSaturationType::Fuzz:
-				return DSPProcessing::ESaturationType::Fuzz;
-			case ESourceEffectSaturationType::HardClip:
-				return DSPProcessing::ESaturationType::HardClip;
-			case ESourceEffectSaturationType::Foldback:
-				return DSPProcessing::ESaturationType::Foldback;
-			case ESourceEffectSaturationType::HalfWaveRectifier:
-				return DSPProcessing::ESaturationType::HalfWaveRectifier;
-			case ESourceEffectSaturationType::FullWaveRectifier:
-				return DSPProcessing::ESaturationType::FullWaveRectifier;
-		}
+		default:
+		case ESourceEffectSaturationType::Tape:
+			return DSPProcessing::ESaturationType::Tape;
+		case ESourceEffectSaturationType::Tape2:
+			return DSPProcessing::ESaturationType::Tape2;
+		case ESourceEffectSaturationType::Overdrive:
+			return DSPProcessing::ESaturationType::Overdrive;
+		case ESourceEffectSaturationType::Tube:
+			return DSPProcessing::ESaturationType::Tube;
+		case ESourceEffectSaturationType::Tube2:
+			return DSPProcessing::ESaturationType::Tube2;
+		case ESourceEffectSaturationType::Distortion:
+			return DSPProcessing::ESaturationType::Distortion;
+		case ESourceEffectSaturationType::Metal:
+			return DSPProcessing::ESaturationType::Metal;
+		case ESourceEffectSaturationType::Fuzz:
+			return DSPProcessing::ESaturationType::Fuzz;
+		case ESourceEffectSaturationType::HardClip:
+			return DSPProcessing::ESaturationType::HardClip;
+		case ESourceEffectSaturationType::Foldback:
+			return DSPProcessing::ESaturationType::Foldback;
+		case ESourceEffectSaturationType::HalfWaveRectifier:
+			return DSPProcessing::ESaturationType::HalfWaveRectifier;
+		case ESourceEffectSaturationType::FullWaveRectifier:
+			return DSPProcessing::ESaturationType::FullWaveRectifier;
+		case ESourceEffectSaturationType::TapeHysteresis:
+			return DSPProcessing::ESaturationType::TapeHysteresis;
+		case ESourceEffectSaturationType::Harmonic:
+			return DSPProcessing::ESaturationType::Harmonic;
+		case ESourceEffectSaturationType::Custom:
+			return DSPProcessing::ESaturationType::Custom;
 	}
 }
 
+DSPProcessing::ETapeHysteresisSolver SourceEffectTapeHysteresisSolverToTapeHysteresisSolver(ESourceEffectTapeHysteresisSolver SourceEffectTapeHysteresisSolver)
+{
+	switch (SourceEffectTapeHysteresisSolver)
+	{
+		case ESourceEffectTapeHysteresisSolver::RK2:
+			return DSPProcessing::ETapeHysteresisSolver::RK2;
+		default:
+		case ESourceEffectTapeHysteresisSolver::RK4:
+			return DSPProcessing::ETapeHysteresisSolver::RK4;
+	}
+}
+
+DSPProcessing::EEnvelopeDetectorMode SourceEffectEnvelopeDetectorModeToEnvelopeDetectorMode(ESourceEffectEnvelopeDetectorMode SourceEffectEnvelopeDetectorMode)
+{
+	switch (SourceEffectEnvelopeDetectorMode)
+	{
+		default:
+		case ESourceEffectEnvelopeDetectorMode::Peak:
+			return DSPProcessing::EEnvelopeDetectorMode::Peak;
+		case ESourceEffectEnvelopeDetectorMode::RMS:
+			return DSPProcessing::EEnvelopeDetectorMode::RMS;
+	}
+}
+
+DSPProcessing::FEmphasisBand SourceEffectSaturationEmphasisBandToEmphasisBand(const FSourceEffectSaturationEmphasisBand& SourceEffectSaturationEmphasisBand)
+{
+	DSPProcessing::FEmphasisBand EmphasisBand;
+	EmphasisBand.Frequency = SourceEffectSaturationEmphasisBand.Frequency;
+	EmphasisBand.GainDb    = SourceEffectSaturationEmphasisBand.GainDb;
+	EmphasisBand.Q         = SourceEffectSaturationEmphasisBand.Q;
+
+	switch (SourceEffectSaturationEmphasisBand.Type)
+	{
+		default:
+		case ESourceEffectEmphasisFilterType::Off:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::Off;
+			break;
+		case ESourceEffectEmphasisFilterType::LowCut:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::LowCut;
+			break;
+		case ESourceEffectEmphasisFilterType::HighCut:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::HighCut;
+			break;
+		case ESourceEffectEmphasisFilterType::LowShelf:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::LowShelf;
+			break;
+		case ESourceEffectEmphasisFilterType::HighShelf:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::HighShelf;
+			break;
+		case ESourceEffectEmphasisFilterType::Peak:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::Peak;
+			break;
+	}
+
+	return EmphasisBand;
+}
+
+void SourceEffectSaturationHarmonicsToHarmonicWeights(const FSourceEffectSaturationHarmonics& SourceEffectSaturationHarmonics, DSPProcessing::FSaturation& OutSaturation)
+{
+	const float Weights[] = { SourceEffectSaturationHarmonics.Fundamental, SourceEffectSaturationHarmonics.Second, SourceEffectSaturationHarmonics.Third, SourceEffectSaturationHarmonics.Fourth,
+							  SourceEffectSaturationHarmonics.Fifth, SourceEffectSaturationHarmonics.Sixth, SourceEffectSaturationHarmonics.Seventh, SourceEffectSaturationHarmonics.Eighth };
+	static_assert(UE_ARRAY_COUNT(Weights) == DSPProcessing::FHarmonicShaper::MaxHarmonic);
+
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Weights); ++Index)
+	{
+		OutSaturation.SetHarmonicWeight(Index + 1, Weights[Index]);
+	}
+}
 
 //------------------------------------------------------------------------------------
 // FSourceEffectSaturation
 //------------------------------------------------------------------------------------
+DEFINE_SOURCE_EFFECT_POOLED_ALLOCATION(FSourceEffectSaturation)
+
 void FSourceEffectSaturation::Init(const FSoundEffectSourceInitData& InitData)
 {
 	bIsActive   = true;
 	NumChannels = InitData.NumSourceChannels;
+	BlockFrames = UDSPCollectionImpulseResponse::GetDeviceBlockFrames(InitData.AudioDeviceId);
+
+	SaturationDSPProcessor.Init(InitData.SampleRate, NumChannels, NumChannels, BlockFrames);
+	CabinetDSPProcessor.Init(InitData.SampleRate, NumChannels);
+	LimiterDSPProcessor.Init(InitData.SampleRate, NumChannels, NumChannels, BlockFrames);
 
-	SaturationDSPProcessor.Init(InitData.SampleRate);
+	GainModulation.Init(InitData.AudioDeviceId, false);
+	BiasModulation.Init(InitData.AudioDeviceId, false);
+	MixModulation.Init(InitData.AudioDeviceId, false);
+	OutLevelModulation.Init(InitData.AudioDeviceId, true);
 }
 
 void FSourceEffectSaturation::OnPresetChanged()
@@ -53,10 +136,65 @@ void FSourceEffectSaturation::OnPresetChanged()
 	GET_EFFECT_SETTINGS(SourceEffectSaturation);
 
 	SaturationDSPProcessor.SetSaturationType(SourceEffectSaturationTypeToSaturationType(Settings.SaturationType));
-	SaturationDSPProcessor.SetGain(Settings.Gain);
-	SaturationDSPProcessor.SetBias(Settings.Bias);
-	SaturationDSPProcessor.SetMix(Settings.Mix);
-	SaturationDSPProcessor.SetOutLevelDb(Settings.OutLevelDb);
+
+	BaseGain       = Settings.Gain;
+	BaseBias       = Settings.Bias;
+	BaseMix        = Settings.Mix;
+	BaseOutLevelDb = Settings.OutLevelDb;
+
+	GainModulation.UpdateModulators(Settings.GainModulators);
+	BiasModulation.UpdateModulators(Settings.BiasModulators);
+	MixModulation.UpdateModulators(Settings.MixModulators);
+	OutLevelModulation.UpdateModulators(Settings.OutLevelModulators);
+
+	bModulated = GainModulation.IsModulated() || BiasModulation.IsModulated() || MixModulation.IsModulated() || OutLevelModulation.IsModulated();
+	ApplyModulation();
+
+	SaturationDSPProcessor.SetTapeHysteresisSolver(SourceEffectTapeHysteresisSolverToTapeHysteresisSolver(Settings.TapeHysteresisSolver));
+	SaturationDSPProcessor.SetTapeHysteresisOversampling(Settings.TapeHysteresisOversampling);
+	SourceEffectSaturationHarmonicsToHarmonicWeights(Settings.Harmonics, SaturationDSPProcessor);
+	SaturationDSPProcessor.SetCustomCurve(Settings.CustomCurve ? Settings.CustomCurve->GetSharedTransferCurve() : nullptr);
+	SaturationDSPProcessor.SetDCBlockerEnabled(Settings.bDCBlockerEnabled);
+	SaturationDSPProcessor.SetDCBlockerCutoffFrequency(Settings.DCBlockerCutoffFrequency);
+	SaturationDSPProcessor.SetEnvelopeFollowerEnabled(Settings.bEnvelopeFollowerEnabled);
+	SaturationDSPProcessor.SetEnvelopeDetectorMode(SourceEffectEnvelopeDetectorModeToEnvelopeDetectorMode(Settings.EnvelopeDetectorMode));
+	SaturationDSPProcessor.SetEnvelopeAttackTimeMs(Settings.EnvelopeAttackTimeMs);
+	SaturationDSPProcessor.SetEnvelopeReleaseTimeMs(Settings.EnvelopeReleaseTimeMs);
+	SaturationDSPProcessor.SetEnvelopeToGain(Settings.EnvelopeToGain);
+	SaturationDSPProcessor.SetEnvelopeToBias(Settings.EnvelopeToBias);
+	SaturationDSPProcessor.SetPreEmphasisBand(0, SourceEffectSaturationEmphasisBandToEmphasisBand(Settings.PreEmphasisBand1));
+	SaturationDSPProcessor.SetPreEmphasisBand(1, SourceEffectSaturationEmphasisBandToEmphasisBand(Settings.PreEmphasisBand2));
+	SaturationDSPProcessor.SetPostEmphasisBand(0, SourceEffectSaturationEmphasisBandToEmphasisBand(Settings.PostEmphasisBand1));
+	SaturationDSPProcessor.SetPostEmphasisBand(1, SourceEffectSaturationEmphasisBandToEmphasisBand(Settings.PostEmphasisBand2));
+
+	CabinetDSPProcessor.SetImpulseResponse(Settings.CabinetImpulseResponse ? Settings.CabinetImpulseResponse->GetSharedImpulseResponse() : nullptr);
+	CabinetDSPProcessor.SetNonUniformPartitions(Settings.bCabinetNonUniformPartitions);
+
+	// Requests the state for the device block size, built on a background task (with the partitions the asset built on the game thread) and swapped in by the first blocks
+	if (BlockFrames > 0)
+	{
+		CabinetDSPProcessor.Prepare(BlockFrames);
+	}
+
+	// The delay line holds stale audio from the last time it was enabled
+	if (Settings.bLimiterEnabled && !bLimiterEnabled)
+	{
+		LimiterDSPProcessor.Reset();
+	}
+
+	bLimiterEnabled = Settings.bLimiterEnabled;
+	LimiterDSPProcessor.SetCeilingDb(Settings.LimiterCeilingDb);
+	LimiterDSPProcessor.SetReleaseTimeMs(Settings.LimiterReleaseTimeMs);
+	LimiterDSPProcessor.SetLookAheadMs(Settings.LimiterLookAheadMs);
+	LimiterDSPProcessor.SetTruePeakEnabled(Settings.bLimiterTruePeak);
+}
+
+void FSourceEffectSaturation::ApplyModulation()
+{
+	SaturationDSPProcessor.SetGain(GainModulation.IsModulated() ? BaseGain * GainModulation.ProcessScale() : BaseGain);
+	SaturationDSPProcessor.SetBias(BiasModulation.IsModulated() ? BaseBias * BiasModulation.ProcessScale() : BaseBias);
+	SaturationDSPProcessor.SetMix(MixModulation.IsModulated() ? BaseMix * MixModulation.ProcessScale() : BaseMix);
+	SaturationDSPProcessor.SetOutLevelDb(OutLevelModulation.IsModulated() ? OutLevelModulation.ProcessDb(BaseOutLevelDb) : BaseOutLevelDb);
 }
 
 void FSourceEffectSaturation::ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData)
@@ -66,7 +204,22 @@ void FSourceEffectSaturation::ProcessAudio(const FSoundEffectSourceInputData& In
 
 	const int32 NumSamples = InData.NumSamples;
 
+	if (bModulated)
+	{
+		ApplyModulation();
+	}
+
 	SaturationDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
+
+	if (CabinetDSPProcessor.IsActive())
+	{
+		CabinetDSPProcessor.ProcessAudioBuffer(OutAudioBuffer, OutAudioBuffer, NumSamples);
+	}
+
+	if (bLimiterEnabled)
+	{
+		LimiterDSPProcessor.ProcessAudioBuffer(OutAudioBuffer, OutAudioBuffer, NumSamples);
+	}
 }
 
 
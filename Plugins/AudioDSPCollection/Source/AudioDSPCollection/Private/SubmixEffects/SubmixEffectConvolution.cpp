@@ -0,0 +1,50 @@
+#include "SubmixEffects/SubmixEffectConvolution.h"
+#include "Assets/DSPCollectionImpulseResponse.h"
+
+
+//------------------------------------------------------------------------------------
+// FSubmixEffectConvolution
+//------------------------------------------------------------------------------------
+void FSubmixEffectConvolution::Init(const FSoundEffectSubmixInitData& InitData)
+{
+	BlockFrames = UDSPCollectionImpulseResponse::GetDeviceBlockFrames(InitData.DeviceID);
+
+	ConvolutionDSPProcessor.Init(InitData.SampleRate);
+}
+
+void FSubmixEffectConvolution::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SubmixEffectConvolution);
+
+	ConvolutionDSPProcessor.SetImpulseResponse(Settings.ImpulseResponse ? Settings.ImpulseResponse->GetSharedImpulseResponse() : nullptr);
+	ConvolutionDSPProcessor.SetNonUniformPartitions(Settings.bNonUniformPartitions);
+
+	// Requests the state for the device block size, built on a background task (with the partitions the asset built on the game thread) and swapped in by the first blocks
+	if (BlockFrames > 0)
+	{
+		ConvolutionDSPProcessor.Prepare(BlockFrames);
+	}
+}
+
+void FSubmixEffectConvolution::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
+{
+	//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSubmixEffectConvolution::OnProcessAudio"))
+
+	const float* InAudioBuffer = InData.AudioBuffer->GetData();
+	float* OutAudioBuffer      = OutData.AudioBuffer->GetData();
+
+	const int32 NumChannels = InData.NumChannels;
+	const int32 NumSamples  = InData.NumFrames * NumChannels;
+
+	ConvolutionDSPProcessor.SetNumChannels(NumChannels);
+	ConvolutionDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
+}
+
+
+//------------------------------------------------------------------------------------
+// USubmixEffectConvolutionPreset
+//------------------------------------------------------------------------------------
+void USubmixEffectConvolutionPreset::SetSettings(const FSubmixEffectConvolutionSettings& InSettings)
+{
+	UpdateSettings(InSettings);
+}
@@ -1,19 +1,52 @@
 #include "SubmixEffects/SubmixEffectGain.h"
 
 
+DSPProcessing::EGainRampShape SubmixEffectGainRampShapeToGainRampShape(ESubmixEffectGainRampShape SubmixEffectGainRampShape)
+{
+	switch (SubmixEffectGainRampShape)
+	{
+		default:
+		case ESubmixEffectGainRampShape::Linear:
+			return DSPProcessing::EGainRampShape::Linear;
+		case ESubmixEffectGainRampShape::Exponential:
+			return DSPProcessing::EGainRampShape::Exponential;
+		case ESubmixEffectGainRampShape::SCurve:
+			return DSPProcessing::EGainRampShape::SCurve;
+		case ESubmixEffectGainRampShape::EqualPower:
+			return DSPProcessing::EGainRampShape::EqualPower;
+	}
+}
+
 //------------------------------------------------------------------------------------
 // FSubmixEffectGain
 //------------------------------------------------------------------------------------
 void FSubmixEffectGain::Init(const FSoundEffectSubmixInitData& InitData)
 {
-	GainDSPProcessor.Init(InitData.SampleRate);
+	SampleRate = InitData.SampleRate;
+
+	GainModulation.Init(InitData.DeviceID, true);
+
+	GainDSPProcessor.Init(SampleRate);
 }
 
 void FSubmixEffectGain::OnPresetChanged()
 {
 	GET_EFFECT_SETTINGS(SubmixEffectGain);
 
-	GainDSPProcessor.SetGain(Settings.Gain);
+	BaseGain = Settings.Gain;
+	GainModulation.UpdateModulators(Settings.GainModulators);
+
+	const float TargetGain = GainModulation.IsModulated() ? BaseGain * GainModulation.ProcessScale() : BaseGain;
+
+	if (Settings.FadeTimeMs > 0.0f)
+	{
+		const int32 FadeTimeInFrames = FMath::RoundToInt(Settings.FadeTimeMs * 0.001f * SampleRate);
+		GainDSPProcessor.StartRamp(TargetGain, FadeTimeInFrames, SubmixEffectGainRampShapeToGainRampShape(Settings.FadeShape));
+	}
+	else
+	{
+		GainDSPProcessor.SetGain(TargetGain);
+	}
 }
 
 void FSubmixEffectGain::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
@@ -26,6 +59,12 @@ void FSubmixEffectGain::OnProcessAudio(const FSoundEffectSubmixInputData& InData
 	const int32 NumChannels = InData.NumChannels;
 	const int32 NumSamples	= InData.NumFrames * NumChannels;
 
+	if (GainModulation.IsModulated() && !GainDSPProcessor.IsRamping())
+	{
+		GainDSPProcessor.SetGain(BaseGain * GainModulation.ProcessScale());
+	}
+
+	GainDSPProcessor.SetNumChannels(NumChannels);
 	GainDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
 }
 
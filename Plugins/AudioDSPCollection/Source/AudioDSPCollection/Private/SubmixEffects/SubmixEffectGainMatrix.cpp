@@ -0,0 +1,81 @@
+#include "SubmixEffects/SubmixEffectGainMatrix.h"
+
+
+DSPProcessing::EGainMatrixLayout SubmixEffectGainMatrixLayoutToGainMatrixLayout(ESubmixEffectGainMatrixLayout SubmixEffectGainMatrixLayout)
+{
+	switch (SubmixEffectGainMatrixLayout)
+	{
+		default:
+		case ESubmixEffectGainMatrixLayout::Identity:
+			return DSPProcessing::EGainMatrixLayout::Identity;
+		case ESubmixEffectGainMatrixLayout::Custom:
+			return DSPProcessing::EGainMatrixLayout::Custom;
+		case ESubmixEffectGainMatrixLayout::DownmixToMono:
+			return DSPProcessing::EGainMatrixLayout::DownmixToMono;
+		case ESubmixEffectGainMatrixLayout::DownmixToStereo:
+			return DSPProcessing::EGainMatrixLayout::DownmixToStereo;
+		case ESubmixEffectGainMatrixLayout::MonoToStereo:
+			return DSPProcessing::EGainMatrixLayout::MonoToStereo;
+		case ESubmixEffectGainMatrixLayout::SwapStereo:
+			return DSPProcessing::EGainMatrixLayout::SwapStereo;
+	}
+}
+
+//------------------------------------------------------------------------------------
+// FSubmixEffectGainMatrix
+//------------------------------------------------------------------------------------
+void FSubmixEffectGainMatrix::Init(const FSoundEffectSubmixInitData& InitData)
+{
+	GainMatrixDSPProcessor.Init(InitData.SampleRate);
+}
+
+void FSubmixEffectGainMatrix::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SubmixEffectGainMatrix);
+
+	const DSPProcessing::EGainMatrixLayout Layout = SubmixEffectGainMatrixLayoutToGainMatrixLayout(Settings.Layout);
+
+	if (Layout == DSPProcessing::EGainMatrixLayout::Custom)
+	{
+		GainMatrixDSPProcessor.ClearGains();
+
+		for (const FSubmixEffectGainMatrixEntry& Entry : Settings.CustomEntries)
+		{
+			GainMatrixDSPProcessor.SetGain(Entry.OutputChannel, Entry.InputChannel, Entry.Gain);
+		}
+	}
+	else
+	{
+		GainMatrixDSPProcessor.SetLayout(Layout);
+	}
+}
+
+void FSubmixEffectGainMatrix::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
+{
+	//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSubmixEffectGainMatrix::OnProcessAudio"))
+
+	const float* InAudioBuffer = InData.AudioBuffer->GetData();
+	float* OutAudioBuffer      = OutData.AudioBuffer->GetData();
+
+	const int32 NumInputChannels  = InData.NumChannels;
+	const int32 NumOutputChannels = OutData.NumChannels;
+	const int32 NumFrames         = InData.NumFrames;
+
+	if (NumInputChannels > DSPProcessing::FGainMatrix::MaxNumChannels || NumOutputChannels > DSPProcessing::FGainMatrix::MaxNumChannels)
+	{
+		FMemory::Memcpy(OutAudioBuffer, InAudioBuffer, sizeof(float) * NumFrames * FMath::Min(NumInputChannels, NumOutputChannels));
+		return;
+	}
+
+	GainMatrixDSPProcessor.SetNumChannels(NumInputChannels, NumOutputChannels);
+	GainMatrixDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumFrames);
+}
+
+
+//------------------------------------------------------------------------------------
+// USubmixEffectGainMatrixPreset
+//------------------------------------------------------------------------------------
+void USubmixEffectGainMatrixPreset::SetSettings(const FSubmixEffectGainMatrixSettings& InSettings)
+{
+	UpdateSettings(InSettings);
+}
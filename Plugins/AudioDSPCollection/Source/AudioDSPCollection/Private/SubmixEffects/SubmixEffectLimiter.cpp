@@ -0,0 +1,55 @@
+#include "SubmixEffects/SubmixEffectLimiter.h"
+#include "Assets/DSPCollectionImpulseResponse.h"
+
+
+//------------------------------------------------------------------------------------
+// FSubmixEffectLimiter
+//------------------------------------------------------------------------------------
+void FSubmixEffectLimiter::Init(const FSoundEffectSubmixInitData& InitData)
+{
+	// Everything is allocated here for the device block, the render thread never allocates
+	LimiterDSPProcessor.Init(InitData.SampleRate, 1, MaxNumChannels, UDSPCollectionImpulseResponse::GetDeviceBlockFrames(InitData.DeviceID));
+}
+
+void FSubmixEffectLimiter::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SubmixEffectLimiter);
+
+	LimiterDSPProcessor.SetCeilingDb(Settings.CeilingDb);
+	LimiterDSPProcessor.SetReleaseTimeMs(Settings.ReleaseTimeMs);
+	LimiterDSPProcessor.SetLookAheadMs(Settings.LookAheadMs);
+	LimiterDSPProcessor.SetTruePeakEnabled(Settings.bTruePeak);
+}
+
+void FSubmixEffectLimiter::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
+{
+	//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FSubmixEffectLimiter::OnProcessAudio"))
+
+	const float* InAudioBuffer = InData.AudioBuffer->GetData();
+	float* OutAudioBuffer      = OutData.AudioBuffer->GetData();
+
+	const int32 NumChannels = InData.NumChannels;
+	const int32 NumSamples  = InData.NumFrames * NumChannels;
+
+	LimiterDSPProcessor.SetNumChannels(NumChannels);
+	LimiterDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
+}
+
+int32 FSubmixEffectLimiter::GetLatencyInFrames() const
+{
+	return LimiterDSPProcessor.GetLatencyInFrames();
+}
+
+
+//------------------------------------------------------------------------------------
+// USubmixEffectLimiterPreset
+//------------------------------------------------------------------------------------
+void USubmixEffectLimiterPreset::SetSettings(const FSubmixEffectLimiterSettings& InSettings)
+{
+	UpdateSettings(InSettings);
+}
+
+int32 USubmixEffectLimiterPreset::GetLatencyInFrames(const float SampleRate) const
+{
+	return DSPProcessing::FLimiter::LookAheadMsToFrames(Settings.LookAheadMs, SampleRate);
+}
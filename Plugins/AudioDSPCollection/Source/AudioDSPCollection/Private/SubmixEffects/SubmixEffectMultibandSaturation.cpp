@@ -0,0 +1,65 @@
+#include "SubmixEffects/SubmixEffectMultibandSaturation.h"
+#include "AudioDSPCollection.h"
+
+
+//------------------------------------------------------------------------------------
+// FSubmixEffectMultibandSaturation
+//------------------------------------------------------------------------------------
+void FSubmixEffectMultibandSaturation::Init(const FSoundEffectSubmixInitData& InitData)
+{
+	MultibandSaturationDSPProcessor.Init(InitData.SampleRate);
+}
+
+void FSubmixEffectMultibandSaturation::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(SubmixEffectMultibandSaturation);
+
+	const FSubmixEffectMultibandSaturationBandSettings* BandSettings[] = { &Settings.Band1, &Settings.Band2, &Settings.Band3, &Settings.Band4 };
+
+	MultibandSaturationDSPProcessor.SetNumBands(Settings.NumBands);
+	MultibandSaturationDSPProcessor.SetCrossoverFrequency(0, Settings.CrossoverFrequency1);
+	MultibandSaturationDSPProcessor.SetCrossoverFrequency(1, Settings.CrossoverFrequency2);
+	MultibandSaturationDSPProcessor.SetCrossoverFrequency(2, Settings.CrossoverFrequency3);
+
+	for (int32 BandIndex = 0; BandIndex < DSPProcessing::FMultibandSaturation::MaxNumBands; ++BandIndex)
+	{
+		MultibandSaturationDSPProcessor.SetBandSaturationType(BandIndex, SubmixEffectSaturationTypeToSaturationType(BandSettings[BandIndex]->SaturationType));
+		MultibandSaturationDSPProcessor.SetBandGain(BandIndex, BandSettings[BandIndex]->Gain);
+		MultibandSaturationDSPProcessor.SetBandMix(BandIndex, BandSettings[BandIndex]->Mix);
+	}
+
+	MultibandSaturationDSPProcessor.SetBias(Settings.Bias);
+	MultibandSaturationDSPProcessor.SetOutLevelDb(Settings.OutLevelDb);
+}
+
+void FSubmixEffectMultibandSaturation::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
+{
+	const float* InAudioBuffer = InData.AudioBuffer->GetData();
+	float* OutAudioBuffer      = OutData.AudioBuffer->GetData();
+
+	const int32 NumChannels = InData.NumChannels;
+	const int32 NumSamples  = InData.NumFrames * NumChannels;
+
+	MultibandSaturationDSPProcessor.SetNumChannels(NumChannels);
+	MultibandSaturationDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
+}
+
+
+//------------------------------------------------------------------------------------
+// USubmixEffectMultibandSaturationPreset
+//------------------------------------------------------------------------------------
+void USubmixEffectMultibandSaturationPreset::SetSettings(const FSubmixEffectMultibandSaturationSettings& InSettings)
+{
+	// Validated here on the game thread, the effect maps the unsupported types to Tape silently on the render thread
+	const FSubmixEffectMultibandSaturationBandSettings* BandSettings[] = { &InSettings.Band1, &InSettings.Band2, &InSettings.Band3, &InSettings.Band4 };
+
+	for (int32 BandIndex = 0; BandIndex < DSPProcessing::FMultibandSaturation::MaxNumBands; ++BandIndex)
+	{
+		if (!DSPProcessing::FMultibandSaturation::IsBandSaturationTypeSupported(SubmixEffectSaturationTypeToSaturationType(BandSettings[BandIndex]->SaturationType)))
+		{
+			UE_LOG(LogAudioDSPCollection, Warning, TEXT("%s: TapeHysteresis, Harmonic and Custom are not available per band, band %d runs as Tape"), *GetName(), BandIndex + 1);
+		}
+	}
+
+	UpdateSettings(InSettings);
+}
@@ -0,0 +1,149 @@
+#include "SubmixEffects/SubmixEffectPipeline.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+FSubmixEffectPipeline::~FSubmixEffectPipeline()
+{
+	Shutdown();
+}
+
+void FSubmixEffectPipeline::Init(FProcessFunction&& InProcessFunction, const int32 InMaxNumSamples)
+{
+	Shutdown();
+
+	ProcessFunction    = MoveTemp(InProcessFunction);
+	MaxNumSamples      = FMath::Max(InMaxNumSamples, 0);
+	InFlightIndex      = 0;
+	NumSamplesInFlight = 0;
+	bHasResult         = false;
+	NumOverruns        = 0;
+
+	for (Audio::FAlignedFloatBuffer& Buffer : Buffers)
+	{
+		Buffer.Reset();
+		Buffer.SetNumZeroed(MaxNumSamples);
+	}
+
+	// Auto-reset: one trigger per submitted block
+	bStopping.store(false, std::memory_order_relaxed);
+	WorkEvent    = FPlatformProcess::GetSynchEventFromPool(false);
+	WorkerThread = FRunnableThread::Create(this, TEXT("DSPCollectionSubmixPipeline"), 0, TPri_AboveNormal);
+}
+
+bool FSubmixEffectPipeline::ReceiveBlock(float* OutBuffer, const int32 InNumSamples)
+{
+	// Acquire: the worker writes to the buffer happen before it clears the flag
+	if (bBlockInFlight.load(std::memory_order_acquire))
+	{
+		++NumOverruns;
+
+		FMemory::Memzero(OutBuffer, sizeof(float) * InNumSamples);
+		return false;
+	}
+
+	// The block size may change between blocks (e.g. channel count), copy what matches and pad with silence
+	const int32 NumSamplesToCopy = bHasResult ? FMath::Min(NumSamplesInFlight, InNumSamples) : 0;
+
+	if (NumSamplesToCopy > 0)
+	{
+		FMemory::Memcpy(OutBuffer, Buffers[InFlightIndex].GetData(), sizeof(float) * NumSamplesToCopy);
+	}
+
+	if (NumSamplesToCopy < InNumSamples)
+	{
+		FMemory::Memzero(OutBuffer + NumSamplesToCopy, sizeof(float) * (InNumSamples - NumSamplesToCopy));
+	}
+
+	bHasResult = false;
+	return true;
+}
+
+void FSubmixEffectPipeline::SubmitBlock(const float* InBuffer, const int32 InNumSamples)
+{
+	check(IsIdle());
+
+	if (InNumSamples > MaxNumSamples || WorkerThread == nullptr)
+	{
+		++NumOverruns;
+		return;
+	}
+
+	// The other buffer, the last result stays intact in the previous one
+	InFlightIndex = 1 - InFlightIndex;
+	FMemory::Memcpy(Buffers[InFlightIndex].GetData(), InBuffer, sizeof(float) * InNumSamples);
+
+	NumSamplesInFlight = InNumSamples;
+	bHasResult         = true;
+
+	// Release: publishes the buffer and the block size to the worker
+	bBlockInFlight.store(true, std::memory_order_release);
+	WorkEvent->Trigger();
+}
+
+bool FSubmixEffectPipeline::IsIdle() const
+{
+	return !bBlockInFlight.load(std::memory_order_acquire);
+}
+
+void FSubmixEffectPipeline::DiscardResult()
+{
+	bHasResult = false;
+}
+
+int32 FSubmixEffectPipeline::GetNumOverruns() const
+{
+	return NumOverruns;
+}
+
+uint32 FSubmixEffectPipeline::Run()
+{
+	while (true)
+	{
+		WorkEvent->Wait();
+
+		if (bStopping.load(std::memory_order_acquire))
+		{
+			break;
+		}
+
+		if (bBlockInFlight.load(std::memory_order_acquire))
+		{
+			ProcessFunction(Buffers[InFlightIndex].GetData(), NumSamplesInFlight);
+
+			// Release: publishes the processed buffer to the render thread
+			bBlockInFlight.store(false, std::memory_order_release);
+		}
+	}
+
+	return 0;
+}
+
+void FSubmixEffectPipeline::Stop()
+{
+	bStopping.store(true, std::memory_order_release);
+
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+void FSubmixEffectPipeline::Shutdown()
+{
+	if (WorkerThread)
+	{
+		// Kill calls Stop and waits for the block in flight to finish
+		WorkerThread->Kill(true);
+		delete WorkerThread;
+		WorkerThread = nullptr;
+	}
+
+	if (WorkEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		WorkEvent = nullptr;
+	}
+
+	bBlockInFlight.store(false, std::memory_order_relaxed);
+}
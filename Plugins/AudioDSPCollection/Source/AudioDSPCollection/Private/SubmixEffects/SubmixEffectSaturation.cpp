@@ -1,59 +1,237 @@
 #include "SubmixEffects/SubmixEffectSaturation.h"
+#include "Assets/DSPCollectionImpulseResponse.h"
+#include "Assets/DSPCollectionTransferCurve.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
 
+static int32 ParallelMinChannelsCVar = 16;
+FAutoConsoleVariableRef CVarDSPCollectionSaturationParallelMinChannels(
+	TEXT("au.DSPCollection.Saturation.ParallelMinChannels"),
+	ParallelMinChannelsCVar,
+	TEXT("Channel count from which the Saturation submix effect processes the channels on the task graph workers when bParallelChannels is enabled (see au.DSPCollection.Benchmark.ParallelChannels)."),
+	ECVF_Default);
 
-namespace
+static int32 ParallelMinFramesCVar = 256;
+FAutoConsoleVariableRef CVarDSPCollectionSaturationParallelMinFrames(
+	TEXT("au.DSPCollection.Saturation.ParallelMinFrames"),
+	ParallelMinFramesCVar,
+	TEXT("Block size (frames) from which the Saturation submix effect processes the channels on the task graph workers when bParallelChannels is enabled (see au.DSPCollection.Benchmark.ParallelChannels)."),
+	ECVF_Default);
+
+
+DSPProcessing::ESaturationType SubmixEffectSaturationTypeToSaturationType(ESubmixEffectSaturationType SubmixEffectSaturationType)
 {
-	DSPProcessing::ESaturationType SubmixEffectSaturationTypeToSaturationType(ESubmixEffectSaturationType SubmixEffectSaturationType)
+	switch (SubmixEffectSaturationType)
 	{
-		switch (SubmixEffectSaturationType)
-		{
-			default:
-			case ESubmixEffectSaturationType::Tape:
-				return DSPProcessing::ESaturationType::Tape;
-			case ESubmixEffectSaturationType::Tape2:
-				return DSPProcessing::ESaturationType::Tape2;
-			case ESubmixEffectSaturationType::Overdrive:
-				return DSPProcessing::ESaturationType::Overdrive;
-			case ESubmixEffectSaturationType::Tube:
-				return DSPProcessing::ESaturationType::Tube;
-			case ESubmixEffectSaturationType::Tube2:
-				return DSPProcessing::ESaturationType::Tube2;
-			case ESubmixEffectSaturationType::Distortion:
-				return DSPProcessing::ESaturationType::Distortion;
-			case ESubmixEffectSaturationType::Metal:
-				return DSPProcessing::ESaturationType::Metal;
-			case ESubmixEffectSaturationType::Fuzz:
-				return DSPProcessing::ESaturationType::Fuzz;
-			case ESubmixEffectSaturationType::HardClip:
-				return DSPProcessing::ESaturationType::HardClip;
-			case ESubmixEffectSaturationType::Foldback:
-				return DSPProcessing::ESaturationType::Foldback;
-			case ESubmixEffectSaturationType::HalfWaveRectifier:
-				return DSPProcessing::ESaturationType::HalfWaveRectifier;
-			case ESubmixEffectSaturationType::FullWaveRectifier:
-				return DSPProcessing::ESaturationType::FullWaveRectifier;
-		}
+		default:
+		case ESubmixEffectSaturationType::Tape:
+			return DSPProcessing::ESaturationType::Tape;
+		case ESubmixEffectSaturationType::Tape2:
+			return DSPProcessing::ESaturationType::Tape2;
+		case ESubmixEffectSaturationType::Overdrive:
+			return DSPProcessing::ESaturationType::Overdrive;
+		case ESubmixEffectSaturationType::Tube:
+			return DSPProcessing::ESaturationType::Tube;
+		case ESubmixEffectSaturationType::Tube2:
+			return DSPProcessing::ESaturationType::Tube2;
+		case ESubmixEffectSaturationType::Distortion:
+			return DSPProcessing::ESaturationType::Distortion;
+		case ESubmixEffectSaturationType::Metal:
+			return DSPProcessing::ESaturationType::Metal;
+		case ESubmixEffectSaturationType::Fuzz:
+			return DSPProcessing::ESaturationType::Fuzz;
+		case ESubmixEffectSaturationType::HardClip:
+			return DSPProcessing::ESaturationType::HardClip;
+		case ESubmixEffectSaturationType::Foldback:
+			return DSPProcessing::ESaturationType::Foldback;
+		case ESubmixEffectSaturationType::HalfWaveRectifier:
+			return DSPProcessing::ESaturationType::HalfWaveRectifier;
+		case ESubmixEffectSaturationType::FullWaveRectifier:
+			return DSPProcessing::ESaturationType::FullWaveRectifier;
+		case ESubmixEffectSaturationType::TapeHysteresis:
+			return DSPProcessing::ESaturationType::TapeHysteresis;
+		case ESubmixEffectSaturationType::Harmonic:
+			return DSPProcessing::ESaturationType::Harmonic;
+		case ESubmixEffectSaturationType::Custom:
+			return DSPProcessing::ESaturationType::Custom;
 	}
 }
 
+DSPProcessing::ETapeHysteresisSolver SubmixEffectTapeHysteresisSolverToTapeHysteresisSolver(ESubmixEffectTapeHysteresisSolver SubmixEffectTapeHysteresisSolver)
+{
+	switch (SubmixEffectTapeHysteresisSolver)
+	{
+		case ESubmixEffectTapeHysteresisSolver::RK2:
+			return DSPProcessing::ETapeHysteresisSolver::RK2;
+		default:
+		case ESubmixEffectTapeHysteresisSolver::RK4:
+			return DSPProcessing::ETapeHysteresisSolver::RK4;
+	}
+}
+
+DSPProcessing::EEnvelopeDetectorMode SubmixEffectEnvelopeDetectorModeToEnvelopeDetectorMode(ESubmixEffectEnvelopeDetectorMode SubmixEffectEnvelopeDetectorMode)
+{
+	switch (SubmixEffectEnvelopeDetectorMode)
+	{
+		default:
+		case ESubmixEffectEnvelopeDetectorMode::Peak:
+			return DSPProcessing::EEnvelopeDetectorMode::Peak;
+		case ESubmixEffectEnvelopeDetectorMode::RMS:
+			return DSPProcessing::EEnvelopeDetectorMode::RMS;
+	}
+}
+
+DSPProcessing::FEmphasisBand SubmixEffectSaturationEmphasisBandToEmphasisBand(const FSubmixEffectSaturationEmphasisBand& SubmixEffectSaturationEmphasisBand)
+{
+	DSPProcessing::FEmphasisBand EmphasisBand;
+	EmphasisBand.Frequency = SubmixEffectSaturationEmphasisBand.Frequency;
+	EmphasisBand.GainDb    = SubmixEffectSaturationEmphasisBand.GainDb;
+	EmphasisBand.Q         = SubmixEffectSaturationEmphasisBand.Q;
+
+	switch (SubmixEffectSaturationEmphasisBand.Type)
+	{
+		default:
+		case ESubmixEffectEmphasisFilterType::Off:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::Off;
+			break;
+		case ESubmixEffectEmphasisFilterType::LowCut:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::LowCut;
+			break;
+		case ESubmixEffectEmphasisFilterType::HighCut:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::HighCut;
+			break;
+		case ESubmixEffectEmphasisFilterType::LowShelf:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::LowShelf;
+			break;
+		case ESubmixEffectEmphasisFilterType::HighShelf:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::HighShelf;
+			break;
+		case ESubmixEffectEmphasisFilterType::Peak:
+			EmphasisBand.Type = DSPProcessing::EEmphasisFilterType::Peak;
+			break;
+	}
+
+	return EmphasisBand;
+}
+
+void SubmixEffectSaturationHarmonicsToHarmonicWeights(const FSubmixEffectSaturationHarmonics& SubmixEffectSaturationHarmonics, DSPProcessing::FSaturation& OutSaturation)
+{
+	const float Weights[] = { SubmixEffectSaturationHarmonics.Fundamental, SubmixEffectSaturationHarmonics.Second, SubmixEffectSaturationHarmonics.Third, SubmixEffectSaturationHarmonics.Fourth,
+							  SubmixEffectSaturationHarmonics.Fifth, SubmixEffectSaturationHarmonics.Sixth, SubmixEffectSaturationHarmonics.Seventh, SubmixEffectSaturationHarmonics.Eighth };
+	static_assert(UE_ARRAY_COUNT(Weights) == DSPProcessing::FHarmonicShaper::MaxHarmonic);
+
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Weights); ++Index)
+	{
+		OutSaturation.SetHarmonicWeight(Index + 1, Weights[Index]);
+	}
+}
 
 //------------------------------------------------------------------------------------
 // FSubmixEffectSaturation
 //------------------------------------------------------------------------------------
 void FSubmixEffectSaturation::Init(const FSoundEffectSubmixInitData& InitData)
 {
-	SaturationDSPProcessor.Init(InitData.SampleRate);
+	BlockFrames = UDSPCollectionImpulseResponse::GetDeviceBlockFrames(InitData.DeviceID);
+
+	// Everything is allocated here for the device block, the render thread never allocates
+	SaturationDSPProcessor.Init(InitData.SampleRate, 1, MaxNumChannels, BlockFrames);
+	CabinetDSPProcessor.Init(InitData.SampleRate);
+	LimiterDSPProcessor.Init(InitData.SampleRate, 1, MaxNumChannels, BlockFrames);
+
+	GainModulation.Init(InitData.DeviceID, false);
+	BiasModulation.Init(InitData.DeviceID, false);
+	MixModulation.Init(InitData.DeviceID, false);
+	OutLevelModulation.Init(InitData.DeviceID, true);
+
+	// Both pipeline buffers are allocated here for the largest block, the render thread never grows them
+	const int32 MaxBlockFrames = BlockFrames > 0 ? BlockFrames : DefaultMaxBlockFrames;
+
+	Pipeline.Init([this](float* InOutBuffer, const int32 InNumSamples)
+	{
+		ProcessBlock(InOutBuffer, InOutBuffer, InNumSamples);
+	},
+	MaxBlockFrames * MaxNumChannels);
 }
 
 void FSubmixEffectSaturation::OnPresetChanged()
 {
 	GET_EFFECT_SETTINGS(SubmixEffectSaturation);
 
+	bPipelined       = Settings.bPipelined;
+	bSettingsChanged = true;
+}
+
+void FSubmixEffectSaturation::ApplySettings()
+{
+	GET_EFFECT_SETTINGS(SubmixEffectSaturation);
+
 	SaturationDSPProcessor.SetSaturationType(SubmixEffectSaturationTypeToSaturationType(Settings.SaturationType));
-	SaturationDSPProcessor.SetGain(Settings.Gain);
-	SaturationDSPProcessor.SetBias(Settings.Bias);
-	SaturationDSPProcessor.SetMix(Settings.Mix);
-	SaturationDSPProcessor.SetOutLevelDb(Settings.OutLevelDb);
+
+	BaseGain       = Settings.Gain;
+	BaseBias       = Settings.Bias;
+	BaseMix        = Settings.Mix;
+	BaseOutLevelDb = Settings.OutLevelDb;
+
+	GainModulation.UpdateModulators(Settings.GainModulators);
+	BiasModulation.UpdateModulators(Settings.BiasModulators);
+	MixModulation.UpdateModulators(Settings.MixModulators);
+	OutLevelModulation.UpdateModulators(Settings.OutLevelModulators);
+
+	bModulated = GainModulation.IsModulated() || BiasModulation.IsModulated() || MixModulation.IsModulated() || OutLevelModulation.IsModulated();
+	ApplyModulation();
+
+	SaturationDSPProcessor.SetTapeHysteresisSolver(SubmixEffectTapeHysteresisSolverToTapeHysteresisSolver(Settings.TapeHysteresisSolver));
+	SaturationDSPProcessor.SetTapeHysteresisOversampling(Settings.TapeHysteresisOversampling);
+	SubmixEffectSaturationHarmonicsToHarmonicWeights(Settings.Harmonics, SaturationDSPProcessor);
+	SaturationDSPProcessor.SetCustomCurve(Settings.CustomCurve ? Settings.CustomCurve->GetSharedTransferCurve() : nullptr);
+	SaturationDSPProcessor.SetMidSideEnabled(Settings.bMidSide);
+	SaturationDSPProcessor.SetSideGain(Settings.SideGain);
+	SaturationDSPProcessor.SetSideBias(Settings.SideBias);
+	SaturationDSPProcessor.SetSideMix(Settings.SideMix);
+	SaturationDSPProcessor.SetDCBlockerEnabled(Settings.bDCBlockerEnabled);
+	SaturationDSPProcessor.SetDCBlockerCutoffFrequency(Settings.DCBlockerCutoffFrequency);
+	SaturationDSPProcessor.SetEnvelopeFollowerEnabled(Settings.bEnvelopeFollowerEnabled);
+	SaturationDSPProcessor.SetEnvelopeDetectorMode(SubmixEffectEnvelopeDetectorModeToEnvelopeDetectorMode(Settings.EnvelopeDetectorMode));
+	SaturationDSPProcessor.SetEnvelopeAttackTimeMs(Settings.EnvelopeAttackTimeMs);
+	SaturationDSPProcessor.SetEnvelopeReleaseTimeMs(Settings.EnvelopeReleaseTimeMs);
+	SaturationDSPProcessor.SetEnvelopeToGain(Settings.EnvelopeToGain);
+	SaturationDSPProcessor.SetEnvelopeToBias(Settings.EnvelopeToBias);
+	SaturationDSPProcessor.SetPreEmphasisBand(0, SubmixEffectSaturationEmphasisBandToEmphasisBand(Settings.PreEmphasisBand1));
+	SaturationDSPProcessor.SetPreEmphasisBand(1, SubmixEffectSaturationEmphasisBandToEmphasisBand(Settings.PreEmphasisBand2));
+	SaturationDSPProcessor.SetPostEmphasisBand(0, SubmixEffectSaturationEmphasisBandToEmphasisBand(Settings.PostEmphasisBand1));
+	SaturationDSPProcessor.SetPostEmphasisBand(1, SubmixEffectSaturationEmphasisBandToEmphasisBand(Settings.PostEmphasisBand2));
+
+	CabinetDSPProcessor.SetImpulseResponse(Settings.CabinetImpulseResponse ? Settings.CabinetImpulseResponse->GetSharedImpulseResponse() : nullptr);
+	CabinetDSPProcessor.SetNonUniformPartitions(Settings.bCabinetNonUniformPartitions);
+
+	// Requests the state for the device block size, built on a background task (with the partitions the asset built on the game thread) and swapped in by the first blocks
+	if (BlockFrames > 0)
+	{
+		CabinetDSPProcessor.Prepare(BlockFrames);
+	}
+
+	// The delay line holds stale audio from the last time it was enabled
+	if (Settings.bLimiterEnabled && !bLimiterEnabled)
+	{
+		LimiterDSPProcessor.Reset();
+	}
+
+	bLimiterEnabled = Settings.bLimiterEnabled;
+	LimiterDSPProcessor.SetCeilingDb(Settings.LimiterCeilingDb);
+	LimiterDSPProcessor.SetReleaseTimeMs(Settings.LimiterReleaseTimeMs);
+	LimiterDSPProcessor.SetLookAheadMs(Settings.LimiterLookAheadMs);
+	LimiterDSPProcessor.SetTruePeakEnabled(Settings.bLimiterTruePeak);
+
+	bParallelChannels = Settings.bParallelChannels;
+	bSettingsChanged  = false;
+}
+
+void FSubmixEffectSaturation::ApplyModulation()
+{
+	SaturationDSPProcessor.SetGain(GainModulation.IsModulated() ? BaseGain * GainModulation.ProcessScale() : BaseGain);
+	SaturationDSPProcessor.SetBias(BiasModulation.IsModulated() ? BaseBias * BiasModulation.ProcessScale() : BaseBias);
+	SaturationDSPProcessor.SetMix(MixModulation.IsModulated() ? BaseMix * MixModulation.ProcessScale() : BaseMix);
+	SaturationDSPProcessor.SetOutLevelDb(OutLevelModulation.IsModulated() ? OutLevelModulation.ProcessDb(BaseOutLevelDb) : BaseOutLevelDb);
 }
 
 void FSubmixEffectSaturation::OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData)
@@ -61,10 +239,96 @@ void FSubmixEffectSaturation::OnProcessAudio(const FSoundEffectSubmixInputData&
 	const float* InAudioBuffer = InData.AudioBuffer->GetData();
 	float* OutAudioBuffer      = OutData.AudioBuffer->GetData();
 
-	const int32 NumChannels = InData.NumChannels;
-	const int32 NumSamples  = InData.NumFrames * NumChannels;
+	const int32 NumSamples = InData.NumFrames * InData.NumChannels;
+
+	LastBlockNumFrames = InData.NumFrames;
+
+	if (bPipelined)
+	{
+		// The previous block comes out, this one goes to the worker. When the worker is late the output is silent and this block is dropped
+		if (!Pipeline.ReceiveBlock(OutAudioBuffer, NumSamples))
+		{
+			return;
+		}
+
+		if (bSettingsChanged)
+		{
+			ApplySettings();
+		}
+		else if (bModulated)
+		{
+			ApplyModulation();
+		}
+
+		NumChannels = InData.NumChannels;
+		SaturationDSPProcessor.SetNumChannels(NumChannels);
+		Pipeline.SubmitBlock(InAudioBuffer, NumSamples);
+
+		return;
+	}
+
+	// Back from pipelined mode: the worker may still own SaturationDSPProcessor, silence until it's done (never waited for here)
+	if (!Pipeline.IsIdle())
+	{
+		FMemory::Memzero(OutAudioBuffer, sizeof(float) * NumSamples);
+		return;
+	}
+
+	Pipeline.DiscardResult();
+
+	if (bSettingsChanged)
+	{
+		ApplySettings();
+	}
+	else if (bModulated)
+	{
+		ApplyModulation();
+	}
+
+	NumChannels = InData.NumChannels;
+	SaturationDSPProcessor.SetNumChannels(NumChannels);
+	ProcessBlock(InAudioBuffer, OutAudioBuffer, NumSamples);
+}
+
+void FSubmixEffectSaturation::ProcessBlock(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
+{
+	// The partitions are only set up for bParallelChannels above the channel threshold, everything else (stereo, quad, 7.1) runs the plain kernels.
+	// Switching in or out of the partitions restarts the DC blocker/emphasis/hysteresis states, the frame threshold only changes the threading
+	const int32 NumFrames    = InNumSamples / FMath::Max(NumChannels, 1);
+	const bool  bPartitioned = bParallelChannels && NumChannels >= ParallelMinChannelsCVar;
+
+	// The calling thread takes part in the ParallelFor, no-op when it's already set
+	SaturationDSPProcessor.SetMaxChannelPartitions(bPartitioned ? FTaskGraphInterface::Get().GetNumWorkerThreads() + 1 : 1);
+
+	if (bPartitioned)
+	{
+		SaturationDSPProcessor.ProcessAudioBufferPartitioned(InBuffer, OutBuffer, InNumSamples, NumFrames >= ParallelMinFramesCVar);
+	}
+	else
+	{
+		SaturationDSPProcessor.ProcessAudioBuffer(InBuffer, OutBuffer, InNumSamples);
+	}
+
+	if (CabinetDSPProcessor.IsActive())
+	{
+		CabinetDSPProcessor.SetNumChannels(NumChannels);
+		CabinetDSPProcessor.ProcessAudioBuffer(OutBuffer, OutBuffer, InNumSamples);
+	}
+
+	// The channels are linked, so the limiter always runs on the whole buffer
+	if (bLimiterEnabled)
+	{
+		LimiterDSPProcessor.SetNumChannels(NumChannels);
+		LimiterDSPProcessor.ProcessAudioBuffer(OutBuffer, OutBuffer, InNumSamples);
+	}
+}
 
-	SaturationDSPProcessor.ProcessAudioBuffer(InAudioBuffer, OutAudioBuffer, NumSamples);
+int32 FSubmixEffectSaturation::GetLatencyInFrames() const
+{
+	const int32 PipelineLatency = bPipelined ? FSubmixEffectPipeline::LatencyInBlocks * LastBlockNumFrames : 0;
+	const int32 LimiterLatency  = bLimiterEnabled ? LimiterDSPProcessor.GetLatencyInFrames() : 0;
+
+	return PipelineLatency + LimiterLatency;
 }
 
 
@@ -75,3 +339,11 @@ void USubmixEffectSaturationPreset::SetSettings(const FSubmixEffectSaturationSet
 {
 	UpdateSettings(InSettings);
 }
+
+int32 USubmixEffectSaturationPreset::GetLatencyInFrames(const float SampleRate, const int32 NumFramesPerBlock) const
+{
+	const int32 PipelineLatency = Settings.bPipelined ? FSubmixEffectPipeline::LatencyInBlocks * NumFramesPerBlock : 0;
+	const int32 LimiterLatency  = Settings.bLimiterEnabled ? DSPProcessing::FLimiter::LookAheadMsToFrames(Settings.LimiterLookAheadMs, SampleRate) : 0;
+
+	return PipelineLatency + LimiterLatency;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "DSPProcessing/Convolution.h"
+#include "IAudioProxyInitializer.h"
+#include "UObject/Object.h"
+
+#include "DSPCollectionImpulseResponse.generated.h"
+
+class USoundWave;
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+// What the audio thread sees of a UDSPCollectionImpulseResponse, the partitioned spectra are shared by every instance using the asset
+class AUDIODSPCOLLECTION_API FDSPCollectionImpulseResponseProxy : public Audio::TProxyData<FDSPCollectionImpulseResponseProxy>
+{
+public:
+	IMPL_AUDIOPROXY_CLASS(FDSPCollectionImpulseResponseProxy);
+
+	explicit FDSPCollectionImpulseResponseProxy(const TSharedPtr<const DSPProcessing::FSharedImpulseResponse>& InImpulseResponse)
+		: ImpulseResponse(InImpulseResponse)
+	{
+	}
+
+	const TSharedPtr<const DSPProcessing::FSharedImpulseResponse>& GetImpulseResponse() const { return ImpulseResponse; }
+
+private:
+	TSharedPtr<const DSPProcessing::FSharedImpulseResponse> ImpulseResponse;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Impulse response for the Convolution effects and node (cabinet, mic or any short coloring IR)
+UCLASS(BlueprintType)
+class AUDIODSPCOLLECTION_API UDSPCollectionImpulseResponse : public UObject, public IAudioProxyDataFactory
+{
+	GENERATED_BODY()
+
+public:
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Copies the samples of SourceSoundWave into the asset
+	UFUNCTION(CallInEditor, Category = "ImpulseResponse")
+	void ImportSoundWave();
+#endif
+
+	// Replaces the IR, InSamples are interleaved. Instances pick it up the next time their settings are applied
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Convolution")
+	void SetImpulseResponse(const TArray<float>& InSamples, const int32 InNumChannels, const float InSampleRate);
+
+	// Thread safe, nullptr when the asset has no samples. Its partitions for the block size and sample rate of every audio device are already built
+	TSharedPtr<const DSPProcessing::FSharedImpulseResponse> GetSharedImpulseResponse() const;
+
+	// Block size the effects of an audio device process (its callback buffer length), 0 when the device doesn't exist
+	static int32 GetDeviceBlockFrames(const uint32 InDeviceId);
+
+	virtual TSharedPtr<Audio::IProxyData> CreateProxyData(const Audio::FProxyDataInitParams& InitParams) override;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(EditAnywhere, Category = "ImpulseResponse")
+	TObjectPtr<USoundWave> SourceSoundWave;
+#endif
+
+	// Scales the IR to unit energy, so switching IRs doesn't change the loudness much
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ImpulseResponse")
+	bool bNormalize = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ImpulseResponse", meta = (ClampMin = "-48.0", ClampMax = "24.0", UIMin = "-48.0", UIMax = "24.0", Units = "dB"))
+	float GainDb = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ImpulseResponse")
+	int32 NumChannels = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ImpulseResponse")
+	int32 NumFrames = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ImpulseResponse", meta = (Units = "Hz"))
+	float SampleRate = 0.0f;
+
+private:
+	void RebuildSharedImpulseResponse();
+
+	// Interleaved, as imported (the normalization and the gain are applied to the shared copy)
+	UPROPERTY()
+	TArray<float> Samples;
+
+	mutable FCriticalSection SharedImpulseResponseCriticalSection;
+	TSharedPtr<const DSPProcessing::FSharedImpulseResponse> SharedImpulseResponse;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Curves/CurveFloat.h"
+#include "DSPProcessing/Helpers/TransferCurve.h"
+#include "IAudioProxyInitializer.h"
+#include "UObject/Object.h"
+
+#include "DSPCollectionTransferCurve.generated.h"
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+// What the audio thread sees of a UDSPCollectionTransferCurve, the compiled table is shared by every instance using the asset
+class AUDIODSPCOLLECTION_API FDSPCollectionTransferCurveProxy : public Audio::TProxyData<FDSPCollectionTransferCurveProxy>
+{
+public:
+	IMPL_AUDIOPROXY_CLASS(FDSPCollectionTransferCurveProxy);
+
+	explicit FDSPCollectionTransferCurveProxy(const TSharedPtr<const DSPProcessing::FSharedTransferCurve>& InTransferCurve)
+		: TransferCurve(InTransferCurve)
+	{
+	}
+
+	const TSharedPtr<const DSPProcessing::FSharedTransferCurve>& GetTransferCurve() const { return TransferCurve; }
+
+private:
+	TSharedPtr<const DSPProcessing::FSharedTransferCurve> TransferCurve;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Saturation curve drawn by hand, for the Custom type of the Saturation effects and nodes.
+// X is the driven input and Y the output, both in [-1, 1] (the input is clamped, keys outside of it are ignored).
+// The curve is compiled into a fixed size table whenever it changes, so its number of keys has no cost on the audio thread
+UCLASS(BlueprintType)
+class AUDIODSPCOLLECTION_API UDSPCollectionTransferCurve : public UObject, public IAudioProxyDataFactory
+{
+	GENERATED_BODY()
+
+public:
+	UDSPCollectionTransferCurve();
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Recompiles the curve after a change made from code. Instances pick it up the next time their settings are applied
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Saturation")
+	void Compile();
+
+	// Thread safe
+	TSharedPtr<const DSPProcessing::FSharedTransferCurve> GetSharedTransferCurve() const;
+
+	virtual TSharedPtr<Audio::IProxyData> CreateProxyData(const Audio::FProxyDataInitParams& InitParams) override;
+
+	// Identity by default, an external Curve Float asset can be used instead
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "TransferCurve", meta = (XAxisName = "In", YAxisName = "Out"))
+	FRuntimeFloatCurve Curve;
+
+	// Makes the curve odd (f(-x) = -f(x)) from its positive half, so only x >= 0 needs to be drawn
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "TransferCurve")
+	bool bSymmetric = false;
+
+private:
+	mutable FCriticalSection SharedTransferCurveCriticalSection;
+	TSharedPtr<const DSPProcessing::FSharedTransferCurve> SharedTransferCurve;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
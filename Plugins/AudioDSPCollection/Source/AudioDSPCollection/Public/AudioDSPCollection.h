@@ -2,6 +2,8 @@
 
 #include "Modules/ModuleManager.h"
 
+AUDIODSPCOLLECTION_API DECLARE_LOG_CATEGORY_EXTERN(LogAudioDSPCollection, Log, All);
+
 class FAudioDSPCollectionModule : public IModuleInterface
 {
 public:
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "DSPCollectionRenderCommandlet.generated.h"
+
+// Streams a WAV file through a chain of FGain/FSaturation stages and writes the result, without loading the map or the whole file:
+// UnrealEditor-Cmd UEAudioDSPCollection.uproject -run=DSPCollectionRender -In=In.wav -Out=Out.wav -Chain=Saturation:Tube:60+GainDb:-6 [-Format=Int16|Int24|Float] [-BlockSize=4096]
+// Chain stages are separated by '+':
+// - Gain:<Linear gain>
+// - GainDb:<Gain in dB>
+// - Saturation:<Type>[:<Gain 0-100>[:<Mix 0-100>[:<Bias -1-1>]]]
+UCLASS()
+class UDSPCollectionRenderCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDSPCollectionRenderCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformFileManager.h"
+#include "Templates/UniquePtr.h"
+
+namespace DSPCollectionCommandlets
+{
+	enum class EWaveSampleFormat : uint8
+	{
+		Int16,
+		Int24,
+		Float32
+	};
+
+	struct FWaveFormat
+	{
+		EWaveSampleFormat SampleFormat = EWaveSampleFormat::Int16;
+		int32 NumChannels              = 2;
+		int32 SampleRate               = 48000;
+
+		int32 GetBytesPerSample() const;
+		int32 GetBytesPerFrame() const;
+	};
+
+	// Reads the data chunk of a RIFF/RF64 WAV file block by block, the file is never loaded whole.
+	// Supports PCM 16/24 bits and float 32 bits (also in WAVE_FORMAT_EXTENSIBLE).
+	class FWaveStreamReader
+	{
+	public:
+		bool Open(const FString& InFilename, FString& OutError);
+
+		const FWaveFormat& GetFormat() const;
+		int64 GetNumFrames() const;
+		int64 GetNumFramesRemaining() const;
+
+		// Raw interleaved frames in the file sample format, returns the number of frames read
+		int32 ReadFrames(uint8* OutBuffer, const int32 InMaxNumFrames);
+
+	private:
+		TUniquePtr<IFileHandle> FileHandle;
+		FWaveFormat Format;
+		int64 NumFrames  = 0;
+		int64 FrameIndex = 0;
+	};
+
+	// Writes a WAV file block by block. The header is patched on Close, switching to RF64 when the data goes over 4GB.
+	class FWaveStreamWriter
+	{
+	public:
+		~FWaveStreamWriter();
+
+		bool Open(const FString& InFilename, const FWaveFormat& InFormat, FString& OutError);
+		bool WriteFrames(const uint8* InBuffer, const int32 InNumFrames);
+		bool Close();
+
+	private:
+		TUniquePtr<IFileHandle> FileHandle;
+		FWaveFormat Format;
+		int64 NumDataBytes = 0;
+	};
+}
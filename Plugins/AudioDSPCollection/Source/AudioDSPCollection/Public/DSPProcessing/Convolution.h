@@ -0,0 +1,237 @@
+#pragma once
+
+#include "DSPProcessing/Helpers/AudioUtils.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+namespace Audio
+{
+	class IFFTAlgorithm;
+}
+
+namespace DSPProcessing
+{
+	// Impulse response split in partitions and transformed once, immutable so any number of FConvolution instances can share it.
+	// Uniform: every partition has the block size.
+	// Non-uniform: the head uses block size partitions and the tail partitions NonUniformTailFactor times longer,
+	// fewer FFTs and multiply-adds for long IRs, at the cost of a heavier block every NonUniformTailFactor blocks.
+	class AUDIODSPCOLLECTION_API FConvolutionIR
+	{
+	public:
+		static constexpr int32 NonUniformTailFactor = 8;
+
+		// InSamples are interleaved, the IR channel of an input channel is Channel % InNumChannels
+		static TSharedPtr<const FConvolutionIR> Create(const float* InSamples, const int32 InNumFrames, const int32 InNumChannels, const int32 InBlockFrames, const bool bInNonUniform);
+
+		int32 GetBlockFrames() const { return BlockFrames; }
+		int32 GetNumChannels() const { return NumChannels; }
+		bool  IsNonUniform() const   { return Stages.Num() > 1; }
+
+		SIZE_T GetAllocatedSize() const;
+
+	private:
+		friend class FConvolution;
+
+		struct FStage
+		{
+			int32 PartitionFrames = 0;
+			int32 Log2FFTSize     = 0;
+			int32 FFTSize         = 0;
+			int32 SpectrumFloats  = 0; // FFTSize + 2 floats rounded up to whole vectors
+			int32 NumPartitions   = 0;
+
+			// [Channel][Partition][SpectrumFloats], pre-scaled so the inverse FFT gives the convolution directly
+			TArray<float, TAlignedHeapAllocator<16>> Spectra;
+
+			const float* GetSpectrum(const int32 InChannel, const int32 InPartition) const
+			{
+				return Spectra.GetData() + (InChannel * NumPartitions + InPartition) * SpectrumFloats;
+			}
+		};
+
+		int32 BlockFrames = 0;
+		int32 NumChannels = 0;
+
+		// Stage 0 is the head, stage 1 (non-uniform only) starts PartitionFrames into the IR and its output is delayed by PartitionFrames
+		TArray<FStage> Stages;
+	};
+
+	// Source IR plus its partitioned versions, built once per block size / sample rate / partitioning and then shared.
+	// The partitions are built off the audio render thread (UDSPCollectionImpulseResponse builds the ones of every audio device on the game thread,
+	// FConvolution the missing ones on a background task), the render thread never builds nor looks them up.
+	class AUDIODSPCOLLECTION_API FSharedImpulseResponse : public TSharedFromThis<FSharedImpulseResponse>
+	{
+	public:
+		static constexpr int32 MaxCacheEntries = 16;
+
+		FSharedImpulseResponse(TArray<float>&& InSamples, const int32 InNumChannels, const float InSampleRate);
+
+		// Not realtime safe (resampling, FFTs, allocations), returns the cached version when there is one. Thread safe, resamples the IR to InSampleRate (linear) when needed
+		TSharedPtr<const FConvolutionIR> BuildPartitionedIR(const int32 InBlockFrames, const float InSampleRate, const bool bInNonUniform) const;
+
+		// Lock free, false when that version hasn't been built yet. OutPartitionedIR can be nullptr when the build failed (unsupported FFT size)
+		bool FindPartitionedIR(const int32 InBlockFrames, const float InSampleRate, const bool bInNonUniform, TSharedPtr<const FConvolutionIR>& OutPartitionedIR) const;
+
+		int32 GetNumFrames() const   { return NumFrames; }
+		int32 GetNumChannels() const { return NumChannels; }
+		float GetSampleRate() const  { return SampleRate; }
+
+		SIZE_T GetAllocatedSize() const;
+
+	private:
+		struct FCacheEntry
+		{
+			int32 BlockFrames = 0;
+			float SampleRate  = 0.0f;
+			bool  bNonUniform = false;
+			TSharedPtr<const FConvolutionIR> PartitionedIR;
+		};
+
+		int32 GetNumResampledFrames(const float InSampleRate) const;
+
+		// Short IRs don't get a tail stage, so their non-uniform version is the uniform one
+		bool UsesNonUniformPartitions(const int32 InBlockFrames, const float InSampleRate, const bool bInNonUniform) const;
+
+		int32 FindCacheEntry(const int32 InBlockFrames, const float InSampleRate, const bool bInNonUniform) const;
+
+		TArray<float> Samples;
+		int32 NumFrames   = 0;
+		int32 NumChannels = 1;
+		float SampleRate  = 48000.0f;
+
+		// Entries below NumCacheEntries are never modified, a new one is filled under the lock and then published by incrementing NumCacheEntries
+		mutable FCriticalSection CacheCriticalSection;
+		mutable FCacheEntry Cache[MaxCacheEntries];
+		mutable std::atomic<int32> NumCacheEntries = 0;
+	};
+
+	// Partitioned FFT convolution (overlap-add with a frequency domain delay line), no latency when called with the block size of the IR.
+	// The FFTs, the per channel state and the scratch buffers are built off the audio render thread along with the partitioned IR, whenever the IR,
+	// the partitioning, the channel count or the block size changes, and handed over as a whole: the render thread only swaps a pointer.
+	class AUDIODSPCOLLECTION_API FConvolution
+	{
+	public:
+		FConvolution();
+		~FConvolution();
+
+		void Init(const float InSampleRate, const int32 InNumChannels = 1);
+		void SetNumChannels(const int32 InNumChannels);
+
+		// nullptr bypasses the convolution. A new IR restarts from silence
+		void SetImpulseResponse(const TSharedPtr<const FSharedImpulseResponse>& InImpulseResponse);
+		void SetNonUniformPartitions(const bool bInNonUniform);
+
+		// Requests the state for InBlockFrames, otherwise done by the first ProcessAudioBuffer. Realtime safe, nothing is built or allocated here:
+		// the state is built on a background task and picked up by ProcessAudioBuffer once it's ready. Meanwhile the previous IR keeps playing
+		// when it was built for the same block size and channel count, otherwise the convolution bypasses. No-op when the current state already matches
+		void Prepare(const int32 InBlockFrames);
+
+		// Same as Prepare but builds the state right away, not on the audio render thread (Metasound operator creation, offline processing, benchmarks)
+		void PrepareBlocking(const int32 InBlockFrames);
+
+		void Reset();
+
+		bool IsActive() const;
+
+		// In-place safe. The block size (InNumSamples / NumChannels) should stay the same from one call to the next, a change re-prepares (and bypasses until ready)
+		void ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
+		SIZE_T GetAllocatedSize() const;
+
+	private:
+		struct FStageState
+		{
+			TUniquePtr<Audio::IFFTAlgorithm> FFT;
+
+			// Per channel: [Channel][Partition][SpectrumFloats] input spectra, newest at DelayLineHead
+			TArray<float, TAlignedHeapAllocator<16>> DelayLine;
+			int32 DelayLineHead = 0;
+
+			TArray<float, TAlignedHeapAllocator<16>> OverlapTail;  // [Channel][PartitionFrames]
+			TArray<float, TAlignedHeapAllocator<16>> InputBlock;   // [Channel][PartitionFrames], tail stage only
+			TArray<float, TAlignedHeapAllocator<16>> OutputBlock;  // [Channel][PartitionFrames], tail stage only
+			int32 BlockPosition = 0;                               // Tail stage only, frames gathered in InputBlock
+		};
+
+		// Everything the processing needs for one IR, partitioning, sample rate, channel count and block size. Built off the render thread, never resized
+		struct FState
+		{
+			// Not realtime safe: builds the partitions when they aren't cached yet, the FFTs and the buffers. No stages when the FFT size isn't supported
+			static TUniquePtr<FState> Create(const TSharedPtr<const FSharedImpulseResponse>& InImpulseResponse, const float InSampleRate, const bool bInNonUniform,
+											 const int32 InNumChannels, const int32 InBlockFrames, const uint32 InRequestId);
+
+			bool Matches(const FSharedImpulseResponse* InImpulseResponse, const float InSampleRate, const bool bInNonUniform, const int32 InNumChannels, const int32 InBlockFrames) const;
+			bool CanProcess(const int32 InNumChannels, const int32 InBlockFrames) const;
+
+			void Reset();
+			SIZE_T GetAllocatedSize() const;
+
+			// InBuffer/OutBuffer are BlockFrames interleaved frames
+			void ProcessBlock(const float* InBuffer, float* OutBuffer);
+
+			// Convolves one partition of planar input, InChannelInput is PartitionFrames long, OutChannelOutput gets PartitionFrames
+			void ProcessStagePartition(const int32 InStageIndex, const int32 InChannel, const float* InChannelInput, float* OutChannelOutput);
+			void AdvanceDelayLine(const int32 InStageIndex);
+
+			TSharedPtr<const FSharedImpulseResponse> ImpulseResponse;
+			TSharedPtr<const FConvolutionIR>         PartitionedIR;
+
+			float  SampleRate  = 48000.0f;
+			bool   bNonUniform = false;
+			int32  NumChannels = 1;
+			int32  BlockFrames = 0;
+			uint32 RequestId   = 0;
+
+			TArray<FStageState> StageStates;
+
+			// Scratch, sized for the largest stage
+			TArray<float, TAlignedHeapAllocator<16>> TimeBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> SpectrumBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> PlanarInput;   // [Channel][BlockFrames]
+			TArray<float, TAlignedHeapAllocator<16>> PlanarOutput;  // [Channel][BlockFrames]
+
+			FState* NextRetired = nullptr;
+		};
+
+		// Hands the states over between the background tasks and the render thread, shared with the tasks since they may outlive the instance.
+		// The render thread never deletes a state: replaced ones are retired here and deleted by the next task (or with the mailbox)
+		struct FStateMailbox
+		{
+			~FStateMailbox();
+
+			// Background task, replaces (and deletes) a state that wasn't picked up
+			void Publish(FState* InState);
+
+			// Render thread, lock and allocation free
+			FState* TakePending();
+			void Retire(FState* InState);
+
+			// Not on the render thread
+			void DeleteRetired();
+
+			std::atomic<FState*> Pending = nullptr;
+			std::atomic<FState*> Retired = nullptr; // Linked through FState::NextRetired
+		};
+
+		// Render thread: launches the build of the state for the current settings, PickUpState swaps it in once it's there
+		void RequestState(const int32 InBlockFrames);
+		void PickUpState();
+		void RetireState();
+
+		float SampleRate    = 48000.0f;
+		int32 NumChannels   = 1;
+		bool  bNonUniform   = false;
+		bool  bStateChanged = false;
+
+		int32  PreparedBlockFrames = 0;
+		uint32 RequestId           = 0;
+		bool   bStatePending       = false;
+
+		TSharedPtr<const FSharedImpulseResponse> ImpulseResponse;
+
+		TUniquePtr<FState> State;
+		TSharedPtr<FStateMailbox, ESPMode::ThreadSafe> Mailbox;
+	};
+}
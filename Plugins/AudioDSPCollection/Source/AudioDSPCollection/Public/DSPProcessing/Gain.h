@@ -1,22 +1,130 @@
 #pragma once
 
+#include "DSPProcessing/Helpers/AudioUtils.h"
+#include "DSPProcessing/Helpers/BlockCapture.h"
 #include "DSPProcessing/Helpers/ParamSmoother.h"
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "Misc/Optional.h"
 
 
 namespace DSPProcessing
 {
+	enum class AUDIODSPCOLLECTION_API EGainRampShape : int32
+	{
+		Linear = 0,
+		Exponential, // Linear in dB
+		SCurve,
+		EqualPower
+	};
+
 	class AUDIODSPCOLLECTION_API FGain
 	{
 	public:
-		void Init(const float InSampleRate);
+		static constexpr int32 MaxRampDurationInFrames = 1 << 24; // Frame indices stay exact in float
+
+		enum class ECaptureCommand : int32
+		{
+			None = 0,
+			SetGain,
+			StartRamp
+		};
+
+		// Recorded with every input block by FBlockCapture: the gain state at the start of the block, which the replay restores on the
+		// first block of an instance, and the last command since the previous block (an earlier one would have been cancelled by it)
+		struct FCaptureParams
+		{
+			float           CurrentGain         = 0.0f;
+			float           TargetGain          = 0.0f; // Smoother or ramp target
+			bool            bIsRamping          = false;
+			EGainRampShape  RampShape           = EGainRampShape::Linear;
+			int32           RampRemainingFrames = 0;
+			ECaptureCommand Command             = ECaptureCommand::None;
+			int32           CommandRampFrames   = 0; // StartRamp duration, the target and the shape are the ones above
+		};
+
+		void Init(const float InSampleRate, const int32 InNumChannels = 1);
+		void SetNumChannels(const int32 InNumChannels);
 
+		// Smoothed (one-pole) changes, cancel any running ramp
 		void SetGain(const float InGain);
+		void SetGainDb(const float InGainDb);
+
+		// Sample-accurate ramp from the current gain to InTargetGain in exactly InDurationInFrames frames, then the gain stays at InTargetGain
+		void StartRamp(const float InTargetGain, const int32 InDurationInFrames, const EGainRampShape InShape = EGainRampShape::Linear);
+		void StartRampDb(const float InTargetGainDb, const int32 InDurationInFrames, const EGainRampShape InShape = EGainRampShape::Linear);
+
+		bool IsRamping() const;
+		float GetRampTargetGain() const;
 
 		void ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
 
+		// One buffer per channel (e.g. Metasound audio pins), the gain is evaluated once and applied to every channel
+		void ProcessPlanarBuffers(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InNumFrames);
+
+		// Frames [InStartFrame, InStartFrame + InNumFrames) of the planar buffers, to split a block at sample-accurate events (e.g. Metasound triggers).
+		// The frames up to the next vector boundary and after the last one are processed one by one, the rest goes through the vectorized kernels.
+		// Call it inside an FScopedPlanarSegments covering the whole block
+		void ProcessPlanarSegment(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InStartFrame, const int32 InNumFrames);
+
+		// Captures (FBlockCapture) and measures (FQualityGovernor) a block processed as several ProcessPlanarSegment calls once, as a whole.
+		// Commands issued between the segments are captured with the next block
+		class FScopedPlanarSegments
+		{
+		public:
+			FScopedPlanarSegments(FGain& InGain, const float* const* InBuffers, const int32 InNumChannels, const int32 InNumFrames);
+
+		private:
+			// Started after the capture, like in ProcessPlanarBuffers
+			TOptional<FQualityGovernor::FScopedMeasure> QualityGovernorMeasure;
+		};
+
+		static float ConvertDbToGain(const float InGainDb);
+
+		// Replay of a captured block, before processing it
+		void ApplyCaptureParams(const FCaptureParams& InParams, const bool bInFirstBlock);
+
 	private:
+		void CaptureBlock(const float* InBuffer, const int32 InNumSamples);
+		void CapturePlanarBlock(const float* const* InBuffers, const int32 InNumChannels, const int32 InNumFrames);
+		FCaptureParams MakeCaptureParams() const;
+
 		FORCEINLINE void ProcessGain(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+		void ProcessPlanarVectors(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InStartFrame, const int32 InNumFrames); // InStartFrame and InNumFrames multiples of 4
+		void ProcessPlanarFrames(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InStartFrame, const int32 InNumFrames);
+
+		template <EGainRampShape RampShapeT>
+		void ProcessRamp(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
+		template <EGainRampShape RampShapeT>
+		void ProcessPlanarRamp(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumChannels, const int32 InStartFrame, const int32 InNumFrames);
+
+		template <EGainRampShape RampShapeT>
+		FORCEINLINE VectorRegister4Float VectorRampGain(const VectorRegister4Float& RampPosition) const;
+
+		float GetCurrentRampGain() const;
+		void  FinishRamp();
+
+		ParamSmootherBlock GainParamSmoother;
+
+		float SampleRate  = 48000.0f;
+		int32 NumChannels = 1;
+
+		// Ramp state, the position goes from 0 to 1 over the ramp duration
+		bool		   bIsRamping		  = false;
+		EGainRampShape RampShape		  = EGainRampShape::Linear;
+		float		   RampStartGain	  = 0.0f;
+		float		   RampTargetGain	  = 0.0f;
+		float		   RampLogRatio		  = 0.0f; // Exponential only: ln(Target / Start)
+		float		   RampSign			  = 1.0f; // EqualPower only: polarity shared by Start and Target
+		int32		   RampFrameIndex	  = 0;
+		int32		   RampDurationFrames = 0;
+		float		   RampPositionStep	  = 0.0f; // 1 / RampDurationFrames
+
+		// Position offset of each lane inside a vector, for Mono [0, 1, 2, 3] and Stereo [0, 0, 1, 1]
+		VectorRegister4Float VLaneFrameOffsets;
 
-		ParamSmootherLPF GainParamSmoother;
+		uint64          CaptureInstanceId        = 0;
+		ECaptureCommand CaptureCommand           = ECaptureCommand::None;
+		int32           CaptureCommandRampFrames = 0;
 	};
 }
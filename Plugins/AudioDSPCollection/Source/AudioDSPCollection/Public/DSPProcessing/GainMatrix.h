@@ -0,0 +1,139 @@
+#pragma once
+
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+namespace DSPProcessing
+{
+	enum class AUDIODSPCOLLECTION_API EGainMatrixLayout : int32
+	{
+		Identity = 0,
+		Custom,
+		DownmixToMono,
+		DownmixToStereo, // ITU fold-down of Quad/5.1/7.1 into the front pair, LFE dropped
+		MonoToStereo,
+		SwapStereo
+	};
+
+	// Routes NumInputChannels to NumOutputChannels through a smoothed gain matrix, Out[o] = Sum(Gain[o][i] * In[i]).
+	// Input and output buffers must not overlap.
+	class AUDIODSPCOLLECTION_API FGainMatrix
+	{
+	public:
+		static constexpr int32 MaxNumChannels = 8;
+
+		void Init(const float InSampleRate, const int32 InNumInputChannels = 2, const int32 InNumOutputChannels = 2);
+		void SetNumChannels(const int32 InNumInputChannels, const int32 InNumOutputChannels);
+
+		int32 GetNumInputChannels() const;
+		int32 GetNumOutputChannels() const;
+
+		// Fills the matrix for the current channel counts, preset layouts are refilled when the channel counts change
+		void SetLayout(const EGainMatrixLayout InLayout);
+
+		// Individual coefficients, both switch the layout to Custom
+		void SetGain(const int32 InOutputChannel, const int32 InInputChannel, const float InGain);
+		void ClearGains();
+
+		// Interleaved buffers, InNumFrames * NumInputChannels samples in, InNumFrames * NumOutputChannels samples out
+		void ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+
+		// One buffer per channel (e.g. Metasound audio pins)
+		void ProcessPlanarBuffers(const float* const* InBuffers, float* const* OutBuffers, const int32 InNumFrames);
+
+	private:
+		// Specialized kernel picked from the shape of the matrix once it has settled
+		enum class EKernel : uint8
+		{
+			Identity,
+			Zero,
+			Diagonal,	 // Per channel trims, any channel count
+			Stereo,		 // Full 2x2
+			FoldDown,	 // Full rows, even NumInputChannels into 2 outputs (Quad/5.1/7.1 to stereo)
+			DotProduct,	 // Dense rows, NumInputChannels multiple of 4
+			Sparse		 // Non zero coefficients only
+		};
+
+		struct FMatrixEntry
+		{
+			int32 InputChannel;
+			int32 OutputChannel;
+			float Gain;
+			float GainDelta; // Per frame increment while smoothing
+		};
+
+		void MarkTargetChanged();
+		void FillLayout();
+		void BeginBlock(const int32 InNumFrames);
+		void EndBlock();
+		void UpdateKernel();
+
+		// Loads the vector gains of InKernel, InGainDeltas (per frame, nullptr when static) also fills the per iteration steps of the ramp
+		void FillKernelGains(const EKernel InKernel, const float* InGains, const float* InGainDeltas);
+
+		FORCEINLINE static int32 GetIndex(const int32 OutputChannel, const int32 InputChannel)
+		{
+			return OutputChannel * MaxNumChannels + InputChannel;
+		}
+
+		// bRampT: the gains move by their steps after every iteration, while smoothing
+		template <bool bRampT>
+		void ProcessKernel(const EKernel InKernel, const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+
+		template <bool bRampT>
+		void ProcessDiagonal(const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+
+		template <bool bRampT>
+		void ProcessStereo(const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+
+		template <bool bRampT>
+		void ProcessFoldDown(const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+
+		template <bool bRampT>
+		void ProcessDotProduct(const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+
+		template <bool bRampT>
+		void ProcessSparse(const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+
+		int32 NumInputChannels	= 2;
+		int32 NumOutputChannels = 2;
+
+		EGainMatrixLayout Layout = EGainMatrixLayout::Identity;
+
+		// Row major [Output][Input], MaxNumChannels stride
+		float TargetGains[MaxNumChannels * MaxNumChannels];
+		float CurrentGains[MaxNumChannels * MaxNumChannels];
+
+		// Linear smoothing, every coefficient reaches its target after SmoothingTimeInFrames
+		int32 SmoothingTimeInFrames		   = 1024;
+		int32 RemainingSmoothingFrames	   = 0;
+		bool  bIsSmoothing				   = false;
+		bool  bFirstUpdate				   = true;
+
+		EKernel Kernel	   = EKernel::Identity;
+		EKernel RampKernel = EKernel::Sparse; // Picked from the channel counts while smoothing, the dense kernels cover any matrix
+
+		// Non zero coefficients of the current block (while smoothing: non zero at either end of the block)
+		TArray<FMatrixEntry, TInlineAllocator<MaxNumChannels * MaxNumChannels>> Entries;
+
+		// The *Steps are only filled while smoothing, added to the gains after each iteration of the kernel
+
+		// Diagonal: the lane pattern repeats every LCM(NumChannels, 4) samples, at most 7 vectors (7 channels)
+		VectorRegister4Float VDiagonalGains[MaxNumChannels];
+		VectorRegister4Float VDiagonalGainSteps[MaxNumChannels];
+		int32				 NumDiagonalVectors = 1;
+
+		// Stereo: Out = Direct * [L, R] + Cross * [R, L]
+		VectorRegister4Float VStereoDirectGains;
+		VectorRegister4Float VStereoCrossGains;
+		VectorRegister4Float VStereoDirectGainSteps;
+		VectorRegister4Float VStereoCrossGainSteps;
+
+		// FoldDown: 2 frames are NumInputChannels / 2 vectors, [Frame][Output][Vector] holds the gains of the lanes of that frame and zeros elsewhere
+		VectorRegister4Float VFoldGains[2][2][MaxNumChannels / 2];
+		VectorRegister4Float VFoldGainSteps[2][2][MaxNumChannels / 2];
+
+		// DotProduct: one row of input gains per output channel
+		VectorRegister4Float VRowGains[MaxNumChannels][MaxNumChannels / 4];
+		VectorRegister4Float VRowGainSteps[MaxNumChannels][MaxNumChannels / 4];
+	};
+}
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "Math/UnrealMathSSE.h"
 
 namespace DSPProcessing
@@ -11,6 +13,12 @@ namespace DSPProcessing
 			return minRange + value * (maxRange - minRange);
 		}
 
+		// Rate of a once-per-vector step over an interleaved buffer: a vector holds 4 / NumChannels frames
+		FORCEINLINE float GetVectorRate(const float InSampleRate, const int32 InNumChannels)
+		{
+			return InSampleRate * InNumChannels * 0.25f;
+		}
+
 		// Vectorized vars/functions
 		const VectorRegister4Float& VMinusOnes = GlobalVectorConstants::FloatMinusOne;
 		const VectorRegister4Float& VZeros     = GlobalVectorConstants::FloatZero;
@@ -19,7 +27,8 @@ namespace DSPProcessing
 		const VectorRegister4Float& VTwos      = GlobalVectorConstants::FloatTwo;
 		const VectorRegister4Float& VEps       = GlobalVectorConstants::SmallLengthThreshold;
 
-		constexpr VectorRegister4Float VThrees = MakeVectorRegisterFloatConstant(3.0f, 3.0f, 3.0f, 3.0f);
+		constexpr VectorRegister4Float VOneQuarter = MakeVectorRegisterFloatConstant(0.25f, 0.25f, 0.25f, 0.25f);
+		constexpr VectorRegister4Float VThrees     = MakeVectorRegisterFloatConstant(3.0f, 3.0f, 3.0f, 3.0f);
 
 		FORCEINLINE VectorRegister4Float VectorClampMinusOneToOne(const VectorRegister4Float& Vec)
 		{
@@ -34,5 +43,51 @@ namespace DSPProcessing
 			const VectorRegister4Float One_Minus_Mix_x_In = VectorMultiply(One_Minus_Mix, In);
 			Out = VectorMultiplyAdd(Out, MixAmount, One_Minus_Mix_x_In);
 		}
+
+		// Mid/side on interleaved stereo, [L0, R0, L1, R1] <-> [M0, S0, M1, S1], M = (L + R) / 2 and S = (L - R) / 2
+		constexpr VectorRegister4Float VMidSideSigns = MakeVectorRegisterFloatConstant(1.0f, -1.0f, 1.0f, -1.0f);
+
+		FORCEINLINE VectorRegister4Float VectorMidSideEncode(const VectorRegister4Float& In)
+		{
+			//M = 0.5f * (R + L), S = 0.5f * (L - R);
+			const VectorRegister4Float Swapped = VectorSwizzle(In, 1, 0, 3, 2);
+			return VectorMultiply(VectorMultiplyAdd(In, VMidSideSigns, Swapped), VOneHalf);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorMidSideDecode(const VectorRegister4Float& In)
+		{
+			//L = M + S, R = M - S;
+			const VectorRegister4Float Swapped = VectorSwizzle(In, 1, 0, 3, 2);
+			return VectorMultiplyAdd(In, VMidSideSigns, Swapped);
+		}
+
+		// Planar (one buffer per channel) <-> interleaved conversions
+		FORCEINLINE void InterleaveBuffers(const float* const* InBuffers, float* OutBuffer, const int32 InNumChannels, const int32 InNumFrames)
+		{
+			for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+			{
+				const float* InChannel = InBuffers[Channel];
+				float* OutChannel      = OutBuffer + Channel;
+
+				for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+				{
+					OutChannel[Frame * InNumChannels] = InChannel[Frame];
+				}
+			}
+		}
+
+		FORCEINLINE void DeinterleaveBuffer(const float* InBuffer, float* const* OutBuffers, const int32 InNumChannels, const int32 InNumFrames)
+		{
+			for (int32 Channel = 0; Channel < InNumChannels; ++Channel)
+			{
+				const float* InChannel = InBuffer + Channel;
+				float* OutChannel      = OutBuffers[Channel];
+
+				for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+				{
+					OutChannel[Frame] = InChannel[Frame * InNumChannels];
+				}
+			}
+		}
 	}
 }
\ No newline at end of file
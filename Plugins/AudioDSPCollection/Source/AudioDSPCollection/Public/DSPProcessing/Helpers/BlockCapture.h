@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Misc/EnumClassFlags.h"
+
+#include <atomic>
+
+namespace DSPProcessing
+{
+	enum class AUDIODSPCOLLECTION_API EBlockCaptureProcessor : int32
+	{
+		Saturation = 0,
+		Gain
+	};
+
+	enum class EBlockCaptureFlags : uint32
+	{
+		None          = 0,
+		ParamsChanged = 1 << 0, // A setter was called since the previous block of the instance
+		Partitioned   = 1 << 1, // FSaturation::ProcessAudioBufferPartitioned
+		UseWorkers    = 1 << 2, // ... with bInUseWorkers
+		Planar        = 1 << 3  // FGain::ProcessPlanarBuffers, the samples are stored channel after channel
+	};
+
+	ENUM_CLASS_FLAGS(EBlockCaptureFlags)
+
+	// One captured block: this header, the processor parameters (FSaturation::FCaptureParams or FGain::FCaptureParams),
+	// then the input samples (interleaved unless Planar), each part starting on 16 bytes
+	struct FBlockCaptureHeader
+	{
+		uint32                 Magic       = 0; // RecordMagic. The buffer is zeroed, so a block that didn't fit reads as the end
+		uint32                 RecordBytes = 0;
+		uint64                 InstanceId  = 0; // New on every Init, pooled instances show up as new ones
+		EBlockCaptureProcessor Processor   = EBlockCaptureProcessor::Saturation;
+		EBlockCaptureFlags     Flags       = EBlockCaptureFlags::None;
+		float                  SampleRate  = 48000.0f;
+		int32                  NumChannels = 1;
+		int32                  NumSamples  = 0;
+		int32                  ParamsBytes = 0;
+	};
+
+	// A block of a loaded capture, pointing into the file data
+	struct FBlockCaptureRecord
+	{
+		const FBlockCaptureHeader* Header = nullptr;
+		const void*                Params = nullptr;
+		const float*               Samples = nullptr;
+	};
+
+	// Records the input blocks and the parameters of every FSaturation and FGain instance, from whatever thread processes them,
+	// so production workloads can be replayed offline (au.DSPCollection.Capture.Replay) with the exact signals and automation.
+	// The blocks go to a preallocated buffer: writers reserve their record with a single atomic add and never wait or allocate.
+	// The capture stops after the requested time or when the buffer is full, and the buffer is saved from the game thread to
+	// Saved/Profiling/DSPCollection. The DSP state at the start of the capture (smoothers, filters, hysteresis) isn't recorded,
+	// the replay starts every instance from a fresh one.
+	class AUDIODSPCOLLECTION_API FBlockCapture
+	{
+	public:
+		static constexpr uint32 RecordMagic = 0x4B4C4244; // "DBLK"
+
+		// Every thread, once per block
+		static bool IsCapturing() { return bCapturing.load(std::memory_order_relaxed); }
+
+		// Called from Init of the captured processors
+		static uint64 NewInstanceId();
+
+		// Copies the block before it is processed, the buffer may be processed in place
+		static void CaptureBlock(const EBlockCaptureProcessor InProcessor, const uint64 InInstanceId, const float InSampleRate, const int32 InNumChannels, const EBlockCaptureFlags InFlags,
+								 const void* InParams, const int32 InParamsBytes, const float* InBuffer, const int32 InNumSamples);
+
+		// Same for one buffer per channel, adds EBlockCaptureFlags::Planar
+		static void CapturePlanarBlock(const EBlockCaptureProcessor InProcessor, const uint64 InInstanceId, const float InSampleRate, const EBlockCaptureFlags InFlags,
+								   const void* InParams, const int32 InParamsBytes, const float* const* InBuffers, const int32 InNumChannels, const int32 InNumFrames);
+
+		// Game thread. Returns false if a capture is already running
+		static bool Start(const float InNumSeconds, const int32 InMaxMegabytes);
+
+		// Game thread. Saves what has been captured so far
+		static void Stop();
+
+		// Reads a saved capture, OutRecords point into OutData
+		static bool LoadFile(const FString& InPath, TArray<uint8>& OutData, TArray<FBlockCaptureRecord>& OutRecords);
+
+	private:
+		// Reserves the record and writes everything but the samples, nullptr when the capture is over.
+		// A record that was begun must be ended, Finish waits for the writers in between
+		static uint8* BeginRecord(const FBlockCaptureHeader& InHeader, const void* InParams);
+		static void   EndRecord(uint8* InRecord);
+
+		static bool Tick(float InDeltaTime);
+		static void Finish();
+
+		static std::atomic<bool> bCapturing;
+	};
+}
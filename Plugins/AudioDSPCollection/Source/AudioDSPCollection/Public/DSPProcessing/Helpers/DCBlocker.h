@@ -0,0 +1,234 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "DSPProcessing/Helpers/AudioUtils.h"
+#include "DSPProcessing/Helpers/ParamSmoother.h"
+
+namespace DSPProcessing
+{
+	// One-pole DC blocking high-pass filter: y[n] = x[n] - x[n-1] + R * y[n-1]
+	// Processes interleaved buffers one vector (4 samples) at a time so it can be fused into the output stage of other processors.
+	class AUDIODSPCOLLECTION_API FDCBlocker
+	{
+	public:
+		void Init(const float InSampleRate, const int32 InNumChannels);
+		void SetNumChannels(const int32 InNumChannels);
+
+		void SetEnabled(const bool bInEnabled);
+		void SetCutoffFrequency(const float InCutoffFrequency);
+
+		void Reset();
+
+		SIZE_T GetAllocatedSize() const;
+
+		// Returns false when the filter is fully disabled and can be skipped for the whole buffer.
+		// Must be called at the start of every interleaved buffer.
+		FORCEINLINE bool BeginBuffer();
+
+		FORCEINLINE VectorRegister4Float ProcessVector(const VectorRegister4Float& In);
+
+	private:
+		enum class EChannelLayout : uint8
+		{
+			Mono,
+			Stereo,
+			MultipleOfFour,
+			Generic
+		};
+
+		void UpdateCoefficients(const float InCutoffFrequency);
+
+		FORCEINLINE VectorRegister4Float ProcessMono(const VectorRegister4Float& In);
+		FORCEINLINE VectorRegister4Float ProcessStereo(const VectorRegister4Float& In);
+		FORCEINLINE VectorRegister4Float ProcessMultipleOfFour(const VectorRegister4Float& In);
+		FORCEINLINE VectorRegister4Float ProcessGeneric(const VectorRegister4Float& In);
+
+		ParamSmootherLinear EnableParamSmoother; // Linear so the crossfade ends exactly on 0 or 1
+		ParamSmootherLPF CutoffParamSmoother;
+
+		float SampleRate      = 48000.0f;
+		float CutoffFrequency = 0.0f;
+		float R               = 0.0f;
+		float EnableAmount    = 0.0f;
+		bool  bEnabled        = false;
+		bool  bNeedsReset     = true;
+
+		int32 NumChannels  = 1;
+		int32 NumGroups    = 0;
+		int32 GroupIndex   = 0;
+		int32 ChannelIndex = 0;
+
+		EChannelLayout ChannelLayout = EChannelLayout::Mono;
+
+		// Block-parallel coefficients for the Mono/Stereo layouts, where several samples of the same channel share a vector
+		VectorRegister4Float VR;
+		VectorRegister4Float VRPowsMono;   // [R, R^2, R^3, R^4]
+		VectorRegister4Float VRPowsStereo; // [R, R,   R^2, R^2]
+		VectorRegister4Float VCol0;        // [1, R,   R^2, R^3]
+		VectorRegister4Float VCol1;        // [0, 1,   R,   R^2]
+		VectorRegister4Float VCol2;        // [0, 0,   1,   R  ]
+		VectorRegister4Float VCol3;        // [0, 0,   0,   1  ]
+
+		VectorRegister4Float XPrev;
+		VectorRegister4Float YPrev;
+
+		// Per channel state for the MultipleOfFour (one vector per 4 channels) and Generic (one float per channel) layouts
+		TArray<float, TAlignedHeapAllocator<16>> XPrevStates;
+		TArray<float, TAlignedHeapAllocator<16>> YPrevStates;
+	};
+
+	FORCEINLINE bool FDCBlocker::BeginBuffer()
+	{
+		GroupIndex   = 0;
+		ChannelIndex = 0;
+
+		if (!bEnabled && EnableAmount == 0.0f)
+		{
+			bNeedsReset = true;
+			return false;
+		}
+
+		if (bNeedsReset)
+		{
+			Reset();
+		}
+
+		return true;
+	}
+
+	FORCEINLINE VectorRegister4Float FDCBlocker::ProcessVector(const VectorRegister4Float& In)
+	{
+		const float CurrentCutoff = CutoffParamSmoother.GetValue();
+
+		if (CurrentCutoff != CutoffFrequency)
+		{
+			UpdateCoefficients(CurrentCutoff);
+		}
+
+		EnableAmount = EnableParamSmoother.GetValue();
+
+		VectorRegister4Float Out;
+
+		switch (ChannelLayout)
+		{
+			default:
+			case EChannelLayout::Mono:
+				Out = ProcessMono(In);
+				break;
+			case EChannelLayout::Stereo:
+				Out = ProcessStereo(In);
+				break;
+			case EChannelLayout::MultipleOfFour:
+				Out = ProcessMultipleOfFour(In);
+				break;
+			case EChannelLayout::Generic:
+				Out = ProcessGeneric(In);
+				break;
+		}
+
+		if (EnableAmount == 1.0f)
+		{
+			return Out;
+		}
+
+		//Out = In + Enable * (Out - In);
+		const VectorRegister4Float VEnable = VectorLoadFloat1(&EnableAmount);
+		return VectorMultiplyAdd(VEnable, VectorSubtract(Out, In), In);
+	}
+
+	FORCEINLINE VectorRegister4Float FDCBlocker::ProcessMono(const VectorRegister4Float& In)
+	{
+		// In = [x0, x1, x2, x3], all from the same channel, so the recursion is unrolled over the 4 lanes:
+		// y0 = R   * yPrev + d0
+		// y1 = R^2 * yPrev + R   * d0 + d1
+		// y2 = R^3 * yPrev + R^2 * d0 + R   * d1 + d2
+		// y3 = R^4 * yPrev + R^3 * d0 + R^2 * d1 + R * d2 + d3
+
+		//[xPrev, x0, x1, x2]
+		const VectorRegister4Float XPrev_X0_X0 = VectorShuffle(XPrev, In, 3, 3, 0, 0);
+		const VectorRegister4Float XShifted    = VectorShuffle(XPrev_X0_X0, In, 1, 2, 1, 2);
+
+		//d[n] = x[n] - x[n-1]
+		const VectorRegister4Float D = VectorSubtract(In, XShifted);
+
+		VectorRegister4Float Out = VectorMultiply(VRPowsMono, VectorReplicate(YPrev, 3));
+		Out = VectorMultiplyAdd(VectorReplicate(D, 0), VCol0, Out);
+		Out = VectorMultiplyAdd(VectorReplicate(D, 1), VCol1, Out);
+		Out = VectorMultiplyAdd(VectorReplicate(D, 2), VCol2, Out);
+		Out = VectorMultiplyAdd(VectorReplicate(D, 3), VCol3, Out);
+
+		XPrev = In;
+		YPrev = Out;
+
+		return Out;
+	}
+
+	FORCEINLINE VectorRegister4Float FDCBlocker::ProcessStereo(const VectorRegister4Float& In)
+	{
+		// In = [L0, R0, L1, R1]
+		// y0 = R   * yPrevL + d0
+		// y1 = R   * yPrevR + d1
+		// y2 = R^2 * yPrevL + R * d0 + d2
+		// y3 = R^2 * yPrevR + R * d1 + d3
+
+		//[xPrevL, xPrevR, L0, R0]
+		const VectorRegister4Float XShifted = VectorShuffle(XPrev, In, 2, 3, 0, 1);
+
+		//d[n] = x[n] - x[n-1]
+		const VectorRegister4Float D = VectorSubtract(In, XShifted);
+
+		//[0, 0, d0, d1]
+		const VectorRegister4Float DShifted = VectorShuffle(AudioUtils::VZeros, D, 0, 0, 0, 1);
+
+		//[yPrevL, yPrevR, yPrevL, yPrevR]
+		const VectorRegister4Float YPrevLR = VectorShuffle(YPrev, YPrev, 2, 3, 2, 3);
+
+		VectorRegister4Float Out = VectorMultiplyAdd(VRPowsStereo, YPrevLR, D);
+		Out = VectorMultiplyAdd(VR, DShifted, Out);
+
+		XPrev = In;
+		YPrev = Out;
+
+		return Out;
+	}
+
+	FORCEINLINE VectorRegister4Float FDCBlocker::ProcessMultipleOfFour(const VectorRegister4Float& In)
+	{
+		// Every lane is a different channel, so each vector is a plain one-pole step
+		float* XPrevPtr = &XPrevStates[GroupIndex * 4];
+		float* YPrevPtr = &YPrevStates[GroupIndex * 4];
+
+		const VectorRegister4Float XPrevGroup = VectorLoadAligned(XPrevPtr);
+		const VectorRegister4Float YPrevGroup = VectorLoadAligned(YPrevPtr);
+
+		//y[n] = x[n] - x[n-1] + R * y[n-1]
+		const VectorRegister4Float Out = VectorMultiplyAdd(VR, YPrevGroup, VectorSubtract(In, XPrevGroup));
+
+		VectorStoreAligned(In,  XPrevPtr);
+		VectorStoreAligned(Out, YPrevPtr);
+
+		GroupIndex = (GroupIndex + 1 == NumGroups) ? 0 : GroupIndex + 1;
+
+		return Out;
+	}
+
+	FORCEINLINE VectorRegister4Float FDCBlocker::ProcessGeneric(const VectorRegister4Float& In)
+	{
+		// Channel counts such as 3, 5 or 6 don't map onto lanes, fall back to a per sample recursion
+		AlignedFloat4 Out_Float4(In);
+
+		for (int32 j = 0; j < 4; ++j)
+		{
+			const float X = Out_Float4[j];
+			const float Y = X - XPrevStates[ChannelIndex] + R * YPrevStates[ChannelIndex];
+
+			XPrevStates[ChannelIndex] = X;
+			YPrevStates[ChannelIndex] = Y;
+			Out_Float4[j]             = Y;
+
+			ChannelIndex = (ChannelIndex + 1 == NumChannels) ? 0 : ChannelIndex + 1;
+		}
+
+		return Out_Float4.ToVectorRegister();
+	}
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "DSPProcessing/Helpers/AudioUtils.h"
+#include "DSPProcessing/Helpers/VectorBiquad.h"
+
+namespace DSPProcessing
+{
+	enum class AUDIODSPCOLLECTION_API EEmphasisFilterType : int32
+	{
+		Off = 0,
+		LowCut,
+		HighCut,
+		LowShelf,
+		HighShelf,
+		Peak
+	};
+
+	struct FEmphasisBand
+	{
+		EEmphasisFilterType Type = EEmphasisFilterType::Off;
+		float Frequency          = 1000.0f;
+		float GainDb             = 0.0f; // Shelves and peak only
+		float Q                  = 0.707f;
+
+		bool operator==(const FEmphasisBand& Other) const
+		{
+			return Type == Other.Type && Frequency == Other.Frequency && GainDb == Other.GainDb && Q == Other.Q;
+		}
+	};
+
+	// Cascade of up to MaxNumBands biquads (TDF-II) used to shape the signal before and after a waveshaper.
+	// Processes interleaved buffers one vector (4 samples) at a time so it can be fused into the saturation kernels, like FDCBlocker.
+	// A band change ramps the coefficients linearly from the current ones over the smoothing time, Off being the identity biquad,
+	// so type changes morph as well. Bands that are Off once the ramp is over cost nothing.
+	class AUDIODSPCOLLECTION_API FEmphasisFilter
+	{
+	public:
+		static constexpr int32 MaxNumBands = 2;
+
+		void Init(const float InSampleRate, const int32 InNumChannels);
+		void SetNumChannels(const int32 InNumChannels);
+
+		void SetBand(const int32 InBandIndex, const FEmphasisBand& InBand);
+
+		void Reset();
+
+		SIZE_T GetAllocatedSize() const;
+
+		// Returns false when every band is Off and the filter can be skipped for the whole buffer.
+		// Must be called at the start of every interleaved buffer.
+		FORCEINLINE bool BeginBuffer();
+
+		FORCEINLINE VectorRegister4Float ProcessVector(const VectorRegister4Float& In);
+
+	private:
+		enum class EChannelLayout : uint8
+		{
+			Mono,
+			Stereo,
+			MultipleOfFour,
+			Generic
+		};
+
+		// Every output and the state at the end of the vector are linear in the inputs and the state at the start of it.
+		// The Mono/Stereo layouts keep one channel's consecutive samples in a vector, so the 4 (Mono) or 2 (Stereo) steps
+		// of the recursion are unrolled into these columns: Out = sum(Input * OutX) + Z1 * OutZ1 + Z2 * OutZ2, same for the state.
+		struct FBandCoefficients
+		{
+			VectorRegister4Float OutX[4];
+			VectorRegister4Float OutZ1;
+			VectorRegister4Float OutZ2;
+			VectorRegister4Float StateX[4];
+			VectorRegister4Float StateZ1;
+			VectorRegister4Float StateZ2;
+
+			// MultipleOfFour, the same biquad in every lane
+			FVectorBiquadCoefficients Lanes;
+		};
+
+		FBiquadCoefficients MakeCoefficients(const FEmphasisBand& InBand) const;
+
+		// Rebuilds the layout specific coefficients of a band from CurrentCoefficients
+		void UpdateBandCoefficients(const int32 InBandIndex);
+
+		void ResetBand(const int32 InBandIndex);
+
+		// Steps the coefficient ramp by one vector
+		void AdvanceRamp();
+
+		FORCEINLINE VectorRegister4Float ProcessMono(const VectorRegister4Float& In);
+		FORCEINLINE VectorRegister4Float ProcessStereo(const VectorRegister4Float& In);
+		FORCEINLINE VectorRegister4Float ProcessMultipleOfFour(const VectorRegister4Float& In);
+		FORCEINLINE VectorRegister4Float ProcessGeneric(const VectorRegister4Float& In);
+
+		FEmphasisBand       Bands[MaxNumBands];
+		FBiquadCoefficients StartCoefficients[MaxNumBands];
+		FBiquadCoefficients TargetCoefficients[MaxNumBands];
+		FBiquadCoefficients CurrentCoefficients[MaxNumBands];
+		FBandCoefficients   BandCoefficients[MaxNumBands];
+		bool                bBandActive[MaxNumBands] = { false, false };
+
+		float SampleRate    = 48000.0f;
+		float RampAlpha     = 1.0f;
+		float RampIncrement = 1.0f; // Per vector, so the ramp takes the same time whatever the channel count
+		bool  bRamping      = false;
+		bool  bNeedsReset   = true;
+
+		int32 NumChannels  = 0;
+		int32 NumGroups    = 0;
+		int32 GroupIndex   = 0;
+		int32 ChannelIndex = 0;
+
+		EChannelLayout ChannelLayout = EChannelLayout::Mono;
+
+		// Mono: [Z1, Z2, 0, 0], Stereo: [Z1L, Z1R, Z2L, Z2R]
+		VectorRegister4Float BandStates[MaxNumBands];
+
+		// MultipleOfFour: [Band][Group], Generic: [Band][Channel][Z1, Z2]
+		TArray<FVectorBiquadState> GroupStates;
+		TArray<float, TAlignedHeapAllocator<16>> ChannelStates;
+	};
+
+	FORCEINLINE bool FEmphasisFilter::BeginBuffer()
+	{
+		GroupIndex   = 0;
+		ChannelIndex = 0;
+
+		if (!bBandActive[0] && !bBandActive[1])
+		{
+			bNeedsReset = true;
+			return false;
+		}
+
+		if (bNeedsReset)
+		{
+			Reset();
+		}
+
+		return true;
+	}
+
+	FORCEINLINE VectorRegister4Float FEmphasisFilter::ProcessVector(const VectorRegister4Float& In)
+	{
+		if (bRamping)
+		{
+			AdvanceRamp();
+		}
+
+		switch (ChannelLayout)
+		{
+			default:
+			case EChannelLayout::Mono:
+				return ProcessMono(In);
+			case EChannelLayout::Stereo:
+				return ProcessStereo(In);
+			case EChannelLayout::MultipleOfFour:
+				return ProcessMultipleOfFour(In);
+			case EChannelLayout::Generic:
+				return ProcessGeneric(In);
+		}
+	}
+
+	FORCEINLINE VectorRegister4Float FEmphasisFilter::ProcessMono(const VectorRegister4Float& In)
+	{
+		// In = [x0, x1, x2, x3], all from the same channel
+		VectorRegister4Float Out = In;
+
+		for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+		{
+			if (!bBandActive[BandIndex])
+			{
+				continue;
+			}
+
+			const FBandCoefficients& Coefs = BandCoefficients[BandIndex];
+			const VectorRegister4Float State = BandStates[BandIndex];
+
+			const VectorRegister4Float X0 = VectorReplicate(Out, 0);
+			const VectorRegister4Float X1 = VectorReplicate(Out, 1);
+			const VectorRegister4Float X2 = VectorReplicate(Out, 2);
+			const VectorRegister4Float X3 = VectorReplicate(Out, 3);
+			const VectorRegister4Float Z1 = VectorReplicate(State, 0);
+			const VectorRegister4Float Z2 = VectorReplicate(State, 1);
+
+			VectorRegister4Float NewState = VectorMultiply(X0, Coefs.StateX[0]);
+			NewState = VectorMultiplyAdd(X1, Coefs.StateX[1], NewState);
+			NewState = VectorMultiplyAdd(X2, Coefs.StateX[2], NewState);
+			NewState = VectorMultiplyAdd(X3, Coefs.StateX[3], NewState);
+			NewState = VectorMultiplyAdd(Z1, Coefs.StateZ1,   NewState);
+			NewState = VectorMultiplyAdd(Z2, Coefs.StateZ2,   NewState);
+
+			Out = VectorMultiply(X0, Coefs.OutX[0]);
+			Out = VectorMultiplyAdd(X1, Coefs.OutX[1], Out);
+			Out = VectorMultiplyAdd(X2, Coefs.OutX[2], Out);
+			Out = VectorMultiplyAdd(X3, Coefs.OutX[3], Out);
+			Out = VectorMultiplyAdd(Z1, Coefs.OutZ1,   Out);
+			Out = VectorMultiplyAdd(Z2, Coefs.OutZ2,   Out);
+
+			BandStates[BandIndex] = NewState;
+		}
+
+		return Out;
+	}
+
+	FORCEINLINE VectorRegister4Float FEmphasisFilter::ProcessStereo(const VectorRegister4Float& In)
+	{
+		// In = [L0, R0, L1, R1], the columns hold the same coefficient for L and R
+		VectorRegister4Float Out = In;
+
+		for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+		{
+			if (!bBandActive[BandIndex])
+			{
+				continue;
+			}
+
+			const FBandCoefficients& Coefs = BandCoefficients[BandIndex];
+			const VectorRegister4Float State = BandStates[BandIndex];
+
+			const VectorRegister4Float X0 = VectorSwizzle(Out, 0, 1, 0, 1);     //[L0,  R0,  L0,  R0 ]
+			const VectorRegister4Float X1 = VectorSwizzle(Out, 2, 3, 2, 3);     //[L1,  R1,  L1,  R1 ]
+			const VectorRegister4Float Z1 = VectorSwizzle(State, 0, 1, 0, 1);   //[Z1L, Z1R, Z1L, Z1R]
+			const VectorRegister4Float Z2 = VectorSwizzle(State, 2, 3, 2, 3);   //[Z2L, Z2R, Z2L, Z2R]
+
+			VectorRegister4Float NewState = VectorMultiply(X0, Coefs.StateX[0]);
+			NewState = VectorMultiplyAdd(X1, Coefs.StateX[1], NewState);
+			NewState = VectorMultiplyAdd(Z1, Coefs.StateZ1,   NewState);
+			NewState = VectorMultiplyAdd(Z2, Coefs.StateZ2,   NewState);
+
+			Out = VectorMultiply(X0, Coefs.OutX[0]);
+			Out = VectorMultiplyAdd(X1, Coefs.OutX[1], Out);
+			Out = VectorMultiplyAdd(Z1, Coefs.OutZ1,   Out);
+			Out = VectorMultiplyAdd(Z2, Coefs.OutZ2,   Out);
+
+			BandStates[BandIndex] = NewState;
+		}
+
+		return Out;
+	}
+
+	FORCEINLINE VectorRegister4Float FEmphasisFilter::ProcessMultipleOfFour(const VectorRegister4Float& In)
+	{
+		// Every lane is a different channel, so each vector is a plain biquad step
+		VectorRegister4Float Out = In;
+
+		for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+		{
+			if (bBandActive[BandIndex])
+			{
+				Out = AudioUtils::VectorBiquad(Out, BandCoefficients[BandIndex].Lanes, GroupStates[BandIndex * NumGroups + GroupIndex]);
+			}
+		}
+
+		GroupIndex = (GroupIndex + 1 == NumGroups) ? 0 : GroupIndex + 1;
+
+		return Out;
+	}
+
+	FORCEINLINE VectorRegister4Float FEmphasisFilter::ProcessGeneric(const VectorRegister4Float& In)
+	{
+		// Channel counts such as 3, 5 or 6 don't map onto lanes, fall back to a per sample recursion
+		AlignedFloat4 Out_Float4(In);
+
+		for (int32 j = 0; j < 4; ++j)
+		{
+			float X = Out_Float4[j];
+
+			for (int32 BandIndex = 0; BandIndex < MaxNumBands; ++BandIndex)
+			{
+				if (!bBandActive[BandIndex])
+				{
+					continue;
+				}
+
+				const FBiquadCoefficients& Coefs = CurrentCoefficients[BandIndex];
+				float* State = &ChannelStates[(BandIndex * NumChannels + ChannelIndex) * 2];
+
+				const float Y = Coefs.B0 * X + State[0];
+				State[0]      = Coefs.B1 * X - Coefs.A1 * Y + State[1];
+				State[1]      = Coefs.B2 * X - Coefs.A2 * Y;
+				X             = Y;
+			}
+
+			Out_Float4[j] = X;
+
+			ChannelIndex = (ChannelIndex + 1 == NumChannels) ? 0 : ChannelIndex + 1;
+		}
+
+		return Out_Float4.ToVectorRegister();
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+namespace DSPProcessing
+{
+	enum class AUDIODSPCOLLECTION_API EEnvelopeDetectorMode : int32
+	{
+		Peak = 0,
+		RMS
+	};
+
+	// Attack/release envelope follower that runs once per vector (4 interleaved samples), so it can be fused into other kernels.
+	// The 4 samples are detected together, which links the channels of an interleaved buffer.
+	// A vector holds 4 / NumChannels frames, so the step rate (and the coefficients) depend on the channel count of the buffer.
+	class AUDIODSPCOLLECTION_API FEnvelopeFollower
+	{
+	public:
+		void Init(const float InSampleRate, const int32 InNumChannels = 1);
+		void SetNumChannels(const int32 InNumChannels);
+
+		void SetDetectorMode(const EEnvelopeDetectorMode InDetectorMode);
+		void SetAttackTimeMs(const float InAttackTimeMs);
+		void SetReleaseTimeMs(const float InReleaseTimeMs);
+
+		void Reset();
+
+		// Returns the current envelope, linear [0, 1+]
+		FORCEINLINE float ProcessVector(const VectorRegister4Float& In);
+
+	private:
+		void UpdateCoefficients();
+
+		FORCEINLINE float UpdateEnvelope(const float InDetectedLevel);
+
+		float SampleRate    = 48000.0f;
+		int32 NumChannels   = 1;
+		float AttackTimeMs  = 10.0f;
+		float ReleaseTimeMs = 100.0f;
+
+		// One step per vector
+		float AttackCoefficient  = 0.0f;
+		float ReleaseCoefficient = 0.0f;
+
+		EEnvelopeDetectorMode DetectorMode = EEnvelopeDetectorMode::Peak;
+
+		// Peak: smoothed |x|, RMS: smoothed x^2
+		float EnvelopeState = 0.0f;
+	};
+
+	FORCEINLINE float FEnvelopeFollower::ProcessVector(const VectorRegister4Float& In)
+	{
+		// Sequential version
+		//float Detected = 0.0f;
+		//for (int32 j = 0; j < 4; ++j)
+		//{
+		//	  Detected = (DetectorMode == Peak) ? FMath::Max(Detected, FMath::Abs(In[j])) : Detected + 0.25f * In[j] * In[j];
+		//}
+		//
+		//const float Coefficient = (Detected > EnvelopeState) ? AttackCoefficient : ReleaseCoefficient;
+		//EnvelopeState = Detected + Coefficient * (EnvelopeState - Detected);
+		//
+		//return (DetectorMode == Peak) ? EnvelopeState : FMath::Sqrt(EnvelopeState);
+
+		// Vectorized detection
+		VectorRegister4Float Detected;
+
+		if (DetectorMode == EEnvelopeDetectorMode::Peak)
+		{
+			//Detected = Max(|x0|, |x1|, |x2|, |x3|);
+			const VectorRegister4Float Abs = VectorAbs(In);
+			Detected = VectorMax(Abs, VectorSwizzle(Abs, 2, 3, 0, 1));
+			Detected = VectorMax(Detected, VectorSwizzle(Detected, 1, 0, 3, 2));
+		}
+		else
+		{
+			//Detected = (x0^2 + x1^2 + x2^2 + x3^2) / 4;
+			Detected = VectorMultiply(VectorDot4(In, In), AudioUtils::VOneQuarter);
+		}
+
+		float DetectedLevel;
+		VectorStoreFloat1(Detected, &DetectedLevel);
+
+		return UpdateEnvelope(DetectedLevel);
+	}
+
+	FORCEINLINE float FEnvelopeFollower::UpdateEnvelope(const float InDetectedLevel)
+	{
+		//EnvelopeState = Detected + Coefficient * (EnvelopeState - Detected);
+		const float Coefficient = (InDetectedLevel > EnvelopeState) ? AttackCoefficient : ReleaseCoefficient;
+		EnvelopeState = InDetectedLevel + Coefficient * (EnvelopeState - InDetectedLevel);
+
+		return (DetectorMode == EEnvelopeDetectorMode::Peak) ? EnvelopeState : FMath::Sqrt(EnvelopeState);
+	}
+}
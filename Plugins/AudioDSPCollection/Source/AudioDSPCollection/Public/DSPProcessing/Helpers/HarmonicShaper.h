@@ -0,0 +1,75 @@
+#pragma once
+
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+namespace DSPProcessing
+{
+	// Polynomial waveshaper built from harmonic weights: f(x) = sum(Weight[k] * T_k(x)), T_k being the Chebyshev polynomials of the first kind,
+	// so a full scale sine (x = cos(wt), T_k(x) = cos(k*wt)) comes out with exactly Weight[k] of its k-th harmonic.
+	// The weights are turned into power basis coefficients only when they change, the curve itself is a vectorized Horner scheme
+	// with no transcendental. The input is clamped to [-1, 1], where the output holds no harmonic above MaxHarmonic.
+	class AUDIODSPCOLLECTION_API FHarmonicShaper
+	{
+	public:
+		static constexpr int32 MaxHarmonic = 8;
+
+		FHarmonicShaper();
+
+		void Init(const float InSampleRate, const int32 InNumChannels);
+		void SetNumChannels(const int32 InNumChannels);
+
+		// InHarmonic in [1, MaxHarmonic], 1 being the fundamental. A negative weight inverts the phase of that harmonic.
+		// The polynomial is linear in its coefficients, so a change ramps them over the smoothing time
+		void SetHarmonicWeight(const int32 InHarmonic, const float InWeight);
+
+		// Jumps to the target coefficients
+		void Reset();
+
+		// Fully wet output for (In + Bias) driven by Gain, like the SaturationUtils curves
+		FORCEINLINE VectorRegister4Float ProcessVector(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain);
+
+	private:
+		// Power basis coefficients of the weighted Chebyshev sum, without the constant term and scaled so the weights sum to 1 at most
+		void UpdateTargetCoefficients();
+
+		// Steps the coefficient ramp by one vector
+		void AdvanceRamp();
+
+		float Weights[MaxHarmonic + 1];             // [0] unused, the constant term is dropped so silence stays silent
+		float StartCoefficients[MaxHarmonic + 1];
+		float TargetCoefficients[MaxHarmonic + 1];
+		float CurrentCoefficients[MaxHarmonic + 1];
+
+		VectorRegister4Float Coefficients[MaxHarmonic + 1]; // CurrentCoefficients, replicated for Horner
+
+		int32 Degree       = 1; // Highest non zero coefficient, of the start or the target during a ramp
+		int32 TargetDegree = 1;
+
+		float SampleRate    = 48000.0f;
+		float RampAlpha     = 1.0f;
+		float RampIncrement = 1.0f; // Per vector, so the ramp takes the same time whatever the channel count
+		bool  bRamping      = false;
+	};
+
+	FORCEINLINE VectorRegister4Float FHarmonicShaper::ProcessVector(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+	{
+		if (bRamping)
+		{
+			AdvanceRamp();
+		}
+
+		//const float X = FMath::Clamp(Gain * In_Plus_Bias, -1.0f, 1.0f);
+		const VectorRegister4Float X = AudioUtils::VectorClampMinusOneToOne(VectorMultiply(In_Plus_Bias, VGain));
+
+		//float Out = (((C[N] * X + C[N - 1]) * X + ...) * X + C[0];
+		VectorRegister4Float Out = Coefficients[Degree];
+
+		for (int32 k = Degree - 1; k >= 0; --k)
+		{
+			Out = VectorMultiplyAdd(Out, X, Coefficients[k]);
+		}
+
+		//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+		return AudioUtils::VectorClampMinusOneToOne(Out);
+	}
+}
@@ -2,28 +2,107 @@
 
 #include "HAL/Platform.h"
 
+#include <type_traits>
+
 namespace DSPProcessing
 {
+	// All the smoothers share the same interface:
+	// - Init takes the transition time and the rate at which GetValue is called: SampleRate when called once per frame,
+	//   AudioUtils::GetVectorRate (SampleRate * NumChannels / 4) when called once per vector of an interleaved buffer
+	// - The first SetNewParamValue after Init jumps to the value
+	// - Once the target is reached the value snaps to it exactly and IsSettled returns true, so callers can take their static fast paths
+	// - No virtuals and no function pointers: the state is a few packed floats, trivially copyable, so thousands of instances stay cheap
+
+	// One-pole low-pass, snaps to the target once it is closer than -96dB
 	class AUDIODSPCOLLECTION_API ParamSmootherLPF
 	{
 	public:
-		ParamSmootherLPF();
-		virtual ~ParamSmootherLPF();
-
-		void Init(int32 InTransitionTimeInMs, float SampleRate);
+		void Init(float InTransitionTimeInMs, float SampleRate);
 		void SetNewParamValue(float InNewParamValue);
-		float GetValue();
+		void ResetParamValue(float InParamValue); // Jumps to InParamValue without smoothing
+
+		FORCEINLINE float GetValue()
+		{
+			return bIsSettled ? CurrentValue : SmoothedResult();
+		}
+
+		bool IsSettled() const;
+		float GetTargetValue() const;
+		float GetCurrentValue() const;
 
 	private:
 		float SmoothedResult();
-		float DirectResult();
 
 		float Step          = 0.0f;
 		float NewParamValue = 0.0f;
 		float CurrentValue  = 0.0f;
 		bool  FirstTime     = true;
+		bool  bIsSettled    = true;
+	};
+
+	// Linear ramp, reaches the target in exactly the transition time
+	class AUDIODSPCOLLECTION_API ParamSmootherLinear
+	{
+	public:
+		void Init(float InTransitionTimeInMs, float SampleRate);
+		void SetNewParamValue(float InNewParamValue);
+		void ResetParamValue(float InParamValue); // Jumps to InParamValue without smoothing
+
+		FORCEINLINE float GetValue()
+		{
+			return bIsSettled ? CurrentValue : SmoothedResult();
+		}
+
+		bool IsSettled() const;
+		float GetTargetValue() const;
+		float GetCurrentValue() const;
+
+	private:
+		float SmoothedResult();
+
+		int32 TransitionTimeInSteps = 1;
+		int32 RemainingSteps        = 0;
+		float Delta                 = 0.0f;
+		float NewParamValue         = 0.0f;
+		float CurrentValue          = 0.0f;
+		bool  FirstTime             = true;
+		bool  bIsSettled            = true;
+	};
+
+	// One-pole response evaluated once per block, linearly interpolated inside the block.
+	// Call PrepareBlock before each block, then GetValue is a single add. The block lasts InNumValues * InStepsPerValue steps of the Init rate,
+	// so one instance can be read once per frame, once per vector of an interleaved buffer or once per 4 frames of planar buffers.
+	class AUDIODSPCOLLECTION_API ParamSmootherBlock
+	{
+	public:
+		void Init(float InTransitionTimeInMs, float SampleRate);
+		void SetNewParamValue(float InNewParamValue);
+		void ResetParamValue(float InParamValue); // Jumps to InParamValue without smoothing
+		void PrepareBlock(int32 InNumValues, float InStepsPerValue = 1.0f);
 
-		// Function pointer that points to either SmoothedResult or DirectResult
-		float (ParamSmootherLPF::* SmoothedValueFuncPtr)();
+		FORCEINLINE float GetValue()
+		{
+			CurrentValue += Delta;
+			return CurrentValue;
+		}
+
+		// True when the whole prepared block stays at the target
+		bool IsSettled() const;
+		float GetTargetValue() const;
+		float GetCurrentValue() const; // Value at the end of the last prepared block
+
+	private:
+		float OneMinusStep  = 0.0f;
+		float Delta         = 0.0f;
+		float NewParamValue = 0.0f;
+		float CurrentValue  = 0.0f;
+		float BlockEndValue = 0.0f;
+		bool  FirstTime     = true;
+		bool  bIsSettled    = true;
 	};
+
+	// Copied by value along with the helpers that own them (e.g. the FDCBlocker of each FSaturation channel partition)
+	static_assert(std::is_trivially_copyable_v<ParamSmootherLPF>,    "ParamSmootherLPF must stay trivially copyable");
+	static_assert(std::is_trivially_copyable_v<ParamSmootherLinear>, "ParamSmootherLinear must stay trivially copyable");
+	static_assert(std::is_trivially_copyable_v<ParamSmootherBlock>,  "ParamSmootherBlock must stay trivially copyable");
 }
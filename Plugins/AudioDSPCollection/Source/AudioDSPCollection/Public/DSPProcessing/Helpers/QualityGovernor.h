@@ -0,0 +1,61 @@
+#pragma once
+
+#include "HAL/PlatformTime.h"
+
+namespace DSPProcessing
+{
+	// Quality steps, each one keeps the reductions of the previous ones
+	enum class AUDIODSPCOLLECTION_API EQualityLevel : int32
+	{
+		Full = 0,
+		ReducedOversampling, // TapeHysteresis runs without oversampling
+		ReducedPrecision,    // TapeHysteresis runs with the RK2 solver
+		Memoryless,          // TapeHysteresis is replaced by the memoryless Tape curve (crossfaded like a type change)
+		Count
+	};
+
+	// Plugin-wide CPU budget governor. FSaturation and FGain time their processing, from every thread, into one measurement window.
+	// At the end of each window the processing time is compared against the budget (percentage of the window, i.e. of real time):
+	// over budget the quality goes down one step, and it comes back up one step once the load has stayed under the restore threshold
+	// for a few windows, so it doesn't bounce between two levels. Every transition is logged (from the game thread).
+	// The instances read the level at the start of their block, a degraded level never touches the presets.
+	// Opt-in, see the au.DSPCollection.QualityGovernor.* CVars
+	class AUDIODSPCOLLECTION_API FQualityGovernor
+	{
+	public:
+		// Full when the governor is disabled
+		static EQualityLevel GetQualityLevel();
+
+		static const TCHAR* GetQualityLevelName(const EQualityLevel InQualityLevel);
+
+		// Adds the time spent in its scope to the current window, and closes the window when it's over
+		class FScopedMeasure
+		{
+		public:
+			FScopedMeasure()
+				: StartCycles(FPlatformTime::Cycles64())
+			{
+			}
+
+			~FScopedMeasure()
+			{
+				AddProcessingCycles(StartCycles, FPlatformTime::Cycles64());
+			}
+
+		private:
+			uint64 StartCycles;
+		};
+
+		// Pins Full quality and stops measuring while it's alive. For the benchmarks and offline renders, that run faster than real time on purpose
+		class FScopedDisable
+		{
+		public:
+			FScopedDisable();
+			~FScopedDisable();
+		};
+
+	private:
+		static void AddProcessingCycles(const uint64 InStartCycles, const uint64 InEndCycles);
+		static void CloseWindow(const uint64 InWindowCycles, const uint64 InProcessingCycles);
+	};
+}
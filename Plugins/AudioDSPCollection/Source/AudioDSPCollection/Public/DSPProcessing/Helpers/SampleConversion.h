@@ -0,0 +1,18 @@
+#pragma once
+
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+namespace DSPProcessing
+{
+	// PCM <-> float conversions for file I/O, little endian, any number of samples.
+	// Float to PCM clamps to [-1, 1] and rounds to the nearest integer.
+	namespace SampleConversion
+	{
+		AUDIODSPCOLLECTION_API void Pcm16ToFloat(const int16* InBuffer, float* OutBuffer, const int32 InNumSamples);
+		AUDIODSPCOLLECTION_API void FloatToPcm16(const float* InBuffer, int16* OutBuffer, const int32 InNumSamples);
+
+		// Packed 3 bytes per sample
+		AUDIODSPCOLLECTION_API void Pcm24ToFloat(const uint8* InBuffer, float* OutBuffer, const int32 InNumSamples);
+		AUDIODSPCOLLECTION_API void FloatToPcm24(const float* InBuffer, uint8* OutBuffer, const int32 InNumSamples);
+	}
+}
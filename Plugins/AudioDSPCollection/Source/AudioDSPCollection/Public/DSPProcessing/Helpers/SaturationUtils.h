@@ -0,0 +1,283 @@
+#pragma once
+
+#include "DSPProcessing/Saturation.h"
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+namespace DSPProcessing
+{
+	namespace SaturationUtils
+	{
+		FORCEINLINE float FastTanh(const float x)
+		{
+			const float AbsX = FMath::Abs(x);
+			const float XSqr = x * x;
+
+			const float Z = x * (1.0f + AbsX + (1.05622909486427f + 0.215166815390934f * XSqr * AbsX) * XSqr);
+
+			return Z / (1.02718982441289f + FMath::Abs(Z));
+		}
+
+		// Vectorized functions
+		FORCEINLINE VectorRegister4Float VectorTanh(const VectorRegister4Float& X)
+		{
+		#if UE_PLATFORM_MATH_USE_SVML
+			return _mm_tanh_ps(X);
+		#else
+			AlignedFloat4 Floats(X);
+			Floats[0] = FastTanh(Floats[0]);
+			Floats[1] = FastTanh(Floats[1]);
+			Floats[2] = FastTanh(Floats[2]);
+			Floats[3] = FastTanh(Floats[3]);
+			return Floats.ToVectorRegister();
+		#endif
+		}
+
+		// Saturation graphs https://www.desmos.com/calculator/12d0ysis1g
+		// Every curve takes (In + Bias) and Gain and returns the fully wet signal, Mix and OutLevel are applied by the caller
+		FORCEINLINE VectorRegister4Float VectorTape(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Gain_x_In = Gain * In_Plus_Bias;
+			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+
+			//float Out = Gain_x_In / FMath::Sqrt(Gain_x_In * Gain_x_In + 1.0f);
+			const VectorRegister4Float Out = VectorMultiplyAdd(Gain_x_In, Gain_x_In, AudioUtils::VOnes);
+			return VectorMultiply(Gain_x_In, VectorReciprocalSqrt(Out));
+		}
+
+		FORCEINLINE VectorRegister4Float VectorTape2(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Gain_x_In = Gain * In_Plus_Bias;
+			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+
+			//float Out = FMath::Atan(Gain_x_In) / FMath::Atan(Gain);
+			const VectorRegister4Float OneOverAtanGain = VectorReciprocal(VectorATan(VGain));
+			VectorRegister4Float Out = VectorATan(Gain_x_In);
+			Out = VectorMultiply(Out, OneOverAtanGain);
+
+			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Out);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorOverdrive(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Gain_x_In = Gain * In_Plus_Bias;
+			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+
+			//const float Gain_x_ClampIn = Gain * FMath::Clamp(In_Plus_Bias, -1.0f, 1.0f);
+			const VectorRegister4Float ClampIn        = AudioUtils::VectorClampMinusOneToOne(In_Plus_Bias);
+			const VectorRegister4Float Gain_x_ClampIn = VectorMultiply(VGain, ClampIn);
+
+			//const float Clamp_Gain_x_ClampIn = FMath::Clamp(Gain_x_ClampIn, -1.0f, 1.0f);
+			const VectorRegister4Float Clamp_Gain_x_ClampIn = AudioUtils::VectorClampMinusOneToOne(Gain_x_ClampIn);
+
+			//float Out = 0.5f * FMath::Clamp(Gain_x_In, -1.0f, 1.0f) * (3.0f - Clamp_Gain_x_ClampIn * Clamp_Gain_x_ClampIn);
+			const VectorRegister4Float Clamp_Gain_x_In                      = AudioUtils::VectorClampMinusOneToOne(Gain_x_In);
+			const VectorRegister4Float Clamp_Gain_x_ClampIn_Sqr             = VectorMultiply(Clamp_Gain_x_ClampIn, Clamp_Gain_x_ClampIn);
+			const VectorRegister4Float Three_Minus_Clamp_Gain_x_ClampIn_Sqr = VectorSubtract(AudioUtils::VThrees, Clamp_Gain_x_ClampIn_Sqr);
+
+			return VectorMultiply(AudioUtils::VOneHalf, VectorMultiply(Clamp_Gain_x_In, Three_Minus_Clamp_Gain_x_ClampIn_Sqr));
+		}
+
+		FORCEINLINE VectorRegister4Float VectorTube(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Gain_x_In = Gain * In_Plus_Bias;
+			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+
+			//float Out = (In_Plus_Bias > 0.0f) ? Gain_x_In : Gain_x_In * FMath::InvSqrt(Gain_x_In * Gain_x_In + 1.0f);
+			const VectorRegister4Float Gain_x_In_Sqr_Plus_One = VectorMultiplyAdd(Gain_x_In, Gain_x_In, AudioUtils::VOnes);
+			const VectorRegister4Float Gain_x_In_Over_Sqrt_Gain_x_In_Sqr_Plus_One = VectorMultiply(Gain_x_In, VectorReciprocalSqrt(Gain_x_In_Sqr_Plus_One));
+
+			const VectorRegister4Float Out = VectorSelect(VectorCompareGT(In_Plus_Bias, AudioUtils::VZeros), Gain_x_In, Gain_x_In_Over_Sqrt_Gain_x_In_Sqr_Plus_One);
+
+			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Out);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorTube2(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//float Out = FMath::Pow(FMath::Clamp(In_Plus_Bias, -1.0f, 1.0f) + 1.0f, Gain) - 1.0f;
+			const VectorRegister4Float Clamp_In_Plus_Bias_Plus_One = VectorAdd(AudioUtils::VectorClampMinusOneToOne(In_Plus_Bias), AudioUtils::VOnes);
+			const VectorRegister4Float Pow_Clamp_In_Plus_Bias_Plus_One_To_Gain = VectorPow(Clamp_In_Plus_Bias_Plus_One, VGain);
+			const VectorRegister4Float Out = VectorSubtract(Pow_Clamp_In_Plus_Bias_Plus_One_To_Gain, AudioUtils::VOnes);
+
+			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Out);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorDistortion(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Gain_x_In = Gain * In_Plus_Bias;
+			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+
+			//float Out = SaturationUtils::FastTanh(Gain_x_In) / SaturationUtils::FastTanh(Gain);
+			const VectorRegister4Float OneOverTanhGain = VectorReciprocal(VectorTanh(VGain));
+			VectorRegister4Float Out = VectorTanh(Gain_x_In);
+			Out = VectorMultiply(Out, OneOverTanhGain);
+
+			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Out);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorMetal(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Gain_x_In = Gain * In_Plus_Bias;
+			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+
+			//const float Abs_Clamp_Gain_x_In = FMath::Abs(FMath::Clamp(Gain_x_In, -1.0f, 1.0f));
+			const VectorRegister4Float Abs_Clamp_Gain_x_In = VectorAbs(AudioUtils::VectorClampMinusOneToOne(Gain_x_In));
+
+			//const float Two_Minus_Abs_Clamp_Gain_x_In = 2.0f - Abs_Clamp_Gain_x_In;
+			const VectorRegister4Float Two_Minus_Abs_Clamp_Gain_x_In = VectorSubtract(AudioUtils::VTwos, Abs_Clamp_Gain_x_In);
+
+			//const float Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In = Abs_Clamp_Gain_x_In * Two_Minus_Abs_Clamp_Gain_x_In;
+			const VectorRegister4Float Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In = VectorMultiply(Abs_Clamp_Gain_x_In, Two_Minus_Abs_Clamp_Gain_x_In);
+
+			//float Out = (In_Plus_Bias > 0.0f) ? Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In : -Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In;
+			return VectorSelect(VectorCompareLT(In_Plus_Bias, AudioUtils::VZeros), VectorNegate(Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In), Abs_Clamp_Gain_x_In_x_Two_Minus_Abs_Clamp_Gain_x_In);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorFuzz(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Gain_x_In = Gain * In_Plus_Bias;
+			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+
+			//const float Gain_x_In_Over_Abs_Gain_x_In = Gain_x_In / (FMath::Abs(Gain_x_In) + AudioUtils::Eps);
+			const VectorRegister4Float Gain_x_In_Over_Abs_Gain_x_In = VectorDivide(Gain_x_In, VectorAdd(VectorAbs(Gain_x_In), AudioUtils::VEps));
+
+			//float Out = -Gain_x_In_Over_Abs_Gain_x_In * (1.0f - FMath::Exp(Gain_x_In * Gain_x_In_Over_Abs_Gain_x_In));
+			const VectorRegister4Float Gain_x_Gain_x_In_Over_Abs_Gain_x_In = VectorMultiply(Gain_x_In, Gain_x_In_Over_Abs_Gain_x_In);
+			const VectorRegister4Float Exp_Gain_x_Gain_x_In_Over_Abs_Gain_x_In = VectorExp(Gain_x_Gain_x_In_Over_Abs_Gain_x_In);
+			const VectorRegister4Float One_Minus_Exp_Gain_x_Gain_x_In_Over_Abs_Gain_x_In = VectorSubtract(AudioUtils::VOnes, Exp_Gain_x_Gain_x_In_Over_Abs_Gain_x_In);
+			const VectorRegister4Float Out = VectorMultiply(VectorNegate(Gain_x_In_Over_Abs_Gain_x_In), One_Minus_Exp_Gain_x_Gain_x_In_Over_Abs_Gain_x_In);
+
+			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Out);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorHardClip(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Gain_x_In = Gain * In_Plus_Bias;
+			const VectorRegister4Float Gain_x_In = VectorMultiply(VGain, In_Plus_Bias);
+
+			//float Out = FMath::Clamp(Gain_x_In, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Gain_x_In);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorFoldback(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//const float Two_x_Gain = 2.0f * Gain;
+			const VectorRegister4Float Two_x_Gain = VectorMultiply(AudioUtils::VTwos, VGain);
+
+			//float Out = (In_Plus_Bias > Gain) ? Two_x_Gain - In_Plus_Bias
+			//									: (In_Plus_Bias < -Gain) ? -Two_x_Gain - In_Plus_Bias
+			//															 : In_Plus_Bias;
+			const VectorRegister4Float Two_x_Gain_Minus_In_Plus_Bias       = VectorSubtract(Two_x_Gain, In_Plus_Bias);
+			const VectorRegister4Float Minus_Two_x_Gain_Minus_In_Plus_Bias = VectorNegate(VectorAdd(Two_x_Gain, In_Plus_Bias));
+
+			VectorRegister4Float Out = VectorSelect(VectorCompareLT(In_Plus_Bias, VectorNegate(VGain)), Minus_Two_x_Gain_Minus_In_Plus_Bias, In_Plus_Bias);
+			Out = VectorSelect(VectorCompareGT(In_Plus_Bias, VGain), Two_x_Gain_Minus_In_Plus_Bias, Out);
+
+			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Out);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorHalfWaveRectifier(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//float Out = (In_Plus_Bias > 0.0f) ? In_Plus_Bias : 0.0f;
+			const VectorRegister4Float Out = VectorMax(In_Plus_Bias, AudioUtils::VZeros);
+
+			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Out);
+		}
+
+		FORCEINLINE VectorRegister4Float VectorFullWaveRectifier(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			//float Out = FMath::Abs(In_Plus_Bias);
+			const VectorRegister4Float Out = VectorAbs(In_Plus_Bias);
+
+			//Out = FMath::Clamp(Out, -1.0f, 1.0f);
+			return AudioUtils::VectorClampMinusOneToOne(Out);
+		}
+
+		template <ESaturationType SaturationTypeT>
+		FORCEINLINE VectorRegister4Float VectorSaturate(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			if constexpr      (SaturationTypeT == ESaturationType::Tape)              { return VectorTape(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::Tape2)             { return VectorTape2(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::Overdrive)         { return VectorOverdrive(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::Tube)              { return VectorTube(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::Tube2)             { return VectorTube2(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::Distortion)        { return VectorDistortion(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::Metal)             { return VectorMetal(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::Fuzz)              { return VectorFuzz(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::HardClip)          { return VectorHardClip(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::Foldback)          { return VectorFoldback(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::HalfWaveRectifier) { return VectorHalfWaveRectifier(In_Plus_Bias, VGain); }
+			else if constexpr (SaturationTypeT == ESaturationType::FullWaveRectifier) { return VectorFullWaveRectifier(In_Plus_Bias, VGain); }
+			else                                                                      { return VectorTape(In_Plus_Bias, VGain); } // TapeHysteresis is stateful, see FTapeHysteresis, Harmonic needs the weights of FHarmonicShaper and Custom its FSharedTransferCurve
+		}
+
+		// True for the curves that only depend on the current sample, the only ones the runtime VectorSaturate below can evaluate
+		FORCEINLINE bool IsMemoryless(const ESaturationType InSaturationType)
+		{
+			return InSaturationType != ESaturationType::TapeHysteresis && InSaturationType != ESaturationType::Harmonic && InSaturationType != ESaturationType::Custom;
+		}
+
+		// Runtime dispatch, used when the curve can change per lane (e.g. one band per lane). Callers must reject the types that aren't memoryless (see IsMemoryless)
+		FORCEINLINE VectorRegister4Float VectorSaturate(const ESaturationType InSaturationType, const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain)
+		{
+			switch (InSaturationType)
+			{
+				default:
+				case ESaturationType::Tape:              return VectorTape(In_Plus_Bias, VGain);
+				case ESaturationType::Tape2:             return VectorTape2(In_Plus_Bias, VGain);
+				case ESaturationType::Overdrive:         return VectorOverdrive(In_Plus_Bias, VGain);
+				case ESaturationType::Tube:              return VectorTube(In_Plus_Bias, VGain);
+				case ESaturationType::Tube2:             return VectorTube2(In_Plus_Bias, VGain);
+				case ESaturationType::Distortion:        return VectorDistortion(In_Plus_Bias, VGain);
+				case ESaturationType::Metal:             return VectorMetal(In_Plus_Bias, VGain);
+				case ESaturationType::Fuzz:              return VectorFuzz(In_Plus_Bias, VGain);
+				case ESaturationType::HardClip:          return VectorHardClip(In_Plus_Bias, VGain);
+				case ESaturationType::Foldback:          return VectorFoldback(In_Plus_Bias, VGain);
+				case ESaturationType::HalfWaveRectifier: return VectorHalfWaveRectifier(In_Plus_Bias, VGain);
+				case ESaturationType::FullWaveRectifier: return VectorFullWaveRectifier(In_Plus_Bias, VGain);
+				case ESaturationType::TapeHysteresis:    return VectorTape(In_Plus_Bias, VGain); // Stateful, rejected by the callers
+				case ESaturationType::Harmonic:          return VectorTape(In_Plus_Bias, VGain); // The weights live in FHarmonicShaper, rejected by the callers
+				case ESaturationType::Custom:            return VectorTape(In_Plus_Bias, VGain); // The curve lives in FSharedTransferCurve, rejected by the callers
+			}
+		}
+
+		// Maps a normalized [0, 1] gain to the internal gain range of each saturation type
+		FORCEINLINE float MapNormalizedGain(const ESaturationType InSaturationType, const float InNormalizedGain)
+		{
+			switch (InSaturationType)
+			{
+				default:
+				case ESaturationType::Tape:              return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 20.0f);
+				case ESaturationType::Tape2:             return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 0.000001f, 35.0f);
+				case ESaturationType::Overdrive:         return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 20.0f);
+				case ESaturationType::Tube:              return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 40.0f);
+				case ESaturationType::Tube2:             return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 45.0f);
+				case ESaturationType::Distortion:        return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 0.000001f, 80.0f);
+				case ESaturationType::Metal:             return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 100.0f);
+				case ESaturationType::Fuzz:              return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 0.5f, 35.0f);
+				case ESaturationType::HardClip:          return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 100.0f);
+				case ESaturationType::Foldback:          return InNormalizedGain;
+				case ESaturationType::HalfWaveRectifier: return InNormalizedGain; // Gain not used
+				case ESaturationType::FullWaveRectifier: return InNormalizedGain; // Gain not used
+				case ESaturationType::TapeHysteresis:    return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 20.0f);
+				case ESaturationType::Harmonic:          return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 4.0f); // Exact harmonic levels up to 1, clamped above
+				case ESaturationType::Custom:            return AudioUtils::MapFromNormalizedRange(InNormalizedGain, 1.0f, 20.0f); // Same as Tape, its fallback
+			}
+		}
+
+		// Maps a gain from the internal range of one saturation type to the same normalized position in the range of another one
+		FORCEINLINE float RemapGain(const ESaturationType InFromType, const ESaturationType InToType, const float InGain)
+		{
+			const float FromMin = MapNormalizedGain(InFromType, 0.0f);
+			const float FromMax = MapNormalizedGain(InFromType, 1.0f);
+
+			return MapNormalizedGain(InToType, (InGain - FromMin) / (FromMax - FromMin));
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+namespace DSPProcessing
+{
+	enum class AUDIODSPCOLLECTION_API ETapeHysteresisSolver : int32
+	{
+		RK2 = 0,
+		RK4
+	};
+
+	// Jiles-Atherton magnetic hysteresis (M = magnetization, H = magnetic field = input) solved with a fixed step Runge-Kutta method.
+	// The number of solver evaluations per frame is fixed (stages * oversampling), so the cost doesn't depend on the signal.
+	// Channels are processed in parallel, one lane per channel and one vector per group of 4 channels.
+	class AUDIODSPCOLLECTION_API FTapeHysteresis
+	{
+	public:
+		static constexpr int32 MaxOversampling = 4;
+
+		void Init(const float InSampleRate, const int32 InNumChannels);
+		void SetNumChannels(const int32 InNumChannels);
+
+		void SetSolver(const ETapeHysteresisSolver InSolver);
+		void SetOversampling(const int32 InOversampling);
+
+		void Reset();
+
+		// Hysteresis function evaluations per frame and per group of 4 channels
+		int32 GetSolverEvaluationsPerFrame() const;
+
+		SIZE_T GetAllocatedSize() const;
+
+		// Replaces every interleaved sample (H) with the normalized magnetization (M) [-1, 1]
+		void ProcessInterleaved(float* InOutBuffer, const int32 InNumSamples);
+
+	private:
+		struct FGroupState
+		{
+			VectorRegister4Float M  = AudioUtils::VZeros;
+			VectorRegister4Float H  = AudioUtils::VZeros;
+			VectorRegister4Float Hd = AudioUtils::VZeros; // dH/dt
+		};
+
+		template <ETapeHysteresisSolver SolverT>
+		void ProcessInterleavedWithSolver(float* InOutBuffer, const int32 InNumSamples);
+
+		template <ETapeHysteresisSolver SolverT>
+		FORCEINLINE VectorRegister4Float ProcessGroup(const VectorRegister4Float& InH, FGroupState& State) const;
+
+		void UpdateTimeStep();
+
+		float SampleRate   = 48000.0f;
+		int32 Oversampling = 1;
+		int32 NumChannels  = 1;
+		int32 NumGroups    = 1;
+
+		ETapeHysteresisSolver Solver = ETapeHysteresisSolver::RK4;
+
+		VectorRegister4Float VTimeStep;               // 1 / (SampleRate * Oversampling)
+		VectorRegister4Float VOversampledSampleRate;  // SampleRate * Oversampling
+		VectorRegister4Float VOneOverOversampling;
+
+		TArray<FGroupState> GroupStates;
+	};
+}
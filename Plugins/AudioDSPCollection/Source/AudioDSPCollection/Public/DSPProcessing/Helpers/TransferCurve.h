@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+namespace DSPProcessing
+{
+	// Authored transfer curve compiled into a table of uniform cubic segments over [-1, 1], shared by every instance using it.
+	// The segments are monotone cubic Hermite (Fritsch-Butland tangents) through knots sampled from the authored curve, so the
+	// table never overshoots between knots: a monotonic curve stays monotonic, and its flat parts stay flat.
+	// Evaluation is one segment lookup and a cubic per sample whatever the number of keys the curve was drawn with.
+	class AUDIODSPCOLLECTION_API FSharedTransferCurve
+	{
+	public:
+		static constexpr int32 DefaultNumSegments = 256;
+
+		// InKnots are the curve values at -1 + 2 * i / (Num - 1), at least 2 of them
+		explicit FSharedTransferCurve(const TArray<float>& InKnots);
+
+		int32 GetNumSegments() const { return NumSegments; }
+
+		SIZE_T GetAllocatedSize() const;
+
+		// Fully wet output for (In + Bias) driven by Gain, like the SaturationUtils curves
+		FORCEINLINE VectorRegister4Float ProcessVector(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain) const;
+
+	private:
+		int32 NumSegments = 1;
+
+		VectorRegister4Float VHalfNumSegments;
+
+		// [C0, C1, C2, C3] per segment, y = ((C3 * t + C2) * t + C1) * t + C0 with t in [0, 1).
+		// One extra constant segment holds the last knot, so x = 1 needs no special case
+		TArray<float, TAlignedHeapAllocator<16>> Coefficients;
+	};
+
+	FORCEINLINE VectorRegister4Float FSharedTransferCurve::ProcessVector(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain) const
+	{
+		//const float X = FMath::Clamp(Gain * In_Plus_Bias, -1.0f, 1.0f);
+		const VectorRegister4Float X = AudioUtils::VectorClampMinusOneToOne(VectorMultiply(In_Plus_Bias, VGain));
+
+		//const float Position = (X + 1) * NumSegments / 2, Segment = (int32)Position, t = Position - Segment;
+		const VectorRegister4Float Position = VectorMultiply(VectorAdd(X, AudioUtils::VOnes), VHalfNumSegments);
+		const VectorRegister4Int   Segment  = VectorFloatToInt(Position);
+		const VectorRegister4Float T        = VectorSubtract(Position, VectorIntToFloat(Segment));
+
+		alignas(16) int32 Segments[4];
+		VectorIntStoreAligned(Segment, Segments);
+
+		// One row of coefficients per lane, transposed to one coefficient per vector
+		const float* Data = Coefficients.GetData();
+		const VectorRegister4Float Row0 = VectorLoadAligned(Data + Segments[0] * 4);
+		const VectorRegister4Float Row1 = VectorLoadAligned(Data + Segments[1] * 4);
+		const VectorRegister4Float Row2 = VectorLoadAligned(Data + Segments[2] * 4);
+		const VectorRegister4Float Row3 = VectorLoadAligned(Data + Segments[3] * 4);
+
+		const VectorRegister4Float Low01  = VectorShuffle(Row0, Row1, 0, 1, 0, 1);   //[C0_0, C1_0, C0_1, C1_1]
+		const VectorRegister4Float High01 = VectorShuffle(Row0, Row1, 2, 3, 2, 3);   //[C2_0, C3_0, C2_1, C3_1]
+		const VectorRegister4Float Low23  = VectorShuffle(Row2, Row3, 0, 1, 0, 1);   //[C0_2, C1_2, C0_3, C1_3]
+		const VectorRegister4Float High23 = VectorShuffle(Row2, Row3, 2, 3, 2, 3);   //[C2_2, C3_2, C2_3, C3_3]
+
+		const VectorRegister4Float C0 = VectorShuffle(Low01,  Low23,  0, 2, 0, 2);
+		const VectorRegister4Float C1 = VectorShuffle(Low01,  Low23,  1, 3, 1, 3);
+		const VectorRegister4Float C2 = VectorShuffle(High01, High23, 0, 2, 0, 2);
+		const VectorRegister4Float C3 = VectorShuffle(High01, High23, 1, 3, 1, 3);
+
+		//return ((C3 * t + C2) * t + C1) * t + C0;
+		VectorRegister4Float Out = VectorMultiplyAdd(C3, T, C2);
+		Out = VectorMultiplyAdd(Out, T, C1);
+		return VectorMultiplyAdd(Out, T, C0);
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+namespace DSPProcessing
+{
+	// Normalized (a0 = 1) biquad coefficients, formulas from the RBJ Audio EQ Cookbook
+	struct AUDIODSPCOLLECTION_API FBiquadCoefficients
+	{
+		float B0 = 1.0f;
+		float B1 = 0.0f;
+		float B2 = 0.0f;
+		float A1 = 0.0f;
+		float A2 = 0.0f;
+
+		static FBiquadCoefficients MakeIdentity();
+		static FBiquadCoefficients MakeLowPass(const float InFrequency, const float InQ, const float InSampleRate);
+		static FBiquadCoefficients MakeHighPass(const float InFrequency, const float InQ, const float InSampleRate);
+		static FBiquadCoefficients MakeAllPass(const float InFrequency, const float InQ, const float InSampleRate);
+		static FBiquadCoefficients MakeLowShelf(const float InFrequency, const float InQ, const float InGainDb, const float InSampleRate);
+		static FBiquadCoefficients MakeHighShelf(const float InFrequency, const float InQ, const float InGainDb, const float InSampleRate);
+		static FBiquadCoefficients MakePeak(const float InFrequency, const float InQ, const float InGainDb, const float InSampleRate);
+
+		// The stable (A1, A2) region is a triangle, so any blend of two stable biquads is stable too
+		static FBiquadCoefficients Lerp(const FBiquadCoefficients& InA, const FBiquadCoefficients& InB, const float InAlpha);
+
+		bool IsIdentity() const { return B0 == 1.0f && B1 == 0.0f && B2 == 0.0f && A1 == 0.0f && A2 == 0.0f; }
+	};
+
+	// 4 independent biquads, one per lane (e.g. one per channel or one per band)
+	struct AUDIODSPCOLLECTION_API FVectorBiquadCoefficients
+	{
+		VectorRegister4Float B0;
+		VectorRegister4Float B1;
+		VectorRegister4Float B2;
+		VectorRegister4Float A1;
+		VectorRegister4Float A2;
+
+		static FVectorBiquadCoefficients MakeFromLanes(const FBiquadCoefficients& InLane0, const FBiquadCoefficients& InLane1, const FBiquadCoefficients& InLane2, const FBiquadCoefficients& InLane3);
+	};
+
+	struct FVectorBiquadState
+	{
+		VectorRegister4Float Z1 = AudioUtils::VZeros;
+		VectorRegister4Float Z2 = AudioUtils::VZeros;
+	};
+
+	namespace AudioUtils
+	{
+		// Transposed direct form II, processes one sample per lane
+		FORCEINLINE VectorRegister4Float VectorBiquad(const VectorRegister4Float& In, const FVectorBiquadCoefficients& Coefficients, FVectorBiquadState& State)
+		{
+			//Out = B0 * In + Z1;
+			const VectorRegister4Float Out = VectorMultiplyAdd(Coefficients.B0, In, State.Z1);
+
+			//Z1 = B1 * In - A1 * Out + Z2;
+			State.Z1 = VectorNegateMultiplyAdd(Coefficients.A1, Out, VectorMultiplyAdd(Coefficients.B1, In, State.Z2));
+
+			//Z2 = B2 * In - A2 * Out;
+			State.Z2 = VectorNegateMultiplyAdd(Coefficients.A2, Out, VectorMultiply(Coefficients.B2, In));
+
+			return Out;
+		}
+	}
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "DSPProcessing/Helpers/AudioUtils.h"
+
+
+namespace DSPProcessing
+{
+	// Look-ahead brickwall limiter, the channels are linked (one gain per frame).
+	// The audio is delayed by the look-ahead, the gain reaches the required reduction with a linear attack over the look-ahead
+	// and recovers with a one-pole release, so the output never goes over the ceiling.
+	// Meant to run right after FSaturation in the same effect, all the per-frame work is O(1) whatever the look-ahead length.
+	class AUDIODSPCOLLECTION_API FLimiter
+	{
+	public:
+		static constexpr float MinLookAheadMs = 0.5f;
+		static constexpr float MaxLookAheadMs = 20.0f;
+
+		// The 4x interpolator is centered on the sample 4 frames in the past, that part of the look-ahead is used by the detector
+		static constexpr int32 TruePeakTapsPerPhase = 8;
+		static constexpr int32 TruePeakDelayInFrames = TruePeakTapsPerPhase / 2;
+
+		static constexpr int32 DefaultMaxBlockFrames = 1024;
+
+		// Allocates everything for MaxLookAheadMs with the true peak detector, up to InMaxNumChannels (InNumChannels when 0) and InMaxBlockFrames
+		// (DefaultMaxBlockFrames when 0). Afterwards the setters and the processing only move indices, longer blocks are processed in chunks
+		void Init(const float InSampleRate, const int32 InNumChannels = 1, const int32 InMaxNumChannels = 0, const int32 InMaxBlockFrames = 0);
+
+		// Only allocates above the max channel count given to Init
+		void SetNumChannels(const int32 InNumChannels);
+
+		void SetCeilingDb(const float InCeilingDb);
+		void SetReleaseTimeMs(const float InReleaseTimeMs);
+
+		// Both change the detector windows, so they clear the state (and the delayed audio when the look-ahead changes)
+		void SetLookAheadMs(const float InLookAheadMs);
+		void SetTruePeakEnabled(const bool bInTruePeakEnabled);
+
+		void Reset();
+
+		// The output is delayed by the look-ahead
+		int32 GetLatencyInFrames() const;
+
+		// Latency for a look-ahead, without an instance (e.g. to report it from the effect presets)
+		static int32 LookAheadMsToFrames(const float InLookAheadMs, const float InSampleRate);
+
+		// Largest reduction applied during the last processed buffer, 0 when the limiter was idle
+		float GetGainReductionDb() const;
+
+		// In-place safe
+		void ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
+		SIZE_T GetAllocatedSize() const;
+
+	private:
+		// Sizes the buffers for MaxNumChannels, MaxBlockFrames and the longest window
+		void AllocateBuffers();
+
+		// Never allocates, the windows are views on the buffers
+		void UpdateWindows();
+
+		template <bool bTruePeakT>
+		void ComputeFrameGains(const float* InBuffer, const int32 InNumFrames);
+
+		FORCEINLINE float DetectSamplePeak(const float* InFrame) const;
+		FORCEINLINE float DetectTruePeak(const float* InFrame);
+
+		FORCEINLINE float SlidingMaxPeak(const float InPeak);
+
+		void ApplyFrameGains(const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+
+		float SampleRate     = 48000.0f;
+		int32 NumChannels    = 1;
+		int32 MaxNumChannels = 1;
+		int32 MaxBlockFrames = DefaultMaxBlockFrames;
+
+		float Ceiling        = 1.0f;
+		float ReleaseCoef    = 0.0f;
+		float ReleaseTimeMs  = 100.0f;
+		float LookAheadMs    = 5.0f;
+		bool  bTruePeak      = false;
+
+		int32 LookAheadFrames = 0; // Delay of the audio
+		int32 WindowFrames    = 1; // Length of the sliding max and of the attack ramp, look-ahead minus the detector delay plus one
+
+		// Delay line: LookAheadFrames of history followed by the current input, the tail is moved back to the front after each buffer.
+		// Below, the rings hold the longest window and use their first WindowFrames entries
+		TArray<float, TAlignedHeapAllocator<16>> DelayBuffer;
+
+		// Monotonic deque of the detected peaks: decreasing values, increasing frame indices, the front is the max of the window.
+		// A ring of WindowFrames entries is enough since every entry leaves the window WindowFrames frames after it came in
+		TArray<float> DequePeaks;
+		TArray<uint32> DequeFrames;
+		int32  DequeHead  = 0;
+		int32  DequeCount = 0;
+		uint32 FrameIndex = 0;
+
+		// The released gain is averaged over the window, a linear attack that lands on the held gain when the peak comes out of the delay
+		TArray<float> AttackRing;
+		int32  AttackRingIndex = 0;
+		double AttackSum       = 0.0; // Recomputed once per lap so the rounding can't drift
+		float  ReleasedGain    = 1.0f;
+
+		// True peak: 4 phases of a windowed sinc (phase 0 is the sample itself), the history is written twice so the taps stay contiguous
+		VectorRegister4Float VTruePeakCoefs[TruePeakTapsPerPhase];
+		TArray<float, TAlignedHeapAllocator<16>> TruePeakHistory;
+		int32 TruePeakHistoryIndex = 0;
+
+		TArray<float, TAlignedHeapAllocator<16>> FrameGains;
+		float MinBlockGain = 1.0f;
+	};
+}
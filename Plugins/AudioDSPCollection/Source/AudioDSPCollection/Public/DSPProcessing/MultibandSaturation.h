@@ -0,0 +1,89 @@
+#pragma once
+
+#include "DSPProcessing/Saturation.h"
+#include "DSPProcessing/Helpers/ParamSmoother.h"
+#include "DSPProcessing/Helpers/VectorBiquad.h"
+
+namespace DSPProcessing
+{
+	// Splits the input in 2-4 bands with Linkwitz-Riley (LR4) crossovers and saturates every band with its own curve.
+	// Each band lives in one lane of a vector, so the crossovers, the curves and the band summing run in a single pass.
+	class AUDIODSPCOLLECTION_API FMultibandSaturation
+	{
+	public:
+		static constexpr int32 MinNumBands = 2;
+		static constexpr int32 MaxNumBands = 4;
+
+		FMultibandSaturation();
+		~FMultibandSaturation();
+
+		void Init(const float InSampleRate, const int32 InNumChannels = 1);
+		void SetNumChannels(const int32 InNumChannels);
+
+		void SetNumBands(const int32 InNumBands);
+		void SetCrossoverFrequency(const int32 InCrossoverIndex, const float InFrequency);
+
+		// The band curves are evaluated per lane: TapeHysteresis, Harmonic and Custom aren't supported. For the validation on the game thread (presets, operator creation)
+		static bool IsBandSaturationTypeSupported(const ESaturationType InSaturationType);
+
+		// Realtime safe, the unsupported types run as Tape without any warning
+		void SetBandSaturationType(const int32 InBandIndex, const ESaturationType InSaturationType);
+		void SetBandGain(const int32 InBandIndex, const float InGain);
+		void SetBandMix(const int32 InBandIndex, const float InMixAmount);
+
+		void SetBias(const float InBias);
+		void SetOutLevelDb(const float InOutLevelDb);
+
+		void ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
+		// Heap memory owned by the instance, on top of sizeof(FMultibandSaturation)
+		SIZE_T GetAllocatedSize() const;
+
+	private:
+		static constexpr int32 MaxNumStages         = MaxNumBands - 1;
+		static constexpr int32 NumBiquadsPerStage   = 2;
+		static constexpr int32 NumBiquadsPerChannel = MaxNumStages * NumBiquadsPerStage;
+
+		void UpdateCrossoverCoefficients();
+		void UpdateBandParams();
+		void ResetFilterStates();
+
+		float SampleRate  = 48000.0f;
+		int32 NumChannels = 1;
+		int32 NumBands    = 3;
+
+		float CrossoverFrequencies[MaxNumStages] = { 200.0f, 2000.0f, 8000.0f };
+		bool  bCrossoversDirty = true;
+
+		ESaturationType BandSaturationTypes[MaxNumBands] = { ESaturationType::Tape, ESaturationType::Tape, ESaturationType::Tape, ESaturationType::Tape };
+		float			BandGains[MaxNumBands]           = { 1.0f, 1.0f, 1.0f, 1.0f }; // Normalized [0, 1]
+		float			BandMixAmounts[MaxNumBands]      = { 1.0f, 1.0f, 1.0f, 1.0f }; // Normalized [0, 1]
+		bool			bBandParamsDirty = true;
+
+		// Stage k of band b is LR4 high-pass (k < b), LR4 low-pass (k == b) or LR4 all-pass (k > b) at crossover k,
+		// so the bands stay phase aligned and sum back flat
+		FVectorBiquadCoefficients StageCoefficients[MaxNumStages][NumBiquadsPerStage];
+
+		// NumChannels * NumBiquadsPerChannel
+		TArray<FVectorBiquadState> FilterStates;
+
+		// Bands sharing the same curve are evaluated together and merged with a lane mask
+		int32				 NumCurveGroups = 0;
+		ESaturationType		 CurveGroupTypes[MaxNumBands];
+		VectorRegister4Float CurveGroupMasks[MaxNumBands];
+
+		// 1.0 for active bands, 0.0 for unused lanes, also used to sum the bands
+		VectorRegister4Float VActiveBands;
+
+		// Per band (per lane) smoothing of Gain and Mix
+		float				 SmoothingStep = 1.0f;
+		VectorRegister4Float VCurrentGains;
+		VectorRegister4Float VTargetGains;
+		VectorRegister4Float VCurrentMix;
+		VectorRegister4Float VTargetMix;
+		bool				 bFirstBandParamsUpdate = true;
+
+		ParamSmootherLPF BiasParamSmoother;
+		ParamSmootherLPF OutLevelParamSmoother;
+	};
+}
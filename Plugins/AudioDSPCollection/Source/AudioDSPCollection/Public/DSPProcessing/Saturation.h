@@ -1,6 +1,16 @@
 #pragma once
 
+#include "DSPProcessing/Helpers/BlockCapture.h"
+#include "DSPProcessing/Helpers/DCBlocker.h"
+#include "DSPProcessing/Helpers/EmphasisFilter.h"
+#include "DSPProcessing/Helpers/EnvelopeFollower.h"
+#include "DSPProcessing/Helpers/HarmonicShaper.h"
 #include "DSPProcessing/Helpers/ParamSmoother.h"
+#include "DSPProcessing/Helpers/QualityGovernor.h"
+#include "DSPProcessing/Helpers/TapeHysteresis.h"
+#include "DSPProcessing/Helpers/TransferCurve.h"
+
+#include <type_traits>
 
 namespace DSPProcessing
 {
@@ -17,47 +27,312 @@ namespace DSPProcessing
 		HardClip,
 		Foldback,
 		HalfWaveRectifier,
-		FullWaveRectifier
+		FullWaveRectifier,
+		TapeHysteresis,
+		Harmonic,
+		Custom
+	};
+
+	// What FSaturation reads every block or every vector: parameters, smoothers, envelope and flags. No heap memory and nothing to own,
+	// trivially copyable and packed in the first cache lines of the instance, ahead of the filter states, scratch buffers and capture data
+	struct FSaturationHotState
+	{
+		static constexpr int32 DefaultMaxBlockFrames = 1024;
+
+		ESaturationType	 SaturationType = ESaturationType::Tape;
+		ParamSmootherLPF GainParamSmoother;
+		ParamSmootherLPF BiasParamSmoother;
+		ParamSmootherLPF MixParamSmoother;
+		ParamSmootherLPF OutLevelParamSmoother;
+
+		// Side parameters of the mid/side mode, the ones above drive the mid
+		ParamSmootherLPF SideGainParamSmoother;
+		ParamSmootherLPF SideBiasParamSmoother;
+		ParamSmootherLPF SideMixParamSmoother;
+		bool             bMidSideEnabled = false;
+		bool             bMidSideActive  = false;
+
+		// Modulates Gain and Bias from the input level, stepped once per vector inside the saturation kernel
+		FEnvelopeFollower EnvelopeFollower;
+		ParamSmootherLPF  EnvelopeToGainParamSmoother;
+		ParamSmootherLPF  EnvelopeToBiasParamSmoother;
+		float			  EnvelopeToGain			= 0.0f;
+		float			  EnvelopeToBias			= 0.0f;
+		float			  MinGain					= 1.0f;  // Lowest gain of the selected type, the modulated gain never goes below it
+		float			  MaxGain					= 20.0f; // Highest gain of the selected type, the modulated gain never goes above it
+		bool			  bEnvelopeFollowerEnabled	= false;
+		bool			  bEnvelopeFollowerActive	= false;
+		bool			  bDCBlockerActive			= false; // Packed with the other flags
+		bool			  bPreEmphasisActive		= false;
+		bool			  bPostEmphasisActive		= false;
+
+		// What the settings asked for, SaturationType and the hysteresis settings are these lowered by QualityLevel
+		ESaturationType       RequestedSaturationType             = ESaturationType::Tape;
+		ETapeHysteresisSolver RequestedTapeHysteresisSolver       = ETapeHysteresisSolver::RK4;
+		int32                 RequestedTapeHysteresisOversampling = 1;
+		EQualityLevel         QualityLevel                        = EQualityLevel::Full;
+
+		// Type crossfade, the previous curve runs in the same pass as the new one until TypeCrossfadeParamSmoother reaches 1
+		ParamSmootherLinear TypeCrossfadeParamSmoother; // Linear so the transition ends exactly on the new curve
+		ESaturationType     PreviousSaturationType = ESaturationType::Tape;
+		float               PreviousGainScale      = 1.0f; // PreviousGain = Gain * Scale + Offset, from the new gain range to the previous one
+		float               PreviousGainOffset     = 0.0f;
+		bool                bTypeCrossfadeActive   = false;
+		bool                bHasProcessedAudio     = false; // Before any audio the type just switches
+
+		float SampleRate           = 48000.0f;
+		int32 NumChannels          = 1;
+		int32 MaxChannelPartitions = 1;
+		int32 MaxBlockFrames       = DefaultMaxBlockFrames;
 	};
 
-	class AUDIODSPCOLLECTION_API FSaturation
+	// No destructor and no copy to run, and 280 bytes on the 64-bit platforms: keep it within 5 cache lines of 64 bytes
+	static_assert(std::is_trivially_copyable_v<FSaturationHotState>, "FSaturationHotState must stay trivially copyable");
+	static_assert(sizeof(FSaturationHotState) <= 5 * 64, "FSaturationHotState must fit in 5 cache lines");
+
+	// The hot state is the base, so it comes first in memory
+	class AUDIODSPCOLLECTION_API FSaturation : private FSaturationHotState
 	{
 	public:
+		// What the setters were given, recorded with the input blocks by FBlockCapture and set back by the replay.
+		// The defaults are the state of a new instance. The custom curve isn't recorded, it replays as Tape
+		struct FCaptureParams
+		{
+			ESaturationType       SaturationType             = ESaturationType::Tape;
+			float                 Gain                       = 0.0f;
+			float                 Bias                       = 0.0f;
+			float                 Mix                        = 0.0f;
+			float                 OutLevelDb                 = -96.0f;
+			bool                  bMidSideEnabled            = false;
+			float                 SideGain                   = 0.0f;
+			float                 SideBias                   = 0.0f;
+			float                 SideMix                    = 0.0f;
+			bool                  bDCBlockerEnabled          = false;
+			float                 DCBlockerCutoffFrequency   = 0.0f;
+			bool                  bEnvelopeFollowerEnabled   = false;
+			EEnvelopeDetectorMode EnvelopeDetectorMode       = EEnvelopeDetectorMode::Peak;
+			float                 EnvelopeAttackTimeMs       = 10.0f;
+			float                 EnvelopeReleaseTimeMs      = 100.0f;
+			float                 EnvelopeToGain             = 0.0f;
+			float                 EnvelopeToBias             = 0.0f;
+			ETapeHysteresisSolver TapeHysteresisSolver       = ETapeHysteresisSolver::RK4;
+			int32                 TapeHysteresisOversampling = 1;
+			float                 HarmonicWeights[FHarmonicShaper::MaxHarmonic + 1] = { 0.0f, 1.0f };
+			FEmphasisBand         PreEmphasisBands[FEmphasisFilter::MaxNumBands];
+			FEmphasisBand         PostEmphasisBands[FEmphasisFilter::MaxNumBands];
+			int32                 MaxChannelPartitions       = 1;
+		};
+
+		static constexpr int32 DefaultMaxBlockFrames = FSaturationHotState::DefaultMaxBlockFrames;
+
 		FSaturation();
-		virtual ~FSaturation();
+		~FSaturation();
+
+		// The scratch buffers are allocated for up to InMaxNumChannels (InNumChannels when 0) and blocks of InMaxBlockFrames (DefaultMaxBlockFrames when 0)
+		void Init(const float InSampleRate, const int32 InNumChannels = 1, const int32 InMaxNumChannels = 0, const int32 InMaxBlockFrames = 0);
 
-		void Init(const float InSampleRate);
+		// Only allocates above the max channel count given to Init
+		void SetNumChannels(const int32 InNumChannels);
 
+		// The scratch buffers are allocated for blocks up to InMaxBlockFrames here and in Init/SetNumChannels/SetMaxChannelPartitions, never while processing.
+		// Longer blocks are processed in chunks of InMaxBlockFrames
+		void SetMaxBlockFrames(const int32 InMaxBlockFrames);
+
+		// Once audio has been processed, a new type is crossfaded in over the smoothing time, see ProcessSaturation
 		void SetSaturationType(const ESaturationType InSaturationType);
 		void SetGain(const float InGain);
 		void SetBias(const float InBias);
 		void SetMix(const float InMixAmount);
 		void SetOutLevelDb(const float InOutLevelDb);
+		void SetDCBlockerEnabled(const bool bInDCBlockerEnabled);
+		void SetDCBlockerCutoffFrequency(const float InCutoffFrequency);
+
+		// Biquad cascades on the wet path: pre-emphasis shapes what drives the curve, post-emphasis shapes its output before the mix.
+		// Band changes ramp the coefficients over the smoothing time
+		void SetPreEmphasisBand(const int32 InBandIndex, const FEmphasisBand& InBand);
+		void SetPostEmphasisBand(const int32 InBandIndex, const FEmphasisBand& InBand);
+
+		// Mid/side mode, stereo only: L/R are encoded to M/S, each one saturated with its own gain, bias and mix, and decoded back, all in one pass.
+		// SetGain/SetBias/SetMix then drive the mid. Ignored for other channel counts, and the switch itself is not crossfaded
+		void SetMidSideEnabled(const bool bInMidSideEnabled);
+		void SetSideGain(const float InGain);
+		void SetSideBias(const float InBias);
+		void SetSideMix(const float InMixAmount);
+
+		void SetEnvelopeFollowerEnabled(const bool bInEnvelopeFollowerEnabled);
+		void SetEnvelopeDetectorMode(const EEnvelopeDetectorMode InDetectorMode);
+		void SetEnvelopeAttackTimeMs(const float InAttackTimeMs);
+		void SetEnvelopeReleaseTimeMs(const float InReleaseTimeMs);
+		void SetEnvelopeToGain(const float InEnvelopeToGain);
+		void SetEnvelopeToBias(const float InEnvelopeToBias);
+
+		// Requested quality, FQualityGovernor may lower it while the plugin is over its CPU budget
+		void SetTapeHysteresisSolver(const ETapeHysteresisSolver InSolver);
+		void SetTapeHysteresisOversampling(const int32 InOversampling);
+
+		// Level of each harmonic of a full scale input for the Harmonic type, InHarmonic in [1, FHarmonicShaper::MaxHarmonic], see FHarmonicShaper
+		void SetHarmonicWeight(const int32 InHarmonic, const float InWeight);
+
+		// Curve of the Custom type, shared with the other instances using the same asset. nullptr falls back to Tape.
+		// A new curve is used from the next vector on, it isn't crossfaded
+		void SetCustomCurve(const TSharedPtr<const FSharedTransferCurve>& InCustomCurve);
 
 		void ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
 
+		// Channel partitions, for high channel counts (ambisonics, object beds).
+		// The channels are split in up to MaxChannelPartitions contiguous partitions of whole groups of 4 channels, each one with its own DC blocker and hysteresis state.
+		// None below 2 (the default), a single partition would be ProcessAudioBuffer with extra steps.
+		// The parameters (and the linked envelope) are stepped once per vector on the calling thread, exactly like ProcessAudioBuffer does, then the partitions
+		// are processed on the task graph workers, or one after the other on the calling thread when bInUseWorkers is false. Both give the same output, so the
+		// caller can switch per block, and the output matches ProcessAudioBuffer up to rounding.
+		// Channel counts that are not a multiple of 4 fall back to ProcessAudioBuffer.
+		static bool SupportsChannelPartitions(const int32 InNumChannels);
+		void SetMaxChannelPartitions(const int32 InMaxChannelPartitions);
+		int32 GetNumChannelPartitions() const;
+		void ProcessAudioBufferPartitioned(const float* InBuffer, float* OutBuffer, const int32 InNumSamples, const bool bInUseWorkers);
+
+		// Heap memory owned by the instance, on top of sizeof(FSaturation)
+		SIZE_T GetAllocatedSize() const;
+
+		// Replay of a captured block, through the setters
+		void ApplyCaptureParams(const FCaptureParams& InParams);
+
 	private:
-		// Saturation graphs https://www.desmos.com/calculator/12d0ysis1g
-		FORCEINLINE void Tape(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void Tape2(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void Overdrive(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void Tube(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void Tube2(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void Distortion(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void Metal(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void Fuzz(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void HardClip(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void Foldback(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void HalfWaveRectifier(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-		FORCEINLINE void FullWaveRectifier(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
-
-		ESaturationType	 SaturationType;
-		ParamSmootherLPF GainParamSmoother;
-		ParamSmootherLPF BiasParamSmoother;
-		ParamSmootherLPF MixParamSmoother;
-		ParamSmootherLPF OutLevelParamSmoother;
+		struct FChannelPartition
+		{
+			int32 ChannelOffset       = 0;
+			int32 NumChannels         = 0;
+			bool  bDCBlockerActive    = false;
+			bool  bPreEmphasisActive  = false;
+			bool  bPostEmphasisActive = false;
+
+			FDCBlocker DCBlocker;
+			FEmphasisFilter PreEmphasis;
+			FEmphasisFilter PostEmphasis;
+			FTapeHysteresis TapeHysteresis;
+			FHarmonicShaper HarmonicShaper;
+			TArray<float, TAlignedHeapAllocator<16>> TapeHysteresisBuffer;
+			TArray<float, TAlignedHeapAllocator<16>> TypeCrossfadeBuffer;
+		};
+
+		// The smoothers step once per vector, so their rate follows the channel count
+		void InitParamSmoothers();
+
+		// Returns true when the whole buffer was handled by the OutLevel == 0 or Mix == 0 fast paths
+		bool ProcessStaticFastPaths(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+		void UpdateEnvelopeFollowerActive();
+
+		// Ends the type crossfade once it has reached the new curve
+		void UpdateTypeCrossfade();
+
+		// Switches the processed type, SetSaturationType goes through the quality level first
+		void SwitchSaturationType(const ESaturationType InSaturationType);
+
+		// Records the block about to be processed, see FBlockCapture
+		void CaptureBlock(const float* InBuffer, const int32 InNumSamples, const EBlockCaptureFlags InFlags);
+
+		// MetaSound nodes call the setters every block, only an actual change is flagged
+		template <typename T>
+		FORCEINLINE void SetCaptureParam(T& OutParam, const T& InValue)
+		{
+			if (!(OutParam == InValue))
+			{
+				OutParam              = InValue;
+				bCaptureParamsChanged = true;
+			}
+		}
+
+		// Picks up a new FQualityGovernor level at the start of the block
+		void UpdateQualityLevel();
+		void ApplyTapeHysteresisQuality();
+		ESaturationType GetGovernedSaturationType() const;
+
+		// Points the kernels to the selected type, with or without the type crossfade
+		void UpdateSelectedKernels();
+
+		template <ESaturationType SaturationTypeT>
+		void SelectKernels();
+
+		// Vectorized kernel shared by all the saturation types, the curve is selected at compile time.
+		// bCrossfadeT also evaluates the previous curve in the same pass and blends it out, only instantiated for the transitions.
+		// bMidSideT runs the curve on [M0, S0, M1, S1] with per-lane gain, bias and mix, see SetMidSideEnabled.
+		template <ESaturationType SaturationTypeT, bool bCrossfadeT, bool bMidSideT>
+		void ProcessSaturation(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
+		// TapeHysteresis is stateful, so the curve runs as a separate pass over the whole buffer.
+		// Also handles the transitions from and to TapeHysteresis, the other curve is evaluated in the 1st pass.
+		template <bool bCrossfadeT, bool bMidSideT>
+		void ProcessTapeHysteresis(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
+		// SaturationUtils::VectorSaturate, plus the Harmonic curve that needs the shaper of the instance or of the partition, and the Custom curve
+		template <ESaturationType SaturationTypeT>
+		FORCEINLINE VectorRegister4Float Saturate(FHarmonicShaper& InOutHarmonicShaper, const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain) const;
+		FORCEINLINE VectorRegister4Float Saturate(FHarmonicShaper& InOutHarmonicShaper, const ESaturationType InSaturationType, const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain) const;
+		FORCEINLINE VectorRegister4Float SaturateCustom(const VectorRegister4Float& In_Plus_Bias, const VectorRegister4Float& VGain) const;
+
+		FORCEINLINE void ApplyEnvelopeModulation(const VectorRegister4Float& In, float& InOutGain, float& InOutBias);
+		FORCEINLINE void ApplyEnvelopeModulation(const VectorRegister4Float& In, float& InOutGain, float& InOutBias, float& InOutSideGain, float& InOutSideBias);
+		FORCEINLINE void ModulateGainAndBias(const float InEnvelope, const float InEnvelopeToGain, const float InEnvelopeToBias, float& InOutGain, float& InOutBias) const;
+
+		// Mid/side mode, only selected for stereo
+		void UpdateMidSideActive();
+
+		void UpdateChannelPartitions();
+
+		// Sizes the serial scratch buffers for MaxBlockFrames of MaxNumChannels
+		void AllocateScratchBuffers();
+
+		// Sizes the VectorParam arrays and the partition scratch buffers for MaxBlockFrames, released when there are no partitions
+		void AllocatePartitionBuffers();
+
+		// Steps the smoothers and the envelope once per vector of the interleaved buffer into the VectorParam arrays, like the serial kernels.
+		// InNumSamples is at most MaxBlockFrames frames
+		void StepVectorParams(const float* InBuffer, const int32 InNumSamples);
+
+		// Same kernels for one channel partition, reading the frame-stepped parameters. Strided over the interleaved buffer, no copy.
+		template <ESaturationType SaturationTypeT, bool bCrossfadeT>
+		void ProcessPartitionSaturation(FChannelPartition& Partition, const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
+		template <bool bCrossfadeT>
+		void ProcessPartitionTapeHysteresis(FChannelPartition& Partition, const float* InBuffer, float* OutBuffer, const int32 InNumFrames);
 
 		// Function pointer that points to the selected saturation type
 		void (FSaturation::*SelectedSaturationTypePtr)(const float* /*InBuffer*/, float* /*OutBuffer*/, const int32 /*InNumSamples*/);
+		void (FSaturation::*SelectedPartitionSaturationTypePtr)(FChannelPartition& /*Partition*/, const float* /*InBuffer*/, float* /*OutBuffer*/, const int32 /*InNumFrames*/);
+
+		// Cold state below the hot one: owns heap memory, or is only touched by some types and settings
+
+		// Filter states per channel, fused in the kernels
+		FDCBlocker      DCBlocker;
+		FEmphasisFilter PreEmphasis;
+		FEmphasisFilter PostEmphasis;
+
+		// Capacity of the serial scratch buffers (TapeHysteresisBuffer and the type crossfade), MaxBlockFrames frames of MaxNumChannels
+		int32 MaxNumChannels = 1;
+
+		FTapeHysteresis TapeHysteresis;
+		TArray<float, TAlignedHeapAllocator<16>> TapeHysteresisBuffer;
+
+		FHarmonicShaper HarmonicShaper;
+
+		// Read only, so the partitions share it too
+		TSharedPtr<const FSharedTransferCurve> CustomCurve;
+
+		// Transitions from/to TapeHysteresis: the other curve (already weighted) and the TapeHysteresis weight per vector
+		TArray<float, TAlignedHeapAllocator<16>> TypeCrossfadeBuffer;
+		TArray<float, TAlignedHeapAllocator<16>> TypeCrossfadeWeights;
+
+		FCaptureParams CaptureParams;
+		uint64         CaptureInstanceId     = 0;
+		bool           bCaptureParamsChanged = true;
+
+		TArray<FChannelPartition> ChannelPartitions;
+
+		// Vector-stepped parameters shared by all the channel partitions, indexed by the vector of the interleaved buffer, MaxBlockFrames long
+		TArray<float, TAlignedHeapAllocator<16>> VectorGains;
+		TArray<float, TAlignedHeapAllocator<16>> VectorBiases;
+		TArray<float, TAlignedHeapAllocator<16>> VectorMixes;
+		TArray<float, TAlignedHeapAllocator<16>> VectorOutLevels;
+		TArray<float, TAlignedHeapAllocator<16>> VectorTypeCrossfades;  // Only during a type crossfade
+		TArray<float, TAlignedHeapAllocator<16>> VectorPreviousGains;   // Only during a type crossfade
 	};
 }
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "DSPProcessing/Saturation.h"
+#include "DSPProcessing/Helpers/ParamSmoother.h"
+
+namespace DSPProcessing
+{
+	// Amp-style chain of 1-4 saturation stages (e.g. Tube -> Tube2 -> Tape) fused in a single pass: every vector goes through all the stages
+	// while it stays in registers, instead of one buffer pass per chained FSaturation. Each stage has its own curve, gain and bias, and a level
+	// applied to its output before the next stage (inter-stage gain). Mix (against the cascade input) and OutLevel are shared by the whole cascade.
+	// The stages are memoryless, so TapeHysteresis, Harmonic and Custom run as Tape (see SaturationUtils::IsMemoryless). The channel count only sets the smoothing rate.
+	class AUDIODSPCOLLECTION_API FSaturationCascade
+	{
+	public:
+		static constexpr int32 MinNumStages = 1;
+		static constexpr int32 MaxNumStages = 4;
+
+		FSaturationCascade();
+		~FSaturationCascade();
+
+		void Init(const float InSampleRate, const int32 InNumChannels = 1);
+
+		void SetNumStages(const int32 InNumStages);
+
+		void SetStageSaturationType(const int32 InStageIndex, const ESaturationType InSaturationType);
+		void SetStageGain(const int32 InStageIndex, const float InGain);
+		void SetStageBias(const int32 InStageIndex, const float InBias);
+		void SetStageLevelDb(const int32 InStageIndex, const float InLevelDb);
+
+		void SetMix(const float InMixAmount);
+		void SetOutLevelDb(const float InOutLevelDb);
+
+		void ProcessAudioBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
+	private:
+		// SaturationUtils::VectorSaturate of one type, resolved per stage when its type changes instead of switching per vector
+		using FVectorSaturateKernel = VectorRegister4Float (*)(const VectorRegister4Float&, const VectorRegister4Float&);
+
+		void UpdateStageParams();
+
+		// Steps the stage smoothers once per vector, and snaps them once they are all within -96dB of their targets.
+		// Works on the caller's copies, so the kernel keeps the stage parameters in registers
+		FORCEINLINE void StepStageParams(VectorRegister4Float& InOutGains, VectorRegister4Float& InOutBiases, VectorRegister4Float& InOutLevels);
+
+		template <int32 NumStagesT>
+		void ProcessStages(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
+		int32 NumStages = 3;
+
+		ESaturationType StageSaturationTypes[MaxNumStages] = { ESaturationType::Tube, ESaturationType::Tube2, ESaturationType::Tape, ESaturationType::Tape };
+		float           StageGains[MaxNumStages]           = { 0.5f, 0.5f, 0.5f, 0.5f }; // Normalized [0, 1]
+		float           StageBiases[MaxNumStages]          = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float           StageLevels[MaxNumStages]          = { 1.0f, 1.0f, 1.0f, 1.0f }; // Linear
+		bool            bStageParamsDirty = true;
+
+		// One lane per stage, the three stage parameters are smoothed with three vector operations for all the stages
+		float                SmoothingStep = 1.0f;
+		VectorRegister4Float VCurrentGains;
+		VectorRegister4Float VTargetGains;
+		VectorRegister4Float VCurrentBiases;
+		VectorRegister4Float VTargetBiases;
+		VectorRegister4Float VCurrentLevels;
+		VectorRegister4Float VTargetLevels;
+		bool                 bStageParamsSettled     = true;
+		bool                 bFirstStageParamsUpdate = true;
+
+		FVectorSaturateKernel StageKernels[MaxNumStages];
+
+		ParamSmootherLPF MixParamSmoother;
+		ParamSmootherLPF OutLevelParamSmoother;
+	};
+}
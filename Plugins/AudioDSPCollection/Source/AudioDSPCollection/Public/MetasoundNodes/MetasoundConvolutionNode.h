@@ -0,0 +1,107 @@
+#pragma once
+
+#include "DSPProcessing/Convolution.h"
+#include "MetasoundDataReferenceMacro.h"
+#include "MetasoundParamHelper.h"
+
+namespace Metasound
+{
+	// MetaSound side of UDSPCollectionImpulseResponse, built from its FDSPCollectionImpulseResponseProxy
+	class AUDIODSPCOLLECTION_API FImpulseResponseAsset
+	{
+	public:
+		FImpulseResponseAsset() = default;
+		FImpulseResponseAsset(const TSharedPtr<Audio::IProxyData>& InInitData);
+
+		const TSharedPtr<const DSPProcessing::FSharedImpulseResponse>& GetImpulseResponse() const { return ImpulseResponse; }
+
+	private:
+		TSharedPtr<const DSPProcessing::FSharedImpulseResponse> ImpulseResponse;
+	};
+
+	DECLARE_METASOUND_DATA_REFERENCE_TYPES(FImpulseResponseAsset, AUDIODSPCOLLECTION_API, FImpulseResponseAssetTypeInfo, FImpulseResponseAssetReadRef, FImpulseResponseAssetWriteRef);
+}
+
+namespace DSPCollection
+{
+	// Control inputs shared by the mono and multichannel flavors
+	struct FConvolutionNodeControls
+	{
+		Metasound::FImpulseResponseAssetReadRef ImpulseResponse;
+		Metasound::FBoolReadRef                 NonUniformPartitions;
+
+		static FConvolutionNodeControls Create(const Metasound::FBuildOperatorParams& InParams);
+		static void AddInputVertices(Metasound::FInputVertexInterface& InOutInterface);
+
+		void Bind(Metasound::FInputVertexInterfaceData& InOutVertexData);
+		void Apply(DSPProcessing::FConvolution& InOutConvolution) const;
+	};
+
+	class FConvolutionOperator : public Metasound::TExecutableOperator<FConvolutionOperator>
+	{
+	public:
+		FConvolutionOperator(const Metasound::FOperatorSettings& InSettings,
+							 const Metasound::FAudioBufferReadRef& InAudioInput,
+							 const FConvolutionNodeControls& InControls);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+		
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+		
+		void Reset(const IOperator::FResetParams& InParams);
+
+	private:
+		Metasound::FAudioBufferReadRef  AudioInput;
+		Metasound::FAudioBufferWriteRef AudioOutput;
+
+		DSPProcessing::FConvolution ConvolutionDSPProcessor;
+
+		FConvolutionNodeControls Controls;
+	};
+
+	using FConvolutionNode = Metasound::TNodeFacade<FConvolutionOperator>;
+
+	// Stereo/Quad/5.1/7.1 flavors, channel N uses the IR channel N % IR channels (a mono IR colors every channel the same way)
+	template <int32 NumChannels>
+	class TConvolutionMultichannelOperator : public Metasound::TExecutableOperator<TConvolutionMultichannelOperator<NumChannels>>
+	{
+	public:
+		TConvolutionMultichannelOperator(const Metasound::FOperatorSettings& InSettings,
+										 const TArray<Metasound::FAudioBufferReadRef>& InAudioInputs,
+										 const FConvolutionNodeControls& InControls);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+		
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+		
+		void Reset(const Metasound::IOperator::FResetParams& InParams);
+
+	private:
+		DSPProcessing::FConvolution ConvolutionDSPProcessor;
+
+		TArray<Metasound::FAudioBufferReadRef>  AudioInputs;
+		TArray<Metasound::FAudioBufferWriteRef> AudioOutputs;
+
+		FConvolutionNodeControls Controls;
+
+		// Interleaved scratch buffer, processed in place
+		TArray<float, TAlignedHeapAllocator<16>> InterleavedBuffer;
+	};
+
+	using FConvolutionStereoNode = Metasound::TNodeFacade<TConvolutionMultichannelOperator<2>>;
+	using FConvolutionQuadNode   = Metasound::TNodeFacade<TConvolutionMultichannelOperator<4>>;
+	using FConvolution51Node     = Metasound::TNodeFacade<TConvolutionMultichannelOperator<6>>;
+	using FConvolution71Node     = Metasound::TNodeFacade<TConvolutionMultichannelOperator<8>>;
+}
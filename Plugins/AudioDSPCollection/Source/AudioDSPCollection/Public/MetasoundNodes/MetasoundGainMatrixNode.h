@@ -0,0 +1,50 @@
+#pragma once
+
+#include "DSPProcessing/GainMatrix.h"
+#include "MetasoundEnumRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+
+namespace DSPCollection
+{
+	// Stereo 2x2 flavor of FGainMatrix (panning, width, swaps, fold-downs)
+	class FGainMatrixOperator : public Metasound::TExecutableOperator<FGainMatrixOperator>
+	{
+	public:
+		FGainMatrixOperator(const Metasound::FOperatorSettings& InSettings,
+							const Metasound::FAudioBufferReadRef& InAudioInputLeft,
+							const Metasound::FAudioBufferReadRef& InAudioInputRight,
+							const Metasound::FFloatReadRef& InLeftToLeft,
+							const Metasound::FFloatReadRef& InRightToLeft,
+							const Metasound::FFloatReadRef& InLeftToRight,
+							const Metasound::FFloatReadRef& InRightToRight);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+		
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+		
+		void Reset(const IOperator::FResetParams& InParams);
+
+	private:
+		void UpdateGains();
+
+		Metasound::FAudioBufferReadRef	AudioInputLeft;
+		Metasound::FAudioBufferReadRef	AudioInputRight;
+		Metasound::FAudioBufferWriteRef AudioOutputLeft;
+		Metasound::FAudioBufferWriteRef AudioOutputRight;
+
+		DSPProcessing::FGainMatrix GainMatrixDSPProcessor;
+
+		Metasound::FFloatReadRef LeftToLeft;
+		Metasound::FFloatReadRef RightToLeft;
+		Metasound::FFloatReadRef LeftToRight;
+		Metasound::FFloatReadRef RightToRight;
+	};
+
+	using FGainMatrixNode = Metasound::TNodeFacade<FGainMatrixOperator>;
+}
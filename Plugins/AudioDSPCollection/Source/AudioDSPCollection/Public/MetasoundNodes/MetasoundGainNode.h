@@ -1,13 +1,29 @@
+#pragma once
+
 #include "DSPProcessing/Gain.h"
 #include "MetasoundEnumRegistrationMacro.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundTrigger.h"
+
+namespace Metasound
+{
+	DECLARE_METASOUND_ENUM(DSPProcessing::EGainRampShape, DSPProcessing::EGainRampShape::Linear, AUDIODSPCOLLECTION_API, FEnumEGainRampShape, FEnumGainRampShapeInfo, FEnumGainRampShapeReadRef, FEnumGainRampShapeWriteRef);
+}
 
 namespace DSPCollection
 {
 	class FGainOperator : public Metasound::TExecutableOperator<FGainOperator>
 	{
 	public:
-		FGainOperator(const Metasound::FOperatorSettings& InSettings, const Metasound::FAudioBufferReadRef& InAudioInput, const Metasound::FFloatReadRef& InGain);
+		FGainOperator(const Metasound::FOperatorSettings& InSettings,
+					  const Metasound::FAudioBufferReadRef& InAudioInput,
+					  const Metasound::FFloatReadRef& InGain,
+					  const Metasound::FFloatReadRef& InFadeTimeMs,
+					  const Metasound::FEnumGainRampShapeReadRef& InFadeShape,
+					  const Metasound::FTriggerReadRef& InFadeInTrigger,
+					  const Metasound::FTriggerReadRef& InFadeOutTrigger,
+					  const Metasound::FTriggerReadRef& InFadeToTrigger,
+					  const Metasound::FFloatReadRef& InFadeToGain);
 
 		static const Metasound::FNodeClassMetadata& GetNodeInfo();
 
@@ -28,7 +44,66 @@ namespace DSPCollection
 		DSPProcessing::FGain GainDSPProcessor;
 
 		Metasound::FFloatReadRef Gain;
+		Metasound::FFloatReadRef FadeTimeMs;
+		Metasound::FEnumGainRampShapeReadRef FadeShape;
+		Metasound::FTriggerReadRef FadeInTrigger;
+		Metasound::FTriggerReadRef FadeOutTrigger;
+		Metasound::FTriggerReadRef FadeToTrigger;
+		Metasound::FFloatReadRef FadeToGain;
+
+		float SampleRate;
+		float PreviousGain;
 	};
 
 	using FGainNode = Metasound::TNodeFacade<FGainOperator>;
+
+	// Stereo/Quad/5.1/7.1 flavors, all the channels share a single gain evaluation per block
+	template <int32 NumChannels>
+	class TGainMultichannelOperator : public Metasound::TExecutableOperator<TGainMultichannelOperator<NumChannels>>
+	{
+	public:
+		TGainMultichannelOperator(const Metasound::FOperatorSettings& InSettings,
+								  const TArray<Metasound::FAudioBufferReadRef>& InAudioInputs,
+								  const Metasound::FFloatReadRef& InGain,
+								  const Metasound::FFloatReadRef& InFadeTimeMs,
+								  const Metasound::FEnumGainRampShapeReadRef& InFadeShape,
+								  const Metasound::FTriggerReadRef& InFadeInTrigger,
+								  const Metasound::FTriggerReadRef& InFadeOutTrigger,
+								  const Metasound::FTriggerReadRef& InFadeToTrigger,
+								  const Metasound::FFloatReadRef& InFadeToGain);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+		
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+		
+		void Reset(const Metasound::IOperator::FResetParams& InParams);
+
+	private:
+		TArray<Metasound::FAudioBufferReadRef>  AudioInputs;
+		TArray<Metasound::FAudioBufferWriteRef> AudioOutputs;
+
+		DSPProcessing::FGain GainDSPProcessor;
+
+		Metasound::FFloatReadRef Gain;
+		Metasound::FFloatReadRef FadeTimeMs;
+		Metasound::FEnumGainRampShapeReadRef FadeShape;
+		Metasound::FTriggerReadRef FadeInTrigger;
+		Metasound::FTriggerReadRef FadeOutTrigger;
+		Metasound::FTriggerReadRef FadeToTrigger;
+		Metasound::FFloatReadRef FadeToGain;
+
+		float SampleRate;
+		float PreviousGain;
+	};
+
+	using FGainStereoNode = Metasound::TNodeFacade<TGainMultichannelOperator<2>>;
+	using FGainQuadNode   = Metasound::TNodeFacade<TGainMultichannelOperator<4>>;
+	using FGain51Node     = Metasound::TNodeFacade<TGainMultichannelOperator<6>>;
+	using FGain71Node     = Metasound::TNodeFacade<TGainMultichannelOperator<8>>;
 }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "DSPProcessing/Limiter.h"
+#include "MetasoundParamHelper.h"
+
+namespace DSPCollection
+{
+	// Control inputs shared by the mono and multichannel flavors
+	struct FLimiterNodeControls
+	{
+		Metasound::FFloatReadRef CeilingDb;
+		Metasound::FFloatReadRef ReleaseTimeMs;
+		Metasound::FFloatReadRef LookAheadMs;
+		Metasound::FBoolReadRef  TruePeakEnabled;
+
+		static FLimiterNodeControls Create(const Metasound::FBuildOperatorParams& InParams);
+		static void AddInputVertices(Metasound::FInputVertexInterface& InOutInterface);
+
+		void Bind(Metasound::FInputVertexInterfaceData& InOutVertexData);
+		void Apply(DSPProcessing::FLimiter& InOutLimiter) const;
+	};
+
+	class FLimiterOperator : public Metasound::TExecutableOperator<FLimiterOperator>
+	{
+	public:
+		FLimiterOperator(const Metasound::FOperatorSettings& InSettings,
+						 const Metasound::FAudioBufferReadRef& InAudioInput,
+						 const FLimiterNodeControls& InControls);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+		
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+		
+		void Reset(const IOperator::FResetParams& InParams);
+
+	private:
+		Metasound::FAudioBufferReadRef  AudioInput;
+		Metasound::FAudioBufferWriteRef AudioOutput;
+		Metasound::FFloatWriteRef       GainReductionDb;
+
+		DSPProcessing::FLimiter LimiterDSPProcessor;
+
+		FLimiterNodeControls Controls;
+	};
+
+	using FLimiterNode = Metasound::TNodeFacade<FLimiterOperator>;
+
+	// Stereo/Quad/5.1/7.1 flavors, the channels are interleaved and linked so the image doesn't move when one channel peaks
+	template <int32 NumChannels>
+	class TLimiterMultichannelOperator : public Metasound::TExecutableOperator<TLimiterMultichannelOperator<NumChannels>>
+	{
+	public:
+		TLimiterMultichannelOperator(const Metasound::FOperatorSettings& InSettings,
+									 const TArray<Metasound::FAudioBufferReadRef>& InAudioInputs,
+									 const FLimiterNodeControls& InControls);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+		
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+		
+		void Reset(const Metasound::IOperator::FResetParams& InParams);
+
+	private:
+		DSPProcessing::FLimiter LimiterDSPProcessor;
+
+		TArray<Metasound::FAudioBufferReadRef>  AudioInputs;
+		TArray<Metasound::FAudioBufferWriteRef> AudioOutputs;
+		Metasound::FFloatWriteRef               GainReductionDb;
+
+		FLimiterNodeControls Controls;
+
+		// Interleaved scratch buffer, processed in place
+		TArray<float, TAlignedHeapAllocator<16>> InterleavedBuffer;
+	};
+
+	using FLimiterStereoNode = Metasound::TNodeFacade<TLimiterMultichannelOperator<2>>;
+	using FLimiterQuadNode   = Metasound::TNodeFacade<TLimiterMultichannelOperator<4>>;
+	using FLimiter51Node     = Metasound::TNodeFacade<TLimiterMultichannelOperator<6>>;
+	using FLimiter71Node     = Metasound::TNodeFacade<TLimiterMultichannelOperator<8>>;
+}
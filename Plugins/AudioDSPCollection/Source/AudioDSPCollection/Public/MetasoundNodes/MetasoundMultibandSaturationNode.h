@@ -0,0 +1,55 @@
+#pragma once
+
+#include "DSPProcessing/MultibandSaturation.h"
+#include "MetasoundNodes/MetasoundSaturationNode.h"
+
+namespace DSPCollection
+{
+	class FMultibandSaturationOperator : public Metasound::TExecutableOperator<FMultibandSaturationOperator>
+	{
+	public:
+		static constexpr int32 NumCrossovers = DSPProcessing::FMultibandSaturation::MaxNumBands - 1;
+		static constexpr int32 MaxNumBands   = DSPProcessing::FMultibandSaturation::MaxNumBands;
+
+		struct FBandInputs
+		{
+			Metasound::FEnumSaturationReadRef SaturationType;
+			Metasound::FFloatReadRef Gain;
+			Metasound::FFloatReadRef Mix;
+		};
+
+		FMultibandSaturationOperator(const Metasound::FOperatorSettings& InSettings,
+									 const Metasound::FAudioBufferReadRef& InAudioInput,
+									 const Metasound::FInt32ReadRef& InNumBands,
+									 const TArray<Metasound::FFloatReadRef>& InCrossoverFrequencies,
+									 const TArray<FBandInputs>& InBands,
+									 const Metasound::FFloatReadRef& InBias,
+									 const Metasound::FFloatReadRef& InOutLevelDb);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+		
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+		
+		void Reset(const IOperator::FResetParams& InParams);
+
+	private:
+		DSPProcessing::FMultibandSaturation MultibandSaturationDSPProcessor;
+
+		Metasound::FAudioBufferReadRef	AudioInput;
+		Metasound::FAudioBufferWriteRef AudioOutput;
+
+		Metasound::FInt32ReadRef NumBands;
+		TArray<Metasound::FFloatReadRef> CrossoverFrequencies;
+		TArray<FBandInputs> Bands;
+		Metasound::FFloatReadRef Bias;
+		Metasound::FFloatReadRef OutLevelDb;
+	};
+
+	using FMultibandSaturationNode = Metasound::TNodeFacade<FMultibandSaturationOperator>;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "DSPProcessing/SaturationCascade.h"
+#include "MetasoundNodes/MetasoundSaturationNode.h"
+
+namespace DSPCollection
+{
+	class FSaturationCascadeOperator : public Metasound::TExecutableOperator<FSaturationCascadeOperator>
+	{
+	public:
+		static constexpr int32 MaxNumStages = DSPProcessing::FSaturationCascade::MaxNumStages;
+
+		struct FStageInputs
+		{
+			Metasound::FEnumSaturationReadRef SaturationType;
+			Metasound::FFloatReadRef Gain;
+			Metasound::FFloatReadRef Bias;
+			Metasound::FFloatReadRef LevelDb;
+		};
+
+		FSaturationCascadeOperator(const Metasound::FOperatorSettings& InSettings,
+								   const Metasound::FAudioBufferReadRef& InAudioInput,
+								   const Metasound::FInt32ReadRef& InNumStages,
+								   const TArray<FStageInputs>& InStages,
+								   const Metasound::FFloatReadRef& InMix,
+								   const Metasound::FFloatReadRef& InOutLevelDb);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+
+		void Reset(const IOperator::FResetParams& InParams);
+
+	private:
+		DSPProcessing::FSaturationCascade SaturationCascadeDSPProcessor;
+
+		Metasound::FAudioBufferReadRef  AudioInput;
+		Metasound::FAudioBufferWriteRef AudioOutput;
+
+		Metasound::FInt32ReadRef NumStages;
+		TArray<FStageInputs> Stages;
+		Metasound::FFloatReadRef Mix;
+		Metasound::FFloatReadRef OutLevelDb;
+	};
+
+	using FSaturationCascadeNode = Metasound::TNodeFacade<FSaturationCascadeOperator>;
+}
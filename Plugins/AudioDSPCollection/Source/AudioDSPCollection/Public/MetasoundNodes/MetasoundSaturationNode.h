@@ -1,24 +1,113 @@
+#pragma once
+
 #include "DSPProcessing/Saturation.h"
+#include "MetasoundDataReferenceMacro.h"
 #include "MetasoundEnumRegistrationMacro.h"
 #include "MetasoundParamHelper.h"
 
 namespace Metasound
 {
 	DECLARE_METASOUND_ENUM(DSPProcessing::ESaturationType, DSPProcessing::ESaturationType::Tape, AUDIODSPCOLLECTION_API, FEnumESaturationType, FEnumSaturationTypeInfo, FEnumSaturationReadRef, FEnumSaturationWriteRef);
+	DECLARE_METASOUND_ENUM(DSPProcessing::EEnvelopeDetectorMode, DSPProcessing::EEnvelopeDetectorMode::Peak, AUDIODSPCOLLECTION_API, FEnumEEnvelopeDetectorMode, FEnumEnvelopeDetectorModeInfo, FEnumEnvelopeDetectorModeReadRef, FEnumEnvelopeDetectorModeWriteRef);
+	DECLARE_METASOUND_ENUM(DSPProcessing::ETapeHysteresisSolver, DSPProcessing::ETapeHysteresisSolver::RK4, AUDIODSPCOLLECTION_API, FEnumETapeHysteresisSolver, FEnumTapeHysteresisSolverInfo, FEnumTapeHysteresisSolverReadRef, FEnumTapeHysteresisSolverWriteRef);
+	DECLARE_METASOUND_ENUM(DSPProcessing::EEmphasisFilterType, DSPProcessing::EEmphasisFilterType::Off, AUDIODSPCOLLECTION_API, FEnumEEmphasisFilterType, FEnumEmphasisFilterTypeInfo, FEnumEmphasisFilterTypeReadRef, FEnumEmphasisFilterTypeWriteRef);
+
+	// MetaSound side of UDSPCollectionTransferCurve, built from its FDSPCollectionTransferCurveProxy
+	class AUDIODSPCOLLECTION_API FTransferCurveAsset
+	{
+	public:
+		FTransferCurveAsset() = default;
+		FTransferCurveAsset(const TSharedPtr<Audio::IProxyData>& InInitData);
+
+		const TSharedPtr<const DSPProcessing::FSharedTransferCurve>& GetTransferCurve() const { return TransferCurve; }
+
+	private:
+		TSharedPtr<const DSPProcessing::FSharedTransferCurve> TransferCurve;
+	};
+
+	DECLARE_METASOUND_DATA_REFERENCE_TYPES(FTransferCurveAsset, AUDIODSPCOLLECTION_API, FTransferCurveAssetTypeInfo, FTransferCurveAssetReadRef, FTransferCurveAssetWriteRef);
 }
 	
 namespace DSPCollection
 {
+	// One pre-emphasis and one post-emphasis band, shared by all the flavors
+	struct FSaturationEmphasisControls
+	{
+		Metasound::FEnumEmphasisFilterTypeReadRef PreType;
+		Metasound::FFloatReadRef PreFrequency;
+		Metasound::FFloatReadRef PreGainDb;
+		Metasound::FFloatReadRef PreQ;
+		Metasound::FEnumEmphasisFilterTypeReadRef PostType;
+		Metasound::FFloatReadRef PostFrequency;
+		Metasound::FFloatReadRef PostGainDb;
+		Metasound::FFloatReadRef PostQ;
+
+		static FSaturationEmphasisControls Create(const Metasound::FBuildOperatorParams& InParams);
+		static void AddInputVertices(Metasound::FInputVertexInterface& InOutInterface);
+
+		void Bind(Metasound::FInputVertexInterfaceData& InOutVertexData);
+		void Apply(DSPProcessing::FSaturation& InOutSaturation) const;
+	};
+
+	// Levels of the 1st to 8th harmonic of the Harmonic type, shared by all the flavors
+	struct FSaturationHarmonicControls
+	{
+		TArray<Metasound::FFloatReadRef> Weights; // Fundamental first
+
+		static FSaturationHarmonicControls Create(const Metasound::FBuildOperatorParams& InParams);
+		static void AddInputVertices(Metasound::FInputVertexInterface& InOutInterface);
+
+		void Bind(Metasound::FInputVertexInterfaceData& InOutVertexData);
+		void Apply(DSPProcessing::FSaturation& InOutSaturation) const;
+	};
+
+	// Curve asset of the Custom type, shared by all the flavors
+	struct FSaturationCustomCurveControls
+	{
+		Metasound::FTransferCurveAssetReadRef Curve;
+
+		static FSaturationCustomCurveControls Create(const Metasound::FBuildOperatorParams& InParams);
+		static void AddInputVertices(Metasound::FInputVertexInterface& InOutInterface);
+
+		void Bind(Metasound::FInputVertexInterfaceData& InOutVertexData);
+		void Apply(DSPProcessing::FSaturation& InOutSaturation) const;
+	};
+
+	// Control inputs shared by the mono and the multichannel flavors
+	struct FSaturationNodeControls
+	{
+		Metasound::FFloatReadRef Gain;
+		Metasound::FFloatReadRef Bias;
+		Metasound::FFloatReadRef Mix;
+		Metasound::FFloatReadRef OutLevelDb;
+		Metasound::FEnumSaturationReadRef SaturationType;
+		Metasound::FBoolReadRef DCBlockerEnabled;
+		Metasound::FFloatReadRef DCBlockerCutoff;
+		Metasound::FBoolReadRef EnvelopeFollowerEnabled;
+		Metasound::FEnumEnvelopeDetectorModeReadRef EnvelopeDetectorMode;
+		Metasound::FFloatReadRef EnvelopeAttackTimeMs;
+		Metasound::FFloatReadRef EnvelopeReleaseTimeMs;
+		Metasound::FFloatReadRef EnvelopeToGain;
+		Metasound::FFloatReadRef EnvelopeToBias;
+		Metasound::FEnumTapeHysteresisSolverReadRef TapeHysteresisSolver;
+		Metasound::FInt32ReadRef TapeHysteresisOversampling;
+		FSaturationEmphasisControls Emphasis;
+		FSaturationHarmonicControls Harmonics;
+		FSaturationCustomCurveControls CustomCurve;
+
+		static FSaturationNodeControls Create(const Metasound::FBuildOperatorParams& InParams);
+		static void AddInputVertices(Metasound::FInputVertexInterface& InOutInterface);
+
+		void Bind(Metasound::FInputVertexInterfaceData& InOutVertexData);
+		void Apply(DSPProcessing::FSaturation& InOutSaturation) const;
+	};
+
 	class FSaturationOperator : public Metasound::TExecutableOperator<FSaturationOperator>
 	{
 	public:
 		FSaturationOperator(const Metasound::FOperatorSettings& InSettings,
 							const Metasound::FAudioBufferReadRef& InAudioInput,
-							const Metasound::FFloatReadRef& InGain,
-							const Metasound::FFloatReadRef& InBias,
-							const Metasound::FFloatReadRef& InMix,
-							const Metasound::FFloatReadRef& InOutLevelDb,
-							const Metasound::FEnumSaturationReadRef& InSaturationType);
+							const FSaturationNodeControls& InControls);
 
 		static const Metasound::FNodeClassMetadata& GetNodeInfo();
 
@@ -38,12 +127,46 @@ namespace DSPCollection
 		Metasound::FAudioBufferReadRef	AudioInput;
 		Metasound::FAudioBufferWriteRef AudioOutput;
 
-		Metasound::FFloatReadRef Gain;
-		Metasound::FFloatReadRef Bias;
-		Metasound::FFloatReadRef Mix;
-		Metasound::FFloatReadRef OutLevelDb;
-		Metasound::FEnumSaturationReadRef SaturationType;
+		FSaturationNodeControls Controls;
 	};
 
 	using FSaturationNode = Metasound::TNodeFacade<FSaturationOperator>;
+
+	// Stereo/Quad/5.1/7.1 flavors, the channels are interleaved so a single FSaturation processes them 4 samples at a time
+	template <int32 NumChannels>
+	class TSaturationMultichannelOperator : public Metasound::TExecutableOperator<TSaturationMultichannelOperator<NumChannels>>
+	{
+	public:
+		TSaturationMultichannelOperator(const Metasound::FOperatorSettings& InSettings,
+										const TArray<Metasound::FAudioBufferReadRef>& InAudioInputs,
+										const FSaturationNodeControls& InControls);
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+		
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults);
+
+		void Execute();
+		
+		void Reset(const Metasound::IOperator::FResetParams& InParams);
+
+	private:
+		DSPProcessing::FSaturation SaturationDSPProcessor;
+
+		TArray<Metasound::FAudioBufferReadRef>  AudioInputs;
+		TArray<Metasound::FAudioBufferWriteRef> AudioOutputs;
+
+		FSaturationNodeControls Controls;
+
+		// Interleaved scratch buffer, processed in place
+		TArray<float, TAlignedHeapAllocator<16>> InterleavedBuffer;
+	};
+
+	using FSaturationStereoNode = Metasound::TNodeFacade<TSaturationMultichannelOperator<2>>;
+	using FSaturationQuadNode   = Metasound::TNodeFacade<TSaturationMultichannelOperator<4>>;
+	using FSaturation51Node     = Metasound::TNodeFacade<TSaturationMultichannelOperator<6>>;
+	using FSaturation71Node     = Metasound::TNodeFacade<TSaturationMultichannelOperator<8>>;
 }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "IAudioModulation.h"
+
+namespace DSPCollection
+{
+	using FModulators = TSet<TObjectPtr<USoundModulatorBase>>;
+
+	// AudioModulation destination of one effect parameter. The preset holds the base value and the modulators (control buses, LFOs, envelopes)
+	// act on it once per block on the audio thread, so a modulated parameter never goes through a preset update.
+	// Volume parameters mix their modulators in dB like the engine volume destinations, the others are scaled by the product of their modulators.
+	class AUDIODSPCOLLECTION_API FModulatedParam
+	{
+	public:
+		void Init(const Audio::FDeviceId InDeviceId, const bool bInVolume);
+
+		// Called from OnPresetChanged
+		void UpdateModulators(const FModulators& InModulators);
+
+		bool IsModulated() const { return bModulated; }
+
+		// Volume only, the modulated value of InBaseValueDb
+		float ProcessDb(const float InBaseValueDb);
+
+		// Linear multiplier, in [0, 1] for the normalized parameters
+		float ProcessScale();
+
+	private:
+		Audio::FModulationDestination Destination;
+		bool bVolume    = false;
+		bool bModulated = false;
+	};
+}
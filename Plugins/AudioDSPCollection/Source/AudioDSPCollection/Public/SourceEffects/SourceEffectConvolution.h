@@ -0,0 +1,70 @@
+#pragma once
+
+#include "DSPProcessing/Convolution.h"
+#include "SourceEffects/SourceEffectPool.h"
+#include "Sound/SoundEffectSource.h"
+
+#include "SourceEffectConvolution.generated.h"
+
+class UDSPCollectionImpulseResponse;
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+class AUDIODSPCOLLECTION_API FSourceEffectConvolution : public FSoundEffectSource
+{
+public:
+	virtual ~FSourceEffectConvolution() = default;
+
+	// Instances are recycled through TSourceEffectPool, one effect is created per voice
+	DECLARE_SOURCE_EFFECT_POOLED_ALLOCATION()
+
+	// Called on an audio effect at initialization on main thread before audio processing begins.
+	virtual void Init(const FSoundEffectSourceInitData& InitData) override;
+
+	// Called when an audio effect preset is changed
+	virtual void OnPresetChanged() override;
+
+	// Process the input block of audio. Called on audio thread.
+	virtual void ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData) override;
+
+protected:
+	DSPProcessing::FConvolution ConvolutionDSPProcessor;
+	int32 NumChannels;
+	int32 BlockFrames = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSourceEffectConvolutionSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	// No IR bypasses the effect. The partitioned spectra are shared by every voice using the same IR
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	TObjectPtr<UDSPCollectionImpulseResponse> ImpulseResponse = nullptr;
+
+	// Longer partitions for the tail of the IR: cheaper on average for long IRs, with a heavier block every 8 blocks
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", AdvancedDisplay)
+	bool bNonUniformPartitions = false;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class AUDIODSPCOLLECTION_API USourceEffectConvolutionPreset : public USoundEffectSourcePreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SourceEffectConvolution)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Convolution")
+	void SetSettings(const FSourceEffectConvolutionSettings& InSettings);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SourceEffect|Preset", Meta = (ShowOnlyInnerProperties))
+	FSourceEffectConvolutionSettings Settings;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
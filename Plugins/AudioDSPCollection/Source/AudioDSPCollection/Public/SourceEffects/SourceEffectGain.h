@@ -1,11 +1,27 @@
 #pragma once
 
 #include "DSPProcessing/Gain.h"
+#include "Modulation/ModulatedParam.h"
+#include "SourceEffects/SourceEffectPool.h"
 #include "Sound/SoundEffectSource.h"
 
 #include "SourceEffectGain.generated.h"
 
 
+//////////////////////////////////////////////////////////////////////////////////////
+
+UENUM(BlueprintType)
+enum class ESourceEffectGainRampShape : uint8
+{
+	Linear = 0,
+	Exponential,
+	SCurve,
+	EqualPower,
+	Count UMETA(Hidden)
+};
+
+AUDIODSPCOLLECTION_API DSPProcessing::EGainRampShape SourceEffectGainRampShapeToGainRampShape(ESourceEffectGainRampShape SourceEffectGainRampShape);
+
 //////////////////////////////////////////////////////////////////////////////////////
 
 class AUDIODSPCOLLECTION_API FSourceEffectGain : public FSoundEffectSource
@@ -13,6 +29,9 @@ class AUDIODSPCOLLECTION_API FSourceEffectGain : public FSoundEffectSource
 public:
 	virtual ~FSourceEffectGain() = default;
 
+	// Instances are recycled through TSourceEffectPool, one effect is created per voice
+	DECLARE_SOURCE_EFFECT_POOLED_ALLOCATION()
+
 	// Called on an audio effect at initialization on main thread before audio processing begins.
 	virtual void Init(const FSoundEffectSourceInitData& InitData) override;
 
@@ -25,6 +44,10 @@ public:
 protected:
 	DSPProcessing::FGain GainDSPProcessor;
 	int32 NumChannels;
+	float SampleRate;
+
+	DSPCollection::FModulatedParam GainModulation;
+	float BaseGain = 1.0f;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +59,17 @@ struct AUDIODSPCOLLECTION_API FSourceEffectGainSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-4.0", ClampMax = "4.0", UIMin = "-4.0", UIMax = "4.0"))
 	float Gain = 1.0f;
+
+	// 0 smooths the gain change, otherwise the gain ramps to its new value in exactly FadeTimeMs
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "0.0", ClampMax = "10000.0", UIMin = "0.0", UIMax = "10000.0", Units = "ms"))
+	float FadeTimeMs = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "FadeTimeMs > 0.0", EditConditionHides))
+	ESourceEffectGainRampShape FadeShape = ESourceEffectGainRampShape::Linear;
+
+	// AudioModulation volume modulators applied on top of Gain. They are held while a fade is running and resume from its target
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Modulation", meta = (AudioParam = "Volume", AudioParamClass = "SoundModulationParameterVolume"))
+	TSet<TObjectPtr<USoundModulatorBase>> GainModulators;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "DSPProcessing/GainMatrix.h"
+#include "SourceEffects/SourceEffectPool.h"
+#include "Sound/SoundEffectSource.h"
+
+#include "SourceEffectGainMatrix.generated.h"
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UENUM(BlueprintType)
+enum class ESourceEffectGainMatrixLayout : uint8
+{
+	Identity = 0,
+	Custom,
+	DownmixToMono,
+	DownmixToStereo,
+	MonoToStereo,
+	SwapStereo,
+	Count UMETA(Hidden)
+};
+
+AUDIODSPCOLLECTION_API DSPProcessing::EGainMatrixLayout SourceEffectGainMatrixLayoutToGainMatrixLayout(ESourceEffectGainMatrixLayout SourceEffectGainMatrixLayout);
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+class AUDIODSPCOLLECTION_API FSourceEffectGainMatrix : public FSoundEffectSource
+{
+public:
+	virtual ~FSourceEffectGainMatrix() = default;
+
+	// Instances are recycled through TSourceEffectPool, one effect is created per voice
+	DECLARE_SOURCE_EFFECT_POOLED_ALLOCATION()
+
+	// Called on an audio effect at initialization on main thread before audio processing begins.
+	virtual void Init(const FSoundEffectSourceInitData& InitData) override;
+
+	// Called when an audio effect preset is changed
+	virtual void OnPresetChanged() override;
+
+	// Process the input block of audio. Called on audio thread.
+	virtual void ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData) override;
+
+protected:
+	DSPProcessing::FGainMatrix GainMatrixDSPProcessor;
+	int32 NumChannels;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSourceEffectGainMatrixEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "0", ClampMax = "7", UIMin = "0", UIMax = "7"))
+	int32 InputChannel = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "0", ClampMax = "7", UIMin = "0", UIMax = "7"))
+	int32 OutputChannel = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-4.0", ClampMax = "4.0", UIMin = "-4.0", UIMax = "4.0"))
+	float Gain = 1.0f;
+};
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSourceEffectGainMatrixSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	ESourceEffectGainMatrixLayout Layout = ESourceEffectGainMatrixLayout::Identity;
+
+	// Non zero coefficients of the matrix, channels not listed are silent
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "Layout == ESourceEffectGainMatrixLayout::Custom", EditConditionHides))
+	TArray<FSourceEffectGainMatrixEntry> CustomEntries;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class AUDIODSPCOLLECTION_API USourceEffectGainMatrixPreset : public USoundEffectSourcePreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SourceEffectGainMatrix)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|GainMatrix")
+	void SetSettings(const FSourceEffectGainMatrixSettings& InSettings);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SourceEffect|Preset", Meta = (ShowOnlyInnerProperties))
+	FSourceEffectGainMatrixSettings Settings;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "DSPProcessing/Limiter.h"
+#include "SourceEffects/SourceEffectPool.h"
+#include "Sound/SoundEffectSource.h"
+
+#include "SourceEffectLimiter.generated.h"
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+class AUDIODSPCOLLECTION_API FSourceEffectLimiter : public FSoundEffectSource
+{
+public:
+	virtual ~FSourceEffectLimiter() = default;
+
+	// Instances are recycled through TSourceEffectPool, one effect is created per voice
+	DECLARE_SOURCE_EFFECT_POOLED_ALLOCATION()
+
+	// Called on an audio effect at initialization on main thread before audio processing begins.
+	virtual void Init(const FSoundEffectSourceInitData& InitData) override;
+
+	// Called when an audio effect preset is changed
+	virtual void OnPresetChanged() override;
+
+	// Process the input block of audio. Called on audio thread.
+	virtual void ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData) override;
+
+protected:
+	DSPProcessing::FLimiter LimiterDSPProcessor;
+	int32 NumChannels;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSourceEffectLimiterSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Maximum output level
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-24.0", ClampMax = "0.0", UIMin = "-24.0", UIMax = "0.0", Units = "dB"))
+	float CeilingDb = -1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "1.0", ClampMax = "5000.0", UIMin = "1.0", UIMax = "5000.0", Units = "ms"))
+	float ReleaseTimeMs = 100.0f;
+
+	// Also the attack time and the latency of the effect, changing it clears the delayed audio
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "0.5", ClampMax = "20.0", UIMin = "0.5", UIMax = "20.0", Units = "ms"))
+	float LookAheadMs = 5.0f;
+
+	// Catches the peaks between the samples with a 4x oversampled detector, at the cost of 4 frames of the look-ahead
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	bool bTruePeak = false;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class AUDIODSPCOLLECTION_API USourceEffectLimiterPreset : public USoundEffectSourcePreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SourceEffectLimiter)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Limiter")
+	void SetSettings(const FSourceEffectLimiterSettings& InSettings);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SourceEffect|Preset", Meta = (ShowOnlyInnerProperties))
+	FSourceEffectLimiterSettings Settings;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
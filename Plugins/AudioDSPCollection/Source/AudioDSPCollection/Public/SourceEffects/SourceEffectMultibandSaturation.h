@@ -0,0 +1,108 @@
+#pragma once
+
+#include "DSPProcessing/MultibandSaturation.h"
+#include "SourceEffects/SourceEffectSaturation.h"
+#include "SourceEffects/SourceEffectPool.h"
+#include "Sound/SoundEffectSource.h"
+
+#include "SourceEffectMultibandSaturation.generated.h"
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+class AUDIODSPCOLLECTION_API FSourceEffectMultibandSaturation : public FSoundEffectSource
+{
+public:
+	virtual ~FSourceEffectMultibandSaturation() = default;
+
+	// Instances are recycled through TSourceEffectPool, one effect is created per voice
+	DECLARE_SOURCE_EFFECT_POOLED_ALLOCATION()
+
+	// Called on an audio effect at initialization on main thread before audio processing begins.
+	virtual void Init(const FSoundEffectSourceInitData& InitData) override;
+
+	// Called when an audio effect preset is changed
+	virtual void OnPresetChanged() override;
+
+	// Process the input block of audio. Called on audio thread.
+	virtual void ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData) override;
+
+protected:
+	DSPProcessing::FMultibandSaturation MultibandSaturationDSPProcessor;
+	int32 NumChannels;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSourceEffectMultibandSaturationBandSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	// The band curves are evaluated per lane, so only the memoryless types can be picked
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (InvalidEnumValues = "TapeHysteresis, Harmonic, Custom"))
+	ESourceEffectSaturationType SaturationType = ESourceEffectSaturationType::Tape;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "0.0", ClampMax = "100.0", UIMin = "0.0", UIMax = "100.0"))
+	float Gain = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "0.0", ClampMax = "100.0", UIMin = "0.0", UIMax = "100.0"))
+	float Mix = 100.0f;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSourceEffectMultibandSaturationSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "2", ClampMax = "4", UIMin = "2", UIMax = "4"))
+	int32 NumBands = 3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "20.0", ClampMax = "20000.0", UIMin = "20.0", UIMax = "20000.0"))
+	float CrossoverFrequency1 = 200.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "20.0", ClampMax = "20000.0", UIMin = "20.0", UIMax = "20000.0"))
+	float CrossoverFrequency2 = 2000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "NumBands > 3", ClampMin = "20.0", ClampMax = "20000.0", UIMin = "20.0", UIMax = "20000.0"))
+	float CrossoverFrequency3 = 8000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	FSourceEffectMultibandSaturationBandSettings Band1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	FSourceEffectMultibandSaturationBandSettings Band2;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "NumBands > 2"))
+	FSourceEffectMultibandSaturationBandSettings Band3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "NumBands > 3"))
+	FSourceEffectMultibandSaturationBandSettings Band4;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Bias = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-96.0", ClampMax = "24.0", UIMin = "-96.0", UIMax = "24.0"))
+	float OutLevelDb = 0.0f;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class AUDIODSPCOLLECTION_API USourceEffectMultibandSaturationPreset : public USoundEffectSourcePreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SourceEffectMultibandSaturation)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Saturation")
+	void SetSettings(const FSourceEffectMultibandSaturationSettings& InSettings);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SourceEffect|Preset", Meta = (ShowOnlyInnerProperties))
+	FSourceEffectMultibandSaturationSettings Settings;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
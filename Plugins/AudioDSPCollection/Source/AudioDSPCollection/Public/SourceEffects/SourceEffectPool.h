@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Containers/LockFreeFixedSizeAllocator.h"
+#include "HAL/ThreadSafeCounter.h"
+
+// Fixed size free list per source effect class. Source effects are created and destroyed with every voice,
+// so recycling the blocks avoids going through the general allocator thousands of times per second.
+// Declare DECLARE_SOURCE_EFFECT_POOLED_ALLOCATION() in the effect class and DEFINE_SOURCE_EFFECT_POOLED_ALLOCATION(Class) in its .cpp
+template <typename EffectType>
+class TSourceEffectPool
+{
+public:
+	static void* Allocate(const SIZE_T InSize)
+	{
+		// Subclasses don't fit in the pool blocks
+		if (InSize != sizeof(EffectType))
+		{
+			return FMemory::Malloc(InSize, alignof(EffectType));
+		}
+
+		return GetAllocator().Allocate();
+	}
+
+	static void Free(void* InPtr, const SIZE_T InSize)
+	{
+		if (InSize != sizeof(EffectType))
+		{
+			FMemory::Free(InPtr);
+			return;
+		}
+
+		GetAllocator().Free(InPtr);
+	}
+
+	static int32 GetNumUsed()
+	{
+		return GetAllocator().GetNumUsed().GetValue();
+	}
+
+	static int32 GetNumFree()
+	{
+		return GetAllocator().GetNumFree().GetValue();
+	}
+
+private:
+	// FMemory::Malloc default alignment, the pool blocks have no extra alignment
+	static_assert(alignof(EffectType) <= 16, "Pooled source effects must not need more than 16 bytes alignment");
+
+	using FAllocator = TLockFreeFixedSizeAllocator<Align(sizeof(EffectType), 16), PLATFORM_CACHE_LINE_SIZE, FThreadSafeCounter>;
+
+	static FAllocator& GetAllocator()
+	{
+		static FAllocator Allocator;
+		return Allocator;
+	}
+};
+
+#define DECLARE_SOURCE_EFFECT_POOLED_ALLOCATION() \
+	static void* operator new(size_t InSize); \
+	static void operator delete(void* InPtr, size_t InSize);
+
+#define DEFINE_SOURCE_EFFECT_POOLED_ALLOCATION(EffectClass) \
+	void* EffectClass::operator new(size_t InSize) \
+	{ \
+		return TSourceEffectPool<EffectClass>::Allocate(InSize); \
+	} \
+	void EffectClass::operator delete(void* InPtr, size_t InSize) \
+	{ \
+		TSourceEffectPool<EffectClass>::Free(InPtr, InSize); \
+	}
@@ -1,10 +1,17 @@
 #pragma once
 
+#include "DSPProcessing/Convolution.h"
+#include "DSPProcessing/Limiter.h"
 #include "DSPProcessing/Saturation.h"
+#include "Modulation/ModulatedParam.h"
+#include "SourceEffects/SourceEffectPool.h"
 #include "Sound/SoundEffectSource.h"
 
 #include "SourceEffectSaturation.generated.h"
 
+class UDSPCollectionImpulseResponse;
+class UDSPCollectionTransferCurve;
+
 
 //////////////////////////////////////////////////////////////////////////////////////
 
@@ -23,9 +30,95 @@ enum class ESourceEffectSaturationType : uint8
 	Foldback,
 	HalfWaveRectifier,
 	FullWaveRectifier,
+	TapeHysteresis, // Not available on the Multiband Saturation bands
+	Harmonic,       // Not available on the Multiband Saturation bands
+	Custom,         // Not available on the Multiband Saturation bands
+	Count UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class ESourceEffectTapeHysteresisSolver : uint8
+{
+	RK2 = 0,
+	RK4,
+	Count UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class ESourceEffectEnvelopeDetectorMode : uint8
+{
+	Peak = 0,
+	RMS,
 	Count UMETA(Hidden)
 };
 
+UENUM(BlueprintType)
+enum class ESourceEffectEmphasisFilterType : uint8
+{
+	Off = 0,
+	LowCut,
+	HighCut,
+	LowShelf,
+	HighShelf,
+	Peak,
+	Count UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSourceEffectSaturationEmphasisBand
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	ESourceEffectEmphasisFilterType Type = ESourceEffectEmphasisFilterType::Off;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "Type != ESourceEffectEmphasisFilterType::Off", ClampMin = "20.0", ClampMax = "20000.0", UIMin = "20.0", UIMax = "20000.0", Units = "Hz"))
+	float Frequency = 1000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "Type == ESourceEffectEmphasisFilterType::LowShelf || Type == ESourceEffectEmphasisFilterType::HighShelf || Type == ESourceEffectEmphasisFilterType::Peak", ClampMin = "-24.0", ClampMax = "24.0", UIMin = "-24.0", UIMax = "24.0", Units = "dB"))
+	float GainDb = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "Type != ESourceEffectEmphasisFilterType::Off", ClampMin = "0.1", ClampMax = "10.0", UIMin = "0.1", UIMax = "10.0"))
+	float Q = 0.707f;
+};
+
+// Level of each harmonic of a full scale input, for the Harmonic type. Negative values invert its phase
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSourceEffectSaturationHarmonics
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Fundamental = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Second = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Third = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Fourth = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Fifth = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Sixth = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Seventh = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Eighth = 0.0f;
+};
+
+AUDIODSPCOLLECTION_API DSPProcessing::ESaturationType SourceEffectSaturationTypeToSaturationType(ESourceEffectSaturationType SourceEffectSaturationType);
+AUDIODSPCOLLECTION_API DSPProcessing::ETapeHysteresisSolver SourceEffectTapeHysteresisSolverToTapeHysteresisSolver(ESourceEffectTapeHysteresisSolver SourceEffectTapeHysteresisSolver);
+AUDIODSPCOLLECTION_API DSPProcessing::EEnvelopeDetectorMode SourceEffectEnvelopeDetectorModeToEnvelopeDetectorMode(ESourceEffectEnvelopeDetectorMode SourceEffectEnvelopeDetectorMode);
+AUDIODSPCOLLECTION_API DSPProcessing::FEmphasisBand SourceEffectSaturationEmphasisBandToEmphasisBand(const FSourceEffectSaturationEmphasisBand& SourceEffectSaturationEmphasisBand);
+AUDIODSPCOLLECTION_API void SourceEffectSaturationHarmonicsToHarmonicWeights(const FSourceEffectSaturationHarmonics& SourceEffectSaturationHarmonics, DSPProcessing::FSaturation& OutSaturation);
+
 //////////////////////////////////////////////////////////////////////////////////////
 
 class AUDIODSPCOLLECTION_API FSourceEffectSaturation : public FSoundEffectSource
@@ -33,6 +126,9 @@ class AUDIODSPCOLLECTION_API FSourceEffectSaturation : public FSoundEffectSource
 public:
 	virtual ~FSourceEffectSaturation() = default;
 
+	// Instances are recycled through TSourceEffectPool, one effect is created per voice
+	DECLARE_SOURCE_EFFECT_POOLED_ALLOCATION()
+
 	// Called on an audio effect at initialization on main thread before audio processing begins.
 	virtual void Init(const FSoundEffectSourceInitData& InitData) override;
 
@@ -45,6 +141,27 @@ public:
 protected:
 	DSPProcessing::FSaturation SaturationDSPProcessor;
 	int32 NumChannels;
+
+	// Cabinet/IR coloring after the saturation, in place on the output
+	DSPProcessing::FConvolution CabinetDSPProcessor;
+	int32 BlockFrames = 0;
+
+	// Fused after the saturation (and the cabinet), in place on the output
+	DSPProcessing::FLimiter LimiterDSPProcessor;
+	bool bLimiterEnabled = false;
+
+	// AudioModulation on top of the preset Gain/Bias/Mix/OutLevelDb, read once per block
+	void ApplyModulation();
+
+	DSPCollection::FModulatedParam GainModulation;
+	DSPCollection::FModulatedParam BiasModulation;
+	DSPCollection::FModulatedParam MixModulation;
+	DSPCollection::FModulatedParam OutLevelModulation;
+	float BaseGain       = 100.0f;
+	float BaseBias       = 0.0f;
+	float BaseMix        = 100.0f;
+	float BaseOutLevelDb = 0.0f;
+	bool  bModulated     = false;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -66,8 +183,107 @@ struct AUDIODSPCOLLECTION_API FSourceEffectSaturationSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (ClampMin = "-96.0", ClampMax = "24.0", UIMin = "-96.0", UIMax = "24.0"))
 	float OutLevelDb = 0.0f;
 
+	// AudioModulation modulators (control buses, LFOs, envelope followers) scaling Gain, from 0 to the preset value
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Modulation")
+	TSet<TObjectPtr<USoundModulatorBase>> GainModulators;
+
+	// Scale Bias, from 0 to the preset value
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Modulation")
+	TSet<TObjectPtr<USoundModulatorBase>> BiasModulators;
+
+	// Scale Mix, from 0 to the preset value
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Modulation")
+	TSet<TObjectPtr<USoundModulatorBase>> MixModulators;
+
+	// Volume modulators, their attenuation in dB is added to OutLevelDb
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Modulation", meta = (AudioParam = "Volume", AudioParamClass = "SoundModulationParameterVolume"))
+	TSet<TObjectPtr<USoundModulatorBase>> OutLevelModulators;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
 	ESourceEffectSaturationType SaturationType = ESourceEffectSaturationType::Tape;
+
+	// RK4 is more accurate on steep inputs, RK2 costs half the solver evaluations
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "SaturationType == ESourceEffectSaturationType::TapeHysteresis", EditConditionHides))
+	ESourceEffectTapeHysteresisSolver TapeHysteresisSolver = ESourceEffectTapeHysteresisSolver::RK4;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "SaturationType == ESourceEffectSaturationType::TapeHysteresis", EditConditionHides, ClampMin = "1", ClampMax = "4", UIMin = "1", UIMax = "4"))
+	int32 TapeHysteresisOversampling = 1;
+
+	// Polynomial curve, exact harmonic levels up to a full scale input (Gain 0), the higher gains clamp the input
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "SaturationType == ESourceEffectSaturationType::Harmonic", EditConditionHides))
+	FSourceEffectSaturationHarmonics Harmonics;
+
+	// Curve drawn in a DSPCollection Transfer Curve asset, no asset falls back to Tape
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "SaturationType == ESourceEffectSaturationType::Custom", EditConditionHides))
+	TObjectPtr<UDSPCollectionTransferCurve> CustomCurve = nullptr;
+
+	// Removes the DC offset introduced by Bias with a one-pole high-pass at the output
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	bool bDCBlockerEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bDCBlockerEnabled", ClampMin = "5.0", ClampMax = "200.0", UIMin = "5.0", UIMax = "200.0"))
+	float DCBlockerCutoffFrequency = 10.0f;
+
+	// Follows the input level and modulates Gain and Bias with it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	bool bEnvelopeFollowerEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled"))
+	ESourceEffectEnvelopeDetectorMode EnvelopeDetectorMode = ESourceEffectEnvelopeDetectorMode::Peak;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled", ClampMin = "0.1", ClampMax = "500.0", UIMin = "0.1", UIMax = "500.0"))
+	float EnvelopeAttackTimeMs = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled", ClampMin = "1.0", ClampMax = "5000.0", UIMin = "1.0", UIMax = "5000.0"))
+	float EnvelopeReleaseTimeMs = 100.0f;
+
+	// Positive values reduce the drive as the level drops (cleaner quiet tails), negative values increase it (sag)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled", ClampMin = "-100.0", ClampMax = "100.0", UIMin = "-100.0", UIMax = "100.0"))
+	float EnvelopeToGain = 0.0f;
+
+	// Amount of Bias added at full scale input
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled", ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float EnvelopeToBias = 0.0f;
+
+	// Biquads on the input of the curve, e.g. a low cut to keep the lows clean or a mid peak to focus the drive. The dry path is not filtered
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	FSourceEffectSaturationEmphasisBand PreEmphasisBand1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	FSourceEffectSaturationEmphasisBand PreEmphasisBand2;
+
+	// Biquads on the output of the curve before the mix, e.g. a high cut to tame the generated harmonics
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	FSourceEffectSaturationEmphasisBand PostEmphasisBand1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	FSourceEffectSaturationEmphasisBand PostEmphasisBand2;
+
+	// Convolved with the saturated signal (cabinet, mic or any coloring IR), before the limiter. No IR disables it, no latency
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	TObjectPtr<UDSPCollectionImpulseResponse> CabinetImpulseResponse = nullptr;
+
+	// Longer partitions for the tail of the IR: cheaper on average for long IRs, with a heavier block every 8 blocks
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", AdvancedDisplay)
+	bool bCabinetNonUniformPartitions = false;
+
+	// Look-ahead brickwall limiter after the saturation, keeps the output under LimiterCeilingDb whatever Gain and OutLevelDb are.
+	// Adds LimiterLookAheadMs of latency
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset")
+	bool bLimiterEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bLimiterEnabled", ClampMin = "-24.0", ClampMax = "0.0", UIMin = "-24.0", UIMax = "0.0", Units = "dB"))
+	float LimiterCeilingDb = -1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bLimiterEnabled", ClampMin = "1.0", ClampMax = "5000.0", UIMin = "1.0", UIMax = "5000.0", Units = "ms"))
+	float LimiterReleaseTimeMs = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bLimiterEnabled", ClampMin = "0.5", ClampMax = "20.0", UIMin = "0.5", UIMax = "20.0", Units = "ms"))
+	float LimiterLookAheadMs = 5.0f;
+
+	// 4x oversampled detector, catches the peaks between the samples
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SourceEffect|Preset", meta = (EditCondition = "bLimiterEnabled"))
+	bool bLimiterTruePeak = false;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "DSPProcessing/Convolution.h"
+#include "Sound/SoundEffectSubmix.h"
+
+#include "SubmixEffectConvolution.generated.h"
+
+class UDSPCollectionImpulseResponse;
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+class AUDIODSPCOLLECTION_API FSubmixEffectConvolution : public FSoundEffectSubmix
+{
+public:
+	virtual ~FSubmixEffectConvolution() = default;
+
+	// Called on an audio effect at initialization on main thread before audio processing begins.
+	virtual void Init(const FSoundEffectSubmixInitData& InitData) override;
+
+	// Called when an audio effect preset is changed
+	virtual void OnPresetChanged() override;
+
+	// Process the input block of audio. Called on audio thread.
+	virtual void OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData) override;
+
+protected:
+	DSPProcessing::FConvolution ConvolutionDSPProcessor;
+	int32 BlockFrames = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSubmixEffectConvolutionSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	// No IR bypasses the effect
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	TObjectPtr<UDSPCollectionImpulseResponse> ImpulseResponse = nullptr;
+
+	// Longer partitions for the tail of the IR: cheaper on average for long IRs, with a heavier block every 8 blocks
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", AdvancedDisplay)
+	bool bNonUniformPartitions = false;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class AUDIODSPCOLLECTION_API USubmixEffectConvolutionPreset : public USoundEffectSubmixPreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SubmixEffectConvolution)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Convolution")
+	void SetSettings(const FSubmixEffectConvolutionSettings& InSettings);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", Meta = (ShowOnlyInnerProperties))
+	FSubmixEffectConvolutionSettings Settings;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
@@ -1,11 +1,26 @@
 #pragma once
 
 #include "DSPProcessing/Gain.h"
+#include "Modulation/ModulatedParam.h"
 #include "Sound/SoundEffectSubmix.h"
 
 #include "SubmixEffectGain.generated.h"
 
 
+//////////////////////////////////////////////////////////////////////////////////////
+
+UENUM(BlueprintType)
+enum class ESubmixEffectGainRampShape : uint8
+{
+	Linear = 0,
+	Exponential,
+	SCurve,
+	EqualPower,
+	Count UMETA(Hidden)
+};
+
+AUDIODSPCOLLECTION_API DSPProcessing::EGainRampShape SubmixEffectGainRampShapeToGainRampShape(ESubmixEffectGainRampShape SubmixEffectGainRampShape);
+
 //////////////////////////////////////////////////////////////////////////////////////
 
 class AUDIODSPCOLLECTION_API FSubmixEffectGain : public FSoundEffectSubmix
@@ -24,6 +39,10 @@ public:
 
 protected:
 	DSPProcessing::FGain GainDSPProcessor;
+	float SampleRate;
+
+	DSPCollection::FModulatedParam GainModulation;
+	float BaseGain = 1.0f;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +54,17 @@ struct AUDIODSPCOLLECTION_API FSubmixEffectGainSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-4.0", ClampMax = "4.0", UIMin = "-4.0", UIMax = "4.0"))
 	float Gain = 1.0f;
+
+	// 0 smooths the gain change, otherwise the gain ramps to its new value in exactly FadeTimeMs
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "0.0", ClampMax = "10000.0", UIMin = "0.0", UIMax = "10000.0", Units = "ms"))
+	float FadeTimeMs = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "FadeTimeMs > 0.0", EditConditionHides))
+	ESubmixEffectGainRampShape FadeShape = ESubmixEffectGainRampShape::Linear;
+
+	// AudioModulation volume modulators applied on top of Gain. They are held while a fade is running and resume from its target
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Modulation", meta = (AudioParam = "Volume", AudioParamClass = "SoundModulationParameterVolume"))
+	TSet<TObjectPtr<USoundModulatorBase>> GainModulators;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "DSPProcessing/GainMatrix.h"
+#include "Sound/SoundEffectSubmix.h"
+
+#include "SubmixEffectGainMatrix.generated.h"
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UENUM(BlueprintType)
+enum class ESubmixEffectGainMatrixLayout : uint8
+{
+	Identity = 0,
+	Custom,
+	DownmixToMono,
+	DownmixToStereo,
+	MonoToStereo,
+	SwapStereo,
+	Count UMETA(Hidden)
+};
+
+AUDIODSPCOLLECTION_API DSPProcessing::EGainMatrixLayout SubmixEffectGainMatrixLayoutToGainMatrixLayout(ESubmixEffectGainMatrixLayout SubmixEffectGainMatrixLayout);
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+class AUDIODSPCOLLECTION_API FSubmixEffectGainMatrix : public FSoundEffectSubmix
+{
+public:
+	virtual ~FSubmixEffectGainMatrix() = default;
+
+	// Called on an audio effect at initialization on main thread before audio processing begins.
+	virtual void Init(const FSoundEffectSubmixInitData& InitData) override;
+
+	// Called when an audio effect preset is changed
+	virtual void OnPresetChanged() override;
+
+	// Process the input block of audio. Called on audio thread.
+	virtual void OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData) override;
+
+protected:
+	DSPProcessing::FGainMatrix GainMatrixDSPProcessor;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSubmixEffectGainMatrixEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "0", ClampMax = "7", UIMin = "0", UIMax = "7"))
+	int32 InputChannel = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "0", ClampMax = "7", UIMin = "0", UIMax = "7"))
+	int32 OutputChannel = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-4.0", ClampMax = "4.0", UIMin = "-4.0", UIMax = "4.0"))
+	float Gain = 1.0f;
+};
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSubmixEffectGainMatrixSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	ESubmixEffectGainMatrixLayout Layout = ESubmixEffectGainMatrixLayout::Identity;
+
+	// Non zero coefficients of the matrix, channels not listed are silent
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "Layout == ESubmixEffectGainMatrixLayout::Custom", EditConditionHides))
+	TArray<FSubmixEffectGainMatrixEntry> CustomEntries;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class AUDIODSPCOLLECTION_API USubmixEffectGainMatrixPreset : public USoundEffectSubmixPreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SubmixEffectGainMatrix)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|GainMatrix")
+	void SetSettings(const FSubmixEffectGainMatrixSettings& InSettings);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", Meta = (ShowOnlyInnerProperties))
+	FSubmixEffectGainMatrixSettings Settings;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "DSPProcessing/Limiter.h"
+#include "Sound/SoundEffectSubmix.h"
+
+#include "SubmixEffectLimiter.generated.h"
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+class AUDIODSPCOLLECTION_API FSubmixEffectLimiter : public FSoundEffectSubmix
+{
+public:
+	virtual ~FSubmixEffectLimiter() = default;
+
+	// Called on an audio effect at initialization on main thread before audio processing begins.
+	virtual void Init(const FSoundEffectSubmixInitData& InitData) override;
+
+	// Called when an audio effect preset is changed
+	virtual void OnPresetChanged() override;
+
+	// Process the input block of audio. Called on audio thread.
+	virtual void OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData) override;
+
+	// The look-ahead
+	int32 GetLatencyInFrames() const;
+
+	// The limiter buffers are allocated for this many channels at Init (third order ambisonics), a wider submix reallocates once
+	static constexpr int32 MaxNumChannels = 16;
+
+protected:
+	DSPProcessing::FLimiter LimiterDSPProcessor;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSubmixEffectLimiterSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Maximum output level
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-24.0", ClampMax = "0.0", UIMin = "-24.0", UIMax = "0.0", Units = "dB"))
+	float CeilingDb = -1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "1.0", ClampMax = "5000.0", UIMin = "1.0", UIMax = "5000.0", Units = "ms"))
+	float ReleaseTimeMs = 100.0f;
+
+	// Also the attack time and the latency of the effect, changing it clears the delayed audio
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "0.5", ClampMax = "20.0", UIMin = "0.5", UIMax = "20.0", Units = "ms"))
+	float LookAheadMs = 5.0f;
+
+	// Catches the peaks between the samples with a 4x oversampled detector, at the cost of 4 frames of the look-ahead
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	bool bTruePeak = true;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class AUDIODSPCOLLECTION_API USubmixEffectLimiterPreset : public USoundEffectSubmixPreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SubmixEffectLimiter)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Limiter")
+	void SetSettings(const FSubmixEffectLimiterSettings& InSettings);
+
+	// Delay of the output (the look-ahead), the mixer doesn't compensate it: use it to align the dry or parallel paths
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Limiter")
+	int32 GetLatencyInFrames(const float SampleRate = 48000.0f) const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", Meta = (ShowOnlyInnerProperties))
+	FSubmixEffectLimiterSettings Settings;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "DSPProcessing/MultibandSaturation.h"
+#include "SubmixEffects/SubmixEffectSaturation.h"
+#include "Sound/SoundEffectSubmix.h"
+
+#include "SubmixEffectMultibandSaturation.generated.h"
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+class AUDIODSPCOLLECTION_API FSubmixEffectMultibandSaturation : public FSoundEffectSubmix
+{
+public:
+	virtual ~FSubmixEffectMultibandSaturation() = default;
+
+	// Called on an audio effect at initialization on main thread before audio processing begins.
+	virtual void Init(const FSoundEffectSubmixInitData& InitData) override;
+
+	// Called when an audio effect preset is changed
+	virtual void OnPresetChanged() override;
+
+	// Process the input block of audio. Called on audio thread.
+	virtual void OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData) override;
+
+protected:
+	DSPProcessing::FMultibandSaturation MultibandSaturationDSPProcessor;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSubmixEffectMultibandSaturationBandSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	// The band curves are evaluated per lane, so only the memoryless types can be picked
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (InvalidEnumValues = "TapeHysteresis, Harmonic, Custom"))
+	ESubmixEffectSaturationType SaturationType = ESubmixEffectSaturationType::Tape;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "0.0", ClampMax = "100.0", UIMin = "0.0", UIMax = "100.0"))
+	float Gain = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "0.0", ClampMax = "100.0", UIMin = "0.0", UIMax = "100.0"))
+	float Mix = 100.0f;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSubmixEffectMultibandSaturationSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "2", ClampMax = "4", UIMin = "2", UIMax = "4"))
+	int32 NumBands = 3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "20.0", ClampMax = "20000.0", UIMin = "20.0", UIMax = "20000.0"))
+	float CrossoverFrequency1 = 200.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "20.0", ClampMax = "20000.0", UIMin = "20.0", UIMax = "20000.0"))
+	float CrossoverFrequency2 = 2000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "NumBands > 3", ClampMin = "20.0", ClampMax = "20000.0", UIMin = "20.0", UIMax = "20000.0"))
+	float CrossoverFrequency3 = 8000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	FSubmixEffectMultibandSaturationBandSettings Band1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	FSubmixEffectMultibandSaturationBandSettings Band2;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "NumBands > 2"))
+	FSubmixEffectMultibandSaturationBandSettings Band3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "NumBands > 3"))
+	FSubmixEffectMultibandSaturationBandSettings Band4;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Bias = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-96.0", ClampMax = "24.0", UIMin = "-96.0", UIMax = "24.0"))
+	float OutLevelDb = 0.0f;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class AUDIODSPCOLLECTION_API USubmixEffectMultibandSaturationPreset : public USoundEffectSubmixPreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(SubmixEffectMultibandSaturation)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Saturation")
+	void SetSettings(const FSubmixEffectMultibandSaturationSettings& InSettings);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", Meta = (ShowOnlyInnerProperties))
+	FSubmixEffectMultibandSaturationSettings Settings;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
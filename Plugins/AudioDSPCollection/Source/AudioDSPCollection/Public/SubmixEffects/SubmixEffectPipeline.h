@@ -0,0 +1,69 @@
+#pragma once
+
+#include "DSP/AlignedBuffer.h"
+#include "HAL/Runnable.h"
+#include "Templates/Function.h"
+
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+
+// Runs a submix effect on a dedicated worker thread, one block behind the audio render thread.
+// Every block the render thread collects the previous block result (ReceiveBlock) and hands over the new block (SubmitBlock).
+// A single block is in flight at a time, double buffered: the worker processes one buffer while the other keeps the last result.
+// Both buffers are allocated by Init and the worker thread is started there, the render thread never allocates, never launches
+// a task and never waits: if the worker misses a block the output is silent for that block, the new block is dropped and NumOverruns counts it.
+// LatencyInBlocks is informational only, the mixer never compensates it: the owning effect reports it so dry or parallel paths
+// can be aligned by hand (see USubmixEffectSaturationPreset::GetLatencyInFrames).
+class AUDIODSPCOLLECTION_API FSubmixEffectPipeline : private FRunnable
+{
+public:
+	using FProcessFunction = TUniqueFunction<void(float* /*InOutBuffer*/, const int32 /*InNumSamples*/)>;
+
+	~FSubmixEffectPipeline();
+
+	// Not on the render thread. Allocates both buffers for blocks up to InMaxNumSamples (frames * channels) and starts the worker
+	void Init(FProcessFunction&& InProcessFunction, const int32 InMaxNumSamples);
+
+	// Render thread. Writes the result of the previous block (silence if there is none yet). False when the worker is late (overrun):
+	// the output is silent, the worker still owns the processor and SubmitBlock must not be called for this block
+	bool ReceiveBlock(float* OutBuffer, const int32 InNumSamples);
+
+	// Render thread, only after ReceiveBlock returned true. A block larger than the buffers is dropped and counted as an overrun
+	void SubmitBlock(const float* InBuffer, const int32 InNumSamples);
+
+	// True when no block is in flight, the processor is owned by the render thread
+	bool IsIdle() const;
+
+	// Render thread, when leaving pipelined mode so a stale block doesn't come out when it is enabled again
+	void DiscardResult();
+
+	// Blocks dropped because the worker was late or they didn't fit the buffers
+	int32 GetNumOverruns() const;
+
+	static constexpr int32 LatencyInBlocks = 1;
+
+private:
+	// FRunnable, worker thread
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	// Stops and joins the worker, never called on the render thread
+	void Shutdown();
+
+	FProcessFunction ProcessFunction;
+
+	Audio::FAlignedFloatBuffer Buffers[2];
+	int32 MaxNumSamples      = 0;
+	int32 InFlightIndex      = 0;     // Buffer handed to the worker by the last SubmitBlock, holds its result once the worker is done
+	int32 NumSamplesInFlight = 0;
+	bool  bHasResult         = false; // Buffers[InFlightIndex] holds a processed block that hasn't been received yet
+	int32 NumOverruns        = 0;
+
+	std::atomic<bool> bBlockInFlight = false;
+	std::atomic<bool> bStopping      = false;
+
+	FEvent*          WorkEvent    = nullptr;
+	FRunnableThread* WorkerThread = nullptr;
+};
@@ -1,10 +1,17 @@
 #pragma once
 
+#include "DSPProcessing/Convolution.h"
+#include "DSPProcessing/Limiter.h"
 #include "DSPProcessing/Saturation.h"
+#include "Modulation/ModulatedParam.h"
+#include "SubmixEffects/SubmixEffectPipeline.h"
 #include "Sound/SoundEffectSubmix.h"
 
 #include "SubmixEffectSaturation.generated.h"
 
+class UDSPCollectionImpulseResponse;
+class UDSPCollectionTransferCurve;
+
 
 //////////////////////////////////////////////////////////////////////////////////////
 
@@ -23,9 +30,95 @@ enum class ESubmixEffectSaturationType : uint8
 	Foldback,
 	HalfWaveRectifier,
 	FullWaveRectifier,
+	TapeHysteresis, // Not available on the Multiband Saturation bands
+	Harmonic,       // Not available on the Multiband Saturation bands
+	Custom,         // Not available on the Multiband Saturation bands
+	Count UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class ESubmixEffectTapeHysteresisSolver : uint8
+{
+	RK2 = 0,
+	RK4,
+	Count UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class ESubmixEffectEnvelopeDetectorMode : uint8
+{
+	Peak = 0,
+	RMS,
+	Count UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class ESubmixEffectEmphasisFilterType : uint8
+{
+	Off = 0,
+	LowCut,
+	HighCut,
+	LowShelf,
+	HighShelf,
+	Peak,
 	Count UMETA(Hidden)
 };
 
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSubmixEffectSaturationEmphasisBand
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	ESubmixEffectEmphasisFilterType Type = ESubmixEffectEmphasisFilterType::Off;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "Type != ESubmixEffectEmphasisFilterType::Off", ClampMin = "20.0", ClampMax = "20000.0", UIMin = "20.0", UIMax = "20000.0", Units = "Hz"))
+	float Frequency = 1000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "Type == ESubmixEffectEmphasisFilterType::LowShelf || Type == ESubmixEffectEmphasisFilterType::HighShelf || Type == ESubmixEffectEmphasisFilterType::Peak", ClampMin = "-24.0", ClampMax = "24.0", UIMin = "-24.0", UIMax = "24.0", Units = "dB"))
+	float GainDb = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "Type != ESubmixEffectEmphasisFilterType::Off", ClampMin = "0.1", ClampMax = "10.0", UIMin = "0.1", UIMax = "10.0"))
+	float Q = 0.707f;
+};
+
+// Level of each harmonic of a full scale input, for the Harmonic type. Negative values invert its phase
+USTRUCT(BlueprintType)
+struct AUDIODSPCOLLECTION_API FSubmixEffectSaturationHarmonics
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Fundamental = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Second = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Third = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Fourth = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Fifth = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Sixth = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Seventh = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float Eighth = 0.0f;
+};
+
+AUDIODSPCOLLECTION_API DSPProcessing::ESaturationType SubmixEffectSaturationTypeToSaturationType(ESubmixEffectSaturationType SubmixEffectSaturationType);
+AUDIODSPCOLLECTION_API DSPProcessing::ETapeHysteresisSolver SubmixEffectTapeHysteresisSolverToTapeHysteresisSolver(ESubmixEffectTapeHysteresisSolver SubmixEffectTapeHysteresisSolver);
+AUDIODSPCOLLECTION_API DSPProcessing::EEnvelopeDetectorMode SubmixEffectEnvelopeDetectorModeToEnvelopeDetectorMode(ESubmixEffectEnvelopeDetectorMode SubmixEffectEnvelopeDetectorMode);
+AUDIODSPCOLLECTION_API DSPProcessing::FEmphasisBand SubmixEffectSaturationEmphasisBandToEmphasisBand(const FSubmixEffectSaturationEmphasisBand& SubmixEffectSaturationEmphasisBand);
+AUDIODSPCOLLECTION_API void SubmixEffectSaturationHarmonicsToHarmonicWeights(const FSubmixEffectSaturationHarmonics& SubmixEffectSaturationHarmonics, DSPProcessing::FSaturation& OutSaturation);
+
 //////////////////////////////////////////////////////////////////////////////////////
 
 class AUDIODSPCOLLECTION_API FSubmixEffectSaturation : public FSoundEffectSubmix
@@ -42,8 +135,51 @@ public:
 	// Process the input block of audio. Called on audio thread.
 	virtual void OnProcessAudio(const FSoundEffectSubmixInputData& InData, FSoundEffectSubmixOutputData& OutData) override;
 
+	// 1 block when Pipelined is enabled, plus the look-ahead when the limiter is enabled, for the current block size.
+	// Informational only, the mixer never compensates it
+	int32 GetLatencyInFrames() const;
+
+	// Capacity of the pipeline buffers: the device block size (DefaultMaxBlockFrames when unknown) times MaxNumChannels (third order ambisonics).
+	// Larger blocks are dropped in pipelined mode
+	static constexpr int32 MaxNumChannels        = 16;
+	static constexpr int32 DefaultMaxBlockFrames = 4096;
+
 protected:
+	void ApplySettings();
+
+	// Serial or channel partitioned, called on the render thread or on the pipeline worker
+	void ProcessBlock(const float* InBuffer, float* OutBuffer, const int32 InNumSamples);
+
 	DSPProcessing::FSaturation SaturationDSPProcessor;
+	bool  bParallelChannels = false;
+	int32 NumChannels       = 0;
+
+	// Cabinet/IR coloring after the saturation, in place on the output
+	DSPProcessing::FConvolution CabinetDSPProcessor;
+	int32 BlockFrames = 0;
+
+	// Fused after the saturation (and the cabinet), in place on the output
+	DSPProcessing::FLimiter LimiterDSPProcessor;
+	bool bLimiterEnabled = false;
+
+	// AudioModulation on top of the preset Gain/Bias/Mix/OutLevelDb, read once per block
+	void ApplyModulation();
+
+	DSPCollection::FModulatedParam GainModulation;
+	DSPCollection::FModulatedParam BiasModulation;
+	DSPCollection::FModulatedParam MixModulation;
+	DSPCollection::FModulatedParam OutLevelModulation;
+	float BaseGain       = 100.0f;
+	float BaseBias       = 0.0f;
+	float BaseMix        = 100.0f;
+	float BaseOutLevelDb = 0.0f;
+	bool  bModulated     = false;
+
+	// Pipelined mode, declared after SaturationDSPProcessor so the worker is stopped before the processor goes away
+	FSubmixEffectPipeline Pipeline;
+	bool  bPipelined         = false;
+	bool  bSettingsChanged   = false; // Applied once the worker doesn't own the DSP processors
+	int32 LastBlockNumFrames = 0;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -65,8 +201,132 @@ struct AUDIODSPCOLLECTION_API FSubmixEffectSaturationSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (ClampMin = "-96.0", ClampMax = "24.0", UIMin = "-96.0", UIMax = "24.0"))
 	float OutLevelDb = 0.0f;
 
+	// AudioModulation modulators (control buses, LFOs, envelope followers) scaling Gain, from 0 to the preset value
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Modulation")
+	TSet<TObjectPtr<USoundModulatorBase>> GainModulators;
+
+	// Scale Bias, from 0 to the preset value
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Modulation")
+	TSet<TObjectPtr<USoundModulatorBase>> BiasModulators;
+
+	// Scale Mix, from 0 to the preset value
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Modulation")
+	TSet<TObjectPtr<USoundModulatorBase>> MixModulators;
+
+	// Volume modulators, their attenuation in dB is added to OutLevelDb
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Modulation", meta = (AudioParam = "Volume", AudioParamClass = "SoundModulationParameterVolume"))
+	TSet<TObjectPtr<USoundModulatorBase>> OutLevelModulators;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
 	ESubmixEffectSaturationType SaturationType = ESubmixEffectSaturationType::Tape;
+
+	// RK4 is more accurate on steep inputs, RK2 costs half the solver evaluations
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "SaturationType == ESubmixEffectSaturationType::TapeHysteresis", EditConditionHides))
+	ESubmixEffectTapeHysteresisSolver TapeHysteresisSolver = ESubmixEffectTapeHysteresisSolver::RK4;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "SaturationType == ESubmixEffectSaturationType::TapeHysteresis", EditConditionHides, ClampMin = "1", ClampMax = "4", UIMin = "1", UIMax = "4"))
+	int32 TapeHysteresisOversampling = 1;
+
+	// Polynomial curve, exact harmonic levels up to a full scale input (Gain 0), the higher gains clamp the input
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "SaturationType == ESubmixEffectSaturationType::Harmonic", EditConditionHides))
+	FSubmixEffectSaturationHarmonics Harmonics;
+
+	// Curve drawn in a DSPCollection Transfer Curve asset, no asset falls back to Tape
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "SaturationType == ESubmixEffectSaturationType::Custom", EditConditionHides))
+	TObjectPtr<UDSPCollectionTransferCurve> CustomCurve = nullptr;
+
+	// Stereo submixes only: saturates mid and side separately, Gain, Bias and Mix above drive the mid and the Side values below the side.
+	// A Side Mix of 0 saturates only the mid. Ignored for other channel counts
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	bool bMidSide = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bMidSide", ClampMin = "0.0", ClampMax = "100.0", UIMin = "0.0", UIMax = "100.0"))
+	float SideGain = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bMidSide", ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float SideBias = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bMidSide", ClampMin = "0.0", ClampMax = "100.0", UIMin = "0.0", UIMax = "100.0"))
+	float SideMix = 100.0f;
+
+	// Removes the DC offset introduced by Bias with a one-pole high-pass at the output
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	bool bDCBlockerEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bDCBlockerEnabled", ClampMin = "5.0", ClampMax = "200.0", UIMin = "5.0", UIMax = "200.0"))
+	float DCBlockerCutoffFrequency = 10.0f;
+
+	// Follows the input level and modulates Gain and Bias with it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	bool bEnvelopeFollowerEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled"))
+	ESubmixEffectEnvelopeDetectorMode EnvelopeDetectorMode = ESubmixEffectEnvelopeDetectorMode::Peak;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled", ClampMin = "0.1", ClampMax = "500.0", UIMin = "0.1", UIMax = "500.0"))
+	float EnvelopeAttackTimeMs = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled", ClampMin = "1.0", ClampMax = "5000.0", UIMin = "1.0", UIMax = "5000.0"))
+	float EnvelopeReleaseTimeMs = 100.0f;
+
+	// Positive values reduce the drive as the level drops (cleaner quiet tails), negative values increase it (sag)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled", ClampMin = "-100.0", ClampMax = "100.0", UIMin = "-100.0", UIMax = "100.0"))
+	float EnvelopeToGain = 0.0f;
+
+	// Amount of Bias added at full scale input
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bEnvelopeFollowerEnabled", ClampMin = "-1.0", ClampMax = "1.0", UIMin = "-1.0", UIMax = "1.0"))
+	float EnvelopeToBias = 0.0f;
+
+	// Biquads on the input of the curve, e.g. a low cut to keep the lows clean or a mid peak to focus the drive. The dry path is not filtered
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	FSubmixEffectSaturationEmphasisBand PreEmphasisBand1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	FSubmixEffectSaturationEmphasisBand PreEmphasisBand2;
+
+	// Biquads on the output of the curve before the mix, e.g. a high cut to tame the generated harmonics
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	FSubmixEffectSaturationEmphasisBand PostEmphasisBand1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	FSubmixEffectSaturationEmphasisBand PostEmphasisBand2;
+
+	// Convolved with the saturated signal (cabinet, mic or any coloring IR), before the limiter. No IR disables it, no latency
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	TObjectPtr<UDSPCollectionImpulseResponse> CabinetImpulseResponse = nullptr;
+
+	// Longer partitions for the tail of the IR: cheaper on average for long IRs, with a heavier block every 8 blocks
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", AdvancedDisplay)
+	bool bCabinetNonUniformPartitions = false;
+
+	// Look-ahead brickwall limiter after the saturation, keeps the output under LimiterCeilingDb whatever Gain and OutLevelDb are.
+	// Adds LimiterLookAheadMs of latency
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset")
+	bool bLimiterEnabled = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bLimiterEnabled", ClampMin = "-24.0", ClampMax = "0.0", UIMin = "-24.0", UIMax = "0.0", Units = "dB"))
+	float LimiterCeilingDb = -1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bLimiterEnabled", ClampMin = "1.0", ClampMax = "5000.0", UIMin = "1.0", UIMax = "5000.0", Units = "ms"))
+	float LimiterReleaseTimeMs = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bLimiterEnabled", ClampMin = "0.5", ClampMax = "20.0", UIMin = "0.5", UIMax = "20.0", Units = "ms"))
+	float LimiterLookAheadMs = 5.0f;
+
+	// 4x oversampled detector, catches the peaks between the samples
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", meta = (EditCondition = "bLimiterEnabled"))
+	bool bLimiterTruePeak = false;
+
+	// Splits the channels across the task graph workers, for ambisonic and object beds with 16 channels or more.
+	// Off or below au.DSPCollection.Saturation.ParallelMinChannels the channels aren't partitioned at all, below ParallelMinFrames the partitions run on the calling thread.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", AdvancedDisplay)
+	bool bParallelChannels = false;
+
+	// Processes on a dedicated worker thread instead of the audio render thread, the output is delayed by one block (see GetLatencyInFrames).
+	// For heavy settings (e.g. TapeHysteresis with oversampling) when the render thread is the bottleneck. The render thread never waits:
+	// when the worker is late that block is dropped and the output is silent for it.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", AdvancedDisplay)
+	bool bPipelined = false;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +342,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Saturation")
 	void SetSettings(const FSubmixEffectSaturationSettings& InSettings);
 
+	// Delay of the output for the submix block size: one block when Pipelined, plus the limiter look-ahead.
+	// Informational only, the mixer never compensates it: use it to align the dry or parallel paths
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects|Saturation")
+	int32 GetLatencyInFrames(const float SampleRate = 48000.0f, const int32 NumFramesPerBlock = 1024) const;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SubmixEffect|Preset", Meta = (ShowOnlyInnerProperties))
 	FSubmixEffectSaturationSettings Settings;
 };